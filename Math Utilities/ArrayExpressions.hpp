@@ -0,0 +1,663 @@
+//  ArrayExpressions.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Array Expressions header file defines expression templates over VectorArrays, so that arithmetic on whole
+ * arrays can be written in the notation of single vectors and still runs as one fused loop without
+ * temporary arrays:
+ *
+ *     positions += velocities * dt + accelerations * (0.5 * dt * dt);
+ *
+ *     auto difference = positions - position; // Vec2D 'position' is broadcast to every element
+ *     auto r2 = squareLength(difference) + softening * softening;
+ *     Vec2D acceleration = G * sum(difference * (scalars(masses) / (r2 * sqrt(r2))));
+ *
+ * These components include:
+ *   - VectorExpression, ScalarExpression: The bases of expressions yielding a vector or a double per element.
+ *   - Operands: VectorArrays, Vec2D/Vec3D values (the same vector for every element), std::vector<double>
+ *     wrapped with scalars(), and plain numbers.
+ *   - Operators: vector + - vector, -vector, vector * / scalar, scalar * vector, scalar + - * / scalar, and
+ *     squareLength, length, dot and sqrt per element. At least one operand must be an array or an expression,
+ *     so arithmetic on single Vec2D/Vec3D values is untouched.
+ *   - Evaluation: assigning to a VectorArray (=, +=, -=), evaluate() into a std::vector<double>, and sum().
+ *
+ * Expressions only hold references to the arrays they read, and build nothing until they are evaluated;
+ * an 'auto' expression must not outlive its arrays. Element i of the result only reads element i of every
+ * array, so the assigned array may appear in its own expression. Arrays of different sizes are combined
+ * over their first min(sizes) elements, like the VectorArrays operations. Every element is computed in the
+ * order the expression is written, so results match the same arithmetic on Vec2D/Vec3D values bitwise.
+ */
+
+
+#pragma once
+#include "VectorArrays.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+
+
+
+
+
+/**
+ * VectorExpression struct, the base of expressions with a vector per element.
+ *
+ * An Expression derived from it provides DIMENSIONS, size() and at(index, values), which writes the
+ * DIMENSIONS components of one element to 'values', so that scalar factors shared by the components (say
+ * mass / r^3) are computed once per element.
+ */
+template<typename Expression>
+struct VectorExpression
+{
+	const Expression &derived() const noexcept { return static_cast<const Expression&>(*this); }
+};
+
+
+/**
+ * ScalarExpression struct, the base of expressions with a double per element.
+ *
+ * An Expression derived from it provides size() and at(index).
+ */
+template<typename Expression>
+struct ScalarExpression
+{
+	const Expression &derived() const noexcept { return static_cast<const Expression&>(*this); }
+};
+
+
+constexpr std::size_t UNBOUNDED_EXPRESSION_SIZE = std::numeric_limits<std::size_t>::max(); // The size of operands that are not arrays
+
+
+
+
+
+
+
+
+/// ------------- Operands -------------
+/// \{
+/// The vectors of a VectorArray.
+template<int Dimensions>
+class VectorArrayOperand : public VectorExpression<VectorArrayOperand<Dimensions>>
+{
+public:
+	static constexpr int DIMENSIONS = Dimensions;
+	explicit VectorArrayOperand(const VectorArray<Dimensions> &_array) noexcept : array(&_array) {}
+	std::size_t size() const noexcept { return array->size(); }
+	void at(std::size_t index, double *values) const noexcept
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			values[d] = array->component(d)[index];
+		}
+	}
+
+private:
+	const VectorArray<Dimensions> *array; // Read at evaluation, so the expression sees the array as it is then
+};
+
+
+/// One vector, the same for every element.
+template<int Dimensions>
+class VectorBroadcast : public VectorExpression<VectorBroadcast<Dimensions>>
+{
+public:
+	static constexpr int DIMENSIONS = Dimensions;
+	explicit VectorBroadcast(const typename VectorArray<Dimensions>::Vector &_vector) noexcept : vector(_vector) {}
+	std::size_t size() const noexcept { return UNBOUNDED_EXPRESSION_SIZE; }
+	void at(std::size_t, double *values) const noexcept
+	{
+		values[0] = vector.x;
+		values[1] = vector.y;
+		if constexpr (Dimensions == 3)
+		{
+			values[2] = vector.z;
+		}
+	}
+
+private:
+	typename VectorArray<Dimensions>::Vector vector; // Copied, so a broadcast of a temporary is safe
+};
+
+
+/// The values of a std::vector<double>, see scalars().
+class ScalarArrayOperand : public ScalarExpression<ScalarArrayOperand>
+{
+public:
+	explicit ScalarArrayOperand(const std::vector<double> &_values) noexcept : values(&_values) {}
+	std::size_t size() const noexcept { return values->size(); }
+	double at(std::size_t index) const noexcept { return (*values)[index]; }
+
+private:
+	const std::vector<double> *values;
+};
+
+
+/// One number, the same for every element.
+class ScalarConstant : public ScalarExpression<ScalarConstant>
+{
+public:
+	explicit ScalarConstant(double _value) noexcept : value(_value) {}
+	std::size_t size() const noexcept { return UNBOUNDED_EXPRESSION_SIZE; }
+	double at(std::size_t) const noexcept { return value; }
+
+private:
+	double value;
+};
+
+
+/// Makes a std::vector<double> an operand of expressions, e.g. the masses of the bodies.
+inline ScalarArrayOperand scalars(const std::vector<double> &values) noexcept { return ScalarArrayOperand(values); }
+/// \}
+
+
+
+
+
+
+
+
+/// ------------- Nodes -------------
+/// \{
+/// Nodes hold their operands by value (operands are small and refer to arrays), so expressions can be returned and stored.
+struct AddOperation { static double apply(double a, double b) noexcept { return a + b; } };
+struct SubtractOperation { static double apply(double a, double b) noexcept { return a - b; } };
+struct MultiplyOperation { static double apply(double a, double b) noexcept { return a * b; } };
+struct DivideOperation { static double apply(double a, double b) noexcept { return a / b; } };
+struct AssignOperation { static double apply(double, double b) noexcept { return b; } };
+
+
+/// Component-wise 'Operation' of two vector expressions.
+template<typename Left, typename Right, typename Operation>
+class VectorBinaryNode : public VectorExpression<VectorBinaryNode<Left, Right, Operation>>
+{
+	static_assert(Left::DIMENSIONS == Right::DIMENSIONS, "Vectors of different dimensions");
+
+public:
+	static constexpr int DIMENSIONS = Left::DIMENSIONS;
+	VectorBinaryNode(const Left &_left, const Right &_right) noexcept : left(_left), right(_right) {}
+	std::size_t size() const noexcept { return std::min(left.size(), right.size()); }
+	void at(std::size_t index, double *values) const noexcept
+	{
+		double rightValues[DIMENSIONS];
+		left.at(index, values);
+		right.at(index, rightValues);
+		for (int d = 0; d < DIMENSIONS; d++)
+		{
+			values[d] = Operation::apply(values[d], rightValues[d]);
+		}
+	}
+
+private:
+	Left left;
+	Right right;
+};
+
+
+/// Each component of a vector expression combined by 'Operation' with a scalar expression, e.g. vector * scalar.
+template<typename Vector, typename Scalar, typename Operation>
+class VectorScalarNode : public VectorExpression<VectorScalarNode<Vector, Scalar, Operation>>
+{
+public:
+	static constexpr int DIMENSIONS = Vector::DIMENSIONS;
+	VectorScalarNode(const Vector &_vector, const Scalar &_scalar) noexcept : vector(_vector), scalar(_scalar) {}
+	std::size_t size() const noexcept { return std::min(vector.size(), scalar.size()); }
+	void at(std::size_t index, double *values) const noexcept
+	{
+		vector.at(index, values);
+		double factor = scalar.at(index);
+		for (int d = 0; d < DIMENSIONS; d++)
+		{
+			values[d] = Operation::apply(values[d], factor);
+		}
+	}
+
+private:
+	Vector vector;
+	Scalar scalar;
+};
+
+
+template<typename Vector>
+class VectorNegateNode : public VectorExpression<VectorNegateNode<Vector>>
+{
+public:
+	static constexpr int DIMENSIONS = Vector::DIMENSIONS;
+	explicit VectorNegateNode(const Vector &_vector) noexcept : vector(_vector) {}
+	std::size_t size() const noexcept { return vector.size(); }
+	void at(std::size_t index, double *values) const noexcept
+	{
+		vector.at(index, values);
+		for (int d = 0; d < DIMENSIONS; d++)
+		{
+			values[d] = -values[d];
+		}
+	}
+
+private:
+	Vector vector;
+};
+
+
+/// 'Operation' of two scalar expressions.
+template<typename Left, typename Right, typename Operation>
+class ScalarBinaryNode : public ScalarExpression<ScalarBinaryNode<Left, Right, Operation>>
+{
+public:
+	ScalarBinaryNode(const Left &_left, const Right &_right) noexcept : left(_left), right(_right) {}
+	std::size_t size() const noexcept { return std::min(left.size(), right.size()); }
+	double at(std::size_t index) const noexcept { return Operation::apply(left.at(index), right.at(index)); }
+
+private:
+	Left left;
+	Right right;
+};
+
+
+template<typename Scalar>
+class ScalarSqrtNode : public ScalarExpression<ScalarSqrtNode<Scalar>>
+{
+public:
+	explicit ScalarSqrtNode(const Scalar &_scalar) noexcept : scalar(_scalar) {}
+	std::size_t size() const noexcept { return scalar.size(); }
+	double at(std::size_t index) const noexcept { return std::sqrt(scalar.at(index)); }
+
+private:
+	Scalar scalar;
+};
+
+
+/// The dot product of two vector expressions per element; squareLength is the dot product of an expression with itself.
+template<typename Left, typename Right>
+class DotNode : public ScalarExpression<DotNode<Left, Right>>
+{
+	static_assert(Left::DIMENSIONS == Right::DIMENSIONS, "Vectors of different dimensions");
+
+public:
+	DotNode(const Left &_left, const Right &_right) noexcept : left(_left), right(_right) {}
+	std::size_t size() const noexcept { return std::min(left.size(), right.size()); }
+	double at(std::size_t index) const noexcept
+	{
+		double leftValues[Left::DIMENSIONS], rightValues[Left::DIMENSIONS];
+		left.at(index, leftValues);
+		right.at(index, rightValues);
+		double sum = leftValues[0] * rightValues[0] + leftValues[1] * rightValues[1]; // Same order as Vec2D::dot
+		if constexpr (Left::DIMENSIONS == 3)
+		{
+			sum = sum + leftValues[2] * rightValues[2];
+		}
+		return sum;
+	}
+
+private:
+	Left left;
+	Right right;
+};
+/// \}
+
+
+
+
+
+
+
+
+/// ------------- Operand Traits -------------
+/// \{
+/// How a type takes part in an expression: VALID if it is an operand, ARRAY if it has one value per element, Node the operand type.
+template<typename T, typename = void>
+struct VectorOperand
+{
+	static constexpr bool VALID = false;
+	static constexpr bool ARRAY = false;
+	static constexpr int DIMENSIONS = 0;
+};
+
+template<int Dimensions>
+struct VectorOperand<VectorArray<Dimensions>>
+{
+	static constexpr bool VALID = true;
+	static constexpr bool ARRAY = true;
+	static constexpr int DIMENSIONS = Dimensions;
+	using Node = VectorArrayOperand<Dimensions>;
+	static Node node(const VectorArray<Dimensions> &array) noexcept { return Node(array); }
+};
+
+template<typename T>
+struct VectorOperand<T, typename std::enable_if<std::is_base_of<VectorExpression<T>, T>::value>::type>
+{
+	static constexpr bool VALID = true;
+	static constexpr bool ARRAY = true;
+	static constexpr int DIMENSIONS = T::DIMENSIONS;
+	using Node = T;
+	static const Node &node(const T &expression) noexcept { return expression; }
+};
+
+template<>
+struct VectorOperand<Vec2D>
+{
+	static constexpr bool VALID = true;
+	static constexpr bool ARRAY = false;
+	static constexpr int DIMENSIONS = 2;
+	using Node = VectorBroadcast<2>;
+	static Node node(const Vec2D &vector) noexcept { return Node(vector); }
+};
+
+template<>
+struct VectorOperand<Vec3D>
+{
+	static constexpr bool VALID = true;
+	static constexpr bool ARRAY = false;
+	static constexpr int DIMENSIONS = 3;
+	using Node = VectorBroadcast<3>;
+	static Node node(const Vec3D &vector) noexcept { return Node(vector); }
+};
+
+
+template<typename T, typename = void>
+struct ScalarOperand
+{
+	static constexpr bool VALID = false;
+	static constexpr bool ARRAY = false;
+};
+
+template<typename T>
+struct ScalarOperand<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+{
+	static constexpr bool VALID = true;
+	static constexpr bool ARRAY = false;
+	using Node = ScalarConstant;
+	static Node node(T value) noexcept { return Node(static_cast<double>(value)); }
+};
+
+template<typename T>
+struct ScalarOperand<T, typename std::enable_if<std::is_base_of<ScalarExpression<T>, T>::value>::type>
+{
+	static constexpr bool VALID = true;
+	static constexpr bool ARRAY = true;
+	using Node = T;
+	static const Node &node(const T &expression) noexcept { return expression; }
+};
+
+
+/// Enables an operator of two vectors of the same dimensions, at least one of them an array.
+template<typename A, typename B>
+using EnableVectorVector = typename std::enable_if<VectorOperand<A>::VALID && VectorOperand<B>::VALID && (VectorOperand<A>::ARRAY || VectorOperand<B>::ARRAY) && VectorOperand<A>::DIMENSIONS == VectorOperand<B>::DIMENSIONS, int>::type;
+
+/// Enables an operator of a vector and a scalar, at least one of them an array.
+template<typename V, typename S>
+using EnableVectorScalar = typename std::enable_if<VectorOperand<V>::VALID && ScalarOperand<S>::VALID && (VectorOperand<V>::ARRAY || ScalarOperand<S>::ARRAY), int>::type;
+
+/// Enables an operator of two scalars, at least one of them an array.
+template<typename A, typename B>
+using EnableScalarScalar = typename std::enable_if<ScalarOperand<A>::VALID && ScalarOperand<B>::VALID && (ScalarOperand<A>::ARRAY || ScalarOperand<B>::ARRAY), int>::type;
+
+template<typename V>
+using EnableVectorArray = typename std::enable_if<VectorOperand<V>::ARRAY, int>::type;
+
+template<typename S>
+using EnableScalarArray = typename std::enable_if<ScalarOperand<S>::ARRAY, int>::type;
+/// \}
+
+
+
+
+
+
+
+
+/// ------------- Operators -------------
+/// \{
+template<typename A, typename B, EnableVectorVector<A, B> = 0>
+auto operator+(const A &a, const B &b) noexcept
+{
+	return VectorBinaryNode<typename VectorOperand<A>::Node, typename VectorOperand<B>::Node, AddOperation>(VectorOperand<A>::node(a), VectorOperand<B>::node(b));
+}
+
+
+template<typename A, typename B, EnableVectorVector<A, B> = 0>
+auto operator-(const A &a, const B &b) noexcept
+{
+	return VectorBinaryNode<typename VectorOperand<A>::Node, typename VectorOperand<B>::Node, SubtractOperation>(VectorOperand<A>::node(a), VectorOperand<B>::node(b));
+}
+
+
+template<typename V, EnableVectorArray<V> = 0>
+auto operator-(const V &v) noexcept
+{
+	return VectorNegateNode<typename VectorOperand<V>::Node>(VectorOperand<V>::node(v));
+}
+
+
+template<typename V, typename S, EnableVectorScalar<V, S> = 0>
+auto operator*(const V &v, const S &s) noexcept
+{
+	return VectorScalarNode<typename VectorOperand<V>::Node, typename ScalarOperand<S>::Node, MultiplyOperation>(VectorOperand<V>::node(v), ScalarOperand<S>::node(s));
+}
+
+
+template<typename S, typename V, EnableVectorScalar<V, S> = 0>
+auto operator*(const S &s, const V &v) noexcept
+{
+	return v * s; // Multiplication commutes exactly
+}
+
+
+template<typename V, typename S, EnableVectorScalar<V, S> = 0>
+auto operator/(const V &v, const S &s) noexcept
+{
+	return VectorScalarNode<typename VectorOperand<V>::Node, typename ScalarOperand<S>::Node, DivideOperation>(VectorOperand<V>::node(v), ScalarOperand<S>::node(s));
+}
+
+
+template<typename A, typename B, EnableScalarScalar<A, B> = 0>
+auto operator+(const A &a, const B &b) noexcept
+{
+	return ScalarBinaryNode<typename ScalarOperand<A>::Node, typename ScalarOperand<B>::Node, AddOperation>(ScalarOperand<A>::node(a), ScalarOperand<B>::node(b));
+}
+
+
+template<typename A, typename B, EnableScalarScalar<A, B> = 0>
+auto operator-(const A &a, const B &b) noexcept
+{
+	return ScalarBinaryNode<typename ScalarOperand<A>::Node, typename ScalarOperand<B>::Node, SubtractOperation>(ScalarOperand<A>::node(a), ScalarOperand<B>::node(b));
+}
+
+
+template<typename A, typename B, EnableScalarScalar<A, B> = 0>
+auto operator*(const A &a, const B &b) noexcept
+{
+	return ScalarBinaryNode<typename ScalarOperand<A>::Node, typename ScalarOperand<B>::Node, MultiplyOperation>(ScalarOperand<A>::node(a), ScalarOperand<B>::node(b));
+}
+
+
+template<typename A, typename B, EnableScalarScalar<A, B> = 0>
+auto operator/(const A &a, const B &b) noexcept
+{
+	return ScalarBinaryNode<typename ScalarOperand<A>::Node, typename ScalarOperand<B>::Node, DivideOperation>(ScalarOperand<A>::node(a), ScalarOperand<B>::node(b));
+}
+
+
+template<typename S, EnableScalarArray<S> = 0>
+auto sqrt(const S &s) noexcept
+{
+	return ScalarSqrtNode<S>(s);
+}
+
+
+template<typename A, typename B, EnableVectorVector<A, B> = 0>
+auto dot(const A &a, const B &b) noexcept
+{
+	return DotNode<typename VectorOperand<A>::Node, typename VectorOperand<B>::Node>(VectorOperand<A>::node(a), VectorOperand<B>::node(b));
+}
+
+
+template<typename V, EnableVectorArray<V> = 0>
+auto squareLength(const V &v) noexcept
+{
+	return DotNode<typename VectorOperand<V>::Node, typename VectorOperand<V>::Node>(VectorOperand<V>::node(v), VectorOperand<V>::node(v));
+}
+
+
+template<typename V, EnableVectorArray<V> = 0>
+auto length(const V &v) noexcept
+{
+	return sqrt(squareLength(v));
+}
+/// \}
+
+
+
+
+
+
+
+
+/// ------------- Evaluation -------------
+/// \{
+/**
+ * evaluate
+ * Evaluates a scalar expression into an array of doubles in one pass.
+ *
+ * @param expression: The expression, with at least one array operand
+ * @param out: Resized to the size of the expression and filled with its values
+ */
+template<typename Expression>
+void evaluate(const ScalarExpression<Expression> &expression, std::vector<double> &out)
+{
+	const Expression &scalar = expression.derived();
+	std::size_t count = scalar.size();
+	out.resize(count);
+	double *values = out.data();
+	for (std::size_t i = 0; i < count; i++)
+	{
+		values[i] = scalar.at(i);
+	}
+}
+
+
+/// The sum of the values of a scalar expression, added in element order.
+template<typename Expression>
+double sum(const ScalarExpression<Expression> &expression)
+{
+	const Expression &scalar = expression.derived();
+	double total = 0;
+	for (std::size_t i = 0, count = scalar.size(); i < count; i++)
+	{
+		total = total + scalar.at(i);
+	}
+	return total;
+}
+
+
+/**
+ * sum
+ * Adds the vectors of a vector expression in element order, e.g. the contributions of all bodies to the
+ * force on one body.
+ *
+ * @param expression: The expression, with at least one array operand
+ * @return Vec2D or Vec3D: The sum
+ */
+template<typename Expression>
+typename VectorArray<Expression::DIMENSIONS>::Vector sum(const VectorExpression<Expression> &expression)
+{
+	const Expression &vector = expression.derived();
+	double total[Expression::DIMENSIONS] = {}, values[Expression::DIMENSIONS];
+	for (std::size_t i = 0, count = vector.size(); i < count; i++)
+	{
+		vector.at(i, values);
+		for (int d = 0; d < Expression::DIMENSIONS; d++)
+		{
+			total[d] = total[d] + values[d];
+		}
+	}
+	if constexpr (Expression::DIMENSIONS == 2)
+	{
+		return Vec2D(total[0], total[1]);
+	}
+	else
+	{
+		return Vec3D(total[0], total[1], total[2]);
+	}
+}
+/// \}
+
+
+
+
+
+
+
+
+/// ------------- VectorArray Expression Definitions -------------
+/// \{
+template<int Dimensions>
+template<typename Expression>
+VectorArray<Dimensions>::VectorArray(const VectorExpression<Expression> &expression)
+{
+	*this = expression;
+}
+
+
+template<int Dimensions>
+template<typename Expression>
+VectorArray<Dimensions> &VectorArray<Dimensions>::operator=(const VectorExpression<Expression> &expression)
+{
+	static_assert(Expression::DIMENSIONS == Dimensions, "Assigning vectors of different dimensions");
+	std::size_t expressionSize = expression.derived().size();
+	resize(expressionSize); // An array read by the expression is at least this long already, so it is never reallocated here
+	evaluate<Expression, AssignOperation>(expression.derived(), expressionSize);
+	return *this;
+}
+
+
+template<int Dimensions>
+template<typename Expression>
+VectorArray<Dimensions> &VectorArray<Dimensions>::operator+=(const VectorExpression<Expression> &expression)
+{
+	static_assert(Expression::DIMENSIONS == Dimensions, "Adding vectors of different dimensions");
+	evaluate<Expression, AddOperation>(expression.derived(), std::min(count, expression.derived().size()));
+	return *this;
+}
+
+
+template<int Dimensions>
+template<typename Expression>
+VectorArray<Dimensions> &VectorArray<Dimensions>::operator-=(const VectorExpression<Expression> &expression)
+{
+	static_assert(Expression::DIMENSIONS == Dimensions, "Subtracting vectors of different dimensions");
+	evaluate<Expression, SubtractOperation>(expression.derived(), std::min(count, expression.derived().size()));
+	return *this;
+}
+
+
+/**
+ * evaluate
+ * The loop every expression assignment compiles to: one pass over the elements, computing all components
+ * of element i before storing them, so the array may be read by the expression it is assigned.
+ *
+ * @param expression: The expression
+ * @param evaluatedCount: The number of leading vectors to update
+ */
+template<int Dimensions>
+template<typename Expression, typename Operation>
+void VectorArray<Dimensions>::evaluate(const Expression &expression, std::size_t evaluatedCount)
+{
+	double *outX = x(), *outY = y(), *outZ = component(Dimensions - 1); // outZ is unused in 2D
+	for (std::size_t i = 0; i < evaluatedCount; i++)
+	{
+		double values[Dimensions];
+		expression.at(i, values);
+		outX[i] = Operation::apply(outX[i], values[0]);
+		outY[i] = Operation::apply(outY[i], values[1]);
+		if constexpr (Dimensions == 3)
+		{
+			outZ[i] = Operation::apply(outZ[i], values[2]);
+		}
+	}
+}
+/// \}
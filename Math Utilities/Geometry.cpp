@@ -20,7 +20,8 @@
  * Default constructor
  * Initializes center and radius to default values
  */
-Circle::Circle() : center(Vec2D()), radius(0.0) {}
+template<typename Scalar>
+BasicCircle<Scalar>::BasicCircle() : center(Vec2<Scalar>()), radius(0.0) {}
 
 
 /**
@@ -30,7 +31,19 @@ Circle::Circle() : center(Vec2D()), radius(0.0) {}
  * @param _center: center position of the circle
  * @param _radius: radius of the circle
  */
-Circle::Circle(const Vec2D& _center, double _radius) : center(_center), radius(_radius) {}
+template<typename Scalar>
+BasicCircle<Scalar>::BasicCircle(const Vec2<Scalar>& _center, Scalar _radius) : center(_center), radius(_radius) {}
+
+
+/**
+ * Circle
+ *
+ * Converting constructor, explicit so that precisions never mix silently
+ * @param other: the circle of another precision, rounded to this one
+ */
+template<typename Scalar>
+template<typename Other>
+BasicCircle<Scalar>::BasicCircle(const BasicCircle<Other>& other) : center(other.center), radius(static_cast<Scalar>(other.radius)) {}
 
 
 
@@ -41,10 +54,11 @@ Circle::Circle(const Vec2D& _center, double _radius) : center(_center), radius(_
  * Computes the area of the circle
  * @return: the area of the circle
  */
-double Circle::area() const
+template<typename Scalar>
+Scalar BasicCircle<Scalar>::area() const
 {
 	// Area of a circle is pi*r^2
-	return M_PI * std::pow(radius, 2);
+	return Scalar(M_PI) * std::pow(radius, Scalar(2));
 }
 
 
@@ -54,10 +68,11 @@ double Circle::area() const
  * Computes the circumference of the circle
  * @return: the circumference of the circle
  */
-double Circle::circumference() const
+template<typename Scalar>
+Scalar BasicCircle<Scalar>::circumference() const
 {
 	// Circumference of a circle is 2*pi*r
-	return 2 * M_PI * radius;
+	return 2 * Scalar(M_PI) * radius;
 }
 
 
@@ -70,7 +85,8 @@ double Circle::circumference() const
  * @param point: the point to check
  * @return: true if the point is inside the circle, false otherwise
  */
-bool Circle::containsPoint(const Vec2D &point) const
+template<typename Scalar>
+bool BasicCircle<Scalar>::containsPoint(const Vec2<Scalar> &point) const
 {
 	// Distance between center and point should be less than or equal to radius for point to be inside circle
 	return (center - point).vectorSquareLength() <= radius * radius;
@@ -85,7 +101,8 @@ bool Circle::containsPoint(const Vec2D &point) const
  * @param radius: the radius of the other circle
  * @return: true if the other circle is inside the circle, false otherwise
  */
-bool Circle::contains(const Vec2D& position, const double radius) const
+template<typename Scalar>
+bool BasicCircle<Scalar>::contains(const Vec2<Scalar>& position, const Scalar radius) const
 {
 	// For another circle to be completely inside, the distance between the centers + radius of the smaller circle should be <= radius of the larger circle
 	return (center - position).vectorSquareLength() <= (this->radius - radius) * (this->radius - radius);
@@ -108,7 +125,8 @@ bool Circle::contains(const Vec2D& position, const double radius) const
  * Default constructor
  * Initializes center and size to default values
  */
-Square::Square() : center(Vec2D(0,0)), size(0) {}
+template<typename Scalar>
+BasicSquare<Scalar>::BasicSquare() : center(Vec2<Scalar>(0,0)), size(0) {}
 
 
 /**
@@ -118,7 +136,19 @@ Square::Square() : center(Vec2D(0,0)), size(0) {}
  * @param _center: the center position of the square
  * @param _size: the size of the square
  */
-Square::Square(const Vec2D& _center, double _size) : center(_center), size(_size) {}
+template<typename Scalar>
+BasicSquare<Scalar>::BasicSquare(const Vec2<Scalar>& _center, Scalar _size) : center(_center), size(_size) {}
+
+
+/**
+ * Square
+ *
+ * Converting constructor, explicit so that precisions never mix silently
+ * @param other: the square of another precision, rounded to this one
+ */
+template<typename Scalar>
+template<typename Other>
+BasicSquare<Scalar>::BasicSquare(const BasicSquare<Other>& other) : center(other.center), size(static_cast<Scalar>(other.size)) {}
 
 
 
@@ -130,7 +160,8 @@ Square::Square(const Vec2D& _center, double _size) : center(_center), size(_size
  * @param other: the other square to compare with
  * @return: true if the squares are not equal, false otherwise
  */
-bool Square::operator!=(const Square& other)
+template<typename Scalar>
+bool BasicSquare<Scalar>::operator!=(const BasicSquare& other)
 {
 	// If this square and the other square are the same, they are not equal
 	bool notEqual = false;
@@ -150,7 +181,8 @@ bool Square::operator!=(const Square& other)
  * Computes the perimeter of the square
  * @return: the perimeter of the square
  */
-double Square::perimeter() const
+template<typename Scalar>
+Scalar BasicSquare<Scalar>::perimeter() const
 {
 	// The perimeter of a square is 4 times its side length
 	return 4 * size;
@@ -163,7 +195,8 @@ double Square::perimeter() const
  * Computes the area of the square
  * @return: the area of the square
  */
-double Square::area() const
+template<typename Scalar>
+Scalar BasicSquare<Scalar>::area() const
 {
 	// The area of a square is the square of its side length
 	return size * size;
@@ -179,10 +212,11 @@ double Square::area() const
  * @param point: the point to check
  * @return: true if the point is inside the square, false otherwise
  */
-bool Square::containsPoint(const Vec2D& point) const
+template<typename Scalar>
+bool BasicSquare<Scalar>::containsPoint(const Vec2<Scalar>& point) const
 {
 	// Calculate half the length of the square's side for comparison
-	double halfSide = size * 0.5;
+	Scalar halfSide = size * 0.5;
 	// Check if the x and y coordinates of the point are within the square's boundaries
 	return (point.x >= (center.x - halfSide) && point.x <= (center.x + halfSide)) &&
 	(point.y >= (center.y - halfSide) && point.y <= (center.y + halfSide));
@@ -197,14 +231,15 @@ bool Square::containsPoint(const Vec2D& point) const
  * @param radius: the radius of the circle
  * @return: true if the circle is entirely inside the square, false otherwise
  */
-bool Square::contains(const Vec2D& position, const double radius) const
+template<typename Scalar>
+bool BasicSquare<Scalar>::contains(const Vec2<Scalar>& position, const Scalar radius) const
 {
 	// For a circle to be completely inside the square, the farthest points of the circle
 	// must be inside the square.
-	return containsPoint(Vec2D(position.x - radius, position.y)) &&
-	containsPoint(Vec2D(position.x + radius, position.y)) &&
-	containsPoint(Vec2D(position.x, position.y - radius)) &&
-	containsPoint(Vec2D(position.x, position.y + radius));
+	return containsPoint(Vec2<Scalar>(position.x - radius, position.y)) &&
+	containsPoint(Vec2<Scalar>(position.x + radius, position.y)) &&
+	containsPoint(Vec2<Scalar>(position.x, position.y - radius)) &&
+	containsPoint(Vec2<Scalar>(position.x, position.y + radius));
 }
 
 
@@ -215,17 +250,18 @@ bool Square::contains(const Vec2D& position, const double radius) const
  * @param circle: the circle to check for intersection
  * @return: true if the square intersects with the circle, false otherwise
  */
-bool Square::intersects(const Circle& circle) const {
+template<typename Scalar>
+bool BasicSquare<Scalar>::intersects(const BasicCircle<Scalar>& circle) const {
 	// 1. Check if any corner of the square is inside the circle
-	double halfSide = size * 0.5;
-	std::vector<Vec2D> corners = {
+	Scalar halfSide = size * 0.5;
+	const Vec2<Scalar> corners[4] = {
 		{center.x - halfSide, center.y - halfSide},
 		{center.x + halfSide, center.y - halfSide},
 		{center.x - halfSide, center.y + halfSide},
 		{center.x + halfSide, center.y + halfSide}
 	};
 	
-	for (const Vec2D& corner : corners) {
+	for (const Vec2<Scalar>& corner : corners) {
 		if (circle.containsPoint(corner)) return true;
 	}
 	
@@ -245,7 +281,8 @@ bool Square::intersects(const Circle& circle) const {
  * @param _y: the y-coordinate of the center
  * @param _size: the size of the square
  */
-void Square::set(double _x, double _y, double _size)
+template<typename Scalar>
+void BasicSquare<Scalar>::set(Scalar _x, Scalar _y, Scalar _size)
 {
 	// Set the center coordinates and the size of the square
 	center.x = _x;
@@ -270,7 +307,8 @@ void Square::set(double _x, double _y, double _size)
  * Default constructor
  * Initializes center and radius to default values
  */
-Sphere::Sphere() : center(Vec3D()), radius(0.0) {}
+template<typename Scalar>
+BasicSphere<Scalar>::BasicSphere() : center(Vec3<Scalar>()), radius(0.0) {}
 
 
 /**
@@ -280,7 +318,19 @@ Sphere::Sphere() : center(Vec3D()), radius(0.0) {}
  * @param _center: the center position of the sphere
  * @param _radius: the radius of the sphere
  */
-Sphere::Sphere(const Vec3D& _center, double _radius) : center(_center), radius(_radius) {}
+template<typename Scalar>
+BasicSphere<Scalar>::BasicSphere(const Vec3<Scalar>& _center, Scalar _radius) : center(_center), radius(_radius) {}
+
+
+/**
+ * Sphere
+ *
+ * Converting constructor, explicit so that precisions never mix silently
+ * @param other: the sphere of another precision, rounded to this one
+ */
+template<typename Scalar>
+template<typename Other>
+BasicSphere<Scalar>::BasicSphere(const BasicSphere<Other>& other) : center(other.center), radius(static_cast<Scalar>(other.radius)) {}
 
 
 
@@ -291,10 +341,11 @@ Sphere::Sphere(const Vec3D& _center, double _radius) : center(_center), radius(_
  * Computes the volume of the sphere
  * @return: the volume of the sphere
  */
-double Sphere::volume() const
+template<typename Scalar>
+Scalar BasicSphere<Scalar>::volume() const
 {
 	// The volume of a sphere is (4/3) * pi * r^3
-	return (4.0 / 3.0) * M_PI * std::pow(radius, 3);
+	return Scalar(4.0 / 3.0) * Scalar(M_PI) * std::pow(radius, Scalar(3));
 }
 
 
@@ -304,10 +355,11 @@ double Sphere::volume() const
  * Computes the surface area of the sphere
  * @return: the surface area of the sphere
  */
-double Sphere::surfaceArea() const
+template<typename Scalar>
+Scalar BasicSphere<Scalar>::surfaceArea() const
 {
 	// The surface area of a sphere is 4 * pi * r^2
-	return 4 * M_PI * std::pow(radius, 2);
+	return 4 * Scalar(M_PI) * std::pow(radius, Scalar(2));
 }
 
 
@@ -320,7 +372,8 @@ double Sphere::surfaceArea() const
  * @param point: the point to check
  * @return: true if the point is inside the sphere, false otherwise
  */
-bool Sphere::containsPoint(const Vec3D& point) const
+template<typename Scalar>
+bool BasicSphere<Scalar>::containsPoint(const Vec3<Scalar>& point) const
 {
 	//double distanceSquared = std::pow(point.x - center.x, 2) + std::pow(point.y - center.y, 2) + std::pow(point.z - center.z, 2);
 	//return distanceSquared <= radius * radius;
@@ -341,7 +394,8 @@ bool Sphere::containsPoint(const Vec3D& point) const
  * @param _radius: the radius of the other sphere
  * @return: true if the other sphere is entirely inside the sphere, false otherwise
  */
-bool Sphere::contains(const Vec3D& position, const double _radius) const
+template<typename Scalar>
+bool BasicSphere<Scalar>::contains(const Vec3<Scalar>& position, const Scalar _radius) const
 {
 	//double distanceSquared = std::pow(position.x - center.x, 2) + std::pow(position.y - center.y, 2) + std::pow(position.z - center.z, 2);
 	//return distanceSquared <= std::pow(radius - _radius, 2);
@@ -371,7 +425,8 @@ bool Sphere::contains(const Vec3D& position, const double _radius) const
  * Default constructor
  * Initializes center and size to default values
  */
-Cube::Cube() : center(0, 0, 0), size(0) {}
+template<typename Scalar>
+BasicCube<Scalar>::BasicCube() : center(0, 0, 0), size(0) {}
 
 
 /**
@@ -381,7 +436,19 @@ Cube::Cube() : center(0, 0, 0), size(0) {}
  * @param _center: the center position of the cube
  * @param _size: the size of the cube
  */
-Cube::Cube(const Vec3D& _center, double _size) : center(_center), size(_size) {}
+template<typename Scalar>
+BasicCube<Scalar>::BasicCube(const Vec3<Scalar>& _center, Scalar _size) : center(_center), size(_size) {}
+
+
+/**
+ * Cube
+ *
+ * Converting constructor, explicit so that precisions never mix silently
+ * @param other: the cube of another precision, rounded to this one
+ */
+template<typename Scalar>
+template<typename Other>
+BasicCube<Scalar>::BasicCube(const BasicCube<Other>& other) : center(other.center), size(static_cast<Scalar>(other.size)) {}
 
 
 
@@ -392,7 +459,8 @@ Cube::Cube(const Vec3D& _center, double _size) : center(_center), size(_size) {}
  * Computes the surface area of the cube
  * @return: the surface area of the cube
  */
-double Cube::surfaceArea() const
+template<typename Scalar>
+Scalar BasicCube<Scalar>::surfaceArea() const
 {
 	// The surface area of a cube is 6 * side_length^2
 	return 6 * size * size;
@@ -405,7 +473,8 @@ double Cube::surfaceArea() const
  * Computes the volume of the cube
  * @return: the volume of the cube
  */
-double Cube::volume() const
+template<typename Scalar>
+Scalar BasicCube<Scalar>::volume() const
 {
 	// The volume of a cube is side_length^3
 	return size * size * size;
@@ -421,9 +490,10 @@ double Cube::volume() const
  * @param point: the point to check
  * @return: true if the point is inside the cube, false otherwise
  */
-bool Cube::containsPoint(const Vec3D& point) const
+template<typename Scalar>
+bool BasicCube<Scalar>::containsPoint(const Vec3<Scalar>& point) const
 {
-	double halfSide = size * 0.5;
+	Scalar halfSide = size * 0.5;
 	return (point.x >= (center.x - halfSide) && point.x <= (center.x + halfSide)) &&
 	(point.y >= (center.y - halfSide) && point.y <= (center.y + halfSide)) &&
 	(point.z >= (center.z - halfSide) && point.z <= (center.z + halfSide));
@@ -438,28 +508,35 @@ bool Cube::containsPoint(const Vec3D& point) const
  * @param radius: the radius of the sphere
  * @return: true if the sphere is entirely inside the cube, false otherwise
  */
-bool Cube::contains(const Vec3D& position, const double radius) const
+template<typename Scalar>
+bool BasicCube<Scalar>::contains(const Vec3<Scalar>& position, const Scalar radius) const
 {
 	// For a sphere to be completely inside the cube, the farthest points of the sphere must be inside the cube.
-	return containsPoint(Vec3D(position.x - radius, position.y, position.z)) &&
-	containsPoint(Vec3D(position.x + radius, position.y, position.z)) &&
-	containsPoint(Vec3D(position.x, position.y - radius, position.z)) &&
-	containsPoint(Vec3D(position.x, position.y + radius, position.z)) &&
-	containsPoint(Vec3D(position.x, position.y, position.z - radius)) &&
-	containsPoint(Vec3D(position.x, position.y, position.z + radius));
+	return containsPoint(Vec3<Scalar>(position.x - radius, position.y, position.z)) &&
+	containsPoint(Vec3<Scalar>(position.x + radius, position.y, position.z)) &&
+	containsPoint(Vec3<Scalar>(position.x, position.y - radius, position.z)) &&
+	containsPoint(Vec3<Scalar>(position.x, position.y + radius, position.z)) &&
+	containsPoint(Vec3<Scalar>(position.x, position.y, position.z - radius)) &&
+	containsPoint(Vec3<Scalar>(position.x, position.y, position.z + radius));
 }
 
 
 
 
 
-
-
-
-
-
-
-
-
-
-
+template class BasicCircle<double>;
+template class BasicCircle<float>;
+template class BasicSquare<double>;
+template class BasicSquare<float>;
+template class BasicSphere<double>;
+template class BasicSphere<float>;
+template class BasicCube<double>;
+template class BasicCube<float>;
+template BasicCircle<double>::BasicCircle(const BasicCircle<float> &);
+template BasicCircle<float>::BasicCircle(const BasicCircle<double> &);
+template BasicSquare<double>::BasicSquare(const BasicSquare<float> &);
+template BasicSquare<float>::BasicSquare(const BasicSquare<double> &);
+template BasicSphere<double>::BasicSphere(const BasicSphere<float> &);
+template BasicSphere<float>::BasicSphere(const BasicSphere<double> &);
+template BasicCube<double>::BasicCube(const BasicCube<float> &);
+template BasicCube<float>::BasicCube(const BasicCube<double> &);
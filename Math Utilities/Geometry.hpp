@@ -5,6 +5,11 @@
  dev NOTE:
  The 'Geometry' header and source files contain code that is not yet incorporated into the larger project and is still in experimental stages of development(probably no point in trying to learn how to make my own graphics thing using OpenGL when graphics won't really be a performance bottleneck for this simulation, that's just a bunch of dots, the real heavy lifting comes from the interactions between these dots and accurately approximating them to balance the insane computational complexity of direct simulations(O(N^2)) with reasonable accuracy, so these will probably find some use in some future thing, who knows, not me. So it almost definitely makes more sense to just use the existing stuff provided by OpenFrameworks.
  */
+/**
+ * Circle, Square, Sphere and Cube are the double instances of the shape templates BasicCircle, BasicSquare,
+ * BasicSphere and BasicCube; CircleF, SquareF, SphereF and CubeF are their float instances, built on
+ * Vec2F and Vec3F. As with the vectors, a shape only converts to another precision explicitly.
+ */
 
 
 #pragma once
@@ -18,37 +23,43 @@
 
 
 /**
- * Circle class representing 2D circle.
+ * BasicCircle class template representing 2D circle.
  *
  * The Circle class represents a circle in a 2D plane with a center point and a radius.
  * It provides geometric computations for the area and circumference of the circle.
  *
  * All computations and checks are based on the Euclidean geometry of the circle.
  */
-class Circle
+template<typename Scalar>
+class BasicCircle
 {
 public:
+	using ScalarType = Scalar; // The type of the coordinates
+
+
 	/// @section Constructors
-	Circle(); // Default constructor
-	Circle(const Vec2D& _center, double _radius); // Construct with provided center and radius
+	BasicCircle(); // Default constructor
+	BasicCircle(const Vec2<Scalar>& _center, Scalar _radius); // Construct with provided center and radius
+	template<typename Other>
+	explicit BasicCircle(const BasicCircle<Other>& other); // Converts a circle of another precision
 	
 	
 	
 	/// @section Geometry computations
-	double area() const; // Computing area
-	double circumference() const; // Computing circumference
+	Scalar area() const; // Computing area
+	Scalar circumference() const; // Computing circumference
 	
 	
 	
 	/// @section Containment checks
-	bool containsPoint(const Vec2D& point) const; // Check if a point is inside the circle
-	bool contains(const Vec2D& position, const double radius) const; // Check if a two-D position with a radius is inside the circle
+	bool containsPoint(const Vec2<Scalar>& point) const; // Check if a point is inside the circle
+	bool contains(const Vec2<Scalar>& position, const Scalar radius) const; // Check if a two-D position with a radius is inside the circle
 	
 	
 	
 	/// @section Member variables
-	Vec2D center; // The center of the circle
-	double radius; // The radius of the circle
+	Vec2<Scalar> center; // The center of the circle
+	Scalar radius; // The radius of the circle
 };
 
 
@@ -59,7 +70,7 @@ public:
 
 
 /**
- * Square class representing a 2D square.
+ * BasicSquare class template representing a 2D square.
  *
  * The Square class represents a square in a 2D plane with a center point and a size.
  * Provides containment checks to determine if a point or another square
@@ -70,41 +81,47 @@ public:
  *
  * All computations and checks are based on the Euclidean geometry of the square.
  */
-class Square
+template<typename Scalar>
+class BasicSquare
 {
 public:
+	using ScalarType = Scalar; // The type of the coordinates
+
+
 	/// @section Constructors
-	Square(); // Default constructor
-	Square(const Vec2D& _center, double _size); // Construct with provided center and size
+	BasicSquare(); // Default constructor
+	BasicSquare(const Vec2<Scalar>& _center, Scalar _size); // Construct with provided center and size
+	template<typename Other>
+	explicit BasicSquare(const BasicSquare<Other>& other); // Converts a square of another precision
 	
 	
 	
 	/// @section Comparison operators
-	bool operator!=(const Square& other); // Checks inequality with another Square object
+	bool operator!=(const BasicSquare& other); // Checks inequality with another Square object
 	
 	
 	
 	/// @section Geometry computations
-	double perimeter() const; // Compute Perimeter
-	double area() const; // Compute Area
+	Scalar perimeter() const; // Compute Perimeter
+	Scalar area() const; // Compute Area
 	
 	
 	
 	/// @section Containment and Intersection checks
-	bool containsPoint(const Vec2D& point) const; // Check if a point is inside the square
-	bool contains(const Vec2D& position, const double radius) const; // Check if a two-D position with a radius is inside the square
-	bool intersects(const Circle& circle) const; // Check if the square intersects with a circle
+	bool containsPoint(const Vec2<Scalar>& point) const; // Check if a point is inside the square
+	bool contains(const Vec2<Scalar>& position, const Scalar radius) const; // Check if a two-D position with a radius is inside the square
+	bool intersects(const BasicCircle<Scalar>& circle) const; // Check if the square intersects with a circle
 	
 	
 	
 	/// @section Configurations
-	void set(double _x, double _y, double _size); // Set the center and size of the square
+	void set(Scalar _x, Scalar _y, Scalar _size); // Set the center and size of the square
 	
 	
 	
 	/// @section Member variables
-	Vec2D center; // The center of the square
-	double size; // The size of the square
+	Vec2<Scalar> center; // The center of the square
+	Scalar size; // The size of the square
 };
 
 
@@ -119,7 +136,7 @@ public:
 
 
 /**
- * Sphere class representing a 3D sphere.
+ * BasicSphere class template representing a 3D sphere.
  *
  * The Sphere class represents a sphere in a 3D space with a center point and a radius.
  * It provides geometric computations for the volume and surface area of the sphere.
@@ -127,31 +144,37 @@ public:
  * with a specified position and radius is within the bounds of the sphere.
  * All computations and checks are based on the Euclidean geometry of the sphere.
  */
-class Sphere
+template<typename Scalar>
+class BasicSphere
 {
 public:
+	using ScalarType = Scalar; // The type of the coordinates
+
+
 	/// @section Constructors
-	Sphere(); // Default constructor
-	Sphere(const Vec3D& _center, double _radius); // Construct with provided center and radius
+	BasicSphere(); // Default constructor
+	BasicSphere(const Vec3<Scalar>& _center, Scalar _radius); // Construct with provided center and radius
+	template<typename Other>
+	explicit BasicSphere(const BasicSphere<Other>& other); // Converts a sphere of another precision
 	
 	
 	
 	/// @section Geometry computations
-	double volume() const; // Computing volume
-	double surfaceArea() const; // Computing surface area
+	Scalar volume() const; // Computing volume
+	Scalar surfaceArea() const; // Computing surface area
 	
 	
 	
 	/// @section Containment checks
-	bool containsPoint(const Vec3D& point) const; // Check if a 3D point is inside the sphere
-	bool contains(const Vec3D& position, const double _radius) const; // Check if a 3D position with a radius is inside the Sphere
+	bool containsPoint(const Vec3<Scalar>& point) const; // Check if a 3D point is inside the sphere
+	bool contains(const Vec3<Scalar>& position, const Scalar _radius) const; // Check if a 3D position with a radius is inside the Sphere
 	
 	
 	
 	
 	/// @section Member variables
-	Vec3D center; // The position of the center of the sphere
-	double radius; // The radius of the sphere
+	Vec3<Scalar> center; // The position of the center of the sphere
+	Scalar radius; // The radius of the sphere
 };
 
 
@@ -162,7 +185,7 @@ public:
 
 
 /**
- * Cube class representing a 3D cube.
+ * BasicCube class template representing a 3D cube.
  *
  * The Cube class represents a cube in a 3D space with a center point and a size (length of one side).
  * It provides geometric computations for the volume and surface area of the cube.
@@ -170,44 +193,51 @@ public:
  * with a specified position and size is within the bounds of the cube.
  * All computations and checks are based on the Euclidean geometry of the cube.
  */
-class Cube
+template<typename Scalar>
+class BasicCube
 {
 public:
+	using ScalarType = Scalar; // The type of the coordinates
+
+
 	/// @section Constructors
-	Cube(); // Default constructor
-	Cube(const Vec3D& _center, double _size); // Construct with provided center and size
+	BasicCube(); // Default constructor
+	BasicCube(const Vec3<Scalar>& _center, Scalar _size); // Construct with provided center and size
+	template<typename Other>
+	explicit BasicCube(const BasicCube<Other>& other); // Converts a cube of another precision
 	
 	
 	
 	/// @section Geometry computations
-	double surfaceArea() const; // Compute Surface Area
-	double volume() const; // Compute Volume
+	Scalar surfaceArea() const; // Compute Surface Area
+	Scalar volume() const; // Compute Volume
 	
 	
 	
 	/// @section Containment checks
-	bool containsPoint(const Vec3D& point) const; // Check if a 3D point is inside the cube
-	bool contains(const Vec3D& position, const double radius) const; // Check if a 3D position with a radius is inside the cube
+	bool containsPoint(const Vec3<Scalar>& point) const; // Check if a 3D point is inside the cube
+	bool contains(const Vec3<Scalar>& position, const Scalar radius) const; // Check if a 3D position with a radius is inside the cube
 	
 	
 	
 	
 	/// @section Member variables
-	Vec3D center; // The center of the cube
-	double size; // The size of the cube
+	Vec3<Scalar> center; // The center of the cube
+	Scalar size; // The size of the cube
 };
 
 
 
 
-
-
-
-
-
-
-
-
-
-
-
+/// ------------- Precisions -------------
+/// \{
+/// Defined in Geometry.cpp, which instantiates them for double and float only.
+using Circle = BasicCircle<double>; // The double-precision shapes the simulations use
+using Square = BasicSquare<double>;
+using Sphere = BasicSphere<double>;
+using Cube = BasicCube<double>;
+using CircleF = BasicCircle<float>; // Single-precision shapes for visualization-quality work
+using SquareF = BasicSquare<float>;
+using SphereF = BasicSphere<float>;
+using CubeF = BasicCube<float>;
+/// \}
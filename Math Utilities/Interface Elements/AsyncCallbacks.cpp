@@ -0,0 +1,125 @@
+//  AsyncCallbacks.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "AsyncCallbacks.hpp"
+#include <algorithm>
+#include <exception>
+
+
+
+
+
+
+/**
+ * AsyncCallback
+ * Constructor that binds a callback to a worker pool, use AsyncCallback::create.
+ */
+AsyncCallback::AsyncCallback(std::function<void()> _work, CoalescePolicy _policy, WorkerPool &_pool) : work(std::move(_work)), policy(_policy), pool(_pool)
+{
+}
+
+
+/**
+ * create
+ * Creates an AsyncCallback owned by a std::shared_ptr, which jobs hold on to while they are queued or running.
+ *
+ * @param work: The callback to run on the pool
+ * @param policy: What to do with launches that arrive while the callback is running
+ * @param pool: The pool running the callback
+ * @return std::shared_ptr<AsyncCallback>: The new callback
+ */
+std::shared_ptr<AsyncCallback> AsyncCallback::create(std::function<void()> work, CoalescePolicy policy, WorkerPool &pool)
+{
+	return std::shared_ptr<AsyncCallback>(new AsyncCallback(std::move(work), policy, pool));
+}
+
+
+/**
+ * launch
+ * Starts the callback on the pool. If it is already busy the launch is coalesced: with
+ * CoalescePolicy::Drop it is ignored, with CoalescePolicy::RunOnceMore the callback runs one more
+ * time after the current run, and in both cases the future of the current run is returned.
+ *
+ * @return std::shared_future<void>: Completes when the run (including any coalesced re-run) finishes
+ */
+std::shared_future<void> AsyncCallback::launch()
+{
+	std::lock_guard<std::mutex> lock(stateMutex);
+	if (busy)
+	{
+		coalesced.fetch_add(1, std::memory_order_relaxed);
+		if (policy == CoalescePolicy::RunOnceMore)
+		{
+			rerunRequested = true;
+		}
+		return currentRun;
+	}
+
+	busy = true;
+	std::shared_ptr<AsyncCallback> self = shared_from_this(); // Keeps the callback alive until the job has run
+	currentRun = pool.submit([self]() { self->run(); });
+	return currentRun;
+}
+
+
+/**
+ * run
+ * Executes the callback on a worker thread, repeating it once if a coalesced launch requested it,
+ * and clears the busy state when done, even if the callback throws.
+ */
+void AsyncCallback::run()
+{
+	while (true)
+	{
+		try
+		{
+			work();
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(stateMutex);
+			busy = false;
+			rerunRequested = false;
+			completed.fetch_add(1, std::memory_order_relaxed);
+			throw; // Reported through the completion future
+		}
+
+		std::lock_guard<std::mutex> lock(stateMutex);
+		if (rerunRequested)
+		{
+			rerunRequested = false;
+			continue;
+		}
+		busy = false;
+		completed.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+}
+
+
+bool AsyncCallback::isBusy() const
+{
+	std::lock_guard<std::mutex> lock(stateMutex);
+	return busy;
+}
+
+
+std::shared_future<void> AsyncCallback::completion() const
+{
+	std::lock_guard<std::mutex> lock(stateMutex);
+	return currentRun;
+}
+
+
+uint64_t AsyncCallback::coalescedLaunches() const
+{
+	return coalesced.load(std::memory_order_relaxed);
+}
+
+
+uint64_t AsyncCallback::completedRuns() const
+{
+	return completed.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,85 @@
+//  AsyncCallbacks.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Async Callbacks header file declares the components that let a widget callback run off the UI thread.
+ *
+ * These components include:
+ *   - AsyncCallback: A callback bound to a WorkerPool (WorkerPool.hpp); launching it returns a
+ *     completion future, reports whether it is still busy, and coalesces launches that arrive while
+ *     it is running.
+ *
+ * Button::bindAsync and Toggle::bindAsync use these so that a heavy callback (rebuilding a tree,
+ * reloading particles, writing a snapshot) no longer freezes the UI: the event handler only launches
+ * the job, the widget draws itself as busy until the job completes, and re-clicks in the meantime do
+ * not queue up duplicate work.
+ *
+ * Async callbacks run concurrently with the render loop, so they must not touch widgets or call
+ * openFrameworks drawing functions; they should only work on their own data.
+ */
+
+
+#pragma once
+#include "WorkerPool.hpp"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+
+
+
+
+
+
+/**
+ * CoalescePolicy enum deciding what happens to launches that arrive while an AsyncCallback is running.
+ */
+enum class CoalescePolicy
+{
+	Drop, // Ignore them, the running job's completion is returned instead
+	RunOnceMore // Remember them and run the callback exactly once more after the current run, however many arrived
+};
+
+
+
+
+/**
+ * AsyncCallback class representing a callback executed on a WorkerPool.
+ *
+ * At most one run of the callback is in flight at any time. Instances are always owned through a
+ * std::shared_ptr (see AsyncCallback::create), which keeps them alive for as long as a job is queued.
+ */
+class AsyncCallback : public std::enable_shared_from_this<AsyncCallback>
+{
+public:
+	/// ------------- Construction -------------
+	/// \{
+	static std::shared_ptr<AsyncCallback> create(std::function<void()> work, CoalescePolicy policy = CoalescePolicy::Drop, WorkerPool &pool = WorkerPool::global()); // Binds 'work' to 'pool'
+	/// \}
+
+
+	/// ------------- Execution -------------
+	/// \{
+	std::shared_future<void> launch(); // Starts the callback, or coalesces the launch if it is already running
+	bool isBusy() const; // Whether a run is queued or executing
+	std::shared_future<void> completion() const; // The future of the current (or last) run, invalid if never launched
+	uint64_t coalescedLaunches() const; // Number of launches that arrived while the callback was busy
+	uint64_t completedRuns() const; // Number of times the callback has finished running
+									/// \}
+
+
+private:
+	AsyncCallback(std::function<void()> work, CoalescePolicy policy, WorkerPool &pool);
+	void run(); // Executes the callback on a worker, including a coalesced re-run
+
+	std::function<void()> work; // The bound callback
+	CoalescePolicy policy; // What to do with launches that arrive while busy
+	WorkerPool &pool; // The pool running the callback
+	mutable std::mutex stateMutex; // Guards the state below
+	std::shared_future<void> currentRun; // Completion of the current (or last) run
+	bool busy = false; // Whether a run is queued or executing
+	bool rerunRequested = false; // Whether a coalesced launch asked for one more run
+	std::atomic<uint64_t> coalesced{0}; // Launches that arrived while busy
+	std::atomic<uint64_t> completed{0}; // Finished runs
+};
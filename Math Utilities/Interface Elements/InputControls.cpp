@@ -4,6 +4,8 @@
 
 
 #include "InputControls.hpp"
+#include "InterfaceDiagnostics.hpp"
+#include "ParameterExpressions.hpp"
 
 
 
@@ -108,14 +110,47 @@ void Button::set(ofVec2f rectPos, ofVec2f rectSize)
 	rect.set(rectPos.x, rectPos.y, rectSize.x, rectSize.y); // Set the position and size of the button
 }
 
+/**
+ * bindAsync
+ * Binds a callback that runs on the WorkerPool instead of inside the mouse event handler. Clicking the
+ * button launches the callback and returns immediately; the button draws itself as busy until the
+ * callback completes, and clicks in the meantime are coalesced according to 'policy'. The completion
+ * future of the current run is available through asyncCallback->completion().
+ *
+ * @param callback: The function to run asynchronously, it must not touch widgets or draw
+ * @param policy: What to do with clicks that arrive while the callback is running
+ */
+void Button::bindAsync(std::function<void()> callback, CoalescePolicy policy)
+{
+	asyncCallback = AsyncCallback::create(callback, policy);
+	std::shared_ptr<AsyncCallback> task = asyncCallback;
+	onClick = [task]() { task->launch(); };
+}
+
+
+/**
+ * isBusy
+ * Returns whether the button's asynchronous callback is still running.
+ */
+bool Button::isBusy() const
+{
+	return asyncCallback && asyncCallback->isBusy();
+}
+
+
 /**
  * draw
  * Draws the button on the screen.
  */
 void Button::draw()
 {
+	bool busy = isBusy();
 	ofFill(); // Fill the button
-	if (isPressed) // If the button is pressed
+	if (busy) // If an asynchronous callback is running
+	{
+		ofSetColor(255, 165, 0, 127); // Set the color to amber
+	}
+	else if (isPressed) // If the button is pressed
 	{
 		ofSetColor(0, 0, 255, 127); // Set the color to blue
 	}
@@ -128,7 +163,7 @@ void Button::draw()
 	ofSetColor(191, 191, 191); // Set the color to light gray
 	ofDrawRectangle(rect); // Draw the button as a rectangle
 	ofSetColor(255); // Set the color back to white
-	ofDrawBitmapString(label, rect.x + rect.width + 10, rect.y + rect.height * 0.5 + 4); // Draw the label of the button
+	ofDrawBitmapString(busy ? label + " (busy)" : label, rect.x + rect.width + 10, rect.y + rect.height * 0.5 + 4); // Draw the label of the button
 }
 
 /**
@@ -148,6 +183,7 @@ void Button::mousePressed(int x, int y, int button)
 		
 		if (onClick) // Check if callback is set
 		{
+			LatencyMonitor::global().record("Button", label); // Record how long the click took to reach the callback
 			onClick(); // Call the callback function
 		}
 	}
@@ -229,6 +265,83 @@ Toggle::Toggle(std::string _label, float _x, float _y, float _w, float _h, bool
 	label = _label; // Set the label of the toggle
 	rect.set(_x, _y, _w, _h); // Set the position and dimensions of the toggle
 	isOn = _isOn; // Set the state of the toggle
+	syncSchedule(); // Start running the callback if the toggle starts out on
+}
+
+
+/**
+ * Toggle
+ * Parameterized constructor that initializes a Toggle object with specified label, position, dimensions, state,
+ * and the rate at which its callback runs while the toggle is on. Expensive callbacks (e.g. recomputing
+ * diagnostics) should use a modest rate instead of running every frame.
+ *
+ * @param _label: The label for the toggle
+ * @param _x: The x-coordinate of the toggle position
+ * @param _y: The y-coordinate of the toggle position
+ * @param _w: The width of the toggle
+ * @param _h: The height of the toggle
+ * @param _isOn: The state of the toggle
+ * @param callback: The function to run while the toggle is on
+ * @param _callbackRate: Invocations per second while the toggle is on, 0 runs the callback every frame
+ */
+Toggle::Toggle(std::string _label, float _x, float _y, float _w, float _h, bool _isOn, std::function<void()> callback, double _callbackRate) : onClick(callback), callbackRate(_callbackRate)
+{
+	/// Assign the parameter values to the object
+	label = _label; // Set the label of the toggle
+	rect.set(_x, _y, _w, _h); // Set the position and dimensions of the toggle
+	isOn = _isOn; // Set the state of the toggle
+	syncSchedule(); // Start running the callback if the toggle starts out on
+}
+
+
+/**
+ * Toggle
+ * Copy constructor. The scheduled task of 'other' runs 'other's callback, so the copy schedules a task of its own.
+ *
+ * @param other: The toggle to copy
+ */
+Toggle::Toggle(const Toggle &other) : rect(other.rect), isOn(other.isOn), label(other.label), onClick(other.onClick), onToggle(other.onToggle), callbackRate(other.callbackRate), scheduledTask(0), asyncCallback(other.asyncCallback), parameter(other.parameter), parameterStore(other.parameterStore)
+{
+	syncSchedule();
+}
+
+
+/**
+ * operator=
+ * Assigns the state of another toggle, cancelling this toggle's task and scheduling a fresh one if needed.
+ *
+ * @param other: The toggle to copy
+ * @return Toggle&: A reference to this toggle
+ */
+Toggle &Toggle::operator=(const Toggle &other)
+{
+	if (this != &other)
+	{
+		TaskScheduler::global().cancel(scheduledTask);
+		scheduledTask = 0;
+		
+		rect = other.rect;
+		isOn = other.isOn;
+		label = other.label;
+		onClick = other.onClick;
+		onToggle = other.onToggle;
+		callbackRate = other.callbackRate;
+		asyncCallback = other.asyncCallback;
+		parameter = other.parameter;
+		parameterStore = other.parameterStore;
+		syncSchedule();
+	}
+	return *this;
+}
+
+
+/**
+ * ~Toggle
+ * Destructor that cancels the toggle's scheduled callback task, which refers to this toggle.
+ */
+Toggle::~Toggle()
+{
+	TaskScheduler::global().cancel(scheduledTask);
 }
 
 
@@ -247,18 +360,126 @@ void Toggle::setPosition(ofVec2f rectPos)
 
 
 
-void Toggle::callbackUpdate()
+/**
+ * setOn
+ * Changes the state of the toggle. On a change of state the edge-triggered onToggle callback fires once,
+ * and the periodic onClick task is scheduled (when turned on) or cancelled (when turned off).
+ *
+ * @param on: The new state of the toggle
+ */
+void Toggle::setOn(bool on)
 {
-	if(isOn) // If the toggle is on
+	if (on == isOn)
 	{
-		if(onClick) // Check if callback is set
-		{
-			onClick(); // Call the callback function... ensures the callback function is continuously called while the toggle is on
-		}
+		return;
+	}
+	
+	isOn = on;
+	if (parameterStore)
+	{
+		parameterStore->set(parameter, isOn);
+	}
+	if (onToggle) // Check if an edge-triggered callback is set
+	{
+		onToggle(isOn);
+	}
+	syncSchedule();
+}
+
+
+/**
+ * setCallbackRate
+ * Sets the rate at which the callback runs while the toggle is on, rescheduling a running task at the new rate.
+ *
+ * @param rateHz: Invocations per second, 0 runs the callback every frame
+ */
+void Toggle::setCallbackRate(double rateHz)
+{
+	callbackRate = rateHz;
+	TaskScheduler::global().cancel(scheduledTask);
+	scheduledTask = 0;
+	syncSchedule();
+}
+
+
+/**
+ * bindAsync
+ * Binds a callback that runs on the WorkerPool instead of on the UI thread. While the toggle is on, each
+ * scheduled invocation launches the callback; invocations that arrive while it is still running are
+ * coalesced according to 'policy', so a slow callback never piles up work at the toggle's rate.
+ *
+ * @param callback: The function to run asynchronously, it must not touch widgets or draw
+ * @param policy: What to do with invocations that arrive while the callback is running
+ */
+void Toggle::bindAsync(std::function<void()> callback, CoalescePolicy policy)
+{
+	asyncCallback = AsyncCallback::create(callback, policy);
+	std::shared_ptr<AsyncCallback> task = asyncCallback;
+	onClick = [task]() { task->launch(); };
+	syncSchedule();
+}
+
+
+/**
+ * isBusy
+ * Returns whether the toggle's asynchronous callback is still running.
+ */
+bool Toggle::isBusy() const
+{
+	return asyncCallback && asyncCallback->isBusy();
+}
+
+
+/**
+ * bindParameter
+ * Keeps the toggle's state in a boolean parameter, so that it is published to the simulation (and mirrored
+ * to anything listening to the store) like bound sliders and text fields. The toggle takes the parameter's
+ * current value; afterwards the store is authoritative and changes made to it elsewhere show on the next draw.
+ *
+ * @param _parameter: The parameter holding the state
+ * @param store: The store the parameter was registered with
+ */
+void Toggle::bindParameter(ParameterHandle<bool> _parameter, ParameterStore &store)
+{
+	parameter = _parameter;
+	parameterStore = &store;
+	setOn(store.get(parameter));
+}
+
+
+/**
+ * syncSchedule
+ * Keeps the TaskScheduler registration in step with the toggle: while the toggle is on and has a callback,
+ * a task runs the callback at 'callbackRate'; otherwise no task exists, so an idle toggle costs nothing.
+ */
+void Toggle::syncSchedule()
+{
+	TaskScheduler &scheduler = TaskScheduler::global();
+	bool scheduled = scheduler.isScheduled(scheduledTask);
+	
+	if (isOn && onClick && !scheduled)
+	{
+		scheduledTask = scheduler.schedulePeriodic([this]() { if (onClick) { onClick(); } }, callbackRate);
+	}
+	else if ((!isOn || !onClick) && scheduled)
+	{
+		scheduler.cancel(scheduledTask);
+		scheduledTask = 0;
 	}
 }
 
 
+/**
+ * callbackUpdate
+ * The callback is no longer polled every frame, the TaskScheduler runs it while the toggle is on.
+ * This only re-synchronizes the scheduled task, e.g. after 'isOn' or 'onClick' were assigned directly.
+ */
+void Toggle::callbackUpdate()
+{
+	syncSchedule();
+}
+
+
 
 
 /**
@@ -277,12 +498,12 @@ void Toggle::draw()
 		onRect.set(rect.x + rect.width*0.5 + 1, rect.y, rect.width*0.5, rect.height);
 		ofSetColor(0, 0, 255); // Set the color to blue
 		ofDrawRectRounded(rect, rect.width*0.25);
-		
-		if(onClick) // Check if callback is set
-		{
-			onClick(); // Call the callback function... this call is included in the draw function to ensure the callback function is continuously called while the toggle is on
-		}
 	}
+	if (parameterStore && parameterStore->get(parameter) != isOn)
+	{
+		setOn(parameterStore->get(parameter)); // The parameter was changed through the store
+	}
+	syncSchedule(); // Pick up direct assignments to 'isOn', the TaskScheduler runs the callback while the toggle is on
 	
 	
 	ofNoFill(); // Do not fill the toggle
@@ -290,7 +511,7 @@ void Toggle::draw()
 	ofSetLineWidth(2); // Set the line width
 	ofDrawRectangle(rect.x - 1, rect.y - 1, rect.width + 2, rect.height + 2); // Draw an outline around the toggle
 	ofSetColor(255, 255, 255); // Set the color to white
-	ofDrawBitmapString(label, rect.x + rect.width + 10, rect.y + rect.height * 0.5 + 4); // Draw the label of the toggle
+	ofDrawBitmapString(isBusy() ? label + " (busy)" : label, rect.x + rect.width + 10, rect.y + rect.height * 0.5 + 4); // Draw the label of the toggle
 }
 
 
@@ -307,11 +528,12 @@ void Toggle::mousePressed(int x, int y, int button)
 	/// Change the state of the toggle when the mouse is pressed
 	if (rect.inside(x, y)) // If the mouse is inside the toggle
 	{
-		isOn = !isOn; // Toggle the state of the toggle
+		setOn(!isOn); // Toggle the state of the toggle, (un)scheduling its callback task
 		
 		if(onClick && isOn) // Check if callback is set
 		{
-			onClick(); // Call the callback function
+			LatencyMonitor::global().record("Toggle", label); // Record how long the click took to reach the callback
+			onClick(); // Call the callback function immediately, the scheduled task takes over from here
 		}
 	}
 }
@@ -369,6 +591,35 @@ TextField::TextField(std::string _label, float _x, float _y, float _w, float _h,
 }
 
 
+/**
+ * TextField
+ * Constructor that binds the TextField object to a parameter of a ParameterStore instead of a raw variable,
+ * so submitted values reach simulation threads through the store's published snapshots. The valid range is
+ * the range the parameter was registered with.
+ *
+ * @param _label: label of the TextField object
+ * @param _x: x-coordinate of the TextField object
+ * @param _y: y-coordinate of the TextField object
+ * @param _w: width of the TextField object
+ * @param _h: height of the TextField object
+ * @param _parameter: the parameter edited by the TextField object
+ * @param _precision: precision of the value displayed in the TextField object
+ * @param _store: the store holding the parameter
+ */
+TextField::TextField(std::string _label, float _x, float _y, float _w, float _h, ParameterHandle<double> _parameter, int _precision, ParameterStore &_store) : parameter(_parameter), parameterStore(&_store), min(_store.info(_parameter.index).min), max(_store.info(_parameter.index).max), rect(_x, _y, _w, _h), label(_label), precision(_precision)
+{
+	resetButton = Button("Reset " + label, _x + _w + 35, _y, 15, 15);
+	
+	value = nullptr;
+	
+	isTyping = false;
+	inputInRange = true;
+	warningMode = false;
+	inputString = ofToString(getValue(), _precision);
+	currentString = ofToString(getValue(), _precision);
+}
+
+
 /**
  * setPosition
  * Sets the position of the TextField object
@@ -383,6 +634,25 @@ void TextField::setPosition(ofVec2f rectPos)
 }
 
 
+double TextField::getValue() const
+{
+	return parameterStore ? parameterStore->get(parameter) : *value;
+}
+
+
+void TextField::setValue(double newValue)
+{
+	if (parameterStore)
+	{
+		parameterStore->set(parameter, newValue);
+	}
+	else
+	{
+		*value = newValue;
+	}
+}
+
+
 /**
  * draw
  *
@@ -431,8 +701,9 @@ void TextField::draw()
 	}
 	else
 	{
-		// Display the value with a precision of 15 if the user is not typing
-		ofDrawBitmapString(label + ": " + ofToString(*value, precision), rect.x + 5, rect.y + rect.height * 0.6125);
+		// Display the value with a precision of 15 if the user is not typing, preceded by its expression if it has one
+		const CompiledExpression *expression = parameterStore ? ParameterExpressions::forStore(*parameterStore).expression(parameter.index) : nullptr;
+		ofDrawBitmapString(label + ": " + (expression ? expression->text() + " = " : "") + ofToString(getValue(), precision), rect.x + 5, rect.y + rect.height * 0.6125);
 	}
 	
 	
@@ -443,14 +714,19 @@ void TextField::draw()
 	
 	
 	/// Display a warning message if the input is out of range or if the value is greater than the minimum allowed value.
-	if(!inputInRange || *value > max)
+	if(!inputInRange || getValue() > max)
 	{
 		warningMode = true; // Enable warning mode
 		
 		ofSetColor(255,0,0); // Set the color to red for the warning message
 		ofDrawBitmapString("WARNING: ", rect.x-5, rect.y + rect.height + 25);
 		ofSetColor(255); // Reset the color to white
-		if(!inputInRange)
+		if(!expressionError.empty())
+		{
+			// Display why the expression was rejected
+			ofDrawBitmapString("         " + expressionError, rect.x-5, rect.y + rect.height + 25);
+		}
+		else if(!inputInRange)
 		{
 			// Display a warning message about the input range
 			ofDrawBitmapString("         Please enter a value in the range: \n[" + ofToString(min) + ", " + ofToString(max) + "]", rect.x-5, rect.y + rect.height + 25);
@@ -462,7 +738,7 @@ void TextField::draw()
 			
 		}
 	}
-	else if (inputInRange && *value == min)
+	else if (inputInRange && getValue() == min)
 	{
 		warningMode = false; // Disable warning mode if the input is in range and the value is equal to the minimum
 	}
@@ -501,9 +777,9 @@ void TextField::mousePressed(int x, int y, int button)
 	if (resetButton.isPressed)
 	{
 		// Reset the value to the minimum value.
-		*value = min;
+		setValue(min);
 		// Update the input string.
-		inputString = ofToString(value, 15);
+		inputString = ofToString(getValue(), 15);
 		currentString = inputString;
 	}
 }
@@ -581,27 +857,49 @@ void TextField::keyReleased(int key)
  * validateAndSetValue
  *
  * This function validates the user's input and updates the value of the TextField.
- * It first converts the inputString to a double using a stringstream.
+ * It first converts the inputString to a double, rejecting text that is not a finite number.
  * It then checks if the value is within the allowed range (min to max).
  * If the value is within the range, it updates the value of the TextField, sets the inputInRange flag to true, the isTyping flag to false, and the warningMode flag to false.
  * If the value is not within the range, it sets the inputInRange flag to false and the warningMode flag to true.
  */
 void TextField::validateAndSetValue()
 {
-	/// Validate the input and update the value.
-	std::stringstream ss(inputString); // Create a stringstream from the inputString
+	/// A field bound to a parameter also accepts an expression of other parameters, e.g. "2*theta"
 	double tempValue; // Declare a temporary variable to store the value
-	ss >> tempValue; // Convert the inputString to a double
+	expressionError.clear();
+	bool isNumber = CompiledExpression::isNumber(inputString, tempValue);
+	if (parameterStore && !isNumber)
+	{
+		if (ParameterExpressions::forStore(*parameterStore).bind(parameter.index, inputString, expressionError)) // Compiled once, re-evaluated whenever an input changes
+		{
+			LatencyMonitor::global().record("TextField", label);
+			inputInRange = true;
+			isTyping = false;
+			warningMode = false;
+		}
+		else
+		{
+			inputInRange = false;
+			warningMode = true;
+		}
+		return;
+	}
 	
 	
-	if (tempValue >= min && tempValue <= max) // Ensure the value is within the allowed range
+	/// Validate the input and update the value.
+	if (isNumber && tempValue >= min && tempValue <= max) // Ensure the input is a number within the allowed range
 	{
-		*value = tempValue; // Update the value
+		if (parameterStore)
+		{
+			ParameterExpressions::forStore(*parameterStore).unbind(parameter.index); // A typed number replaces an expression
+		}
+		setValue(tempValue); // Update the value
+		LatencyMonitor::global().record("TextField", label); // Record how long the submission took to reach the bound value
 		inputInRange = true; // Set the inputInRange flag to true
 		isTyping = false; // Set the isTyping flag to false
 		warningMode = false; // Set the warningMode flag to false
 	}
-	else // Handle the case when the value is not within the allowed range
+	else // Handle the case when the input is not a number or not within the allowed range
 	{
 		inputInRange = false; // Set the inputInRange flag to false
 		warningMode = true; // Set the warningMode flag to true
@@ -757,6 +1055,7 @@ void Tab::mousePressed(int x, int y, int button)
 		
 		if (onClick) // Check if callback is set
 		{
+			LatencyMonitor::global().record("Tab", label); // Record how long the click took to reach the callback
 			onClick(); // Call the callback function
 		}
 	}
@@ -12,6 +12,9 @@
 #pragma once
 #include "ofMain.h"
 #include <functional> // <-- library for 'std::function' to handle function callbacks
+#include "InterfaceScheduler.hpp"
+#include "AsyncCallbacks.hpp"
+#include "ParameterStore.hpp"
 
 
 
@@ -40,6 +43,8 @@ public:
 	/// \{
 	void setPosition(ofVec2f rectPos); // Sets the position of the button
 	void set(ofVec2f rectPos, ofVec2f rectSize); // Sets the position and size of the button
+	void bindAsync(std::function<void()> callback, CoalescePolicy policy = CoalescePolicy::Drop); // Binds a callback that runs on the WorkerPool instead of inline
+	bool isBusy() const; // Whether an asynchronous callback is still running
 												 /// \}
 	
 	
@@ -58,6 +63,7 @@ public:
 	bool isPressed; // Indicates whether the button is currently pressed
 	std::string label; // The label displayed on the button
 	std::function<void()> onClick; // Callback function for click events
+	std::shared_ptr<AsyncCallback> asyncCallback; // The asynchronous callback launched by onClick, if bound with bindAsync
 								   /// \}
 };
 
@@ -83,13 +89,22 @@ public:
 	Toggle(); // Default constructor that initializes a toggle button with no label, default position, size, and state
 	Toggle(std::string _label, float _x, float _y, float _w, float _h, bool _isOn); // Constructor that initializes a toggle button with a label, specific position, size, and state
 	Toggle(std::string _label, float _x, float _y, float _w, float _h, bool _isOn, std::function<void()> callback);
+	Toggle(std::string _label, float _x, float _y, float _w, float _h, bool _isOn, std::function<void()> callback, double _callbackRate); // Constructor whose callback runs at '_callbackRate' Hz while the toggle is on
+	Toggle(const Toggle &other); // Copies a toggle, the copy schedules its own callback task
+	Toggle &operator=(const Toggle &other); // Assigns a toggle, rescheduling the callback task for this toggle
+	~Toggle(); // Cancels the toggle's scheduled callback task
 	/// \}
 	
 	
 	/// ------------- Setters -------------
 	/// \{
 	void setPosition(ofVec2f rectPos); // Sets the position of the toggle button
-									   /// \}
+	void setOn(bool on); // Changes the state of the toggle, firing onToggle and (un)scheduling the callback
+	void setCallbackRate(double rateHz); // Sets the rate at which the callback runs while the toggle is on
+	void bindAsync(std::function<void()> callback, CoalescePolicy policy = CoalescePolicy::Drop); // Binds a callback that runs on the WorkerPool instead of inline
+	bool isBusy() const; // Whether an asynchronous callback is still running
+	void bindParameter(ParameterHandle<bool> _parameter, ParameterStore &store = ParameterStore::global()); // Keeps the toggle's state in a ParameterStore parameter
+										 /// \}
 	
 	
 	
@@ -98,8 +113,9 @@ public:
 	/// \{
 	void draw(); // Draws the toggle button on the screen
 	void mousePressed(int x, int y, int button); // Handles the mouse pressed event
-	void callbackUpdate(); // Continuously calls the callback function while the toggle is on.
-						   /// \}
+	void callbackUpdate(); // Keeps the scheduled callback task in step with the toggle's state
+	void syncSchedule(); // Registers the callback with the TaskScheduler while on, cancels it while off
+						 /// \}
 	
 	
 	
@@ -108,8 +124,14 @@ public:
 	ofRectangle rect; // Represents the size and position of the toggle button
 	bool isOn = false; // Represents the state of the toggle button (on/off)
 	std::string label; // The label displayed on the toggle button
-	std::function<void()> onClick; // Callback function for click events
-								   /// \}
+	std::function<void()> onClick; // Callback function, run by the TaskScheduler at 'callbackRate' while the toggle is on
+	std::function<void(bool)> onToggle; // Edge-triggered callback, invoked once each time the toggle changes state
+	double callbackRate = 0; // Rate (Hz) at which onClick runs while the toggle is on, 0 runs it every frame
+	TaskHandle scheduledTask = 0; // The TaskScheduler task running onClick, 0 while none is scheduled
+	std::shared_ptr<AsyncCallback> asyncCallback; // The asynchronous callback launched by onClick, if bound with bindAsync
+	ParameterHandle<bool> parameter; // The parameter holding the state, if bound with bindParameter
+	ParameterStore *parameterStore = nullptr; // The store of 'parameter', nullptr while unbound
+								  /// \}
 };
 
 
@@ -133,6 +155,7 @@ public:
 	/// \{
 	TextField(); // Default constructor that initializes a text field with no label, default position, size, min, max, value, and precision
 	TextField(std::string _label, float _x, float _y, float _w, float _h, float _min, float _max, double &_value, int _precision); // Constructor that initializes a text field with a label, specific position, size, min, max, value, and precision
+	TextField(std::string _label, float _x, float _y, float _w, float _h, ParameterHandle<double> _parameter, int _precision, ParameterStore &_store = ParameterStore::global()); // Constructor that binds the text field to a parameter, taking its range from the store
 																																   /// \}
 	
 	
@@ -140,6 +163,8 @@ public:
 	/// ------------- Setters -------------
 	/// \{
 	void setPosition(ofVec2f rectPos); // Sets the position of the text field
+	double getValue() const; // The bound value, read from the parameter store if bound to a parameter
+	void setValue(double newValue); // Writes the bound value, into the parameter store's back buffer if bound to a parameter
 									   /// \}
 	
 	
@@ -158,7 +183,9 @@ public:
 	
 	/// ------------- Text Field Attributes -------------
 	/// \{
-	double *value; // The value to be manipulated
+	double *value; // The value to be manipulated, nullptr when bound to a parameter
+	ParameterHandle<double> parameter; // The parameter to be manipulated, if bound to one
+	ParameterStore *parameterStore = nullptr; // The store holding 'parameter'
 	double min, max; // Minimum and maximum acceptable values
 	bool isTyping = false; // Flag to indicate if the user is currently editing the field
 	ofRectangle rect; // Rectangle representing the TextField's area
@@ -167,6 +194,7 @@ public:
 	std::string inputString; // The current string in the TextField
 	std::string currentString; // The current value of the TextField
 	bool inputInRange = true; // Flag check to ensure the inputted value falls within the acceptable range
+	std::string expressionError; // Why the last submitted expression was rejected, empty if it was not
 	std::string label; // Label for the textfield, shown inside of the textfield box, preceding the user defined text space
 	int precision;  // Integer to track the degree of precision needed to record and display value of object passed into slider. For example, gravitational constant, 'g', needs approximately 15 digits of precision
 					/// \}
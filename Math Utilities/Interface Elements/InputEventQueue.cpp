@@ -0,0 +1,148 @@
+//  InputEventQueue.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "InputEventQueue.hpp"
+#include "InterfaceDiagnostics.hpp"
+
+
+
+
+
+
+/**
+ * enqueue
+ * Queues an event for the consumer. Never blocks: if the queue is full the event is dropped and counted.
+ *
+ * @param event: The event to queue
+ * @return bool: true if the event was queued, false if it was dropped
+ */
+bool InputEventQueue::enqueue(const InputEvent &event)
+{
+	if (!events.push(event))
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+
+bool InputEventQueue::enqueueKeyReleased(int key)
+{
+	return enqueue({InputEventType::KeyReleased, 0, 0, 0, key, ofGetElapsedTimeMicros()});
+}
+
+
+bool InputEventQueue::enqueueMousePressed(int x, int y, int button)
+{
+	return enqueue({InputEventType::MousePressed, x, y, button, 0, ofGetElapsedTimeMicros()});
+}
+
+
+bool InputEventQueue::enqueueMouseDragged(int x, int y, int button)
+{
+	return enqueue({InputEventType::MouseDragged, x, y, button, 0, ofGetElapsedTimeMicros()});
+}
+
+
+bool InputEventQueue::enqueueMouseReleased(int x, int y, int button)
+{
+	return enqueue({InputEventType::MouseReleased, x, y, button, 0, ofGetElapsedTimeMicros()});
+}
+
+
+
+
+/**
+ * dispatch
+ * Drains the queue, forwarding every event to the matching TableManager handler in the order the events arrived.
+ *
+ * @param tableManager: The table manager receiving the events
+ * @return std::size_t: The number of events dispatched
+ */
+std::size_t InputEventQueue::dispatch(TableManager &tableManager)
+{
+	return dispatch(tableManager, QUEUE_CAPACITY);
+}
+
+
+/**
+ * dispatch
+ * Forwards at most 'maxEvents' events to the matching TableManager handler, which lets the consumer
+ * bound how much of the frame it spends on input. Remaining events stay queued for the next call.
+ *
+ * @param tableManager: The table manager receiving the events
+ * @param maxEvents: The maximum number of events to dispatch
+ * @return std::size_t: The number of events dispatched
+ */
+std::size_t InputEventQueue::dispatch(TableManager &tableManager, std::size_t maxEvents)
+{
+	return dispatch([&tableManager](const InputEvent &event) { deliver(tableManager, event); }, maxEvents);
+}
+
+
+/**
+ * deliver
+ * Forwards a single event to the matching TableManager handler. Custom dispatch handlers call it to
+ * keep the default routing while doing work of their own between events.
+ *
+ * @param tableManager: The table manager receiving the event
+ * @param event: The event to forward
+ */
+void InputEventQueue::deliver(TableManager &tableManager, const InputEvent &event)
+{
+	switch (event.type)
+	{
+		case InputEventType::KeyReleased:
+			tableManager.keyReleased(event.key);
+			break;
+		case InputEventType::MousePressed:
+			tableManager.mousePressed(event.x, event.y, event.button);
+			break;
+		case InputEventType::MouseDragged:
+			tableManager.mouseDragged(event.x, event.y, event.button);
+			break;
+		case InputEventType::MouseReleased:
+			tableManager.mouseReleased(event.x, event.y, event.button);
+			break;
+	}
+}
+
+
+/**
+ * dispatch
+ * Hands at most 'maxEvents' events to a custom handler. Each event is wrapped in a ScopedInputEvent
+ * stamped with its capture time, so latency measurements include the time spent waiting in the queue.
+ *
+ * @param handler: The function receiving each event
+ * @param maxEvents: The maximum number of events to dispatch
+ * @return std::size_t: The number of events dispatched
+ */
+std::size_t InputEventQueue::dispatch(std::function<void(const InputEvent &)> handler, std::size_t maxEvents)
+{
+	std::size_t dispatched = 0;
+	InputEvent event;
+	while (dispatched < maxEvents && events.pop(event))
+	{
+		ScopedInputEvent inputEvent(event.timestampMicros);
+		handler(event);
+		dispatched++;
+	}
+	return dispatched;
+}
+
+
+
+
+std::size_t InputEventQueue::pendingEvents() const
+{
+	return events.size();
+}
+
+
+uint64_t InputEventQueue::droppedEvents() const
+{
+	return dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,211 @@
+//  InputEventQueue.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Input Event Queue header file declares the components that decouple event intake from event processing.
+ *
+ * These components include:
+ *   - InputEvent: A small, trivially copyable record of a single key or mouse event and the time it occurred.
+ *   - SPSCRingBuffer: A fixed-capacity, lock-free, single-producer/single-consumer ring buffer.
+ *   - InputEventQueue: Queues events from the window callbacks and dispatches them to a TableManager
+ *     at a point of the consumer's choosing.
+ *
+ * The window callbacks in ofApp only enqueue, which never blocks and never runs a widget callback,
+ * so a slow callback can no longer stall event intake. The consumer (ofApp::update, or a dedicated
+ * UI-logic thread) drains the queue and dispatches the events in their original order.
+ */
+
+
+#pragma once
+#include "NavigationalComponents.hpp"
+#include <atomic>
+#include <cstddef>
+
+
+
+
+
+
+/**
+ * InputEventType enum identifying which TableManager handler an event is dispatched to.
+ */
+enum class InputEventType : uint8_t
+{
+	KeyReleased,
+	MousePressed,
+	MouseDragged,
+	MouseReleased
+};
+
+
+
+
+/**
+ * InputEvent struct representing a single queued key or mouse event.
+ */
+struct InputEvent
+{
+	InputEventType type; // The kind of event
+	int x; // The x-coordinate of the mouse (mouse events only)
+	int y; // The y-coordinate of the mouse (mouse events only)
+	int button; // The mouse button (mouse events only)
+	int key; // The key (key events only)
+	uint64_t timestampMicros; // The time the event was captured, from ofGetElapsedTimeMicros()
+};
+
+
+
+
+
+
+
+
+/**
+ * SPSCRingBuffer class representing a bounded lock-free queue between exactly one producer thread
+ * and exactly one consumer thread.
+ *
+ * The producer only writes 'head' and the consumer only writes 'tail', each publishing its progress
+ * with a release store that the other side reads with an acquire load, so no locks or read-modify-write
+ * atomics are needed. Each side also keeps a cached copy of the other side's index to avoid touching
+ * the shared cache line on every operation. Capacity must be a power of two; one slot is never used,
+ * so the buffer holds at most Capacity - 1 elements.
+ */
+template <typename T, std::size_t Capacity>
+class SPSCRingBuffer
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SPSCRingBuffer capacity must be a power of two");
+
+public:
+	/// ------------- Producer -------------
+	/// \{
+	/**
+	 * push
+	 * Appends an element, called from the producer thread only.
+	 *
+	 * @param element: The element to append
+	 * @return bool: false if the buffer was full and the element was not appended
+	 */
+	bool push(const T &element)
+	{
+		const std::size_t currentHead = head.load(std::memory_order_relaxed);
+		const std::size_t nextHead = (currentHead + 1) & MASK;
+
+		if (nextHead == cachedTail) // Looks full, refresh the consumer's progress before giving up
+		{
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (nextHead == cachedTail)
+			{
+				return false;
+			}
+		}
+
+		slots[currentHead] = element;
+		head.store(nextHead, std::memory_order_release); // Publish the element to the consumer
+		return true;
+	}
+	/// \}
+
+
+	/// ------------- Consumer -------------
+	/// \{
+	/**
+	 * pop
+	 * Removes the oldest element, called from the consumer thread only.
+	 *
+	 * @param element: Receives the removed element
+	 * @return bool: false if the buffer was empty
+	 */
+	bool pop(T &element)
+	{
+		const std::size_t currentTail = tail.load(std::memory_order_relaxed);
+
+		if (currentTail == cachedHead) // Looks empty, refresh the producer's progress before giving up
+		{
+			cachedHead = head.load(std::memory_order_acquire);
+			if (currentTail == cachedHead)
+			{
+				return false;
+			}
+		}
+
+		element = slots[currentTail];
+		tail.store((currentTail + 1) & MASK, std::memory_order_release); // Hand the slot back to the producer
+		return true;
+	}
+	/// \}
+
+
+	/// ------------- Queries -------------
+	/// \{
+	std::size_t size() const // Approximate number of queued elements, exact when called from either endpoint while the other is idle
+	{
+		return (head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire)) & MASK;
+	}
+	bool empty() const { return size() == 0; } // Whether the buffer is (approximately) empty
+	static constexpr std::size_t capacity() { return Capacity - 1; } // Maximum number of elements held at once
+																	   /// \}
+
+
+private:
+	static constexpr std::size_t MASK = Capacity - 1;
+
+	alignas(64) std::atomic<std::size_t> head{0}; // Next slot to write, owned by the producer
+	std::size_t cachedTail = 0; // Producer's last observed value of 'tail'
+	alignas(64) std::atomic<std::size_t> tail{0}; // Next slot to read, owned by the consumer
+	std::size_t cachedHead = 0; // Consumer's last observed value of 'head'
+	alignas(64) T slots[Capacity]; // Element storage
+};
+
+
+
+
+
+
+
+
+/**
+ * InputEventQueue class representing the hand-off point between the window's event callbacks and the UI logic.
+ *
+ * The producer side (the enqueue functions) is called from the window callbacks; the consumer side
+ * (dispatch) is called once per frame, or from a dedicated UI-logic thread, and forwards every queued
+ * event to a TableManager. Events that arrive while the queue is full are dropped and counted rather
+ * than blocking the window thread.
+ */
+class InputEventQueue
+{
+public:
+	/// ------------- Producer -------------
+	/// \{
+	bool enqueue(const InputEvent &event); // Queues an event, returns false if it had to be dropped
+	bool enqueueKeyReleased(int key); // Queues a key released event stamped with the current time
+	bool enqueueMousePressed(int x, int y, int button); // Queues a mouse pressed event stamped with the current time
+	bool enqueueMouseDragged(int x, int y, int button); // Queues a mouse dragged event stamped with the current time
+	bool enqueueMouseReleased(int x, int y, int button); // Queues a mouse released event stamped with the current time
+														 /// \}
+
+
+	/// ------------- Consumer -------------
+	/// \{
+	std::size_t dispatch(TableManager &tableManager); // Dispatches every queued event to the table manager, returns the number dispatched
+	std::size_t dispatch(TableManager &tableManager, std::size_t maxEvents); // Dispatches at most 'maxEvents' queued events
+	std::size_t dispatch(std::function<void(const InputEvent &)> handler, std::size_t maxEvents); // Hands at most 'maxEvents' queued events to a custom handler
+	static void deliver(TableManager &tableManager, const InputEvent &event); // Forwards one event to the matching TableManager handler
+																									/// \}
+
+
+	/// ------------- Queries -------------
+	/// \{
+	std::size_t pendingEvents() const; // Number of events waiting to be dispatched
+	uint64_t droppedEvents() const; // Number of events dropped because the queue was full
+									/// \}
+
+
+	/// ------------- Input Event Queue Attributes -------------
+	/// \{
+	static const std::size_t QUEUE_CAPACITY = 1024; // Slots in the ring buffer, enough for several frames of dragging
+
+private:
+	SPSCRingBuffer<InputEvent, QUEUE_CAPACITY> events; // The queued events
+	std::atomic<uint64_t> dropped{0}; // Events dropped because the queue was full
+									  /// \}
+};
@@ -0,0 +1,285 @@
+//  InterfaceAnimation.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "InterfaceAnimation.hpp"
+
+
+
+
+
+
+Suspend Suspend::nextFrame()
+{
+	return {Kind::NextFrame, 0};
+}
+
+
+Suspend Suspend::forSeconds(double seconds)
+{
+	return {Kind::Deadline, std::max(0.0, seconds)};
+}
+
+
+Suspend Suspend::finish()
+{
+	return {Kind::Finished, 0};
+}
+
+
+
+
+double AnimationFrame::elapsed() const
+{
+	return nowSeconds - startSeconds;
+}
+
+
+double AnimationFrame::stageElapsed() const
+{
+	return nowSeconds - stageStartSeconds;
+}
+
+
+void AnimationFrame::advance(int nextResumePoint)
+{
+	resumePoint = nextResumePoint;
+	stageStartSeconds = nowSeconds;
+}
+
+
+
+
+/**
+ * ease
+ * Applies an easing curve to linear progress.
+ *
+ * @param easing: The easing curve
+ * @param t: The linear progress, clamped to [0, 1]
+ * @return float: The eased progress in [0, 1]
+ */
+float ease(Easing easing, float t)
+{
+	t = ofClamp(t, 0, 1);
+	switch (easing)
+	{
+		case Easing::Linear:
+			return t;
+		case Easing::EaseOutQuad:
+			return 1 - (1 - t) * (1 - t);
+		case Easing::EaseInOutCubic:
+			return t < 0.5f ? 4 * t * t * t : 1 - 4 * (1 - t) * (1 - t) * (1 - t);
+	}
+	return t;
+}
+
+
+
+
+
+
+
+
+/**
+ * Animator
+ * Constructor that binds the animator to the scheduler resuming its animations.
+ */
+Animator::Animator(TaskScheduler &_scheduler) : scheduler(_scheduler)
+{
+}
+
+
+/**
+ * global
+ * Returns the animator shared by every widget, driven by the global TaskScheduler.
+ */
+Animator &Animator::global()
+{
+	static Animator animator(TaskScheduler::global());
+	return animator;
+}
+
+
+double Animator::nowSeconds()
+{
+	return ofGetElapsedTimeMicros() * 1e-6;
+}
+
+
+
+
+/**
+ * start
+ * Starts an animation and runs its first step immediately, so a transition begins on the frame that
+ * triggered it. From then on the animation is resumed whenever its last Suspend asked to be.
+ *
+ * @param body: The resumable body of the animation
+ * @param onFinish: Called once the body returns Suspend::finish(), not called if the animation is cancelled
+ * @return AnimationHandle: The handle used to cancel the animation
+ */
+AnimationHandle Animator::start(AnimationBody body, std::function<void()> onFinish)
+{
+	AnimationHandle handle = nextHandle++;
+	Animation &animation = animations[handle];
+	animation.body = std::move(body);
+	animation.onFinish = std::move(onFinish);
+	animation.frame.startSeconds = animation.frame.stageStartSeconds = nowSeconds();
+
+	resume(handle);
+	return handle;
+}
+
+
+/**
+ * tween
+ * Animates a value from its current value to a target over a duration. The start value is read when
+ * the tween starts, so a tween that replaces a cancelled one continues from wherever the value was left.
+ *
+ * @param value: The value to animate, it must outlive the tween or cancel it
+ * @param target: The value reached at the end of the tween
+ * @param durationSeconds: The length of the tween, 0 jumps straight to the target
+ * @param easing: The easing curve
+ * @param onFinish: Called once the target has been reached
+ * @return AnimationHandle: The handle used to cancel the tween
+ */
+AnimationHandle Animator::tween(float *value, float target, double durationSeconds, Easing easing, std::function<void()> onFinish)
+{
+	float from = 0;
+	return start([value, target, durationSeconds, easing, from](AnimationFrame &frame) mutable -> Suspend
+	{
+		switch (frame.resumePoint)
+		{
+			case 0: // Capture the start value
+				from = *value;
+				frame.advance(1);
+				[[fallthrough]];
+			case 1: // Move towards the target once per frame
+			{
+				double t = durationSeconds > 0 ? std::min(1.0, frame.stageElapsed() / durationSeconds) : 1.0;
+				*value = from + (target - from) * ease(easing, static_cast<float>(t));
+				return t < 1 ? Suspend::nextFrame() : Suspend::finish();
+			}
+		}
+		return Suspend::finish();
+	}, std::move(onFinish));
+}
+
+
+/**
+ * cancel
+ * Stops an animation and removes its scheduler task. An animation cancelled from within its own body
+ * is removed as soon as the body returns.
+ *
+ * @param handle: The handle returned by start or tween
+ */
+void Animator::cancel(AnimationHandle handle)
+{
+	auto it = animations.find(handle);
+	if (it == animations.end())
+	{
+		return;
+	}
+
+	scheduler.cancel(it->second.task);
+	it->second.task = 0;
+	if (handle == runningAnimation)
+	{
+		runningAnimationCancelled = true;
+	}
+	else
+	{
+		animations.erase(it);
+	}
+}
+
+
+bool Animator::isRunning(AnimationHandle handle) const
+{
+	return animations.count(handle) != 0 && !(handle == runningAnimation && runningAnimationCancelled);
+}
+
+
+
+
+/**
+ * resume
+ * Runs one step of an animation, then registers it with the scheduler according to the Suspend it
+ * returned. An animation that keeps asking for the next frame keeps its per-update task instead of
+ * re-registering every frame.
+ *
+ * @param handle: The animation to resume
+ */
+void Animator::resume(AnimationHandle handle)
+{
+	/// Step 1: Run the body, the animation record stays put even if the body starts other animations
+	auto it = animations.find(handle);
+	if (it == animations.end())
+	{
+		return;
+	}
+	Animation &animation = it->second;
+	animation.frame.nowSeconds = nowSeconds();
+
+	AnimationHandle outerAnimation = runningAnimation; // Animations may be started from within a body
+	bool outerCancelled = runningAnimationCancelled;
+	runningAnimation = handle;
+	runningAnimationCancelled = false;
+	Suspend next = animation.body(animation.frame);
+	bool cancelled = runningAnimationCancelled;
+	runningAnimation = outerAnimation;
+	runningAnimationCancelled = outerCancelled;
+	resumeCount++;
+
+	if (cancelled)
+	{
+		animations.erase(handle);
+		return;
+	}
+
+
+	/// Step 2: Suspend the animation until it asked to be resumed
+	switch (next.kind)
+	{
+		case Suspend::Kind::NextFrame:
+			if (!animation.perFrame || !scheduler.isScheduled(animation.task))
+			{
+				scheduler.cancel(animation.task);
+				animation.task = scheduler.scheduleEveryUpdate([this, handle]() { resume(handle); });
+				animation.perFrame = true;
+			}
+			break;
+
+		case Suspend::Kind::Deadline:
+			scheduler.cancel(animation.task);
+			animation.task = scheduler.scheduleOnce([this, handle]() { resume(handle); }, next.delaySeconds);
+			animation.perFrame = false;
+			break;
+
+		case Suspend::Kind::Finished:
+		{
+			scheduler.cancel(animation.task);
+			std::function<void()> onFinish = std::move(animation.onFinish);
+			animations.erase(handle);
+			if (onFinish)
+			{
+				onFinish();
+			}
+			break;
+		}
+	}
+}
+
+
+
+
+std::size_t Animator::activeAnimations() const
+{
+	return animations.size();
+}
+
+
+uint64_t Animator::resumptions() const
+{
+	return resumeCount;
+}
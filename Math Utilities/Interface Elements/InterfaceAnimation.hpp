@@ -0,0 +1,162 @@
+//  InterfaceAnimation.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Interface Animation header file declares a small runtime for resumable UI animations, such as
+ * a table unfolding or a value tween.
+ *
+ * An animation is written as a resumable body: a function that is called with its AnimationFrame,
+ * does one step of work and returns a Suspend telling the runtime when to call it again:
+ *  - Suspend::nextFrame(): resume on the next scheduler update (i.e. the next frame).
+ *  - Suspend::forSeconds(s): resume once 's' seconds have passed.
+ *  - Suspend::finish(): the animation is done and is removed.
+ * The frame's 'resumePoint' records where the body left off, so a multi-stage transition is written
+ * as a switch over its stages, the same shape a coroutine's suspension points have.
+ *
+ * Suspended animations are registered with the TaskScheduler (a per-update task while they animate,
+ * a one-shot task while they wait for a deadline), so only active animations are ever resumed and
+ * idle widgets pay nothing per frame.
+ */
+
+
+#pragma once
+#include "ofMain.h"
+#include "InterfaceScheduler.hpp"
+#include <functional>
+#include <unordered_map>
+
+
+
+
+
+
+/**
+ * Suspend class describing when a suspended animation wants to be resumed.
+ */
+class Suspend
+{
+public:
+	/// ------------- Kinds -------------
+	/// \{
+	enum class Kind : uint8_t
+	{
+		NextFrame, // Resume on the next scheduler update
+		Deadline, // Resume after 'delaySeconds'
+		Finished // Do not resume, the animation is complete
+	};
+	/// \}
+
+
+	/// ------------- Construction -------------
+	/// \{
+	static Suspend nextFrame(); // Resume on the next frame
+	static Suspend forSeconds(double seconds); // Resume after a delay
+	static Suspend finish(); // Complete the animation
+							 /// \}
+
+
+	/// ------------- Suspend Attributes -------------
+	/// \{
+	Kind kind; // When to resume
+	double delaySeconds; // The delay for Kind::Deadline
+						 /// \}
+};
+
+
+
+
+/**
+ * AnimationFrame struct holding the state that persists between resumptions of an animation,
+ * the equivalent of a coroutine frame. Bodies keep their own locals in their captures.
+ */
+struct AnimationFrame
+{
+	int resumePoint = 0; // The stage to continue at, 0 on the first resumption
+	double startSeconds = 0; // When the animation started
+	double stageStartSeconds = 0; // When the current stage started
+	double nowSeconds = 0; // The time of the current resumption
+
+	double elapsed() const; // Seconds since the animation started
+	double stageElapsed() const; // Seconds since the current stage started
+	void advance(int nextResumePoint); // Moves on to another stage, restarting the stage clock
+};
+
+
+
+
+/// Easing curves for tweens, mapping linear progress in [0, 1] to eased progress in [0, 1].
+enum class Easing
+{
+	Linear,
+	EaseOutQuad,
+	EaseInOutCubic
+};
+
+float ease(Easing easing, float t); // Applies an easing curve to the progress 't'
+
+
+/// Identifies a running animation; 0 is never a valid handle.
+using AnimationHandle = uint64_t;
+
+/// The resumable body of an animation, called once per resumption.
+using AnimationBody = std::function<Suspend(AnimationFrame &)>;
+
+
+
+
+/**
+ * Animator class representing the runtime that starts, resumes and cancels animations.
+ *
+ * A new animation runs its first step immediately; afterwards it is resumed by the TaskScheduler
+ * when it asked to be. Animations run in the draw context (TaskScheduler::update is advanced by
+ * TableManager::draw) and may therefore touch widgets. An animation writing through a pointer must be
+ * cancelled by the owner of the pointee before it is destroyed.
+ */
+class Animator
+{
+public:
+	/// ------------- Access -------------
+	/// \{
+	static Animator &global(); // The animator shared by all widgets
+							   /// \}
+
+
+	/// ------------- Animations -------------
+	/// \{
+	AnimationHandle start(AnimationBody body, std::function<void()> onFinish = nullptr); // Starts an animation, 'onFinish' runs when it completes (not when cancelled)
+	AnimationHandle tween(float *value, float target, double durationSeconds, Easing easing = Easing::EaseInOutCubic, std::function<void()> onFinish = nullptr); // Animates '*value' to 'target'
+	void cancel(AnimationHandle handle); // Stops an animation, unknown or finished handles are ignored
+	bool isRunning(AnimationHandle handle) const; // Whether a handle refers to an animation that has not finished
+												  /// \}
+
+
+	/// ------------- Queries -------------
+	/// \{
+	std::size_t activeAnimations() const; // Number of running animations
+	uint64_t resumptions() const; // Number of times an animation body has been resumed
+								  /// \}
+
+
+private:
+	explicit Animator(TaskScheduler &_scheduler);
+
+	/// A running animation and its scheduler registration.
+	struct Animation
+	{
+		AnimationBody body; // The resumable body
+		std::function<void()> onFinish; // Called once the body finishes
+		AnimationFrame frame; // State kept between resumptions
+		TaskHandle task = 0; // The scheduler task that resumes the animation
+		bool perFrame = false; // Whether 'task' is a per-update task
+	};
+
+	void resume(AnimationHandle handle); // Runs one step of an animation and suspends it again
+	static double nowSeconds();
+
+	TaskScheduler &scheduler; // The scheduler resuming suspended animations
+	std::unordered_map<AnimationHandle, Animation> animations; // Running animations, node-based so references survive insertions
+	AnimationHandle nextHandle = 1; // Handles are never reused
+	AnimationHandle runningAnimation = 0; // The animation whose body is executing, it is not erased until the body returns
+	bool runningAnimationCancelled = false; // Whether the running animation was cancelled from within its body
+	uint64_t resumeCount = 0; // Number of resumptions
+};
@@ -0,0 +1,351 @@
+//  InterfaceDiagnostics.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "InterfaceDiagnostics.hpp"
+
+
+
+
+
+
+/**
+ * LatencyHistogram
+ * Default constructor that initializes an empty histogram.
+ */
+LatencyHistogram::LatencyHistogram()
+{
+	reset();
+}
+
+
+/**
+ * bucketIndex
+ * Maps a latency to the index of the counter it is recorded in.
+ *
+ * @param micros: The latency in microseconds
+ * @return int: The counter index
+ */
+int LatencyHistogram::bucketIndex(uint64_t micros)
+{
+	/// Small values are stored exactly
+	if (micros < SUB_BUCKETS)
+	{
+		return static_cast<int>(micros);
+	}
+
+
+	/// Larger values are stored by their power of two and the next SUB_BUCKET_BITS bits below it
+	int exponent = 63 - __builtin_clzll(micros); // Position of the highest set bit
+	if (exponent >= MAX_EXPONENT)
+	{
+		return BUCKET_COUNT - 1; // Saturate in the last bucket
+	}
+	int subBucket = static_cast<int>((micros >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+	return SUB_BUCKETS + (exponent - SUB_BUCKET_BITS) * SUB_BUCKETS + subBucket;
+}
+
+
+/**
+ * bucketValue
+ * Maps a counter index back to a representative latency, the midpoint of the bucket's range.
+ *
+ * @param index: The counter index
+ * @return uint64_t: The representative latency in microseconds
+ */
+uint64_t LatencyHistogram::bucketValue(int index)
+{
+	if (index < SUB_BUCKETS)
+	{
+		return static_cast<uint64_t>(index);
+	}
+
+	int exponent = (index - SUB_BUCKETS) / SUB_BUCKETS + SUB_BUCKET_BITS;
+	uint64_t subBucket = static_cast<uint64_t>((index - SUB_BUCKETS) % SUB_BUCKETS);
+	uint64_t width = 1ull << (exponent - SUB_BUCKET_BITS); // Range covered by one sub-bucket
+	uint64_t lower = (1ull << exponent) + subBucket * width;
+	return lower + width / 2;
+}
+
+
+/**
+ * record
+ * Adds a single latency sample to the histogram.
+ *
+ * @param micros: The latency in microseconds
+ */
+void LatencyHistogram::record(uint64_t micros)
+{
+	buckets[bucketIndex(micros)]++;
+	total++;
+	sum += micros;
+	maxValue = std::max(maxValue, micros);
+}
+
+
+/**
+ * reset
+ * Clears all recorded samples.
+ */
+void LatencyHistogram::reset()
+{
+	buckets.fill(0);
+	total = 0;
+	sum = 0;
+	maxValue = 0;
+}
+
+
+/**
+ * percentile
+ * Walks the counters in increasing order until 'p' percent of all samples have been passed.
+ *
+ * @param p: The percentile in the range [0, 100]
+ * @return uint64_t: The latency in microseconds, 0 if the histogram is empty
+ */
+uint64_t LatencyHistogram::percentile(double p) const
+{
+	if (total == 0)
+	{
+		return 0;
+	}
+
+
+	/// The rank of the requested sample, at least the first one
+	uint64_t rank = static_cast<uint64_t>(std::ceil(ofClamp(p, 0, 100) * 0.01 * total));
+	rank = std::max<uint64_t>(rank, 1);
+
+	uint64_t seen = 0;
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		seen += buckets[i];
+		if (seen >= rank)
+		{
+			return std::min(bucketValue(i), maxValue); // Never report more than was actually observed
+		}
+	}
+	return maxValue;
+}
+
+
+uint64_t LatencyHistogram::count() const
+{
+	return total;
+}
+
+
+uint64_t LatencyHistogram::maximum() const
+{
+	return maxValue;
+}
+
+
+double LatencyHistogram::mean() const
+{
+	return total == 0 ? 0.0 : static_cast<double>(sum) / total;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+/**
+ * global
+ * Returns the monitor shared by every widget.
+ */
+LatencyMonitor &LatencyMonitor::global()
+{
+	static LatencyMonitor monitor;
+	return monitor;
+}
+
+
+thread_local int LatencyMonitor::eventDepth = 0;
+thread_local uint64_t LatencyMonitor::eventTimestamp = 0;
+
+
+/**
+ * beginEvent
+ * Stamps the start of an input event with the current time. Only the outermost call of a nested
+ * sequence takes effect, so the earliest point an event was seen is the one that is measured from.
+ */
+void LatencyMonitor::beginEvent()
+{
+	beginEvent(ofGetElapsedTimeMicros());
+}
+
+
+/**
+ * beginEvent
+ * Stamps the start of an input event with an externally captured timestamp, e.g. the time an
+ * event was captured by the window before being queued.
+ *
+ * @param timestampMicros: The time the event occurred, from ofGetElapsedTimeMicros()
+ */
+void LatencyMonitor::beginEvent(uint64_t timestampMicros)
+{
+	if (eventDepth++ == 0)
+	{
+		eventTimestamp = timestampMicros;
+	}
+}
+
+
+/**
+ * endEvent
+ * Marks the end of the current input event.
+ */
+void LatencyMonitor::endEvent()
+{
+	if (eventDepth > 0 && --eventDepth == 0)
+	{
+		eventTimestamp = 0;
+	}
+}
+
+
+bool LatencyMonitor::eventInFlight() const
+{
+	return eventDepth > 0;
+}
+
+
+uint64_t LatencyMonitor::currentEventTimestamp() const
+{
+	return eventTimestamp;
+}
+
+
+/**
+ * record
+ * Records the latency of the event the calling thread is dispatching for the given widget. Calls made
+ * outside of an input event (e.g. a toggle firing from its per-frame update) are ignored, since
+ * there is no event to measure from.
+ *
+ * @param widgetType: The type of the widget, e.g. "Button"
+ * @param widgetLabel: The label of the widget
+ */
+void LatencyMonitor::record(const std::string &widgetType, const std::string &widgetLabel)
+{
+	if (!enabled || eventDepth == 0)
+	{
+		return;
+	}
+	record(widgetType + ": " + widgetLabel, eventTimestamp);
+}
+
+
+/**
+ * record
+ * Records the latency from a specific event timestamp until now for the given widget key.
+ *
+ * @param widgetKey: The widget key, e.g. "Button: Click Button"
+ * @param eventTimestampMicros: The time the event occurred, from ofGetElapsedTimeMicros()
+ */
+void LatencyMonitor::record(const std::string &widgetKey, uint64_t eventTimestampMicros)
+{
+	if (!enabled)
+	{
+		return;
+	}
+
+	uint64_t now = ofGetElapsedTimeMicros();
+	uint64_t latency = now > eventTimestampMicros ? now - eventTimestampMicros : 0;
+
+	std::lock_guard<std::mutex> lock(histogramMutex);
+	histograms[widgetKey].record(latency);
+}
+
+
+void LatencyMonitor::reset()
+{
+	std::lock_guard<std::mutex> lock(histogramMutex);
+	histograms.clear();
+}
+
+
+/**
+ * summary
+ * Returns the latency percentiles recorded for a single widget.
+ *
+ * @param widgetKey: The widget key, e.g. "Button: Click Button"
+ * @return LatencySummary: The summary, with a count of zero if the widget has no samples
+ */
+LatencySummary LatencyMonitor::summary(const std::string &widgetKey) const
+{
+	LatencySummary result;
+	result.widget = widgetKey;
+
+	std::lock_guard<std::mutex> lock(histogramMutex);
+	auto it = histograms.find(widgetKey);
+	if (it != histograms.end())
+	{
+		const LatencyHistogram &histogram = it->second;
+		result.count = histogram.count();
+		result.p50 = histogram.percentile(50);
+		result.p95 = histogram.percentile(95);
+		result.p99 = histogram.percentile(99);
+		result.max = histogram.maximum();
+		result.mean = histogram.mean();
+	}
+	return result;
+}
+
+
+std::vector<LatencySummary> LatencyMonitor::summaries() const
+{
+	std::vector<LatencySummary> result;
+	for (auto &widget : widgets())
+	{
+		result.push_back(summary(widget));
+	}
+	return result;
+}
+
+
+std::vector<std::string> LatencyMonitor::widgets() const
+{
+	std::vector<std::string> keys;
+	std::lock_guard<std::mutex> lock(histogramMutex);
+	for (auto &entry : histograms)
+	{
+		keys.push_back(entry.first);
+	}
+	return keys;
+}
+
+
+/**
+ * draw
+ * Draws a readout of the latency percentiles of every widget with recorded samples, one line per
+ * widget, starting at the given position.
+ *
+ * @param x: The x-coordinate of the readout's top left corner
+ * @param y: The y-coordinate of the readout's top left corner
+ */
+void LatencyMonitor::draw(float x, float y) const
+{
+	std::string readout = "Input latency (us)      n     p50     p95     p99     max";
+	for (auto &entry : summaries())
+	{
+		std::string name = entry.widget.substr(0, 20);
+		name.resize(20, ' ');
+		readout += "\n" + name
+		+ " " + ofToString(entry.count, 6, ' ')
+		+ " " + ofToString(entry.p50, 7, ' ')
+		+ " " + ofToString(entry.p95, 7, ' ')
+		+ " " + ofToString(entry.p99, 7, ' ')
+		+ " " + ofToString(entry.max, 7, ' ');
+	}
+
+	ofSetColor(255);
+	ofDrawBitmapStringHighlight(readout, x, y);
+}
@@ -0,0 +1,199 @@
+//  InterfaceDiagnostics.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Interface Diagnostics header file declares the tooling used to measure how responsive the UI is.
+ *
+ * These components include:
+ *   - LatencyHistogram: A fixed-size, log-linear histogram of microsecond latencies with percentile queries.
+ *   - LatencyMonitor: Stamps input events as they enter the UI and records, per widget, how long it took
+ *     for the event to reach the bound callback or bound value.
+ *   - ScopedInputEvent: RAII helper that marks the start and end of a single input event.
+ *
+ * The monitor answers the question "how long after the window delivered the mouse/key event did
+ * Button::onClick (or Toggle::onClick, Tab::onClick, a Slider/TextField value write) actually run",
+ * which is what stays visible to the user when the simulation saturates the CPU.
+ */
+
+
+#pragma once
+#include "ofMain.h"
+#include <array>
+#include <map>
+#include <mutex>
+
+
+
+
+
+
+/**
+ * LatencyHistogram class representing a distribution of latencies in microseconds.
+ *
+ * Values below 16us are stored exactly, larger values are stored in 16 linear sub-buckets per
+ * power of two (~6% relative resolution), so the histogram covers 1us to ~70 minutes in a few
+ * hundred counters. Recording never allocates, which keeps it safe to call from event handlers.
+ */
+class LatencyHistogram
+{
+public:
+	/// ------------- Constructors -------------
+	/// \{
+	LatencyHistogram(); // Initializes an empty histogram
+						/// \}
+
+
+	/// ------------- Recording -------------
+	/// \{
+	void record(uint64_t micros); // Adds a single latency sample
+	void reset(); // Clears all recorded samples
+				  /// \}
+
+
+	/// ------------- Queries -------------
+	/// \{
+	uint64_t percentile(double p) const; // Returns the latency (us) below which 'p' percent of the samples fall
+	uint64_t count() const; // Returns the number of recorded samples
+	uint64_t maximum() const; // Returns the largest recorded sample
+	double mean() const; // Returns the arithmetic mean of the recorded samples
+						 /// \}
+
+
+	/// ------------- Histogram Attributes -------------
+	/// \{
+	static const int SUB_BUCKET_BITS = 4; // log2 of the number of linear sub-buckets per power of two
+	static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS; // Linear sub-buckets per power of two
+	static const int MAX_EXPONENT = 32; // Largest power of two tracked (2^32us ~ 71 minutes)
+	static const int BUCKET_COUNT = SUB_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS) * SUB_BUCKETS; // Total number of counters
+
+private:
+	static int bucketIndex(uint64_t micros); // Maps a latency to its counter
+	static uint64_t bucketValue(int index); // Maps a counter back to the representative latency (bucket midpoint)
+
+	std::array<uint64_t, BUCKET_COUNT> buckets; // Sample counts per bucket
+	uint64_t total; // Number of recorded samples
+	uint64_t sum; // Sum of all recorded samples, used for the mean
+	uint64_t maxValue; // Largest recorded sample
+					   /// \}
+};
+
+
+
+
+
+
+
+
+/**
+ * LatencySummary struct representing the result of a latency query for a single widget.
+ * All latencies are expressed in microseconds.
+ */
+struct LatencySummary
+{
+	std::string widget; // The widget key the summary belongs to, e.g. "Button: Click Button"
+	uint64_t count = 0; // Number of samples recorded for the widget
+	uint64_t p50 = 0; // Median latency
+	uint64_t p95 = 0; // 95th percentile latency
+	uint64_t p99 = 0; // 99th percentile latency
+	uint64_t max = 0; // Worst observed latency
+	double mean = 0; // Average latency
+};
+
+
+
+
+
+
+
+
+/**
+ * LatencyMonitor class measuring input-to-callback latency for every widget.
+ *
+ * Input events are stamped when they enter the UI (see ScopedInputEvent), and the widgets
+ * report back when they invoke their bound callback or write their bound value. The elapsed
+ * time between the two is recorded into a LatencyHistogram keyed by the widget's type and label.
+ * A single shared monitor is used by all widgets, accessible through LatencyMonitor::global().
+ * The event being dispatched is tracked per thread, so events dispatched on different threads are
+ * stamped and attributed independently; the histograms are shared under a mutex.
+ */
+class LatencyMonitor
+{
+public:
+	/// ------------- Access -------------
+	/// \{
+	static LatencyMonitor &global(); // The monitor shared by all widgets
+									 /// \}
+
+
+	/// ------------- Event Stamping -------------
+	/// \{
+	void beginEvent(); // Stamps the start of an input event (only the outermost call takes effect)
+	void beginEvent(uint64_t timestampMicros); // Stamps the start of an input event with an externally captured timestamp
+	void endEvent(); // Marks the end of the current input event
+	bool eventInFlight() const; // Whether an input event is currently being dispatched
+	uint64_t currentEventTimestamp() const; // Timestamp of the event currently being dispatched, 0 if none
+											/// \}
+
+
+	/// ------------- Recording -------------
+	/// \{
+	void record(const std::string &widgetType, const std::string &widgetLabel); // Records the latency of the current event for a widget
+	void record(const std::string &widgetKey, uint64_t eventTimestampMicros); // Records the latency from a specific event timestamp until now
+	void reset(); // Clears every recorded histogram
+				  /// \}
+
+
+	/// ------------- Queries -------------
+	/// \{
+	LatencySummary summary(const std::string &widgetKey) const; // Returns the p50/p95/p99 summary for a widget
+	std::vector<LatencySummary> summaries() const; // Returns a summary for every widget with recorded samples
+	std::vector<std::string> widgets() const; // Returns the keys of every widget with recorded samples
+											  /// \}
+
+
+	/// ------------- Rendering -------------
+	/// \{
+	void draw(float x, float y) const; // Draws an on-screen readout of every widget's latency percentiles
+									   /// \}
+
+
+	/// ------------- Latency Monitor Attributes -------------
+	/// \{
+	bool enabled = true; // Whether samples are recorded at all
+	bool showReadout = false; // Whether the on-screen readout should be drawn by the application
+
+private:
+	LatencyMonitor() = default;
+
+	mutable std::mutex histogramMutex; // Guards the histogram map, events may be dispatched off the render thread
+	std::map<std::string, LatencyHistogram> histograms; // Latency distribution per widget key
+	static thread_local int eventDepth; // Nesting depth of begin/endEvent calls on the calling thread
+	static thread_local uint64_t eventTimestamp; // Timestamp (us) of the event the calling thread is dispatching
+								 /// \}
+};
+
+
+
+
+
+
+
+
+/**
+ * ScopedInputEvent class marking the lifetime of a single input event.
+ *
+ * Constructing one stamps the event as it enters the UI, destroying it ends the event.
+ * Nested scopes are harmless: only the outermost scope determines the timestamp, so an
+ * application can stamp an event in its window callback before handing it to a TableManager
+ * which stamps it again.
+ */
+class ScopedInputEvent
+{
+public:
+	ScopedInputEvent() { LatencyMonitor::global().beginEvent(); }
+	explicit ScopedInputEvent(uint64_t timestampMicros) { LatencyMonitor::global().beginEvent(timestampMicros); }
+	~ScopedInputEvent() { LatencyMonitor::global().endEvent(); }
+
+	ScopedInputEvent(const ScopedInputEvent &) = delete;
+	ScopedInputEvent &operator=(const ScopedInputEvent &) = delete;
+};
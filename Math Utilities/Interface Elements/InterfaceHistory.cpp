@@ -0,0 +1,186 @@
+//  InterfaceHistory.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "InterfaceHistory.hpp"
+#include <algorithm>
+
+
+
+
+
+
+UndoHistory::UndoHistory(std::size_t capacity) : entries(std::max<std::size_t>(capacity, 1))
+{
+}
+
+
+UndoHistory::~UndoHistory()
+{
+	detach();
+}
+
+
+/**
+ * attach
+ * Starts recording the changes made to a store. Values the store already holds are the baseline and
+ * cannot be undone.
+ *
+ * @param _store: The store to record
+ */
+void UndoHistory::attach(ParameterStore &_store)
+{
+	detach();
+	store = &_store;
+	store->addListener(this);
+}
+
+
+void UndoHistory::detach()
+{
+	if (store)
+	{
+		store->removeListener(this);
+	}
+	store = nullptr;
+}
+
+
+/**
+ * seal
+ * Ends the current gesture. Called when the mouse button or a key is released, so that one drag of a
+ * slider, one click of a toggle or one submitted text field becomes one entry.
+ */
+void UndoHistory::seal()
+{
+	gestureOpen = false;
+}
+
+
+void UndoHistory::clear()
+{
+	first = cursor = last = 0;
+	gestureOpen = false;
+}
+
+
+
+
+/**
+ * undo
+ * Writes the old value of the most recent entry back into the store, where the bound widget picks it up
+ * on its next draw.
+ *
+ * @return bool: true if an entry was undone
+ */
+bool UndoHistory::undo()
+{
+	if (!store || !canUndo())
+	{
+		return false;
+	}
+	gestureOpen = false;
+	const UndoEntry &entry = at(--cursor);
+	replaying = true;
+	store->setWord(entry.parameter, entry.oldWord);
+	replaying = false;
+	return true;
+}
+
+
+/**
+ * redo
+ * Writes the new value of the most recently undone entry back into the store.
+ *
+ * @return bool: true if an entry was redone
+ */
+bool UndoHistory::redo()
+{
+	if (!store || !canRedo())
+	{
+		return false;
+	}
+	gestureOpen = false;
+	const UndoEntry &entry = at(cursor++);
+	replaying = true;
+	store->setWord(entry.parameter, entry.newWord);
+	replaying = false;
+	return true;
+}
+
+
+bool UndoHistory::canUndo() const
+{
+	return cursor > first;
+}
+
+
+bool UndoHistory::canRedo() const
+{
+	return last > cursor;
+}
+
+
+std::size_t UndoHistory::undoDepth() const
+{
+	return static_cast<std::size_t>(cursor - first);
+}
+
+
+std::size_t UndoHistory::redoDepth() const
+{
+	return static_cast<std::size_t>(last - cursor);
+}
+
+
+const UndoEntry *UndoHistory::nextUndo() const
+{
+	return canUndo() ? &at(cursor - 1) : nullptr;
+}
+
+
+
+
+/**
+ * parameterChanged
+ * Records a change. A change of the parameter of the open gesture only moves that entry's new value
+ * (and drops the entry if the gesture ends where it started); any other change discards the redoable
+ * entries and appends a new one, overwriting the oldest entry when the ring is full.
+ *
+ * @param index: The parameter's index in the store
+ * @param oldWord: The previous value
+ * @param newWord: The new value
+ */
+void UndoHistory::parameterChanged(uint32_t index, uint64_t oldWord, uint64_t newWord)
+{
+	if (replaying || store->isDerived(index)) // Derived parameters follow their inputs, undoing an input re-derives them
+	{
+		return;
+	}
+
+	/// Step 1: Coalesce into the open gesture
+	if (gestureOpen && cursor > first && at(cursor - 1).parameter == index)
+	{
+		UndoEntry &entry = at(cursor - 1);
+		entry.newWord = newWord;
+		if (entry.newWord == entry.oldWord) // Dragged back to where it started, nothing to undo
+		{
+			cursor--;
+			gestureOpen = false;
+		}
+		last = cursor;
+		return;
+	}
+
+
+	/// Step 2: Append a new entry, discarding the redo branch and, if full, the oldest entry
+	at(cursor) = UndoEntry{index, oldWord, newWord};
+	cursor++;
+	last = cursor;
+	if (cursor - first > entries.size())
+	{
+		first = cursor - entries.size();
+	}
+	gestureOpen = true;
+}
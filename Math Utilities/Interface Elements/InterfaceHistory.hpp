@@ -0,0 +1,107 @@
+//  InterfaceHistory.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Interface History header file declares undo/redo of widget edits as a log of deltas.
+ *
+ * These components include:
+ *   - UndoEntry: One edit, the parameter (and so the widget bound to it) with its old and new value.
+ *   - UndoHistory: A ParameterListener that records every change of a ParameterStore parameter into a
+ *     bounded ring of entries and steps backwards and forwards through it.
+ *
+ * Only deltas are stored, never snapshots of the widget tree, so recording, undoing and redoing each
+ * cost O(1) regardless of how many widgets exist. The changes of one gesture, e.g. every value a slider
+ * passes through during a drag, are coalesced into a single entry until seal() ends the gesture; the
+ * application seals on mouse and key release. When the ring is full the oldest entries are dropped.
+ */
+
+
+#pragma once
+#include "ParameterStore.hpp"
+#include <cstdint>
+#include <vector>
+
+
+
+
+
+
+/**
+ * UndoEntry struct, one recorded edit.
+ */
+struct UndoEntry
+{
+	uint32_t parameter; // The edited parameter's index in its store, identifying the widget bound to it
+	uint64_t oldWord; // The value before the edit, encoded as by encodeParameter
+	uint64_t newWord; // The value after the edit
+};
+
+
+
+
+
+
+
+
+/**
+ * UndoHistory class representing the undo/redo log of the edits made to a ParameterStore.
+ *
+ * Used from the UI thread, like the store it records.
+ */
+class UndoHistory : public ParameterListener
+{
+public:
+	/// ------------- Constructors and Destructor -------------
+	/// \{
+	explicit UndoHistory(std::size_t capacity = DEFAULT_CAPACITY); // Creates an empty history holding up to 'capacity' entries
+	~UndoHistory(); // Stops recording
+	UndoHistory(const UndoHistory &) = delete;
+	UndoHistory &operator=(const UndoHistory &) = delete;
+	/// \}
+
+
+	/// ------------- Recording -------------
+	/// \{
+	void attach(ParameterStore &_store = ParameterStore::global()); // Starts recording the changes of a store
+	void detach(); // Stops recording
+	void seal(); // Ends the current gesture, the next change starts a new entry
+	void clear(); // Forgets every entry
+				  /// \}
+
+
+	/// ------------- Undo and Redo -------------
+	/// \{
+	bool undo(); // Restores the old value of the most recent entry, false if there is nothing to undo
+	bool redo(); // Reapplies the most recently undone entry, false if there is nothing to redo
+	bool canUndo() const; // Whether an entry can be undone
+	bool canRedo() const; // Whether an undone entry can be redone
+	std::size_t undoDepth() const; // Number of entries that can be undone
+	std::size_t redoDepth() const; // Number of entries that can be redone
+	const UndoEntry *nextUndo() const; // The entry undo() would restore, nullptr if none
+									   /// \}
+
+
+	/// ------------- ParameterListener -------------
+	/// \{
+	void parameterChanged(uint32_t index, uint64_t oldWord, uint64_t newWord) override; // Records the change, coalescing it into the open gesture
+																						 /// \}
+
+
+	/// ------------- Capacity -------------
+	/// \{
+	static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+	/// \}
+
+
+private:
+	UndoEntry &at(uint64_t position) { return entries[position % entries.size()]; } // The slot of an absolute position
+	const UndoEntry &at(uint64_t position) const { return entries[position % entries.size()]; }
+
+	std::vector<UndoEntry> entries; // The ring, allocated once
+	uint64_t first = 0; // Absolute position of the oldest entry still held
+	uint64_t cursor = 0; // Absolute position after the last entry that is not undone
+	uint64_t last = 0; // Absolute position after the last redoable entry
+	bool gestureOpen = false; // Whether the entry before 'cursor' may still absorb changes of its parameter
+	bool replaying = false; // Set while undo/redo write to the store, so their changes are not recorded
+	ParameterStore *store = nullptr; // The store being recorded
+};
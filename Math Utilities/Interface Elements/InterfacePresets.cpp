@@ -0,0 +1,472 @@
+//  InterfacePresets.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "InterfacePresets.hpp"
+#include "ParameterExpressions.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+
+
+
+namespace
+{
+	const char PRESET_MAGIC[8] = {'U', 'I', 'P', 'R', 'E', 'S', 'E', 'T'};
+}
+
+
+
+
+/**
+ * widgetId
+ * Hashes a widget path with 64-bit FNV-1a, which is stable across runs and platforms.
+ *
+ * @param path: The widget path, "<table label>/<widget label>"
+ * @return uint64_t: The widget's id
+ */
+uint64_t widgetId(const std::string &path)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (unsigned char character : path)
+	{
+		hash ^= character;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+
+/**
+ * collectBoundWidgets
+ * Walks a TableManager tree and lists every slider, text field and toggle with its path and id.
+ * Repeated paths get "#2", "#3", ... appended so that every widget has its own id.
+ *
+ * @param tableManager: The tree to walk
+ * @return std::vector<BoundWidget>: The widgets, in table order
+ */
+std::vector<BoundWidget> collectBoundWidgets(TableManager &tableManager)
+{
+	std::vector<BoundWidget> widgets;
+	std::unordered_map<std::string, int> occurrences;
+	auto add = [&widgets, &occurrences](const std::string &tableLabel, const std::string &widgetLabel, PresetWidgetKind kind) -> BoundWidget&
+	{
+		std::string path = tableLabel + "/" + widgetLabel;
+		int occurrence = ++occurrences[path];
+		if (occurrence > 1)
+		{
+			path += "#" + ofToString(occurrence);
+		}
+		BoundWidget widget;
+		widget.path = path;
+		widget.id = widgetId(path);
+		widget.kind = kind;
+		widgets.push_back(widget);
+		return widgets.back();
+	};
+
+	for (Table *table : tableManager.tables)
+	{
+		for (SliderElement *slider : table->sliderElements)
+		{
+			add(table->label, slider->label, PresetWidgetKind::Slider).slider = slider;
+		}
+		for (TextField *textField : table->textfieldElements)
+		{
+			add(table->label, textField->label, PresetWidgetKind::TextField).textField = textField;
+		}
+		for (Toggle *toggle : table->toggleElements)
+		{
+			add(table->label, toggle->label, PresetWidgetKind::Toggle).toggle = toggle;
+		}
+	}
+	return widgets;
+}
+
+
+/**
+ * presetTableFilter
+ * Returns a filter that restricts a partial apply to the widgets of one table.
+ *
+ * @param tableLabel: The label of the table
+ * @return PresetFilter: The filter
+ */
+PresetFilter presetTableFilter(const std::string &tableLabel)
+{
+	std::string prefix = tableLabel + "/";
+	return [prefix](const BoundWidget &widget) { return widget.path.compare(0, prefix.size(), prefix) == 0; };
+}
+
+
+
+
+
+
+
+
+Preset::Preset()
+{
+}
+
+
+Preset::~Preset()
+{
+	release();
+}
+
+
+Preset::Preset(Preset &&other) noexcept
+{
+	*this = std::move(other);
+}
+
+
+Preset &Preset::operator=(Preset &&other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		bool owned = other.entries == other.ownedEntries.data();
+		ownedEntries = std::move(other.ownedEntries);
+		entries = owned ? ownedEntries.data() : other.entries;
+		count = other.count;
+		mapping = other.mapping;
+		mappingSize = other.mappingSize;
+
+		other.entries = nullptr;
+		other.count = 0;
+		other.mapping = nullptr;
+		other.mappingSize = 0;
+	}
+	return *this;
+}
+
+
+void Preset::release()
+{
+#ifndef _WIN32
+	if (mapping)
+	{
+		munmap(mapping, mappingSize);
+	}
+#endif
+	mapping = nullptr;
+	mappingSize = 0;
+	entries = nullptr;
+	count = 0;
+	ownedEntries.clear();
+}
+
+
+
+
+/**
+ * capture
+ * Stores the current value of every bound widget of a tree: slider values in their own type, text field values
+ * as double and toggle states as bool.
+ *
+ * @param tableManager: The tree to capture
+ * @return Preset: The captured preset
+ */
+Preset Preset::capture(TableManager &tableManager)
+{
+	Preset preset;
+	for (const BoundWidget &widget : collectBoundWidgets(tableManager))
+	{
+		PresetEntry entry = {};
+		entry.widgetId = widget.id;
+		entry.kind = static_cast<uint8_t>(widget.kind);
+		switch (widget.kind)
+		{
+			case PresetWidgetKind::Slider:
+				entry.word = parameterFromDouble(widget.slider->valueType(), widget.slider->getValueAsDouble());
+				break;
+			case PresetWidgetKind::TextField:
+				entry.word = encodeParameter(widget.textField->getValue());
+				break;
+			case PresetWidgetKind::Toggle:
+				entry.word = encodeParameter(widget.toggle->isOn);
+				break;
+		}
+		preset.ownedEntries.push_back(entry);
+	}
+
+	std::sort(preset.ownedEntries.begin(), preset.ownedEntries.end(), [](const PresetEntry &a, const PresetEntry &b) { return a.widgetId < b.widgetId; });
+	preset.entries = preset.ownedEntries.data();
+	preset.count = preset.ownedEntries.size();
+	return preset;
+}
+
+
+/**
+ * save
+ * Writes the preset to a file: a 16-byte header followed by the sorted entries.
+ *
+ * @param path: The file to write
+ * @return bool: true if the file was written completely
+ */
+bool Preset::save(const std::string &path) const
+{
+	PresetHeader header = {};
+	std::memcpy(header.magic, PRESET_MAGIC, sizeof(PRESET_MAGIC));
+	header.formatVersion = FORMAT_VERSION;
+	header.count = static_cast<uint32_t>(count);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(entries), count * sizeof(PresetEntry));
+	if (!file)
+	{
+		ofLogError("Preset") << "Could not write " << path;
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * load
+ * Maps a preset file read-only; the entries are used in place, nothing is parsed or copied. Where
+ * mapping is unavailable the entries are read into memory instead.
+ *
+ * @param path: The file to load
+ * @return Preset: The loaded preset, empty if the file is missing or not a preset
+ */
+Preset Preset::load(const std::string &path)
+{
+	Preset preset;
+
+#ifndef _WIN32
+	/// Step 1: Map the file
+	int fd = ::open(path.c_str(), O_RDONLY);
+	struct stat fileStatus;
+	if (fd < 0 || fstat(fd, &fileStatus) != 0 || static_cast<std::size_t>(fileStatus.st_size) < sizeof(PresetHeader))
+	{
+		if (fd >= 0)
+		{
+			::close(fd);
+		}
+		return preset;
+	}
+	std::size_t size = static_cast<std::size_t>(fileStatus.st_size);
+	void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (address == MAP_FAILED)
+	{
+		return preset;
+	}
+	preset.mapping = address;
+	preset.mappingSize = size;
+	const char *bytes = static_cast<const char*>(address);
+#else
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	std::size_t size = file ? static_cast<std::size_t>(file.tellg()) : 0;
+	if (size < sizeof(PresetHeader))
+	{
+		return preset;
+	}
+	std::vector<char> contents(size);
+	file.seekg(0);
+	file.read(contents.data(), size);
+	const char *bytes = contents.data();
+#endif
+
+
+	/// Step 2: Validate the header and point at the entries
+	const PresetHeader *header = reinterpret_cast<const PresetHeader*>(bytes);
+	if (std::memcmp(header->magic, PRESET_MAGIC, sizeof(PRESET_MAGIC)) != 0 || header->formatVersion != FORMAT_VERSION || size != sizeof(PresetHeader) + header->count * sizeof(PresetEntry))
+	{
+		ofLogWarning("Preset") << path << " is not a preset of format version " << FORMAT_VERSION;
+		preset.release();
+		return preset;
+	}
+
+#ifndef _WIN32
+	preset.entries = reinterpret_cast<const PresetEntry*>(bytes + sizeof(PresetHeader));
+#else
+	preset.ownedEntries.resize(header->count);
+	std::memcpy(preset.ownedEntries.data(), bytes + sizeof(PresetHeader), header->count * sizeof(PresetEntry));
+	preset.entries = preset.ownedEntries.data();
+#endif
+	preset.count = header->count;
+	return preset;
+}
+
+
+
+
+/**
+ * apply
+ * Sets the widgets of a tree to the stored values. Widgets the preset does not know, widgets whose
+ * kind changed and widgets rejected by the filter are left alone, so presets stay usable after the
+ * panel gains or loses widgets. Values go through the widgets' normal setters, so parameter-bound
+ * widgets publish, journal and notify as if the operator had made the change. Values are clamped to
+ * the widgets' current ranges, and a text field holding an expression is set to the plain number.
+ *
+ * @param tableManager: The tree to apply the preset to
+ * @param filter: Restricts the apply to some widgets, e.g. presetTableFilter(label); nullptr applies all
+ * @return std::size_t: The number of widgets that were set
+ */
+std::size_t Preset::apply(TableManager &tableManager, PresetFilter filter) const
+{
+	std::size_t applied = 0;
+	for (const BoundWidget &widget : collectBoundWidgets(tableManager))
+	{
+		const PresetEntry *entry = find(widget.id);
+		if (!entry || entry->kind != static_cast<uint8_t>(widget.kind) || (filter && !filter(widget)))
+		{
+			continue;
+		}
+
+		switch (widget.kind)
+		{
+			case PresetWidgetKind::Slider:
+				widget.slider->setValueFromDouble(parameterAsDouble(widget.slider->valueType(), entry->word));
+				break;
+			case PresetWidgetKind::TextField:
+				if (widget.textField->parameterStore)
+				{
+					ParameterExpressions::forStore(*widget.textField->parameterStore).unbind(widget.textField->parameter.index); // A stored number replaces an expression, as a typed one does
+				}
+				widget.textField->setValue(std::min(std::max(decodeParameter<double>(entry->word), widget.textField->min), widget.textField->max)); // Clamped like the sliders, an older preset may predate the range
+				widget.textField->currentString = ofToString(widget.textField->getValue(), widget.textField->precision);
+				widget.textField->inputString = widget.textField->currentString;
+				widget.textField->inputInRange = true;
+				widget.textField->warningMode = false;
+				break;
+			case PresetWidgetKind::Toggle:
+				widget.toggle->setOn(decodeParameter<bool>(entry->word));
+				break;
+		}
+		applied++;
+	}
+	return applied;
+}
+
+
+/**
+ * find
+ * Looks a widget up by binary search over the sorted entries.
+ *
+ * @param id: The widget's id
+ * @return const PresetEntry*: The widget's entry, nullptr if the preset has none
+ */
+const PresetEntry *Preset::find(uint64_t id) const
+{
+	const PresetEntry *end = entries + count;
+	const PresetEntry *entry = std::lower_bound(entries, end, id, [](const PresetEntry &candidate, uint64_t value) { return candidate.widgetId < value; });
+	return entry != end && entry->widgetId == id ? entry : nullptr;
+}
+
+
+std::size_t Preset::size() const
+{
+	return count;
+}
+
+
+bool Preset::empty() const
+{
+	return count == 0;
+}
+
+
+
+
+
+
+
+
+PresetLibrary::PresetLibrary(const std::string &_directory) : directory(_directory)
+{
+}
+
+
+std::string PresetLibrary::pathOf(const std::string &name) const
+{
+	return (std::filesystem::path(directory) / (name + ".preset")).string();
+}
+
+
+/**
+ * save
+ * Captures the tree and stores it under a name, replacing a previous preset of that name.
+ *
+ * @param name: The name of the preset
+ * @param tableManager: The tree to capture
+ * @return bool: true if the preset was written
+ */
+bool PresetLibrary::save(const std::string &name, TableManager &tableManager)
+{
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+	cache.erase(name); // Unmap the old file before it is replaced
+	return Preset::capture(tableManager).save(pathOf(name));
+}
+
+
+/**
+ * get
+ * Returns a named preset, mapping its file on first use and keeping it mapped afterwards.
+ *
+ * @param name: The name of the preset
+ * @return const Preset*: The preset, nullptr if there is no valid preset of that name
+ */
+const Preset *PresetLibrary::get(const std::string &name)
+{
+	auto it = cache.find(name);
+	if (it == cache.end())
+	{
+		std::unique_ptr<Preset> preset(new Preset(Preset::load(pathOf(name))));
+		if (preset->empty())
+		{
+			return nullptr;
+		}
+		it = cache.emplace(name, std::move(preset)).first;
+	}
+	return it->second.get();
+}
+
+
+/**
+ * apply
+ * Applies a named preset to a tree, fully or partially.
+ *
+ * @param name: The name of the preset
+ * @param tableManager: The tree to apply it to
+ * @param filter: Restricts the apply to some widgets, nullptr applies all
+ * @return std::size_t: The number of widgets that were set, 0 if there is no such preset
+ */
+std::size_t PresetLibrary::apply(const std::string &name, TableManager &tableManager, PresetFilter filter)
+{
+	const Preset *preset = get(name);
+	return preset ? preset->apply(tableManager, filter) : 0;
+}
+
+
+std::vector<std::string> PresetLibrary::names() const
+{
+	std::vector<std::string> presetNames;
+	std::error_code error;
+	for (const auto &file : std::filesystem::directory_iterator(directory, error))
+	{
+		if (file.path().extension() == ".preset")
+		{
+			presetNames.push_back(file.path().stem().string());
+		}
+	}
+	std::sort(presetNames.begin(), presetNames.end());
+	return presetNames;
+}
@@ -0,0 +1,192 @@
+//  InterfacePresets.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Interface Presets header file declares binary preset snapshots of every bound widget value in a
+ * TableManager tree.
+ *
+ * These components include:
+ *   - BoundWidget: A slider, text field or toggle found in the tree, with its stable id.
+ *   - Preset: A compact binary blob of widget values keyed by widget id; captured from a tree, saved
+ *     to a file, loaded back through mmap and applied to a tree, fully or partially.
+ *   - PresetLibrary: Named presets kept as files in a directory, mapped once and cached so that
+ *     switching between configurations is instant.
+ *
+ * A widget's id is the 64-bit FNV-1a hash of its path "<table label>/<widget label>" (with "#n"
+ * appended to the n-th repeat of a path), so ids survive restarts and code changes that do not rename
+ * widgets, and presets do not depend on the order in which ofApp::setup creates widgets.
+ *
+ * Preset file layout (native byte order):
+ *   [PresetHeader, 16 bytes][PresetEntry x count], entries sorted by widget id
+ * so applying a preset looks every widget up by binary search directly in the mapped file.
+ */
+
+
+#pragma once
+#include "ofMain.h"
+#include "NavigationalComponents.hpp"
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+
+
+
+
+/// The kinds of widgets whose values are stored in presets.
+enum class PresetWidgetKind : uint8_t
+{
+	Slider,
+	TextField,
+	Toggle
+};
+
+
+/**
+ * PresetHeader struct, the first 16 bytes of a preset file.
+ */
+struct PresetHeader
+{
+	char magic[8]; // "UIPRESET"
+	uint32_t formatVersion; // Preset::FORMAT_VERSION
+	uint32_t count; // Number of entries
+};
+
+
+/**
+ * PresetEntry struct, the stored value of one widget.
+ */
+struct PresetEntry
+{
+	uint64_t widgetId; // The widget's stable id
+	uint64_t word; // The value, encoded as by encodeParameter (the slider's value type, double for text fields, bool for toggles)
+	uint8_t kind; // The PresetWidgetKind of the widget
+	uint8_t reserved[7];
+};
+
+
+static_assert(sizeof(PresetHeader) == 16, "PresetHeader is part of the file format");
+static_assert(sizeof(PresetEntry) == 24, "PresetEntry is part of the file format");
+
+
+
+
+/**
+ * BoundWidget struct referring to a widget of a TableManager tree whose value presets store.
+ */
+struct BoundWidget
+{
+	std::string path; // "<table label>/<widget label>", unique within the tree
+	uint64_t id; // widgetId(path)
+	PresetWidgetKind kind; // Which of the pointers below is set
+	SliderElement *slider = nullptr;
+	TextField *textField = nullptr;
+	Toggle *toggle = nullptr;
+};
+
+
+uint64_t widgetId(const std::string &path); // The stable id of a widget path
+std::vector<BoundWidget> collectBoundWidgets(TableManager &tableManager); // Every slider, text field and toggle of a tree, in table order
+
+/// Decides whether a widget takes part in a partial apply, nullptr applies every widget.
+using PresetFilter = std::function<bool(const BoundWidget &widget)>;
+PresetFilter presetTableFilter(const std::string &tableLabel); // A filter accepting only the widgets of one table
+
+
+
+
+
+
+
+
+/**
+ * Preset class representing the stored widget values of a tree.
+ *
+ * A preset either owns its entries (after capture) or refers to a read-only mapping of its file
+ * (after load); applying works the same way for both.
+ */
+class Preset
+{
+public:
+	/// ------------- Constructors and Destructor -------------
+	/// \{
+	Preset(); // Creates an empty preset
+	~Preset(); // Unmaps the file of a loaded preset
+	Preset(Preset &&other) noexcept;
+	Preset &operator=(Preset &&other) noexcept;
+	Preset(const Preset &) = delete;
+	Preset &operator=(const Preset &) = delete;
+	/// \}
+
+
+	/// ------------- Capture, Save and Load -------------
+	/// \{
+	static Preset capture(TableManager &tableManager); // Stores the current value of every bound widget of a tree
+	bool save(const std::string &path) const; // Writes the preset to a file
+	static Preset load(const std::string &path); // Maps a preset file, an empty preset if it is missing or invalid
+												 /// \}
+
+
+	/// ------------- Access and Apply -------------
+	/// \{
+	std::size_t apply(TableManager &tableManager, PresetFilter filter = nullptr) const; // Sets the widgets of a tree to the stored values, returns how many were set
+	const PresetEntry *find(uint64_t id) const; // The entry of a widget, nullptr if the preset has none
+	std::size_t size() const; // Number of stored widget values
+	bool empty() const; // Whether the preset stores no values
+						/// \}
+
+
+	/// ------------- Format -------------
+	/// \{
+	static constexpr uint32_t FORMAT_VERSION = 1;
+	/// \}
+
+
+private:
+	void release(); // Unmaps the file of a loaded preset
+
+	std::vector<PresetEntry> ownedEntries; // The entries of a captured preset
+	const PresetEntry *entries = nullptr; // The sorted entries, either in 'ownedEntries' or in the mapping
+	std::size_t count = 0; // Number of entries
+	void *mapping = nullptr; // The mapped file of a loaded preset
+	std::size_t mappingSize = 0; // The size of the mapping
+};
+
+
+
+
+
+
+
+
+/**
+ * PresetLibrary class representing named presets stored as "<name>.preset" files in a directory.
+ *
+ * Loaded presets stay mapped, so applying a preset a second time does not touch the file system.
+ */
+class PresetLibrary
+{
+public:
+	/// ------------- Constructor -------------
+	/// \{
+	explicit PresetLibrary(const std::string &_directory); // Uses (and creates when saving) 'directory'
+														   /// \}
+
+
+	/// ------------- Named Presets -------------
+	/// \{
+	bool save(const std::string &name, TableManager &tableManager); // Captures the tree and stores it under 'name'
+	std::size_t apply(const std::string &name, TableManager &tableManager, PresetFilter filter = nullptr); // Applies the preset stored under 'name', returns how many widgets were set
+	const Preset *get(const std::string &name); // The preset stored under 'name', mapped on first use, nullptr if there is none
+	std::vector<std::string> names() const; // The names of the stored presets, sorted
+	std::string pathOf(const std::string &name) const; // The file of a named preset
+													   /// \}
+
+
+private:
+	std::string directory; // Where the preset files live
+	std::map<std::string, std::unique_ptr<Preset>> cache; // Mapped presets by name
+};
@@ -0,0 +1,339 @@
+//  InterfaceScheduler.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "InterfaceScheduler.hpp"
+
+
+
+
+
+
+/**
+ * TaskScheduler
+ * Constructor that initializes an empty wheel anchored at the current time.
+ */
+TaskScheduler::TaskScheduler() : wheel(WHEEL_SLOTS)
+{
+	currentTick = ofGetElapsedTimeMicros() / TICK_MICROS;
+}
+
+
+/**
+ * global
+ * Returns the scheduler shared by every widget.
+ */
+TaskScheduler &TaskScheduler::global()
+{
+	static TaskScheduler scheduler;
+	return scheduler;
+}
+
+
+
+
+TaskHandle TaskScheduler::makeHandle(uint32_t index, uint32_t generation)
+{
+	return (static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(index) + 1); // +1 so that 0 is never a valid handle
+}
+
+
+uint64_t TaskScheduler::secondsToTicks(double seconds)
+{
+	return static_cast<uint64_t>(std::max(0.0, seconds) * 1e6 / TICK_MICROS + 0.5);
+}
+
+
+/**
+ * allocate
+ * Claims a task record for a new task, reusing a released record when one is available.
+ *
+ * @param task: The work the task performs
+ * @return TaskHandle: The handle of the new task
+ */
+TaskHandle TaskScheduler::allocate(std::function<void()> task)
+{
+	uint32_t index;
+	if (!freeTasks.empty())
+	{
+		index = freeTasks.back();
+		freeTasks.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(tasks.size());
+		tasks.emplace_back();
+	}
+
+	Task &record = tasks[index];
+	record.function = std::move(task);
+	record.active = true;
+	record.periodic = false;
+	record.everyUpdate = false;
+	record.intervalTicks = 0;
+	record.deadlineTick = currentTick;
+	active++;
+	return makeHandle(index, record.generation);
+}
+
+
+/**
+ * release
+ * Invalidates a task's handles and returns its record to the free list. A task that releases
+ * itself while running keeps its record until it returns, so its function is never overwritten
+ * while it executes.
+ *
+ * @param index: The index of the task record
+ */
+void TaskScheduler::release(uint32_t index)
+{
+	Task &record = tasks[index];
+	record.active = false;
+	record.generation++;
+	active--;
+
+	if (index == runningTask)
+	{
+		runningTaskReleased = true;
+	}
+	else
+	{
+		record.function = nullptr;
+		freeTasks.push_back(index);
+	}
+}
+
+
+void TaskScheduler::insert(uint32_t index)
+{
+	const Task &record = tasks[index];
+	wheel[record.deadlineTick & (WHEEL_SLOTS - 1)].push_back({index, record.generation});
+}
+
+
+bool TaskScheduler::valid(const SlotEntry &entry) const
+{
+	const Task &record = tasks[entry.index];
+	return record.active && record.generation == entry.generation;
+}
+
+
+
+
+/**
+ * schedulePeriodic
+ * Registers a task that runs at a fixed rate until cancelled. The first run happens one period from now.
+ *
+ * @param task: The work to run
+ * @param rateHz: Invocations per second; 0 runs the task on every update
+ * @return TaskHandle: The handle used to cancel the task
+ */
+TaskHandle TaskScheduler::schedulePeriodic(std::function<void()> task, double rateHz)
+{
+	if (rateHz <= 0)
+	{
+		return scheduleEveryUpdate(std::move(task));
+	}
+
+	TaskHandle handle = allocate(std::move(task));
+	uint32_t index = static_cast<uint32_t>((handle & 0xFFFFFFFFull) - 1);
+	Task &record = tasks[index];
+	record.periodic = true;
+	record.intervalTicks = std::max<uint64_t>(1, secondsToTicks(1.0 / rateHz));
+	record.deadlineTick = currentTick + record.intervalTicks;
+	insert(index);
+	return handle;
+}
+
+
+/**
+ * scheduleEveryUpdate
+ * Registers a task that runs once per update until cancelled, for work that has to happen every
+ * frame such as a toggle callback that draws an overlay.
+ *
+ * @param task: The work to run
+ * @return TaskHandle: The handle used to cancel the task
+ */
+TaskHandle TaskScheduler::scheduleEveryUpdate(std::function<void()> task)
+{
+	TaskHandle handle = allocate(std::move(task));
+	uint32_t index = static_cast<uint32_t>((handle & 0xFFFFFFFFull) - 1);
+	tasks[index].everyUpdate = true;
+	everyUpdateTasks.push_back({index, tasks[index].generation});
+	return handle;
+}
+
+
+/**
+ * scheduleOnce
+ * Registers a task that runs a single time after a delay, then releases itself.
+ *
+ * @param task: The work to run
+ * @param delaySeconds: The delay before the task runs; 0 runs it on the next update
+ * @return TaskHandle: The handle used to cancel the task before it runs
+ */
+TaskHandle TaskScheduler::scheduleOnce(std::function<void()> task, double delaySeconds)
+{
+	TaskHandle handle = allocate(std::move(task));
+	uint32_t index = static_cast<uint32_t>((handle & 0xFFFFFFFFull) - 1);
+	tasks[index].deadlineTick = currentTick + std::max<uint64_t>(1, secondsToTicks(delaySeconds));
+	insert(index);
+	return handle;
+}
+
+
+/**
+ * cancel
+ * Removes a task. The entry left behind in its wheel slot is skipped and dropped the next time
+ * the slot is visited.
+ *
+ * @param handle: The handle returned when the task was scheduled
+ */
+void TaskScheduler::cancel(TaskHandle handle)
+{
+	if (isScheduled(handle))
+	{
+		release(static_cast<uint32_t>((handle & 0xFFFFFFFFull) - 1));
+	}
+}
+
+
+bool TaskScheduler::isScheduled(TaskHandle handle) const
+{
+	if (handle == 0)
+	{
+		return false;
+	}
+	uint64_t index = (handle & 0xFFFFFFFFull) - 1;
+	return index < tasks.size() && valid({static_cast<uint32_t>(index), static_cast<uint32_t>(handle >> 32)});
+}
+
+
+
+
+void TaskScheduler::update()
+{
+	update(ofGetElapsedTimeMicros());
+}
+
+
+/**
+ * update
+ * Runs the per-update tasks, then advances the wheel to the given time, running every task whose
+ * deadline has passed. Only the slots of elapsed ticks are visited; if more than a full revolution
+ * has elapsed every slot is visited exactly once. Periodic tasks that fell behind run once and are
+ * re-armed relative to now rather than replaying every missed period.
+ *
+ * @param nowMicros: The current time, from ofGetElapsedTimeMicros()
+ */
+void TaskScheduler::update(uint64_t nowMicros)
+{
+	/// Step 1: Run the per-update tasks, dropping the ones cancelled since the last update
+	std::size_t perUpdateCount = everyUpdateTasks.size(); // Tasks added while running wait for the next update
+	for (std::size_t i = 0; i < perUpdateCount; i++)
+	{
+		SlotEntry entry = everyUpdateTasks[i];
+		if (valid(entry))
+		{
+			runningTask = entry.index;
+			tasks[entry.index].function();
+			invocations++;
+			finishRunning();
+		}
+	}
+	everyUpdateTasks.erase(std::remove_if(everyUpdateTasks.begin(), everyUpdateTasks.end(), [this](const SlotEntry &entry) { return !valid(entry); }), everyUpdateTasks.end());
+
+
+	/// Step 2: Determine which ticks elapsed since the last update
+	uint64_t nowTick = nowMicros / TICK_MICROS;
+	if (nowTick <= currentTick)
+	{
+		return;
+	}
+	uint64_t firstTick = currentTick + 1;
+	if (nowTick - currentTick > WHEEL_SLOTS)
+	{
+		firstTick = nowTick - WHEEL_SLOTS + 1; // Every slot is visited once
+	}
+	currentTick = nowTick; // Tasks scheduled from within a task are placed relative to now
+
+
+	/// Step 3: Visit the slot of every elapsed tick
+	for (uint64_t tick = firstTick; tick <= nowTick; tick++)
+	{
+		std::vector<SlotEntry> &slot = wheel[tick & (WHEEL_SLOTS - 1)];
+		if (slot.empty())
+		{
+			continue;
+		}
+		dueScratch.swap(slot); // Tasks re-armed into this slot while it is processed land in the (now empty) slot
+
+
+		for (const SlotEntry &entry : dueScratch)
+		{
+			if (!valid(entry))
+			{
+				continue; // Cancelled, drop the stale entry
+			}
+
+			Task &record = tasks[entry.index];
+			if (record.deadlineTick > nowTick)
+			{
+				wheel[record.deadlineTick & (WHEEL_SLOTS - 1)].push_back(entry); // Due in a later revolution
+				continue;
+			}
+
+
+			/// Run the task, then re-arm or release it
+			runningTask = entry.index;
+			record.function();
+			invocations++;
+
+			if (!runningTaskReleased) // The task may have cancelled itself
+			{
+				if (record.periodic)
+				{
+					record.deadlineTick = std::max(record.deadlineTick + record.intervalTicks, nowTick + 1);
+					insert(entry.index);
+				}
+				else
+				{
+					release(entry.index);
+				}
+			}
+			finishRunning();
+		}
+		dueScratch.clear();
+	}
+}
+
+
+/**
+ * finishRunning
+ * Completes a deferred release of the task that just ran, if it cancelled itself.
+ */
+void TaskScheduler::finishRunning()
+{
+	if (runningTaskReleased)
+	{
+		tasks[runningTask].function = nullptr;
+		freeTasks.push_back(runningTask);
+	}
+	runningTask = NO_TASK;
+	runningTaskReleased = false;
+}
+
+
+
+
+std::size_t TaskScheduler::activeTasks() const
+{
+	return active;
+}
+
+
+uint64_t TaskScheduler::tasksRun() const
+{
+	return invocations;
+}
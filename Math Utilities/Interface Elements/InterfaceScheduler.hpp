@@ -0,0 +1,125 @@
+//  InterfaceScheduler.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Interface Scheduler header file declares the TaskScheduler, a hashed timer wheel that runs
+ * widget tasks only when they are due.
+ *
+ * It replaces per-frame polling (every Toggle asked "are you on?" every frame) with registration:
+ *  - Periodic tasks run at an explicit rate (e.g. a diagnostics recompute at 4 Hz).
+ *  - Per-frame tasks run once per scheduler update, for callbacks that must draw every frame.
+ *  - One-shot tasks run once after a delay, e.g. for edge-triggered reactions.
+ *
+ * Only registered tasks are ever visited, so an idle (off) toggle costs nothing. The scheduler is
+ * advanced by TableManager::draw, so tasks keep running inside the draw context as toggle callbacks
+ * always have; applications that draw widgets without a TableManager call update() themselves.
+ */
+
+
+#pragma once
+#include "ofMain.h"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <vector>
+
+
+
+
+
+
+/// Identifies a scheduled task; 0 is never a valid handle.
+using TaskHandle = uint64_t;
+
+
+
+
+/**
+ * TaskScheduler class representing a hashed timer wheel of widget tasks.
+ *
+ * Time is divided into ticks of TICK_MICROS; a task due at tick t lives in slot (t mod WHEEL_SLOTS).
+ * Advancing the wheel only visits the slots of the ticks that elapsed since the last update, and
+ * within them only the tasks that were registered there. Deadlines further away than one revolution
+ * simply stay in their slot until their tick comes around.
+ */
+class TaskScheduler
+{
+public:
+	/// ------------- Access -------------
+	/// \{
+	static TaskScheduler &global(); // The scheduler shared by all widgets
+									/// \}
+
+
+	/// ------------- Registration -------------
+	/// \{
+	TaskHandle schedulePeriodic(std::function<void()> task, double rateHz); // Runs 'task' at 'rateHz' until cancelled; a rate of 0 runs it every update
+	TaskHandle scheduleEveryUpdate(std::function<void()> task); // Runs 'task' once per update until cancelled
+	TaskHandle scheduleOnce(std::function<void()> task, double delaySeconds); // Runs 'task' once, 'delaySeconds' from now
+	void cancel(TaskHandle handle); // Removes a task, stale or unknown handles are ignored
+	bool isScheduled(TaskHandle handle) const; // Whether a handle still refers to a pending task
+											   /// \}
+
+
+	/// ------------- Execution -------------
+	/// \{
+	void update(); // Runs every task that is due at the current time
+	void update(uint64_t nowMicros); // Runs every task that is due at the given time
+									 /// \}
+
+
+	/// ------------- Queries -------------
+	/// \{
+	std::size_t activeTasks() const; // Number of pending tasks
+	uint64_t tasksRun() const; // Number of task invocations since construction
+							   /// \}
+
+
+	/// ------------- Scheduler Attributes -------------
+	/// \{
+	static const uint64_t TICK_MICROS = 1000; // Resolution of the wheel, 1 ms
+	static const std::size_t WHEEL_SLOTS = 512; // Slots per revolution (power of two), ~0.5 s per revolution
+
+private:
+	TaskScheduler();
+
+	/// A registered task and its timing.
+	struct Task
+	{
+		std::function<void()> function; // The work to run
+		uint64_t intervalTicks = 0; // Period in ticks, 0 for one-shot and per-update tasks
+		uint64_t deadlineTick = 0; // Tick at which the task is next due
+		uint32_t generation = 0; // Incremented every time the slot is released, invalidates old handles
+		bool active = false; // Whether the task is pending
+		bool periodic = false; // Whether the task is re-armed after it runs
+		bool everyUpdate = false; // Whether the task runs on every update instead of living in the wheel
+	};
+
+	/// A reference to a task stored in a wheel slot, carrying the generation it was scheduled with.
+	struct SlotEntry
+	{
+		uint32_t index;
+		uint32_t generation;
+	};
+
+	TaskHandle allocate(std::function<void()> task); // Claims a task record, reusing released ones
+	void release(uint32_t index); // Returns a task record to the free list
+	void insert(uint32_t index); // Places a task in the slot of its deadline
+	bool valid(const SlotEntry &entry) const; // Whether a slot entry still refers to the task it was created for
+	void finishRunning(); // Completes a deferred release of the task that just ran
+	static TaskHandle makeHandle(uint32_t index, uint32_t generation);
+	static uint64_t secondsToTicks(double seconds);
+
+	std::deque<Task> tasks; // Task records, a deque so running tasks are not moved when new ones are added
+	std::vector<uint32_t> freeTasks; // Indices of released task records
+	std::vector<std::vector<SlotEntry>> wheel; // The timer wheel slots
+	std::vector<SlotEntry> everyUpdateTasks; // Tasks run on every update
+	std::vector<SlotEntry> dueScratch; // Reused buffer of the slot being processed, avoids allocating per update
+	uint64_t currentTick; // The last tick that was processed
+	std::size_t active = 0; // Number of pending tasks
+	uint64_t invocations = 0; // Number of task invocations
+	static const uint32_t NO_TASK = 0xFFFFFFFFu; // Marker for 'no task is running'
+	uint32_t runningTask = NO_TASK; // The task currently executing, its record must not be reused until it returns
+	bool runningTaskReleased = false; // Whether the running task was cancelled while executing
+							  /// \}
+};
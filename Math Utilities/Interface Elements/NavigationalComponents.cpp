@@ -4,98 +4,26 @@
 
 
 #include "NavigationalComponents.hpp"
+#include "InterfaceDiagnostics.hpp"
 
 
 
 
 
 
-/**
- * Slider
- *
- * Default constructor for the Slider class.
- * Initializes the slider with no label, default position, size, and range.
- */
-Slider::Slider()
-{
-	/// Set default values
-	label = ""; // Set the label as an empty string
-	rect = ofRectangle(); //  Initialize the rectangle representing the slider's position and size
-	min = 0;
-	max = 0;
-	value = 0;
-}
-
-
-/**
- * Slider
- *
- * Constructor for the Slider class. Initializes the slider with a label, specific position, size, and range.
- *
- * @param _label: The label for the slider
- * @param _x: The x-coordinate of the slider's position
- * @param _y: The y-coordinate of the slider's position
- * @param _w: The width of the slider
- * @param _h: The height of the slider
- * @param _min: The minimum value of the slider
- * @param _max: The maximum value of the slider
- * @param _value: The initial value of the slider
- * @return None
- */
-Slider::Slider(std::string _label, float _x, float _y, float _w, float _h, float _min, float _max, float &_value)
-{
-	/// Assign the label, minimum value, maximum value, and current value of the slider
-	label = _label;
-	min = _min;
-	max = _max;
-	value = &_value;
-	
-	/// Set the position and size of the slider
-	rect.set(_x, _y, _w, _h);
-}
-
-
-/**
- * Slider
- *
- * Constructor for the Slider class. Initializes the slider with a label, specific position,
- * size, range, and precision of the value displayed in the Slider object.
- *
- * @param _label: The label for the slider
- * @param _x: The x-coordinate of the slider's position
- * @param _y: The y-coordinate of the slider's position
- * @param _w: The width of the slider
- * @param _h: The height of the slider
- * @param _min: The minimum value of the slider
- * @param _max: The maximum value of the slider
- * @param _value: The initial value of the slider
- * @param _precision: precision needed to fully capture the value displayed in the Slider object
- */
-Slider::Slider(std::string _label, float _x, float _y, float _w, float _h, float _min, float _max, float &_value, int _precision)
-{
-	label = _label;
-	rect.set(_x, _y, _w, _h);
-	min = _min;
-	max = _max;
-	value = &_value;
-	precision = _precision;
-}
-
-
 /**
  * setPosition
  * Sets the position of the slider while keeping the same width and height.
  *
  * @param rectPos: The new position of the slider
  */
-void Slider::setPosition(ofVec2f rectPos)
+void SliderElement::setPosition(ofVec2f rectPos)
 {
 	// Set the new position of the slider
 	rect.set(rectPos.x, rectPos.y, rect.width, rect.height);
 }
 
 
-
 /**
  * draw
  *
@@ -106,7 +34,7 @@ void Slider::setPosition(ofVec2f rectPos)
  * current value. Finally, it displays a textual label to convey both the
  * slider’s name and numeric value, providing users with visual feedback.
  */
-void Slider::draw()
+void SliderElement::draw()
 {
 	/// Step 1: Draw the outline of the slider
 	ofNoFill();
@@ -115,7 +43,7 @@ void Slider::draw()
 	
 	
 	/// Step 2: Map the current slider value to a screen position
-	float x = ofMap(*value, min, max, rect.x, rect.x + rect.width); // Calculate the x-coordinate of the filled rectangle inside the slider rectangle
+	float x = rect.x + ofClamp(getSliderPosition(), 0, 1) * rect.width; // Calculate the x-coordinate of the filled rectangle inside the slider rectangle, through the slider's mapping
 	
 	
 	/// Step 3: Draw the filled portion of the slider rectangle
@@ -126,7 +54,7 @@ void Slider::draw()
 	
 	/// Step 4: Show the label and current numeric value
 	ofSetColor(255, 255, 255); // Switch the color to white
-	ofDrawBitmapString(label + ": " + ofToString(*value, 3), rect.x + rect.width + 10, rect.y + rect.height * 0.5); // Render the label and the current value of the slider text to the right of the slider’s bounding rectangle
+	ofDrawBitmapString(label + ": " + valueText(), rect.x + rect.width + 10, rect.y + rect.height * 0.5); // Render the label and the current value of the slider text to the right of the slider’s bounding rectangle
 }
 
 
@@ -140,7 +68,7 @@ void Slider::draw()
  * @param y: The y-coordinate of the mouse press
  * @param button: The mouse button that was pressed
  */
-void Slider::mousePressed(int x, int y, int button)
+void SliderElement::mousePressed(int x, int y, int button)
 {
 	/// Check if the mouse press was inside the slider rectangle
 	if (rect.inside(x, y))
@@ -165,16 +93,14 @@ void Slider::mousePressed(int x, int y, int button)
  * @param y: The y-coordinate of the mouse drag
  * @param button: The mouse button that is being dragged
  */
-void Slider::mouseDragged(int x, int y, int button)
+void SliderElement::mouseDragged(int x, int y, int button)
 {
 	/// Check if the mouse is being dragged and isDragging is true
 	if (isDragging)
 	{
-		/// If the mouse is being dragged and isDragging is true, calculate the new value of the slider
-		float newValue = ofMap(x, rect.x, (rect.x + rect.width), min, max, true);
-		
-		/// Update the value of the slider
-		*value = newValue;
+		/// If the mouse is being dragged and isDragging is true, find the position along the slider and update the value found there
+		setSliderPosition(ofMap(x, rect.x, (rect.x + rect.width), 0, 1, true));
+		LatencyMonitor::global().record("Slider", label); // Record how long the drag took to reach the bound value
 		
 	}
 }
@@ -188,7 +114,7 @@ void Slider::mouseDragged(int x, int y, int button)
  * @param y: The y-coordinate of the mouse release
  * @param button: The mouse button that was released
  */
-void Slider::mouseReleased(int x, int y, int button)
+void SliderElement::mouseReleased(int x, int y, int button)
 {
 	/// Whenever the mouse is released, set isDragging to false
 	isDragging = false;
@@ -216,6 +142,9 @@ void Slider::mouseReleased(int x, int y, int button)
  */
 Table::~Table()
 {
+	/// Stop the unfold animation, it writes to 'openAmount'
+	Animator::global().cancel(openAnimation);
+	
 	/// Call the clear function to clear all the elements in the table
 	clear();
 }
@@ -238,6 +167,8 @@ Table::Table(std::string _label, float _x, float _y, float _w, float _h, bool _i
 	/// Assign the label, opened state, and type of the table
 	label = _label;
 	isOpened = _isOpened;
+	openAmount = isOpened ? 1 : 0;
+	animatedOpenState = isOpened;
 	
 	
 	/// Initialize the rectangle
@@ -269,6 +200,8 @@ Table::Table(std::string _label, float _x, float _y, float _w, float _h, bool _i
 	/// Assign the label, opened state, and type of the table
 	label = _label;
 	isOpened = _isOpened;
+	openAmount = isOpened ? 1 : 0;
+	animatedOpenState = isOpened;
 	
 	
 	
@@ -304,7 +237,7 @@ Table::Table(std::string _label, float _x, float _y, float _w, float _h, bool _i
  * @param _sliderElement: A pointer to the slider element to be added
  * @return void
  */
-void Table::addSliderElement(Slider* &_sliderElement)
+void Table::addSliderElement(SliderElement *_sliderElement)
 {
 	/// Add the slider element to the list of slider elements
 	sliderElements.emplace_back(_sliderElement);
@@ -562,15 +495,37 @@ void Table::setPosition(ofVec2f rectPos)
 	layoutElements();
 }
 
+
+/**
+ * syncOpenAnimation
+ * Keeps the unfold animation in step with 'isOpened', which is toggled by the tab and assigned directly by
+ * the TableManager. When the state changed, 'openAmount' is tweened towards it, taking a fraction of
+ * UNFOLD_SECONDS proportional to the distance left so that reversing halfway does not restart the motion.
+ *
+ * @return void
+ */
+void Table::syncOpenAnimation()
+{
+	if (isOpened == animatedOpenState)
+	{
+		return;
+	}
+	animatedOpenState = isOpened;
+	
+	Animator &animator = Animator::global();
+	animator.cancel(openAnimation);
+	float target = isOpened ? 1 : 0;
+	openAnimation = animator.tween(&openAmount, target, UNFOLD_SECONDS * std::abs(target - openAmount), isOpened ? Easing::EaseOutQuad : Easing::EaseInOutCubic);
+}
+
 /**
  * callbackUpdate
  *
- * The callbackUpdate function triggers complementary or required state updates
- * on all toggles contained within this Table instance. Specifically, if there
- * are toggles present, each toggle is prompted to run its own callbackUpdate.
- * This ensures that changes in toggle states are signaled or processed
- * appropriately, perhaps reacting to user input or system events that
- * necessitate these toggles’ internal logic refreshes.
+ * The callbackUpdate function re-synchronizes the scheduled callback tasks of
+ * all toggles contained within this Table instance. Toggle callbacks are run by
+ * the TaskScheduler while a toggle is on, so this is no longer needed every
+ * frame; it is only useful after toggle states were changed directly, without
+ * going through Toggle::setOn.
  *
  * @return void
  */
@@ -605,6 +560,9 @@ void Table::callbackUpdate()
  * toggles, tooltips within the Table accordingly. The final layout logic adapts to screen quadrants, ensuring
  * the table elements unfold in a suitable direction without clutter.
  *
+ * Opening and closing are animated: 'openAmount' is tweened by the Animator, and while the table unfolds
+ * or folds only the revealed part of the backdrop and the elements inside it are drawn.
+ *
  * @return void
  */
 void Table::draw()
@@ -623,8 +581,9 @@ void Table::draw()
 	// Draw the visual tab associated with the Table
 	tableTab.draw();
 	
-	/// Step 2: Check if this table is currently open
-	if (isOpened)
+	/// Step 2: Check if this table is currently open, or still folding closed
+	syncOpenAnimation();
+	if (isOpened || openAmount > 0)
 	{
 		/// Calculate the dimensions of the table
 		ofVec2f tableBounds = tableElementsDimensions(); // Gather spatial bounds from all contained elements
@@ -670,7 +629,7 @@ void Table::draw()
 		/// Step 2c: Draw the background rectangle for the opened table rectangle
 		ofFill();
 		ofSetColor(255, 255, 255, 18.75); // Very light fill for the table’s backdrop
-		ofDrawRectangle(openedTableX, openedTableY - tableTab.rect.height, openedTableWidth * 1.25 , openedTableHeight * 1.05); // Draw a slightly scaled rectangle
+		ofDrawRectangle(openedTableX, openedTableY - tableTab.rect.height, openedTableWidth * 1.25 , openedTableHeight * 1.05 * openAmount); // Draw a slightly scaled rectangle, unfolded as far as the animation has got
 		ofNoFill();
 		
 		
@@ -678,6 +637,8 @@ void Table::draw()
 		// Compute available vertical space for each element(the y position and height of the table elements)
 		float elementHeight = openedTableHeight / (sliderElements.size() + buttonElements.size() + toggleElements.size());
 		float yPos = openedTableY;
+		// While unfolding or folding, only the elements within the unfolded part of the backdrop are drawn
+		float revealedBottom = openedTableY - tableTab.rect.height + openedTableHeight * 1.05 * openAmount;
 		
 		
 		
@@ -686,7 +647,10 @@ void Table::draw()
 		{
 			// Shift the slider’s position just right of the table tab
 			slider->setPosition(ofVec2f(openedTableX + tableTab.rect.width, yPos));
-			slider->draw();
+			if (yPos <= revealedBottom)
+			{
+				slider->draw();
+			}
 			yPos += elementHeight;
 		}
 		yPos += 5; 		// Slight padding after sliders
@@ -698,7 +662,10 @@ void Table::draw()
 		for (auto& textField : textfieldElements)
 		{
 			textField->setPosition(ofVec2f(openedTableX + tableTab.rect.width, yPos));
-			textField->draw();
+			if (yPos <= revealedBottom)
+			{
+				textField->draw();
+			}
 			yPos += elementHeight+35;
 		}
 		
@@ -707,7 +674,10 @@ void Table::draw()
 		for (auto& button : buttonElements)
 		{
 			button->setPosition(ofVec2f(openedTableX + tableTab.rect.width, yPos ));
-			button->draw();
+			if (yPos <= revealedBottom)
+			{
+				button->draw();
+			}
 			yPos += elementHeight;
 		}
 		
@@ -733,14 +703,21 @@ void Table::draw()
 			{
 				toggle->setPosition(ofVec2f(openedTableX + tableTab.rect.width, yPos ));
 			}
-			toggle->draw();
+			if (toggle->rect.y <= revealedBottom)
+			{
+				toggle->draw();
+			}
 			yPos += elementHeight;
 		}
 		
 		
-		/// Step 2d-v: Draw any tooltip elements, if present
+		/// Step 2d-v: Draw any tooltip elements, if present, once the table is fully unfolded
 		for (auto& toolTip : toolTipElements)
 		{
+			if (openAmount < 1)
+			{
+				break;
+			}
 			//toolTip->setPosition(openedTableX + tableTab.rect.width, yPos);
 			toolTip->draw();
 			//yPos += elementHeight;
@@ -1029,6 +1006,88 @@ TableManager::~TableManager()
 }
 
 
+/**
+ * update
+ *
+ * Hands the simulation parameters edited through the UI to the simulation at a step boundary. The
+ * latest snapshot published by the global ParameterStore is read without locking, and only the
+ * parameters that changed since the previous update are visited (in O(changed), using the snapshot's
+ * change versions). Of those, the parameters registered as "theta", "G", "e" and "dt" are copied into
+ * the given variables; the others are recorded in 'changedParameters', so the caller can tell e.g.
+ * whether anything that requires a tree rebuild moved via parameterChanged(). Variables whose parameter
+ * is not registered or did not change are left untouched. The four handles are looked up by name only
+ * when a snapshot holds parameters that were not registered at the last lookup, so an update otherwise
+ * touches nothing but its own snapshot.
+ *
+ * @param theta: The Barnes-Hut opening angle
+ * @param G: The gravitational constant
+ * @param e: The softening length
+ * @param dt: The time step
+ * @return void
+ */
+void TableManager::update(float &theta, double &G, float &e, float &dt)
+{
+	/// Step 1: Pick up the latest published parameters, nothing to do if none were published since the last update
+	ParameterStore &store = ParameterStore::global();
+	changedParameters.clear();
+	if (!store.readIfNewer(simulationParameters))
+	{
+		return;
+	}
+	
+	
+	/// Step 2: Collect the parameters that changed since the previous update
+	simulationParameters.forEachChangedSince(lastParameterChange, [this](uint32_t index) { changedParameters.push_back(index); });
+	uint64_t previousChange = lastParameterChange;
+	lastParameterChange = simulationParameters.changeVersion();
+	if (changedParameters.empty())
+	{
+		return;
+	}
+	
+	
+	/// Step 3: Copy the changed values of the parameters the caller asked for, resolving their handles once new parameters are registered
+	if (simulationParameters.size() != resolvedParameterCount)
+	{
+		thetaParameter = store.find<float>("theta");
+		eParameter = store.find<float>("e");
+		dtParameter = store.find<float>("dt");
+		gParameter = store.find<double>("G");
+		resolvedParameterCount = simulationParameters.size();
+	}
+	if (thetaParameter.valid() && simulationParameters.changedSince(thetaParameter, previousChange))
+	{
+		theta = simulationParameters.get(thetaParameter);
+	}
+	if (gParameter.valid() && simulationParameters.changedSince(gParameter, previousChange))
+	{
+		G = simulationParameters.get(gParameter);
+	}
+	if (eParameter.valid() && simulationParameters.changedSince(eParameter, previousChange))
+	{
+		e = simulationParameters.get(eParameter);
+	}
+	if (dtParameter.valid() && simulationParameters.changedSince(dtParameter, previousChange))
+	{
+		dt = simulationParameters.get(dtParameter);
+	}
+}
+
+
+/**
+ * parameterChanged
+ * Returns whether the named parameter was among the parameters that changed in the last update.
+ *
+ * @param name: The name the parameter was registered with
+ * @return bool: true if the parameter changed
+ */
+bool TableManager::parameterChanged(const std::string &name) const
+{
+	int index = ParameterStore::global().indexOf(name);
+	return index >= 0 && std::find(changedParameters.begin(), changedParameters.end(), static_cast<uint32_t>(index)) != changedParameters.end();
+}
+
+
 /**
  * setPosition
  *
@@ -1084,8 +1143,8 @@ void TableManager::setPosition(ofVec2f rectPos) //adjust position and size of en
  *
  * The draw function manages the rendering of the TableManager’s label and
  * the relevant tables it holds. It begins by drawing the manager’s label
- * at a designated position. Next, it calls each table’s callbackUpdate
- * before deciding how to render the visual layout based on whether the
+ * at a designated position. Next, it advances the TaskScheduler, running the
+ * callbacks of any toggles that are on and due, before deciding how to render the visual layout based on whether the
  * table manager is in an opened or closed state. If opened, a semi-transparent
  * rectangle is drawn behind all tables, which are then individually rendered.
  * If closed, a minimal bounding box with cross lines is displayed instead.
@@ -1102,14 +1161,9 @@ void TableManager::draw()
 	ofDrawBitmapString(label, labelRect.x, labelRect.y); // Draw the label string at the coordinates of the label rectangle
 	
 	
-	/// Step 2: Update each table’s state before rendering all tables in TableManager
-	if (!tables.empty())
-	{
-		for (auto& table : tables)
-		{
-			table->callbackUpdate(); // Update callbacks for each table
-		}
-	}
+	/// Step 2: Run the widget tasks that are due before rendering all tables in TableManager
+	// Toggles register their callbacks with the TaskScheduler, so only toggles that are on are visited
+	TaskScheduler::global().update();
 	
 	
 	
@@ -1303,6 +1357,8 @@ void TableManager::clear()
 
 void TableManager::keyReleased(int key)
 {
+	ScopedInputEvent inputEvent; // Stamp the event as it enters the UI, for latency measurements
+	
 	if (!tables.empty())
 	{
 		for (auto& table : tables)
@@ -1317,6 +1373,8 @@ void TableManager::keyReleased(int key)
 
 void TableManager::mousePressed(int x, int y, int button)
 {
+	ScopedInputEvent inputEvent; // Stamp the event as it enters the UI, for latency measurements
+	
 	if (rect.inside(x, y))
 	{
 		isOpened = !isOpened;
@@ -1337,6 +1395,8 @@ void TableManager::mousePressed(int x, int y, int button)
 
 void TableManager::mouseDragged(int x, int y, int button)
 {
+	ScopedInputEvent inputEvent; // Stamp the event as it enters the UI, for latency measurements
+	
 	if (!tables.empty())
 	{
 		for (auto& table : tables)
@@ -1351,6 +1411,8 @@ void TableManager::mouseDragged(int x, int y, int button)
 
 void TableManager::mouseReleased(int x, int y, int button)
 {
+	ScopedInputEvent inputEvent; // Stamp the event as it enters the UI, for latency measurements
+	
 	if (!tables.empty())
 	{
 		for (auto& table : tables)
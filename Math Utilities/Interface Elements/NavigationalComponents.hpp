@@ -6,7 +6,7 @@
  * for an OpenFrameworks-based interface.
  *
  * These components include:
- *   - Slider: A basic GUI slider with interactive mouse handling and configurable range/precision.
+ *   - BasicSlider / Slider: A GUI slider over a float, double or int64_t value with a linear, log10 or power mapping, interactive mouse handling and configurable range/precision.
  *   - Table: A container organizing multiple elements (sliders, buttons, toggles, text fields, etc.).(WIP,		7/8, ~87.5%, 	fully functional but slight auto-positioning issues)
  *   - TableManager: Manages multiple tables, orchestrating their positions, interactions, and layout.(WIP,		4/5, ~80%, 		fully functional but bit more tricky auto-positionaing & aligning issues)
  *   - RectangularGridDragSelection: Allows the user to drag and define a square grid area with uniform cells.(WIP,		2/3, ~66%, 		mostly done with groundwork but needs to be significantly extended)
@@ -20,6 +20,10 @@
 #include "InputControls.hpp"
 #include "InformationalComponents.hpp"
 #include "DrawingUtilities.hpp"
+#include "InterfaceAnimation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 
 
 
@@ -27,22 +31,73 @@
 
 
 /**
- * Slider class representing a GUI slider.
+ * Slider mapping policies translating between a slider value and its position along the slider, 0 at
+ * the left end and 1 at the right end. Each provides static toPosition(value, min, max) and
+ * toValue(position, min, max).
  *
- * The Slider class represents a basic GUI slider with a label, position, size, and a range (min, max).
- * It provides functionalities for user interactions, including mouse pressed, dragged and released events.
- * The slider's attributes, such as the label, position, size, and range can be directly accessed and modified.
+ *   - LinearSliderMapping: Equal distances cover equal value differences.
+ *   - Log10SliderMapping: Equal distances cover equal ratios, for ranges spanning orders of magnitude
+ *     (e.g. G from 1e-11 to 1e4); requires 0 < min < max and falls back to linear otherwise.
+ *   - PowerSliderMapping<N, D>: value = min + (max - min) * position^(N/D), finer control near min for N/D > 1.
+ */
+struct LinearSliderMapping
+{
+	static double toPosition(double value, double min, double max) { return max != min ? (value - min) / (max - min) : 0; }
+	static double toValue(double position, double min, double max) { return min + position * (max - min); }
+};
+
+
+struct Log10SliderMapping
+{
+	static double toPosition(double value, double min, double max)
+	{
+		if (!(min > 0 && max > min))
+		{
+			return LinearSliderMapping::toPosition(value, min, max);
+		}
+		return (std::log10(std::max(value, min)) - std::log10(min)) / (std::log10(max) - std::log10(min));
+	}
+	static double toValue(double position, double min, double max)
+	{
+		if (!(min > 0 && max > min))
+		{
+			return LinearSliderMapping::toValue(position, min, max);
+		}
+		return std::pow(10.0, std::log10(min) + position * (std::log10(max) - std::log10(min)));
+	}
+};
+
+
+template<int Numerator, int Denominator = 1>
+struct PowerSliderMapping
+{
+	static_assert(Numerator > 0 && Denominator > 0, "The exponent of a power mapping must be positive");
+	static constexpr double exponent = static_cast<double>(Numerator) / Denominator;
+
+	static double toPosition(double value, double min, double max) { return std::pow(std::max(LinearSliderMapping::toPosition(value, min, max), 0.0), 1.0 / exponent); }
+	static double toValue(double position, double min, double max) { return LinearSliderMapping::toValue(std::pow(position, exponent), min, max); }
+};
+
+
+
+
+
+
+
+
+/**
+ * SliderElement class representing what every slider has in common, whatever its value type and mapping.
+ *
+ * It draws the slider and turns mouse drags into positions along it; BasicSlider supplies the value
+ * behind a position. Tables hold their sliders through this class.
  */
-class Slider
+class SliderElement
 {
 public:
-	/// ------------- Constructors -------------
+	/// ------------- Destructor -------------
 	/// \{
-	Slider(); // Basic constructor that initializes a slider with no label and default position, size, and range
-	Slider(std::string _label, float _x, float _y, float _w, float _h, float _min, float _max, float &_value); // Constructor that initializes a slider with a label, specific position, size, and range
-	Slider(std::string _label, float _x, float _y, float _w, float _h, float _min, float _max, float &_value, int _precision); // Constructor that initializes a slider with a label, specific position, size, range, and precision
-																															   /// \}
-	
+	virtual ~SliderElement() {}
+	/// \}
 	
 	
 	/// ------------- Setters and Upkeep -------------
@@ -51,6 +106,16 @@ public:
 									   /// \}
 	
 	
+	/// ------------- Value Access -------------
+	/// \{
+	virtual ParameterType valueType() const = 0; // The type of the value the slider edits
+	virtual double getValueAsDouble() const = 0; // The value, converted to double
+	virtual void setValueFromDouble(double newValue) = 0; // Sets the value from a double, rounding for integer sliders
+	virtual double getSliderPosition() const = 0; // Where the value lies along the slider, from 0 to 1
+	virtual void setSliderPosition(double position) = 0; // Sets the value found at a position along the slider
+	virtual std::string valueText() const = 0; // The value formatted for display
+											   /// \}
+	
 	
 	/// ------------- User Interaction -------------
 	/// \{
@@ -61,20 +126,73 @@ public:
 												  /// \}
 	
 	
-	
-	
 	/// ------------- Slider Attributes -------------
 	/// \{
-	float *value; // The current value of the slider
-	float min, max; // The minimum and maximum values of the slider
 	std::string label; // The label displayed on the slider
-	bool isDragging; // Indicates whether the slider is currently being dragged
+	bool isDragging = false; // Indicates whether the slider is currently being dragged
 	ofRectangle rect; // Represents the size and position of the slider
-	int precision;  // Integer to track the degree of precision needed to record and display value of object passed into slider. For example, gravitational constant, 'g', needs approximately 15 digits of precision
-					/// \}
+	int precision = 3;  // Integer to track the degree of precision needed to record and display value of object passed into slider. For example, gravitational constant, 'g', needs approximately 15 digits of precision
+						/// \}
+};
+
+
+
+
+
+
+
+
+/**
+ * BasicSlider class representing a GUI slider over a value of type T (float, double or int64_t), laid out
+ * along the slider according to a mapping policy.
+ *
+ * The BasicSlider class represents a basic GUI slider with a label, position, size, and a range (min, max).
+ * It provides functionalities for user interactions, including mouse pressed, dragged and released events.
+ * The slider's attributes, such as the label, position, size, and range can be directly accessed and modified.
+ * Slider is the float slider with a linear mapping.
+ */
+template<typename T, typename Mapping = LinearSliderMapping>
+class BasicSlider : public SliderElement
+{
+public:
+	/// ------------- Constructors -------------
+	/// \{
+	BasicSlider(); // Basic constructor that initializes a slider with no label and default position, size, and range
+	BasicSlider(std::string _label, float _x, float _y, float _w, float _h, T _min, T _max, T &_value); // Constructor that initializes a slider with a label, specific position, size, and range
+	BasicSlider(std::string _label, float _x, float _y, float _w, float _h, T _min, T _max, T &_value, int _precision); // Constructor that initializes a slider with a label, specific position, size, range, and precision
+	BasicSlider(std::string _label, float _x, float _y, float _w, float _h, ParameterHandle<T> _parameter, ParameterStore &_store = ParameterStore::global()); // Constructor that binds the slider to a parameter, taking its range from the store
+																															   /// \}
+	
+	
+	
+	/// ------------- Value Access -------------
+	/// \{
+	T getValue() const; // The bound value, read from the parameter store if bound to a parameter
+	void setValue(T newValue); // Writes the bound value, into the parameter store's back buffer if bound to a parameter
+	ParameterType valueType() const override { return ParameterTraits<T>::type; }
+	double getValueAsDouble() const override { return static_cast<double>(getValue()); }
+	void setValueFromDouble(double newValue) override;
+	double getSliderPosition() const override { return Mapping::toPosition(static_cast<double>(getValue()), static_cast<double>(min), static_cast<double>(max)); }
+	void setSliderPosition(double position) override { setValueFromDouble(Mapping::toValue(position, static_cast<double>(min), static_cast<double>(max))); }
+	std::string valueText() const override { return ofToString(getValue(), std::is_integral<T>::value ? 0 : precision); }
+	/// \}
+	
+	
+	
+	
+	/// ------------- Slider Attributes -------------
+	/// \{
+	T *value = nullptr; // The current value of the slider, nullptr when bound to a parameter
+	ParameterHandle<T> parameter; // The parameter controlled by the slider, if bound to one
+	ParameterStore *parameterStore = nullptr; // The store holding 'parameter'
+	T min = 0, max = 0; // The minimum and maximum values of the slider
+						/// \}
 };
 
 
+using Slider = BasicSlider<float>; // The float slider with a linear mapping
+
+
 
 
 
@@ -102,7 +220,7 @@ public:
 	
 	/// ------------- Element Addition -------------
 	/// \{
-	void addSliderElement(Slider* &_sliderElement); // Adds a slider element to the table
+	void addSliderElement(SliderElement *_sliderElement); // Adds a slider element (any BasicSlider) to the table
 	void addButtonElement(Button* &_buttonElement); // Adds a button element to the table
 	void addToggleElement(Toggle* &_toggleElement); // Adds a toggle element to the table
 	void addTextFieldElement(TextField* &_textFieldElement); // Adds a text field element to the table
@@ -117,6 +235,7 @@ public:
 	ofVec2f tableElementsDimensions(); // Returns the dimensions of the table
 	void layoutElements(); // Method to dynamically adjust the layout of elements within tableRect
 	void setPosition(ofVec2f rectPos); // Sets the position of the table
+	void syncOpenAnimation(); // Starts the unfold/fold animation when 'isOpened' changed
 									   /// \}
 	
 	
@@ -147,6 +266,10 @@ public:
 	ofRectangle tableRect; // The opaque rectangle that encloses the elements of the table
 	Tab tableTab; // The tab of the table
 	bool isOpened; // Indicates whether the table is open or not
+	float openAmount; // How far the table is unfolded, from 0 (closed) to 1 (open), animated towards 'isOpened'
+	bool animatedOpenState; // The state 'openAmount' is animating towards
+	AnimationHandle openAnimation = 0; // The running unfold/fold animation, if any
+	static constexpr double UNFOLD_SECONDS = 0.18; // Duration of a full unfold or fold
 	std::string label; // The label displayed on the table
 	ofRectangle labelRect; // The size of the bounding box enclosing the table element's name
 	/**
@@ -166,7 +289,7 @@ public:
 	
 	
 	/// Table Elements
-	std::vector<Slider*> sliderElements; // The slider elements in the table
+	std::vector<SliderElement*> sliderElements; // The slider elements in the table
 	std::vector<Button*> buttonElements; // The button elements in the table
 	std::vector<Toggle*> toggleElements; // The toggle elements in the table
 	std::vector<TextField*> textfieldElements; // The text field elements in the table
@@ -217,7 +340,8 @@ public:
 	
 	/// ------------- User Interaction -------------
 	/// \{
-	void update(float &theta, double &G, float &e, float &dt); // Updates the table manager
+	void update(float &theta, double &G, float &e, float &dt); // Copies the simulation parameters that changed since the last update into the given variables
+	bool parameterChanged(const std::string &name) const; // Whether a parameter changed in the last update
 	void draw(); // Draws the table manager on the screen
 	void exit(); // Handles the exit event
 	void clear(); // Clears all tables from the table manager
@@ -250,6 +374,14 @@ public:
 	std::string label; // The label of the table manager
 	ofTrueTypeFont labelFont, labelBodyFont; //fonts of table elements
 	ofRectangle labelRect; // The size of the bounding box enclosing the table manager's name
+	
+	/// Simulation parameters handed out by update()
+	ParameterSnapshot simulationParameters; // The parameters as of the last update
+	uint64_t lastParameterChange = 0; // The change version the previous update caught up to
+	std::vector<uint32_t> changedParameters; // Indices of the parameters that changed in the last update, reused between updates
+	ParameterHandle<float> thetaParameter, eParameter, dtParameter; // The handles of "theta", "e" and "dt", resolved by name only when new parameters appear
+	ParameterHandle<double> gParameter; // The handle of "G"
+	std::size_t resolvedParameterCount = 0; // The number of parameters the handles were resolved against
 						   /// \}
 };
 
@@ -433,3 +565,131 @@ public:
 	/// \}
 };
 
+
+
+
+
+
+
+
+/**
+ * BasicSlider
+ *
+ * Default constructor for the BasicSlider class.
+ * Initializes the slider with no label, default position, size, and range.
+ */
+template<typename T, typename Mapping>
+BasicSlider<T, Mapping>::BasicSlider()
+{
+}
+
+
+/**
+ * BasicSlider
+ *
+ * Constructor for the BasicSlider class. Initializes the slider with a label, specific position, size, and range.
+ *
+ * @param _label: The label for the slider
+ * @param _x: The x-coordinate of the slider's position
+ * @param _y: The y-coordinate of the slider's position
+ * @param _w: The width of the slider
+ * @param _h: The height of the slider
+ * @param _min: The minimum value of the slider
+ * @param _max: The maximum value of the slider
+ * @param _value: The initial value of the slider
+ */
+template<typename T, typename Mapping>
+BasicSlider<T, Mapping>::BasicSlider(std::string _label, float _x, float _y, float _w, float _h, T _min, T _max, T &_value)
+{
+	label = _label;
+	rect.set(_x, _y, _w, _h);
+	min = _min;
+	max = _max;
+	value = &_value;
+}
+
+
+/**
+ * BasicSlider
+ *
+ * Constructor for the BasicSlider class. Initializes the slider with a label, specific position,
+ * size, range, and precision of the value displayed in the slider.
+ *
+ * @param _label: The label for the slider
+ * @param _x: The x-coordinate of the slider's position
+ * @param _y: The y-coordinate of the slider's position
+ * @param _w: The width of the slider
+ * @param _h: The height of the slider
+ * @param _min: The minimum value of the slider
+ * @param _max: The maximum value of the slider
+ * @param _value: The initial value of the slider
+ * @param _precision: precision needed to fully capture the value displayed in the slider
+ */
+template<typename T, typename Mapping>
+BasicSlider<T, Mapping>::BasicSlider(std::string _label, float _x, float _y, float _w, float _h, T _min, T _max, T &_value, int _precision) : BasicSlider(_label, _x, _y, _w, _h, _min, _max, _value)
+{
+	precision = _precision;
+}
+
+
+/**
+ * BasicSlider
+ *
+ * Constructor for the BasicSlider class. Binds the slider to a parameter of a ParameterStore instead of a raw
+ * variable, so the value it edits reaches simulation threads through the store's published snapshots.
+ * The range of the slider is the range the parameter was registered with.
+ *
+ * @param _label: The label for the slider
+ * @param _x: The x-coordinate of the slider's position
+ * @param _y: The y-coordinate of the slider's position
+ * @param _w: The width of the slider
+ * @param _h: The height of the slider
+ * @param _parameter: The parameter controlled by the slider
+ * @param _store: The store holding the parameter
+ */
+template<typename T, typename Mapping>
+BasicSlider<T, Mapping>::BasicSlider(std::string _label, float _x, float _y, float _w, float _h, ParameterHandle<T> _parameter, ParameterStore &_store)
+{
+	label = _label;
+	rect.set(_x, _y, _w, _h);
+	parameter = _parameter;
+	parameterStore = &_store;
+	min = static_cast<T>(_store.info(_parameter.index).min);
+	max = static_cast<T>(_store.info(_parameter.index).max);
+}
+
+
+template<typename T, typename Mapping>
+T BasicSlider<T, Mapping>::getValue() const
+{
+	return parameterStore ? parameterStore->get(parameter) : *value;
+}
+
+
+template<typename T, typename Mapping>
+void BasicSlider<T, Mapping>::setValue(T newValue)
+{
+	if (parameterStore)
+	{
+		parameterStore->set(parameter, newValue);
+	}
+	else
+	{
+		*value = newValue;
+	}
+}
+
+
+/**
+ * setValueFromDouble
+ * Sets the value from a double, clamped to the slider's range and rounded to the nearest integer for
+ * integer sliders.
+ *
+ * @param newValue: The new value
+ */
+template<typename T, typename Mapping>
+void BasicSlider<T, Mapping>::setValueFromDouble(double newValue)
+{
+	newValue = std::min(std::max(newValue, static_cast<double>(min)), static_cast<double>(max));
+	setValue(std::is_integral<T>::value ? static_cast<T>(std::llround(newValue)) : static_cast<T>(newValue));
+}
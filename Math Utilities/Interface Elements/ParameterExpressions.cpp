@@ -0,0 +1,577 @@
+//  ParameterExpressions.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "ParameterExpressions.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+
+
+
+
+
+
+/**
+ * ExpressionParser class compiling expression text into a CompiledExpression by recursive descent:
+ *
+ *   sum     := product (('+' | '-') product)*
+ *   product := unary (('*' | '/') unary)*
+ *   unary   := '-' unary | power
+ *   power   := primary ('^' unary)?
+ *   primary := number | name | function '(' sum ')' | '(' sum ')'
+ */
+class ExpressionParser
+{
+public:
+	ExpressionParser(const std::string &_text, const ParameterStore &_store, CompiledExpression &_output) : text(_text), store(_store), output(_output) {}
+
+	bool parse(std::string &error)
+	{
+		skipSpaces();
+		if (!sum())
+		{
+			error = message;
+			return false;
+		}
+		if (position != text.size())
+		{
+			error = "Unexpected '" + text.substr(position, 1) + "' at " + std::to_string(position + 1);
+			return false;
+		}
+		if (maxDepth > CompiledExpression::MAX_STACK)
+		{
+			error = "Expression is nested too deeply";
+			return false;
+		}
+		return true;
+	}
+
+private:
+	bool sum()
+	{
+		if (!product())
+		{
+			return false;
+		}
+		while (peek() == '+' || peek() == '-')
+		{
+			ExpressionOp op = take() == '+' ? ExpressionOp::Add : ExpressionOp::Subtract;
+			if (!product())
+			{
+				return false;
+			}
+			emit({op});
+		}
+		return true;
+	}
+
+	bool product()
+	{
+		if (!unary())
+		{
+			return false;
+		}
+		while (peek() == '*' || peek() == '/')
+		{
+			ExpressionOp op = take() == '*' ? ExpressionOp::Multiply : ExpressionOp::Divide;
+			if (!unary())
+			{
+				return false;
+			}
+			emit({op});
+		}
+		return true;
+	}
+
+	bool unary()
+	{
+		if (peek() == '-')
+		{
+			take();
+			if (!unary())
+			{
+				return false;
+			}
+			emit({ExpressionOp::Negate});
+			return true;
+		}
+		if (peek() == '+')
+		{
+			take();
+			return unary();
+		}
+		return power();
+	}
+
+	bool power()
+	{
+		if (!primary())
+		{
+			return false;
+		}
+		if (peek() == '^')
+		{
+			take();
+			if (!unary())
+			{
+				return false;
+			}
+			emit({ExpressionOp::Power});
+		}
+		return true;
+	}
+
+	bool primary()
+	{
+		/// Parenthesized sum
+		if (peek() == '(')
+		{
+			take();
+			if (!sum())
+			{
+				return false;
+			}
+			return expect(')');
+		}
+
+		/// Number
+		if (std::isdigit(static_cast<unsigned char>(peek())) || peek() == '.')
+		{
+			const char *begin = text.c_str() + position;
+			char *end = nullptr;
+			double value = std::strtod(begin, &end);
+			if (end == begin)
+			{
+				return fail("Invalid number at " + std::to_string(position + 1));
+			}
+			position += end - begin;
+			skipSpaces();
+			ExpressionInstruction instruction{ExpressionOp::Constant};
+			instruction.constant = value;
+			emit(instruction);
+			return true;
+		}
+
+		/// Name: a function call, a parameter or a constant
+		if (std::isalpha(static_cast<unsigned char>(peek())) || peek() == '_')
+		{
+			std::size_t begin = position;
+			while (position < text.size() && (std::isalnum(static_cast<unsigned char>(text[position])) || text[position] == '_'))
+			{
+				position++;
+			}
+			std::string name = text.substr(begin, position - begin);
+			skipSpaces();
+			return peek() == '(' ? call(name) : reference(name);
+		}
+
+		return fail(position < text.size() ? "Unexpected '" + text.substr(position, 1) + "' at " + std::to_string(position + 1) : "Unexpected end of expression");
+	}
+
+	bool call(const std::string &name)
+	{
+		static const std::map<std::string, ExpressionFunction> functions = {
+			{"sin", ExpressionFunction::Sin}, {"cos", ExpressionFunction::Cos}, {"tan", ExpressionFunction::Tan},
+			{"sqrt", ExpressionFunction::Sqrt}, {"exp", ExpressionFunction::Exp}, {"log", ExpressionFunction::Log},
+			{"log10", ExpressionFunction::Log10}, {"abs", ExpressionFunction::Abs}};
+		auto function = functions.find(name);
+		if (function == functions.end())
+		{
+			return fail("Unknown function '" + name + "'");
+		}
+		take();
+		if (!sum() || !expect(')'))
+		{
+			return false;
+		}
+		ExpressionInstruction instruction{ExpressionOp::Function};
+		instruction.function = function->second;
+		emit(instruction);
+		return true;
+	}
+
+	bool reference(const std::string &name)
+	{
+		int index = store.indexOf(name);
+		if (index >= 0)
+		{
+			ExpressionInstruction instruction{ExpressionOp::Parameter};
+			instruction.parameter = static_cast<uint32_t>(index);
+			emit(instruction);
+			if (std::find(output.inputs.begin(), output.inputs.end(), instruction.parameter) == output.inputs.end())
+			{
+				output.inputs.push_back(instruction.parameter);
+			}
+			return true;
+		}
+		if (name == "pi")
+		{
+			ExpressionInstruction instruction{ExpressionOp::Constant};
+			instruction.constant = 3.14159265358979323846;
+			emit(instruction);
+			return true;
+		}
+		return fail("Unknown parameter '" + name + "'");
+	}
+
+	/// Appends an instruction and tracks the stack depth it leaves behind.
+	void emit(ExpressionInstruction instruction)
+	{
+		switch (instruction.op)
+		{
+			case ExpressionOp::Constant:
+			case ExpressionOp::Parameter:
+				depth++;
+				break;
+			case ExpressionOp::Add:
+			case ExpressionOp::Subtract:
+			case ExpressionOp::Multiply:
+			case ExpressionOp::Divide:
+			case ExpressionOp::Power:
+				depth--;
+				break;
+			case ExpressionOp::Negate:
+			case ExpressionOp::Function:
+				break;
+		}
+		maxDepth = std::max(maxDepth, depth);
+		output.code.push_back(instruction);
+	}
+
+	char peek() const { return position < text.size() ? text[position] : '\0'; }
+	char take() { char c = text[position++]; skipSpaces(); return c; }
+	void skipSpaces() { while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) position++; }
+	bool expect(char c) { if (peek() != c) return fail(std::string("Expected '") + c + "'"); take(); return true; }
+	bool fail(const std::string &_message) { if (message.empty()) message = _message; return false; }
+
+	const std::string &text; // The expression being parsed
+	const ParameterStore &store; // Resolves parameter names
+	CompiledExpression &output; // Receives the bytecode
+	std::size_t position = 0; // The next character to parse
+	std::size_t depth = 0, maxDepth = 0; // Current and deepest stack depth of the emitted bytecode
+	std::string message; // The first error found
+};
+
+
+
+
+/**
+ * compile
+ * Parses an expression and resolves its parameter names against a store.
+ *
+ * @param text: The expression, e.g. "2*theta"
+ * @param store: The store whose parameters the expression may read
+ * @param error: Receives a description of the problem if the expression is invalid
+ * @return std::unique_ptr<CompiledExpression>: The compiled expression, nullptr if invalid
+ */
+std::unique_ptr<CompiledExpression> CompiledExpression::compile(const std::string &text, const ParameterStore &store, std::string &error)
+{
+	std::unique_ptr<CompiledExpression> compiled(new CompiledExpression());
+	compiled->source = text;
+	ExpressionParser parser(compiled->source, store, *compiled);
+	if (!parser.parse(error))
+	{
+		return nullptr;
+	}
+	return compiled;
+}
+
+
+/**
+ * isNumber
+ * Returns whether a text is nothing but a finite number (surrounding spaces allowed). strtod also reads
+ * "inf" and "nan", which are not values a parameter can take.
+ *
+ * @param text: The text to check
+ * @param value: Receives the number
+ * @return bool: true if the whole text is a finite number
+ */
+bool CompiledExpression::isNumber(const std::string &text, double &value)
+{
+	const char *begin = text.c_str();
+	char *end = nullptr;
+	value = std::strtod(begin, &end);
+	if (end == begin || !std::isfinite(value))
+	{
+		return false;
+	}
+	while (*end && std::isspace(static_cast<unsigned char>(*end)))
+	{
+		end++;
+	}
+	return *end == '\0';
+}
+
+
+/**
+ * evaluate
+ * Runs the bytecode on a fixed-size stack, reading parameters straight from the store's back buffer.
+ *
+ * @param store: The store the expression was compiled against
+ * @return double: The value of the expression
+ */
+double CompiledExpression::evaluate(const ParameterStore &store) const
+{
+	double stack[MAX_STACK];
+	std::size_t top = 0;
+	for (const ExpressionInstruction &instruction : code)
+	{
+		switch (instruction.op)
+		{
+			case ExpressionOp::Constant:
+				stack[top++] = instruction.constant;
+				break;
+			case ExpressionOp::Parameter:
+				stack[top++] = parameterAsDouble(store.info(instruction.parameter).type, store.getWord(instruction.parameter));
+				break;
+			case ExpressionOp::Add:
+				top--;
+				stack[top - 1] += stack[top];
+				break;
+			case ExpressionOp::Subtract:
+				top--;
+				stack[top - 1] -= stack[top];
+				break;
+			case ExpressionOp::Multiply:
+				top--;
+				stack[top - 1] *= stack[top];
+				break;
+			case ExpressionOp::Divide:
+				top--;
+				stack[top - 1] /= stack[top];
+				break;
+			case ExpressionOp::Power:
+				top--;
+				stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+				break;
+			case ExpressionOp::Negate:
+				stack[top - 1] = -stack[top - 1];
+				break;
+			case ExpressionOp::Function:
+			{
+				double &x = stack[top - 1];
+				switch (instruction.function)
+				{
+					case ExpressionFunction::Sin: x = std::sin(x); break;
+					case ExpressionFunction::Cos: x = std::cos(x); break;
+					case ExpressionFunction::Tan: x = std::tan(x); break;
+					case ExpressionFunction::Sqrt: x = std::sqrt(x); break;
+					case ExpressionFunction::Exp: x = std::exp(x); break;
+					case ExpressionFunction::Log: x = std::log(x); break;
+					case ExpressionFunction::Log10: x = std::log10(x); break;
+					case ExpressionFunction::Abs: x = std::fabs(x); break;
+				}
+				break;
+			}
+		}
+	}
+	return top > 0 ? stack[top - 1] : 0;
+}
+
+
+
+
+
+
+
+
+ParameterExpressions::ParameterExpressions(ParameterStore &_store) : store(_store)
+{
+	store.addListener(this);
+}
+
+
+ParameterExpressions::~ParameterExpressions()
+{
+	store.removeListener(this);
+}
+
+
+/**
+ * forStore
+ * Returns the expressions of a store, creating them on first use. The store must outlive the program's
+ * last use of them, which holds for ParameterStore::global().
+ *
+ * @param store: The store
+ * @return ParameterExpressions&: Its expressions
+ */
+ParameterExpressions &ParameterExpressions::forStore(ParameterStore &store)
+{
+	static std::map<ParameterStore*, std::unique_ptr<ParameterExpressions>> registry;
+	std::unique_ptr<ParameterExpressions> &expressions = registry[&store];
+	if (!expressions)
+	{
+		expressions.reset(new ParameterExpressions(store));
+	}
+	return *expressions;
+}
+
+
+ParameterExpressions &ParameterExpressions::global()
+{
+	return forStore(ParameterStore::global());
+}
+
+
+
+
+/**
+ * bind
+ * Compiles an expression and makes it the value of a parameter: the parameter is marked as derived,
+ * registered as a dependent of every parameter the expression reads and evaluated once right away.
+ * Expressions that would read their own result, directly or through other expressions, are rejected.
+ *
+ * @param target: The parameter computed by the expression
+ * @param text: The expression
+ * @param error: Receives a description of the problem if the expression is rejected
+ * @return bool: true if the expression is bound
+ */
+bool ParameterExpressions::bind(uint32_t target, const std::string &text, std::string &error)
+{
+	std::unique_ptr<CompiledExpression> compiled = CompiledExpression::compile(text, store, error);
+	if (!compiled)
+	{
+		return false;
+	}
+	for (uint32_t input : compiled->dependencies())
+	{
+		if (input == target || reaches(input, target))
+		{
+			error = "'" + store.info(target).name + "' cannot depend on itself";
+			return false;
+		}
+	}
+
+	unbind(target);
+	for (uint32_t input : compiled->dependencies())
+	{
+		dependents[input].push_back(target);
+	}
+	bindings[target] = std::move(compiled);
+	store.setDerived(target, true);
+	evaluate(target);
+	return true;
+}
+
+
+/**
+ * unbind
+ * Removes the expression of a parameter, leaving its current value in place.
+ *
+ * @param target: The parameter
+ */
+void ParameterExpressions::unbind(uint32_t target)
+{
+	if (!bindings[target])
+	{
+		return;
+	}
+	for (uint32_t input : bindings[target]->dependencies())
+	{
+		std::vector<uint32_t> &readers = dependents[input];
+		readers.erase(std::remove(readers.begin(), readers.end(), target), readers.end());
+	}
+	bindings[target].reset();
+	store.setDerived(target, false);
+}
+
+
+bool ParameterExpressions::isBound(uint32_t target) const
+{
+	return bindings[target] != nullptr;
+}
+
+
+const CompiledExpression *ParameterExpressions::expression(uint32_t target) const
+{
+	return bindings[target].get();
+}
+
+
+/**
+ * reaches
+ * Returns whether the expression of a parameter reads another, directly or through the expressions of
+ * the parameters it reads.
+ *
+ * @param from: The parameter whose expression is followed
+ * @param target: The parameter looked for
+ * @return bool: true if 'from' depends on 'target'
+ */
+bool ParameterExpressions::reaches(uint32_t from, uint32_t target) const
+{
+	if (!bindings[from])
+	{
+		return false;
+	}
+	for (uint32_t input : bindings[from]->dependencies())
+	{
+		if (input == target || reaches(input, target))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+
+/**
+ * update
+ * Evaluates the expressions whose inputs changed since the last update. Writing a result marks the
+ * expressions that read it, which are evaluated in the same update; bound expressions never form a
+ * cycle, so this terminates.
+ *
+ * @return std::size_t: The number of expressions evaluated
+ */
+std::size_t ParameterExpressions::update()
+{
+	std::size_t evaluated = 0;
+	for (std::size_t i = 0; i < pending.size(); i++) // evaluate() may append to 'pending'
+	{
+		uint32_t target = pending[i];
+		queued[target] = false;
+		if (bindings[target])
+		{
+			evaluate(target);
+			evaluated++;
+		}
+	}
+	pending.clear();
+	return evaluated;
+}
+
+
+void ParameterExpressions::schedule(uint32_t target)
+{
+	if (!queued[target])
+	{
+		queued[target] = true;
+		pending.push_back(target);
+	}
+}
+
+
+void ParameterExpressions::evaluate(uint32_t target)
+{
+	const ParameterInfo &info = store.info(target);
+	double value = bindings[target]->evaluate(store);
+	evaluationCount++;
+	if (std::isfinite(value)) // A division by zero or log of a negative input keeps the last valid result
+	{
+		store.setWord(target, parameterFromDouble(info.type, std::min(std::max(value, info.min), info.max)));
+	}
+}
+
+
+void ParameterExpressions::parameterChanged(uint32_t index, uint64_t /*oldWord*/, uint64_t /*newWord*/)
+{
+	for (uint32_t target : dependents[index])
+	{
+		schedule(target);
+	}
+}
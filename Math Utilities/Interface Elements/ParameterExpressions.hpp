@@ -0,0 +1,175 @@
+//  ParameterExpressions.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Parameter Expressions header file declares parameters whose value is an arithmetic expression of other
+ * parameters, e.g. "2*theta" or "G*1e3", as typed into a bound TextField.
+ *
+ * These components include:
+ *   - CompiledExpression: An expression parsed once into stack bytecode, with the parameters it reads.
+ *   - ParameterExpressions: The expressions bound to the parameters of one ParameterStore, with the
+ *     reverse dependency index used to re-evaluate only the expressions whose inputs changed.
+ *
+ * Grammar: numbers (1, 2.5, 1e3), parameter names, pi, + - * / ^ (right-associative power), unary minus,
+ * parentheses and the functions sin cos tan sqrt exp log log10 abs. Names are resolved through the
+ * store's registry when the expression is compiled, so evaluating never looks anything up by name.
+ */
+
+
+#pragma once
+#include "ParameterStore.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+
+
+
+
+/// The instructions of compiled expressions, each operates on the evaluation stack.
+enum class ExpressionOp : uint8_t
+{
+	Constant, // Pushes 'constant'
+	Parameter, // Pushes the value of 'parameter'
+	Add,
+	Subtract,
+	Multiply,
+	Divide,
+	Power,
+	Negate,
+	Function // Applies 'function' to the top of the stack
+};
+
+
+/// The functions an expression can call.
+enum class ExpressionFunction : uint8_t
+{
+	Sin,
+	Cos,
+	Tan,
+	Sqrt,
+	Exp,
+	Log,
+	Log10,
+	Abs
+};
+
+
+/**
+ * ExpressionInstruction struct, one bytecode instruction.
+ */
+struct ExpressionInstruction
+{
+	ExpressionOp op;
+	ExpressionFunction function = ExpressionFunction::Sin; // The function called by ExpressionOp::Function
+	uint32_t parameter = 0; // The parameter read by ExpressionOp::Parameter
+	double constant = 0; // The value pushed by ExpressionOp::Constant
+};
+
+
+
+
+
+
+
+
+/**
+ * CompiledExpression class representing an expression compiled against a ParameterStore.
+ */
+class CompiledExpression
+{
+public:
+	/// ------------- Compilation -------------
+	/// \{
+	static std::unique_ptr<CompiledExpression> compile(const std::string &text, const ParameterStore &store, std::string &error); // Parses 'text', nullptr (and a message in 'error') if it is invalid
+	static bool isNumber(const std::string &text, double &value); // Whether 'text' is a plain number, which TextFields store directly
+																  /// \}
+
+
+	/// ------------- Evaluation -------------
+	/// \{
+	double evaluate(const ParameterStore &store) const; // Runs the bytecode over the store's current values, without allocating
+	const std::vector<uint32_t> &dependencies() const { return inputs; } // The parameters the expression reads, without repeats
+	const std::string &text() const { return source; } // The expression as typed
+													   /// \}
+
+
+	/// ------------- Limits -------------
+	/// \{
+	static constexpr std::size_t MAX_STACK = 32; // Deepest evaluation stack an expression may need
+	/// \}
+
+
+private:
+	friend class ExpressionParser;
+
+	std::vector<ExpressionInstruction> code; // The bytecode, in evaluation order
+	std::vector<uint32_t> inputs; // The parameters read by the bytecode
+	std::string source; // The expression text
+};
+
+
+
+
+
+
+
+
+/**
+ * ParameterExpressions class representing the expressions bound to the parameters of a store.
+ *
+ * Used from the UI thread. Changes of a parameter mark the expressions reading it; update() evaluates
+ * just those, once per frame before the store is published, and writes their results into the store,
+ * which in turn marks expressions reading the results.
+ */
+class ParameterExpressions : public ParameterListener
+{
+public:
+	/// ------------- Constructors, Destructor and Access -------------
+	/// \{
+	explicit ParameterExpressions(ParameterStore &_store); // Starts listening to '_store'
+	~ParameterExpressions(); // Stops listening
+	ParameterExpressions(const ParameterExpressions &) = delete;
+	ParameterExpressions &operator=(const ParameterExpressions &) = delete;
+	static ParameterExpressions &forStore(ParameterStore &store); // The expressions of a store, created on first use and kept for the rest of the program
+	static ParameterExpressions &global(); // The expressions of ParameterStore::global()
+										   /// \}
+
+
+	/// ------------- Binding -------------
+	/// \{
+	bool bind(uint32_t target, const std::string &text, std::string &error); // Compiles 'text' and makes it the value of 'target', false (with a message) if invalid or circular
+	void unbind(uint32_t target); // Lets 'target' be edited directly again
+	bool isBound(uint32_t target) const; // Whether 'target' is computed by an expression
+	const CompiledExpression *expression(uint32_t target) const; // The expression of 'target', nullptr if none
+																 /// \}
+
+
+	/// ------------- Evaluation -------------
+	/// \{
+	std::size_t update(); // Re-evaluates the expressions whose inputs changed, returns how many were evaluated
+	uint64_t evaluations() const { return evaluationCount; } // Number of evaluations so far
+															 /// \}
+
+
+	/// ------------- ParameterListener -------------
+	/// \{
+	void parameterChanged(uint32_t index, uint64_t oldWord, uint64_t newWord) override; // Marks the expressions reading the parameter
+																						 /// \}
+
+
+private:
+	bool reaches(uint32_t from, uint32_t target) const; // Whether the expression of 'from' reads 'target', directly or through other expressions
+	void schedule(uint32_t target); // Queues an expression for the next update
+	void evaluate(uint32_t target); // Evaluates an expression and writes its result, clamped to the parameter's range
+
+	ParameterStore &store; // The store whose parameters the expressions read and write
+	std::array<std::unique_ptr<CompiledExpression>, ParameterSnapshot::CAPACITY> bindings; // The expression of each parameter, if any
+	std::array<std::vector<uint32_t>, ParameterSnapshot::CAPACITY> dependents; // The parameters whose expressions read each parameter
+	std::vector<uint32_t> pending; // Expressions to evaluate in the next update
+	std::array<bool, ParameterSnapshot::CAPACITY> queued{}; // Whether each expression is in 'pending'
+	uint64_t evaluationCount = 0; // Number of evaluations so far
+};
@@ -0,0 +1,250 @@
+//  ParameterJournal.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "ParameterJournal.hpp"
+#include "ofMain.h"
+#include <chrono>
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+
+
+
+namespace
+{
+	const char JOURNAL_MAGIC[8] = {'P', 'J', 'O', 'U', 'R', 'N', 'L', '1'};
+
+	uint64_t steadyMicros()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	uint64_t wallClockMicros()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+}
+
+
+
+
+ParameterJournal::ParameterJournal()
+{
+}
+
+
+ParameterJournal::~ParameterJournal()
+{
+	close();
+}
+
+
+/**
+ * open
+ * Maps a journal file. An existing file written with the same format and capacity is continued,
+ * otherwise the file is (re)created empty. All file system work happens here, so that appending
+ * records later never has to touch the file system.
+ *
+ * @param path: The path of the journal file
+ * @param capacity: The number of records the ring holds before the oldest are overwritten
+ * @return bool: true if the file is mapped and records will be journaled
+ */
+bool ParameterJournal::open(const std::string &path, uint64_t capacity)
+{
+	close();
+	if (capacity == 0)
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	ofLogError("ParameterJournal") << "Memory-mapped journals are not supported on this platform, not journaling to " << path;
+	return false;
+#else
+	/// Step 1: Open the file and decide whether it can be continued
+	int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (fd < 0)
+	{
+		ofLogError("ParameterJournal") << "Could not open " << path << ": " << std::strerror(errno);
+		return false;
+	}
+
+	std::size_t size = fileSize(capacity);
+	struct stat fileStatus;
+	bool continuing = fstat(fd, &fileStatus) == 0 && static_cast<std::size_t>(fileStatus.st_size) == size;
+	if (!continuing && (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(size)) != 0)) // Truncating first zeroes every byte
+	{
+		ofLogError("ParameterJournal") << "Could not size " << path << ": " << std::strerror(errno);
+		::close(fd);
+		return false;
+	}
+
+
+	/// Step 2: Map it, the mapping stays valid after the descriptor is closed
+	void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (address == MAP_FAILED)
+	{
+		ofLogError("ParameterJournal") << "Could not map " << path << ": " << std::strerror(errno);
+		return false;
+	}
+	mapping = address;
+	mappingSize = size;
+	header = static_cast<JournalHeader*>(address);
+	names = reinterpret_cast<JournalParameterName*>(static_cast<char*>(address) + sizeof(JournalHeader));
+	records = reinterpret_cast<JournalRecord*>(names + MAX_PARAMETERS);
+
+
+	/// Step 3: Validate a continued file, or write the header of a new one
+	if (continuing && (std::memcmp(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 || header->formatVersion != FORMAT_VERSION || header->recordSize != sizeof(JournalRecord) || header->capacity != capacity))
+	{
+		std::memset(address, 0, size); // Same size but not a journal of this format, start over
+		continuing = false;
+	}
+	if (!continuing)
+	{
+		std::memcpy(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+		header->formatVersion = FORMAT_VERSION;
+		header->recordSize = sizeof(JournalRecord);
+		header->capacity = capacity;
+		header->epochMicros = wallClockMicros();
+		header->writeIndex.store(0, std::memory_order_relaxed);
+	}
+
+	steadyOriginMicros = steadyMicros();
+	epochOffsetMicros = wallClockMicros() - header->epochMicros;
+	return true;
+#endif
+}
+
+
+/**
+ * close
+ * Writes the mapped pages back synchronously and unmaps the file.
+ */
+void ParameterJournal::close()
+{
+#ifndef _WIN32
+	if (mapping)
+	{
+		msync(mapping, mappingSize, MS_SYNC);
+		munmap(mapping, mappingSize);
+	}
+#endif
+	mapping = nullptr;
+	mappingSize = 0;
+	header = nullptr;
+	names = nullptr;
+	records = nullptr;
+}
+
+
+/**
+ * flush
+ * Schedules the write-back of the mapped pages without waiting for it, e.g. once per second or at a checkpoint.
+ */
+void ParameterJournal::flush()
+{
+#ifndef _WIN32
+	if (mapping)
+	{
+		msync(mapping, mappingSize, MS_ASYNC);
+	}
+#endif
+}
+
+
+bool ParameterJournal::isOpen() const
+{
+	return mapping != nullptr;
+}
+
+
+
+
+uint64_t ParameterJournal::nowMicros() const
+{
+	return epochOffsetMicros + (steadyMicros() - steadyOriginMicros);
+}
+
+
+/**
+ * append
+ * Appends a change record. The slot is claimed with one atomic increment, so any number of threads may
+ * append concurrently; the record is published by storing its sequence number last. Nothing is allocated
+ * and no system call is made (the monotonic clock is read through the vDSO/commpage).
+ *
+ * @param parameter: The parameter's index in its store
+ * @param type: The type the values are encoded with
+ * @param oldWord: The previous value
+ * @param newWord: The new value
+ */
+void ParameterJournal::append(uint32_t parameter, ParameterType type, uint64_t oldWord, uint64_t newWord)
+{
+	if (!records)
+	{
+		return;
+	}
+
+	uint64_t index = header->writeIndex.fetch_add(1, std::memory_order_relaxed);
+	JournalRecord &record = records[index % header->capacity];
+	record.sequence.store(0, std::memory_order_relaxed); // Mark the slot as being rewritten
+	std::atomic_thread_fence(std::memory_order_release);
+	record.timestampMicros = nowMicros();
+	record.oldWord = oldWord;
+	record.newWord = newWord;
+	record.parameter = parameter;
+	record.type = static_cast<uint8_t>(type);
+	record.sequence.store(index + 1, std::memory_order_release);
+}
+
+
+/**
+ * nameParameter
+ * Stores a parameter's name and type in the file's name table. Called when a parameter is registered,
+ * never per change.
+ *
+ * @param parameter: The parameter's index in its store
+ * @param name: The parameter's name, truncated to 46 characters
+ * @param type: The parameter's type
+ */
+void ParameterJournal::nameParameter(uint32_t parameter, const std::string &name, ParameterType type)
+{
+	if (!names || parameter >= MAX_PARAMETERS)
+	{
+		return;
+	}
+	JournalParameterName &entry = names[parameter];
+	std::memset(entry.name, 0, sizeof(entry.name));
+	std::memcpy(entry.name, name.c_str(), std::min(name.size(), sizeof(entry.name) - 1));
+	entry.type = static_cast<uint8_t>(type);
+}
+
+
+uint64_t ParameterJournal::recordsWritten() const
+{
+	return header ? header->writeIndex.load(std::memory_order_relaxed) : 0;
+}
+
+
+
+
+void ParameterJournal::parameterAdded(uint32_t index, const ParameterInfo &info)
+{
+	nameParameter(index, info.name, info.type);
+}
+
+
+void ParameterJournal::parameterChanged(uint32_t index, uint64_t oldWord, uint64_t newWord)
+{
+	append(index, names && index < MAX_PARAMETERS ? static_cast<ParameterType>(names[index].type) : ParameterType::Double, oldWord, newWord);
+}
@@ -0,0 +1,150 @@
+//  ParameterJournal.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Parameter Journal header file declares an audit trail of parameter changes, kept in a
+ * memory-mapped ring file.
+ *
+ * These components include:
+ *   - JournalHeader, JournalParameterName, JournalRecord: The on-disk format, shared with the reader
+ *     tool (tools/ParameterJournalReader.cpp).
+ *   - ParameterJournal: A ParameterListener that appends one fixed-size record (timestamp, parameter
+ *     id, old and new value) per change of a ParameterStore parameter.
+ *
+ * The file is mapped once when the journal is opened. Appending a record claims a slot with a single
+ * atomic increment and writes it with plain stores into the mapping: no lock, no allocation and no
+ * system call per change; the operating system writes the dirty pages back in the background and
+ * flush() can force it. When the ring is full the oldest records are overwritten.
+ *
+ * File layout (little-endian, native alignment):
+ *   [JournalHeader, 64 bytes][JournalParameterName x MAX_PARAMETERS][JournalRecord x capacity]
+ * Record i (counting from 0 since the file was created) lives in slot i % capacity and is complete
+ * when its 'sequence' equals i + 1.
+ */
+
+
+#pragma once
+#include "ParameterStore.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+
+
+
+
+
+/**
+ * JournalHeader struct, the first 64 bytes of a journal file.
+ */
+struct JournalHeader
+{
+	char magic[8]; // "PJOURNL1"
+	uint32_t formatVersion; // FORMAT_VERSION of the writer
+	uint32_t recordSize; // sizeof(JournalRecord)
+	uint64_t capacity; // Number of record slots in the ring
+	uint64_t epochMicros; // Wall-clock time (microseconds since the Unix epoch) record timestamps are relative to
+	std::atomic<uint64_t> writeIndex; // Number of records ever claimed
+	uint8_t reserved[24]; // Pads the header to 64 bytes
+};
+
+
+/**
+ * JournalParameterName struct naming a parameter id, so the reader can print names instead of ids.
+ */
+struct JournalParameterName
+{
+	char name[47]; // Zero-terminated parameter name, truncated if longer
+	uint8_t type; // The ParameterType of the parameter
+};
+
+
+/**
+ * JournalRecord struct, one parameter change.
+ */
+struct JournalRecord
+{
+	std::atomic<uint64_t> sequence; // Record index + 1 once the record is complete, 0 while it is being written
+	uint64_t timestampMicros; // Microseconds since JournalHeader::epochMicros
+	uint64_t oldWord; // The previous value, encoded as by encodeParameter
+	uint64_t newWord; // The new value, encoded as by encodeParameter
+	uint32_t parameter; // The parameter's index in its ParameterStore
+	uint8_t type; // The ParameterType of the values
+	uint8_t reserved[3];
+};
+
+
+static_assert(sizeof(JournalHeader) == 64, "JournalHeader is part of the file format");
+static_assert(sizeof(JournalParameterName) == 48, "JournalParameterName is part of the file format");
+static_assert(sizeof(JournalRecord) == 40, "JournalRecord is part of the file format");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The journal needs lock-free 64-bit atomics in shared memory");
+
+
+
+
+
+
+
+
+/**
+ * ParameterJournal class representing a memory-mapped ring file of parameter changes.
+ *
+ * Attach it to a store with ParameterStore::addListener after opening it. append() may also be called
+ * directly, from any thread.
+ */
+class ParameterJournal : public ParameterListener
+{
+public:
+	/// ------------- Constructors and Destructor -------------
+	/// \{
+	ParameterJournal(); // Creates a closed journal
+	~ParameterJournal(); // Closes the journal, flushing it
+	ParameterJournal(const ParameterJournal &) = delete;
+	ParameterJournal &operator=(const ParameterJournal &) = delete;
+	/// \}
+
+
+	/// ------------- File -------------
+	/// \{
+	bool open(const std::string &path, uint64_t capacity = DEFAULT_CAPACITY); // Maps a journal file, continuing an existing one of the same capacity
+	void close(); // Flushes and unmaps the file
+	void flush(); // Asks the operating system to write the mapped pages back now
+	bool isOpen() const; // Whether a file is mapped
+						 /// \}
+
+
+	/// ------------- Recording -------------
+	/// \{
+	void append(uint32_t parameter, ParameterType type, uint64_t oldWord, uint64_t newWord); // Appends a record, lock-free and allocation-free
+	void nameParameter(uint32_t parameter, const std::string &name, ParameterType type); // Stores a parameter's name for the reader
+	uint64_t recordsWritten() const; // Number of records appended since the file was created
+									 /// \}
+
+
+	/// ------------- ParameterListener -------------
+	/// \{
+	void parameterAdded(uint32_t index, const ParameterInfo &info) override; // Names the parameter in the file
+	void parameterChanged(uint32_t index, uint64_t oldWord, uint64_t newWord) override; // Appends a record
+																						 /// \}
+
+
+	/// ------------- Format -------------
+	/// \{
+	static constexpr uint32_t FORMAT_VERSION = 1;
+	static constexpr uint64_t DEFAULT_CAPACITY = 1 << 16; // 65536 records, 2.5 MB
+	static constexpr std::size_t MAX_PARAMETERS = ParameterSnapshot::CAPACITY; // Entries of the name table
+	static std::size_t fileSize(uint64_t capacity) { return sizeof(JournalHeader) + MAX_PARAMETERS * sizeof(JournalParameterName) + capacity * sizeof(JournalRecord); } // The size of a journal file with 'capacity' records, inline for the reader tool
+													/// \}
+
+
+private:
+	uint64_t nowMicros() const; // Microseconds since the header's epoch, from a monotonic clock
+
+	void *mapping = nullptr; // The mapped file
+	std::size_t mappingSize = 0; // The size of the mapping
+	JournalHeader *header = nullptr; // The header inside the mapping
+	JournalParameterName *names = nullptr; // The name table inside the mapping
+	JournalRecord *records = nullptr; // The record ring inside the mapping
+	uint64_t steadyOriginMicros = 0; // The monotonic clock reading that corresponds to 'epochOffsetMicros'
+	uint64_t epochOffsetMicros = 0; // Microseconds between the header's epoch and opening the file
+};
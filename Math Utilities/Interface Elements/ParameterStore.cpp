@@ -0,0 +1,427 @@
+//  ParameterStore.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "ParameterStore.hpp"
+#include <algorithm>
+
+
+
+
+
+
+/**
+ * parameterAsDouble
+ * Converts a parameter word of any type to a double, e.g. for display or range checks.
+ *
+ * @param type: The type the word was encoded with
+ * @param word: The encoded value
+ * @return double: The value as a double
+ */
+double parameterAsDouble(ParameterType type, uint64_t word)
+{
+	switch (type)
+	{
+		case ParameterType::Float:
+			return decodeParameter<float>(word);
+		case ParameterType::Double:
+			return decodeParameter<double>(word);
+		case ParameterType::Int64:
+			return static_cast<double>(decodeParameter<int64_t>(word));
+		case ParameterType::Bool:
+			return decodeParameter<bool>(word) ? 1.0 : 0.0;
+	}
+	return 0;
+}
+
+
+/**
+ * parameterFromDouble
+ * Converts a double to a parameter word of the given type, rounding for integer types.
+ *
+ * @param type: The type to encode the value as
+ * @param value: The value
+ * @return uint64_t: The encoded value
+ */
+uint64_t parameterFromDouble(ParameterType type, double value)
+{
+	switch (type)
+	{
+		case ParameterType::Float:
+			return encodeParameter(static_cast<float>(value));
+		case ParameterType::Double:
+			return encodeParameter(value);
+		case ParameterType::Int64:
+			return encodeParameter(static_cast<int64_t>(value < 0 ? value - 0.5 : value + 0.5));
+		case ParameterType::Bool:
+			return encodeParameter(value != 0);
+	}
+	return 0;
+}
+
+
+
+
+uint64_t ParameterSnapshot::word(uint32_t index) const
+{
+	return words[index];
+}
+
+
+std::size_t ParameterSnapshot::size() const
+{
+	return count;
+}
+
+
+uint64_t ParameterSnapshot::version() const
+{
+	return snapshotVersion;
+}
+
+
+uint64_t ParameterSnapshot::changeVersion() const
+{
+	return count > 0 ? versions[recency[0]] : 0;
+}
+
+
+uint64_t ParameterSnapshot::changeVersion(uint32_t index) const
+{
+	return versions[index];
+}
+
+
+
+
+
+
+
+
+/**
+ * ParameterStore
+ * Constructor that creates an empty store with every published word cleared.
+ */
+ParameterStore::ParameterStore()
+{
+	for (std::size_t i = 0; i < ParameterSnapshot::CAPACITY; i++)
+	{
+		published[i].store(0, std::memory_order_relaxed);
+		publishedVersions[i].store(0, std::memory_order_relaxed);
+		publishedRecency[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+
+/**
+ * global
+ * Returns the store shared by the application's widgets.
+ */
+ParameterStore &ParameterStore::global()
+{
+	static ParameterStore store;
+	return store;
+}
+
+
+
+
+/**
+ * registerParameter
+ * Adds a parameter record and sets its initial value in the back buffer. The parameter becomes
+ * visible to readers with the next publish.
+ *
+ * @param parameterInfo: The description of the parameter
+ * @param word: The encoded initial value
+ * @return uint32_t: The index of the new parameter
+ */
+uint32_t ParameterStore::registerParameter(ParameterInfo parameterInfo, uint64_t word)
+{
+	uint32_t index = static_cast<uint32_t>(infos.size());
+	names[parameterInfo.name] = index;
+	infos.push_back(std::move(parameterInfo));
+	backBuffer[index] = word;
+	newer[index] = older[index] = NO_PARAMETER;
+	touch(index); // Registration counts as the parameter's first change
+	
+	for (ParameterListener *listener : listeners)
+	{
+		listener->parameterAdded(index, infos[index]);
+	}
+	return index;
+}
+
+
+/**
+ * touch
+ * Records a change of a parameter: stamps it with the next change version and moves it to the front
+ * of the recency list, in O(1).
+ *
+ * @param index: The parameter that changed
+ */
+void ParameterStore::touch(uint32_t index)
+{
+	versions[index] = ++changeCounter;
+	dirty = true;
+	if (index == mostRecent)
+	{
+		return;
+	}
+
+	unlink(index);
+	older[index] = mostRecent;
+	newer[index] = NO_PARAMETER;
+	if (mostRecent != NO_PARAMETER)
+	{
+		newer[mostRecent] = index;
+	}
+	mostRecent = index;
+	if (leastRecent == NO_PARAMETER)
+	{
+		leastRecent = index;
+	}
+}
+
+
+void ParameterStore::unlink(uint32_t index)
+{
+	if (newer[index] != NO_PARAMETER)
+	{
+		older[newer[index]] = older[index];
+	}
+	else if (mostRecent == index)
+	{
+		mostRecent = older[index];
+	}
+
+	if (older[index] != NO_PARAMETER)
+	{
+		newer[older[index]] = newer[index];
+	}
+	else if (leastRecent == index)
+	{
+		leastRecent = newer[index];
+	}
+	newer[index] = older[index] = NO_PARAMETER;
+}
+
+
+int ParameterStore::indexOf(const std::string &name) const
+{
+	auto it = names.find(name);
+	return it == names.end() ? -1 : static_cast<int>(it->second);
+}
+
+
+const ParameterInfo &ParameterStore::info(uint32_t index) const
+{
+	return infos[index];
+}
+
+
+std::size_t ParameterStore::size() const
+{
+	return infos.size();
+}
+
+
+/**
+ * addListener
+ * Starts notifying a listener of registrations and changes. The listener is told about every parameter
+ * registered so far, so it can be added at any time.
+ *
+ * @param listener: The listener, it must be removed before it is destroyed
+ */
+void ParameterStore::addListener(ParameterListener *listener)
+{
+	if (std::find(listeners.begin(), listeners.end(), listener) != listeners.end())
+	{
+		return;
+	}
+	listeners.push_back(listener);
+	for (uint32_t index = 0; index < infos.size(); index++)
+	{
+		listener->parameterAdded(index, infos[index]);
+	}
+}
+
+
+void ParameterStore::removeListener(ParameterListener *listener)
+{
+	listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+
+
+
+uint64_t ParameterStore::getWord(uint32_t index) const
+{
+	return backBuffer[index];
+}
+
+
+void ParameterStore::setWord(uint32_t index, uint64_t word)
+{
+	if (backBuffer[index] != word)
+	{
+		uint64_t oldWord = backBuffer[index];
+		backBuffer[index] = word;
+		touch(index);
+		
+		for (ParameterListener *listener : listeners)
+		{
+			listener->parameterChanged(index, oldWord, word);
+		}
+	}
+}
+
+
+/**
+ * publish
+ * Copies the back buffer into the published buffer under the seqlock, so readers see either all of
+ * the previous values or all of the new ones. Called by the UI once per frame, which also batches the
+ * many writes of a slider drag into a single publish.
+ *
+ * @return bool: true if anything changed since the last publish
+ */
+bool ParameterStore::publish()
+{
+	if (!dirty)
+	{
+		return false;
+	}
+
+	/// Step 1: Mark the published buffer as being written, readers that overlap will retry
+	uint64_t begin = sequence.load(std::memory_order_relaxed) + 1;
+	sequence.store(begin, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release); // The odd sequence is visible before any of the new words
+
+
+	/// Step 2: Copy the values, their change versions and the recency order
+	std::size_t count = infos.size();
+	for (std::size_t i = 0; i < count; i++)
+	{
+		published[i].store(backBuffer[i], std::memory_order_relaxed);
+		publishedVersions[i].store(versions[i], std::memory_order_relaxed);
+	}
+	std::size_t position = 0;
+	for (uint32_t index = mostRecent; index != NO_PARAMETER; index = older[index])
+	{
+		publishedRecency[position++].store(index, std::memory_order_relaxed);
+	}
+	publishedCount.store(static_cast<uint32_t>(count), std::memory_order_relaxed);
+
+
+	/// Step 3: Mark the buffer as consistent again
+	sequence.store(begin + 1, std::memory_order_release);
+	dirty = false;
+	return true;
+}
+
+
+bool ParameterStore::hasUnpublishedChanges() const
+{
+	return dirty;
+}
+
+
+uint64_t ParameterStore::changeVersion() const
+{
+	return changeCounter;
+}
+
+
+uint64_t ParameterStore::changeVersion(uint32_t index) const
+{
+	return versions[index];
+}
+
+
+
+/**
+ * setDerived
+ * Marks a parameter as derived from other parameters. Its value still changes through setWord and
+ * listeners still hear of it, but listeners that record user edits (e.g. UndoHistory) skip it, since
+ * undoing the edit of an input re-derives it.
+ *
+ * @param index: The parameter to mark
+ * @param isDerivedParameter: Whether it is computed from others
+ */
+void ParameterStore::setDerived(uint32_t index, bool isDerivedParameter)
+{
+	derived[index] = isDerivedParameter;
+}
+
+
+bool ParameterStore::isDerived(uint32_t index) const
+{
+	return derived[index];
+}
+
+
+
+
+/**
+ * read
+ * Copies a consistent set of the published values into a snapshot. Lock-free: if a publish
+ * overlaps the copy, the copy is simply repeated.
+ *
+ * @param snapshot: The snapshot to fill
+ */
+void ParameterStore::read(ParameterSnapshot &snapshot) const
+{
+	while (true)
+	{
+		uint64_t begin = sequence.load(std::memory_order_acquire);
+		if (begin & 1)
+		{
+			continue; // A publish is in progress
+		}
+
+		std::size_t count = publishedCount.load(std::memory_order_relaxed);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			snapshot.words[i] = published[i].load(std::memory_order_relaxed);
+			snapshot.versions[i] = publishedVersions[i].load(std::memory_order_relaxed);
+			snapshot.recency[i] = publishedRecency[i].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire); // The words are read before the sequence is checked again
+		if (sequence.load(std::memory_order_relaxed) == begin)
+		{
+			snapshot.count = count;
+			snapshot.snapshotVersion = begin / 2;
+			return;
+		}
+	}
+}
+
+
+/**
+ * readIfNewer
+ * Refreshes a snapshot only if a newer version has been published, so a simulation step that finds
+ * nothing changed costs a single atomic load.
+ *
+ * @param snapshot: The snapshot to refresh
+ * @return bool: true if the snapshot was refreshed
+ */
+bool ParameterStore::readIfNewer(ParameterSnapshot &snapshot) const
+{
+	if (version() == snapshot.version())
+	{
+		return false;
+	}
+	read(snapshot);
+	return true;
+}
+
+
+/**
+ * version
+ * Returns the number of completed publishes. While a publish is in progress the previous count is returned.
+ */
+uint64_t ParameterStore::version() const
+{
+	return sequence.load(std::memory_order_acquire) / 2;
+}
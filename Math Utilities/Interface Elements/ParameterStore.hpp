@@ -0,0 +1,344 @@
+//  ParameterStore.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Parameter Store header file declares the components that hand widget-edited parameters to
+ * simulation threads without data races.
+ *
+ * These components include:
+ *   - ParameterHandle: A typed handle (float, double, int64_t, bool) identifying one parameter of a store.
+ *   - ParameterInfo: The registered name, type and range of a parameter.
+ *   - ParameterSnapshot: A consistent copy of every parameter, taken by a simulation thread.
+ *   - ParameterStore: The store itself, owned by the UI thread and read by any number of simulation threads.
+ *
+ * Widgets (Slider, TextField) bind to handles instead of raw pointers. Their writes go into the UI
+ * thread's back buffer, which the UI sees immediately. Once per frame the UI calls publish(), which
+ * copies the back buffer into the published buffer under a seqlock. A simulation thread calls read()
+ * (or readIfNewer()) at a step boundary: the read side never takes a lock, it only retries in the rare
+ * case that a publish overlapped it, and a step therefore never sees a mix of old and new parameters.
+ *
+ * Every value occupies one 64-bit word, so the published buffer is a plain array of atomic words.
+ *
+ * Parameters are versioned: every change stamps the parameter with the next value of a store-wide,
+ * monotonically increasing change version, and the store keeps its parameters ordered by their last
+ * change. "What changed since version N" is therefore answered by walking that order from the most
+ * recent change until a parameter older than N is reached, in O(changed) rather than O(parameters).
+ * Snapshots carry the versions and the order with them, so simulation threads can ask the same
+ * question of the values they actually use (e.g. to skip a tree rebuild when only unrelated
+ * parameters moved).
+ *
+ * ParameterListeners (e.g. the ParameterJournal) are notified on the UI thread of every registration
+ * and every change, with the old and new value.
+ */
+
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+
+
+
+
+
+/// The value types a parameter can have.
+enum class ParameterType : uint8_t
+{
+	Float,
+	Double,
+	Int64,
+	Bool
+};
+
+
+/// Maps a C++ type to its ParameterType, only the supported types are defined.
+template<typename T> struct ParameterTraits;
+template<> struct ParameterTraits<float> { static constexpr ParameterType type = ParameterType::Float; };
+template<> struct ParameterTraits<double> { static constexpr ParameterType type = ParameterType::Double; };
+template<> struct ParameterTraits<int64_t> { static constexpr ParameterType type = ParameterType::Int64; };
+template<> struct ParameterTraits<bool> { static constexpr ParameterType type = ParameterType::Bool; };
+
+
+/// Stores a parameter value in a 64-bit word, bit for bit.
+template<typename T>
+uint64_t encodeParameter(T value)
+{
+	static_assert(std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(uint64_t), "Parameters must fit in one 64-bit word");
+	uint64_t word = 0;
+	std::memcpy(&word, &value, sizeof(T));
+	return word;
+}
+
+
+/// Reads a parameter value back out of a 64-bit word.
+template<typename T>
+T decodeParameter(uint64_t word)
+{
+	static_assert(std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(uint64_t), "Parameters must fit in one 64-bit word");
+	T value;
+	std::memcpy(&value, &word, sizeof(T));
+	return value;
+}
+
+
+double parameterAsDouble(ParameterType type, uint64_t word); // Converts a parameter word of any type to double, for display and ranges
+uint64_t parameterFromDouble(ParameterType type, double value); // Converts a double to a parameter word of the given type
+
+
+
+
+/**
+ * ParameterHandle struct identifying a parameter of type T in a ParameterStore.
+ */
+template<typename T>
+struct ParameterHandle
+{
+	static constexpr uint32_t INVALID = 0xFFFFFFFFu; // Index of a handle that refers to nothing
+	uint32_t index = INVALID; // The slot of the parameter in its store
+
+	bool valid() const { return index != INVALID; }
+};
+
+
+
+
+/**
+ * ParameterInfo struct describing a registered parameter.
+ */
+struct ParameterInfo
+{
+	std::string name; // Unique name of the parameter
+	ParameterType type; // The value type
+	double min, max; // The accepted range, used by widgets and validation
+	double defaultValue; // The value the parameter was registered with
+};
+
+
+
+
+
+
+
+
+/**
+ * ParameterListener class, the interface of components that observe a ParameterStore's registrations
+ * and changes. Notifications arrive on the UI thread, inside ParameterStore::add and ParameterStore::set.
+ */
+class ParameterListener
+{
+public:
+	virtual ~ParameterListener() = default;
+	virtual void parameterAdded(uint32_t /*index*/, const ParameterInfo &/*info*/) {} // A parameter was registered (or already was when the listener was added)
+	virtual void parameterChanged(uint32_t index, uint64_t oldWord, uint64_t newWord) = 0; // A parameter's value changed
+};
+
+
+
+
+
+
+
+
+/**
+ * ParameterSnapshot class representing a consistent copy of all published parameters.
+ *
+ * A simulation thread keeps one snapshot and refreshes it at step boundaries; reading values out of
+ * it is plain memory access.
+ */
+class ParameterSnapshot
+{
+public:
+	static constexpr std::size_t CAPACITY = 256; // Maximum number of parameters in a store
+
+	/// ------------- Access -------------
+	/// \{
+	template<typename T>
+	T get(ParameterHandle<T> handle) const { return decodeParameter<T>(words[handle.index]); } // The value of a parameter
+	uint64_t word(uint32_t index) const; // The raw word of a parameter
+	std::size_t size() const; // Number of parameters in the snapshot
+	uint64_t version() const; // The publish count the snapshot was taken at, 0 before the first publish
+							  /// \}
+
+
+	/// ------------- Change Versions -------------
+	/// \{
+	uint64_t changeVersion() const; // The change version of the most recent change in the snapshot
+	uint64_t changeVersion(uint32_t index) const; // The change version of a parameter's last change
+	template<typename T>
+	bool changedSince(ParameterHandle<T> handle, uint64_t since) const { return changeVersion(handle.index) > since; } // Whether a parameter changed after 'since'
+	template<typename Function>
+	std::size_t forEachChangedSince(uint64_t since, Function function) const; // Calls function(index) for every parameter changed after 'since', most recent first
+																			   /// \}
+
+
+private:
+	friend class ParameterStore;
+
+	std::array<uint64_t, CAPACITY> words{}; // The parameter values
+	std::array<uint64_t, CAPACITY> versions{}; // The change version of every parameter
+	std::array<uint32_t, CAPACITY> recency{}; // Parameter indices, most recently changed first
+	std::size_t count = 0; // Number of valid words
+	uint64_t snapshotVersion = 0; // The version the values were published with
+};
+
+
+
+
+
+
+
+
+/**
+ * ParameterStore class representing typed parameters shared between the UI thread and simulation threads.
+ *
+ * Registration, get/set and publish belong to the UI thread (a single writer). read, readIfNewer and
+ * version may be called from any number of threads concurrently and never block.
+ */
+class ParameterStore
+{
+public:
+	/// ------------- Constructor and Access -------------
+	/// \{
+	ParameterStore(); // Creates an empty store
+	ParameterStore(const ParameterStore &) = delete;
+	ParameterStore &operator=(const ParameterStore &) = delete;
+	static ParameterStore &global(); // The store shared by the application's widgets
+									 /// \}
+
+
+	/// ------------- Registration (UI Thread) -------------
+	/// \{
+	template<typename T>
+	ParameterHandle<T> add(const std::string &name, T initialValue, double min, double max); // Registers a parameter, or returns the existing one of the same name and type
+	template<typename T>
+	ParameterHandle<T> find(const std::string &name) const; // The handle of a parameter, invalid if unknown or of another type
+	int indexOf(const std::string &name) const; // The index of a parameter, -1 if unknown
+	const ParameterInfo &info(uint32_t index) const; // The description of a parameter
+	std::size_t size() const; // Number of registered parameters
+	void addListener(ParameterListener *listener); // Starts notifying 'listener', which first hears of every registered parameter
+	void removeListener(ParameterListener *listener); // Stops notifying 'listener'
+							  /// \}
+
+
+	/// ------------- Back Buffer (UI Thread) -------------
+	/// \{
+	template<typename T>
+	T get(ParameterHandle<T> handle) const { return decodeParameter<T>(backBuffer[handle.index]); } // The value as last set by the UI
+	template<typename T>
+	void set(ParameterHandle<T> handle, T value) { setWord(handle.index, encodeParameter(value)); } // Changes a value, simulation threads see it after the next publish
+	uint64_t getWord(uint32_t index) const; // The raw word of a parameter in the back buffer
+	void setWord(uint32_t index, uint64_t word); // Changes the raw word of a parameter
+	bool publish(); // Makes the back buffer visible to readers if it changed, returns whether it did
+	bool hasUnpublishedChanges() const; // Whether the back buffer changed since the last publish
+										/// \}
+
+
+	/// ------------- Derived Parameters (UI Thread) -------------
+	/// \{
+	void setDerived(uint32_t index, bool derived); // Marks a parameter as computed from others (e.g. by an expression) rather than edited directly
+	bool isDerived(uint32_t index) const; // Whether a parameter is computed from others
+										  /// \}
+
+
+	/// ------------- Change Versions (UI Thread) -------------
+	/// \{
+	uint64_t changeVersion() const; // The change version of the most recent change
+	uint64_t changeVersion(uint32_t index) const; // The change version of a parameter's last change
+	template<typename Function>
+	std::size_t forEachChangedSince(uint64_t since, Function function) const; // Calls function(index) for every parameter changed after 'since', most recent first
+																			   /// \}
+
+
+	/// ------------- Published Values (Any Thread) -------------
+	/// \{
+	void read(ParameterSnapshot &snapshot) const; // Copies a consistent set of the published values
+	bool readIfNewer(ParameterSnapshot &snapshot) const; // Refreshes 'snapshot' only if a newer version was published
+	uint64_t version() const; // Number of publishes so far
+							  /// \}
+
+
+private:
+	uint32_t registerParameter(ParameterInfo parameterInfo, uint64_t word); // Adds a parameter record and its initial value
+	void touch(uint32_t index); // Stamps a parameter with the next change version and moves it to the front of the recency list
+	void unlink(uint32_t index); // Removes a parameter from the recency list
+
+	static const uint32_t NO_PARAMETER = 0xFFFFFFFFu; // End marker of the recency list
+
+	std::vector<ParameterInfo> infos; // Parameter descriptions, indexed by handle
+	std::unordered_map<std::string, uint32_t> names; // Parameter indices by name
+	std::vector<ParameterListener*> listeners; // Observers of registrations and changes
+	std::array<uint64_t, ParameterSnapshot::CAPACITY> backBuffer{}; // Values written by the UI
+	std::array<uint64_t, ParameterSnapshot::CAPACITY> versions{}; // Change version of every parameter
+	std::array<bool, ParameterSnapshot::CAPACITY> derived{}; // Whether each parameter is computed from others
+	std::array<uint32_t, ParameterSnapshot::CAPACITY> newer{}, older{}; // Doubly linked recency list, by parameter index
+	uint32_t mostRecent = NO_PARAMETER, leastRecent = NO_PARAMETER; // Ends of the recency list
+	uint64_t changeCounter = 0; // The last change version handed out
+	bool dirty = false; // Whether the back buffer differs from the published values
+
+	alignas(64) std::atomic<uint64_t> sequence{0}; // Seqlock counter: odd while a publish is in progress, twice the version otherwise
+	std::atomic<uint32_t> publishedCount{0}; // Number of published parameters
+	std::array<std::atomic<uint64_t>, ParameterSnapshot::CAPACITY> published; // Values visible to readers
+	std::array<std::atomic<uint64_t>, ParameterSnapshot::CAPACITY> publishedVersions; // Change versions visible to readers
+	std::array<std::atomic<uint32_t>, ParameterSnapshot::CAPACITY> publishedRecency; // Recency order visible to readers
+};
+
+
+
+
+template<typename Function>
+std::size_t ParameterSnapshot::forEachChangedSince(uint64_t since, Function function) const
+{
+	std::size_t visited = 0;
+	for (std::size_t i = 0; i < count && versions[recency[i]] > since; i++, visited++)
+	{
+		function(recency[i]);
+	}
+	return visited;
+}
+
+
+template<typename Function>
+std::size_t ParameterStore::forEachChangedSince(uint64_t since, Function function) const
+{
+	std::size_t visited = 0;
+	for (uint32_t index = mostRecent; index != NO_PARAMETER && versions[index] > since; index = older[index], visited++)
+	{
+		function(index);
+	}
+	return visited;
+}
+
+
+
+
+template<typename T>
+ParameterHandle<T> ParameterStore::add(const std::string &name, T initialValue, double min, double max)
+{
+	ParameterHandle<T> handle = find<T>(name);
+	if (handle.valid() || indexOf(name) >= 0 || infos.size() >= ParameterSnapshot::CAPACITY)
+	{
+		return handle; // Already registered (invalid if with another type), or the store is full
+	}
+
+	handle.index = registerParameter({name, ParameterTraits<T>::type, min, max, parameterAsDouble(ParameterTraits<T>::type, encodeParameter(initialValue))}, encodeParameter(initialValue));
+	return handle;
+}
+
+
+template<typename T>
+ParameterHandle<T> ParameterStore::find(const std::string &name) const
+{
+	ParameterHandle<T> handle;
+	int index = indexOf(name);
+	if (index >= 0 && infos[index].type == ParameterTraits<T>::type)
+	{
+		handle.index = static_cast<uint32_t>(index);
+	}
+	return handle;
+}
@@ -0,0 +1,414 @@
+//  ParameterSweep.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "ParameterSweep.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+
+
+
+
+
+/**
+ * valueAt
+ * Returns the i-th of 'count' values spaced evenly, in value or in log10, from 'first' to 'last'.
+ *
+ * @param i: The index of the value, from 0 to count - 1
+ * @return double: The value
+ */
+double SweepRange::valueAt(int i) const
+{
+	if (count <= 1)
+	{
+		return first;
+	}
+	double t = static_cast<double>(i) / (count - 1);
+	if (logarithmic)
+	{
+		return std::pow(10.0, std::log10(first) + t * (std::log10(last) - std::log10(first)));
+	}
+	return first + t * (last - first);
+}
+
+
+
+
+
+
+
+
+ParameterSweep::ParameterSweep()
+{
+}
+
+
+ParameterSweep::~ParameterSweep()
+{
+	cancel();
+	pool.reset(); // Waits for the simulations in progress, which write into the members below
+	releaseResultsTable();
+}
+
+
+
+
+/**
+ * start
+ * Validates the ranges and queues one simulation per combination of their values. The settings of each
+ * simulation are the store's current values with the swept parameters replaced. The rows of the previous
+ * sweep stop responding; releaseStaleResultsTable removes them and fillResultsTable lists the new results
+ * once they are collected. start may be called from a button of the results table, so it leaves the
+ * table's buttons alone.
+ *
+ * @param ranges: The ranges, each over a different registered simulation parameter
+ * @param configuration: The simulation each combination runs
+ * @param store: The store the parameters are registered in
+ * @return bool: true if the sweep was queued
+ */
+bool ParameterSweep::start(const std::vector<SweepRange> &ranges, const SweepConfiguration &configuration, const ParameterStore &store)
+{
+	if (isRunning())
+	{
+		ofLogWarning("ParameterSweep") << "A sweep is already running, not starting another";
+		return false;
+	}
+
+	/// Step 1: Take the base settings from the store and validate the ranges
+	SimulationSettings base;
+	for (uint32_t i = 0; i < store.size(); i++)
+	{
+		base.set(store.info(i).name, parameterAsDouble(store.info(i).type, store.getWord(i))); // Parameters that are not settings are ignored
+	}
+	std::size_t combinations = 1;
+	for (const SweepRange &range : ranges)
+	{
+		SimulationSettings probe;
+		if (store.indexOf(range.parameter) < 0 || !probe.set(range.parameter, range.first))
+		{
+			ofLogError("ParameterSweep") << "\"" << range.parameter << "\" is not a registered simulation parameter";
+			return false;
+		}
+		if (range.count < 1 || (range.logarithmic && (range.first <= 0 || range.last <= 0)))
+		{
+			ofLogError("ParameterSweep") << "Invalid range for \"" << range.parameter << "\"";
+			return false;
+		}
+		combinations *= range.count;
+	}
+
+
+	/// Step 2: Lay out one result slot per combination, the last range varying fastest
+	resultsStale = true; // The rows of the previous sweep must not read the slots the workers are about to write
+	sweepRanges = ranges;
+	sweepResults.assign(combinations, SweepResult());
+	for (std::size_t run = 0; run < combinations; run++)
+	{
+		std::size_t remainder = run;
+		sweepResults[run].values.resize(ranges.size());
+		for (std::size_t r = ranges.size(); r-- > 0;)
+		{
+			sweepResults[run].values[r] = ranges[r].valueAt(static_cast<int>(remainder % ranges[r].count));
+			remainder /= ranges[r].count;
+		}
+	}
+	runCount = combinations;
+	completed.store(0, std::memory_order_relaxed);
+	cancelled.store(false, std::memory_order_relaxed);
+	reported = false;
+
+
+	/// Step 3: Queue the simulations, the pool's queue hands them to whichever core is free
+	if (!pool)
+	{
+		pool.reset(new WorkerPool(std::max(1u, std::thread::hardware_concurrency())));
+	}
+	for (std::size_t run = 0; run < combinations; run++)
+	{
+		SimulationSettings settings = base;
+		for (std::size_t r = 0; r < ranges.size(); r++)
+		{
+			settings.set(ranges[r].parameter, sweepResults[run].values[r]);
+		}
+		pool->submit([this, run, settings, configuration]() {
+			if (!cancelled.load(std::memory_order_relaxed))
+			{
+				SweepResult measured = ParameterSweep::run(settings, configuration);
+				measured.values = std::move(sweepResults[run].values);
+				sweepResults[run] = std::move(measured);
+			}
+			completed.fetch_add(1, std::memory_order_release); // Publishes the slot to the UI thread
+		});
+	}
+	ofLogNotice("ParameterSweep") << "Running " << combinations << " simulations on " << pool->threadCount() << " threads";
+	return true;
+}
+
+
+void ParameterSweep::cancel()
+{
+	cancelled.store(true, std::memory_order_relaxed);
+}
+
+
+bool ParameterSweep::isRunning() const
+{
+	return completed.load(std::memory_order_acquire) < runCount;
+}
+
+
+/**
+ * collect
+ * Reports the end of a sweep once, so the UI thread can poll it every frame and publish the results.
+ *
+ * @return bool: true on the first call after all simulations of the sweep finished
+ */
+bool ParameterSweep::collect()
+{
+	if (reported || isRunning())
+	{
+		return false;
+	}
+	reported = true;
+	return true;
+}
+
+
+std::size_t ParameterSweep::completedRuns() const
+{
+	return completed.load(std::memory_order_acquire);
+}
+
+
+std::size_t ParameterSweep::totalRuns() const
+{
+	return runCount;
+}
+
+
+
+
+/**
+ * run
+ * Runs one simulation of a uniform disk and measures it. The disk's mass is 1/G so that its dynamical time
+ * is of order one whatever G is, which keeps dt meaningful across values of G.
+ *
+ * @param settings: The parameters of the simulation
+ * @param configuration: The size and length of the simulation
+ * @return SweepResult: The measurements, without parameter values
+ */
+SweepResult ParameterSweep::run(const SimulationSettings &settings, const SweepConfiguration &configuration)
+{
+	SweepResult result;
+	auto begin = std::chrono::steady_clock::now();
+	NBodySimulation simulation(NBodySimulation::uniformDisk(configuration.bodies, 1.0, 1.0 / settings.G, settings.G, configuration.seed), settings);
+	if (simulation.bodies.empty())
+	{
+		return result;
+	}
+
+	/// Step 1: Force error of the initial state, on bodies spread evenly through the list
+	simulation.computeAccelerations();
+	std::size_t samples = std::min(configuration.errorSamples, simulation.bodies.size());
+	double squaredErrors = 0;
+	for (std::size_t s = 0; s < samples; s++)
+	{
+		std::size_t index = s * simulation.bodies.size() / samples;
+		Vec2D exact = simulation.directAcceleration(index);
+		Vec2D difference = simulation.bodies[index].acceleration - exact;
+		double relative = exact.vectorSquareLength() > 0 ? std::sqrt(difference.vectorSquareLength() / exact.vectorSquareLength()) : 0;
+		squaredErrors += relative * relative;
+		result.forceErrorMax = std::max(result.forceErrorMax, relative);
+	}
+	result.forceErrorRms = samples > 0 ? std::sqrt(squaredErrors / samples) : 0;
+
+
+	/// Step 2: Step the simulation, timing only the steps
+	double initialEnergy = simulation.totalEnergy();
+	auto stepsBegin = std::chrono::steady_clock::now();
+	for (int step = 0; step < configuration.steps; step++)
+	{
+		simulation.step();
+	}
+	auto stepsEnd = std::chrono::steady_clock::now();
+	double finalEnergy = simulation.totalEnergy();
+
+
+	/// Step 3: Derive the metrics
+	result.millisecondsPerStep = configuration.steps > 0 ? std::chrono::duration<double, std::milli>(stepsEnd - stepsBegin).count() / configuration.steps : 0;
+	result.energyDrift = initialEnergy != 0 ? std::fabs(finalEnergy - initialEnergy) / std::fabs(initialEnergy) : 0;
+	result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	return result;
+}
+
+
+
+
+/**
+ * writeCsv
+ * Writes the results of the last sweep, one line per simulation, in result order.
+ *
+ * @param path: The file to write
+ * @return bool: true if the file was written
+ */
+bool ParameterSweep::writeCsv(const std::string &path) const
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		ofLogError("ParameterSweep") << "Could not write " << path;
+		return false;
+	}
+	for (const SweepRange &range : sweepRanges)
+	{
+		file << range.parameter << ',';
+	}
+	file << "wall_seconds,ms_per_step,energy_drift,force_error_rms,force_error_max\n";
+	file << std::setprecision(9);
+	for (const SweepResult &result : sweepResults)
+	{
+		for (double value : result.values)
+		{
+			file << value << ',';
+		}
+		file << result.wallSeconds << ',' << result.millisecondsPerStep << ',' << result.energyDrift << ',' << result.forceErrorRms << ',' << result.forceErrorMax << '\n';
+	}
+	return static_cast<bool>(file);
+}
+
+
+/**
+ * fillResultsTable
+ * Adds three sort buttons and one button per result to a table, replacing what an earlier sweep added.
+ * The buttons stay owned by the sweep; clicking a result applies its parameters to the store.
+ *
+ * @param table: The table to list the results in
+ * @param store: The store clicked results are applied to
+ */
+void ParameterSweep::fillResultsTable(Table &table, ParameterStore &store)
+{
+	releaseResultsTable();
+	resultsTable = &table;
+	resultsStale = false;
+
+	/// Step 1: Sort buttons
+	headerButtons.emplace_back(new Button("Sort by time per step", 0, 0, 20, 20, [this]() { sortResults(SweepMetric::TimePerStep); }));
+	headerButtons.emplace_back(new Button("Sort by energy drift", 0, 0, 20, 20, [this]() { sortResults(SweepMetric::EnergyDrift); }));
+	headerButtons.emplace_back(new Button("Sort by force error", 0, 0, 20, 20, [this]() { sortResults(SweepMetric::ForceError); }));
+	for (std::unique_ptr<Button> &button : headerButtons)
+	{
+		Button *pointer = button.get();
+		table.addButtonElement(pointer);
+	}
+
+
+	/// Step 2: One row per result
+	firstRow = table.buttonElements.size();
+	for (std::size_t i = 0; i < sweepResults.size(); i++)
+	{
+		const SweepResult &result = sweepResults[i];
+		std::ostringstream label;
+		label << std::setprecision(3);
+		for (std::size_t r = 0; r < sweepRanges.size(); r++)
+		{
+			label << sweepRanges[r].parameter << '=' << result.values[r] << ' ';
+		}
+		label << "| " << result.millisecondsPerStep << " ms/step | drift " << result.energyDrift << " | error " << result.forceErrorRms;
+		rowButtons.emplace_back(new Button(label.str(), 0, 0, 20, 20, [this, i, &store]() { if (!resultsStale) { apply(sweepResults[i], store); } }));
+		Button *pointer = rowButtons.back().get();
+		table.addButtonElement(pointer);
+		rowOrder.push_back(i);
+	}
+}
+
+
+/**
+ * sortResults
+ * Reorders the result rows of the results table, lowest value of the metric first. The rows are permuted in
+ * place, so this is safe to call from a button of the same table while it dispatches a click.
+ *
+ * @param metric: The metric to sort by
+ */
+void ParameterSweep::sortResults(SweepMetric metric)
+{
+	if (resultsStale)
+	{
+		return; // The results are being rewritten by a running sweep
+	}
+	auto key = [this, metric](std::size_t i) {
+		const SweepResult &result = sweepResults[i];
+		return metric == SweepMetric::TimePerStep ? result.millisecondsPerStep : metric == SweepMetric::EnergyDrift ? result.energyDrift : result.forceErrorRms;
+	};
+	std::stable_sort(rowOrder.begin(), rowOrder.end(), [&key](std::size_t a, std::size_t b) { return key(a) < key(b); });
+	if (resultsTable && firstRow + rowOrder.size() <= resultsTable->buttonElements.size())
+	{
+		for (std::size_t k = 0; k < rowOrder.size(); k++)
+		{
+			resultsTable->buttonElements[firstRow + k] = rowButtons[rowOrder[k]].get();
+		}
+	}
+}
+
+
+/**
+ * apply
+ * Sets the swept parameters to the values of a result, clamped to their registered ranges.
+ *
+ * @param result: A result of the last sweep
+ * @param store: The store the parameters are registered in
+ */
+void ParameterSweep::apply(const SweepResult &result, ParameterStore &store) const
+{
+	for (std::size_t r = 0; r < sweepRanges.size() && r < result.values.size(); r++)
+	{
+		int index = store.indexOf(sweepRanges[r].parameter);
+		if (index >= 0)
+		{
+			const ParameterInfo &info = store.info(index);
+			store.setWord(index, parameterFromDouble(info.type, std::min(std::max(result.values[r], info.min), info.max)));
+		}
+	}
+}
+
+
+
+
+/**
+ * releaseStaleResultsTable
+ * Removes the rows of the previous sweep from the results table once a new sweep started. Call it from
+ * the UI thread outside of the tables' event handling, e.g. once per frame.
+ */
+void ParameterSweep::releaseStaleResultsTable()
+{
+	if (resultsStale && resultsTable)
+	{
+		releaseResultsTable();
+	}
+}
+
+
+void ParameterSweep::releaseResultsTable()
+{
+	if (resultsTable)
+	{
+		std::vector<Button*> &buttons = resultsTable->buttonElements;
+		auto owned = [this](Button *button) {
+			for (const std::unique_ptr<Button> &header : headerButtons) { if (header.get() == button) { return true; } }
+			for (const std::unique_ptr<Button> &row : rowButtons) { if (row.get() == button) { return true; } }
+			return false;
+		};
+		buttons.erase(std::remove_if(buttons.begin(), buttons.end(), owned), buttons.end());
+	}
+	resultsTable = nullptr;
+	headerButtons.clear();
+	rowButtons.clear();
+	rowOrder.clear();
+	firstRow = 0;
+}
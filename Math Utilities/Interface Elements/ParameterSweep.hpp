@@ -0,0 +1,153 @@
+//  ParameterSweep.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Parameter Sweep header file declares a runner that explores ranges of the interface's simulation
+ * parameters with headless simulations on every core.
+ *
+ * These components include:
+ *   - SweepRange: The values one registered parameter takes, linearly or logarithmically spaced.
+ *   - SweepConfiguration: The size and length of every simulation of a sweep.
+ *   - SweepResult: The parameter values of one simulation and what it measured: wall time, time per step,
+ *     relative energy drift and the Barnes-Hut force error against direct summation.
+ *   - ParameterSweep: Runs the cartesian product of the ranges as jobs on its own WorkerPool (one worker per
+ *     core), writes the results to a CSV file and lists them in a Table whose rows can be sorted by any
+ *     metric and clicked to apply their parameters.
+ *
+ * A sweep starts from the store's current values, so parameters that are not swept keep the values the
+ * interface shows. Every simulation writes only its own result slot, so the workers share nothing but a
+ * completion counter.
+ */
+
+
+#pragma once
+#include "ofMain.h"
+#include "WorkerPool.hpp"
+#include "NavigationalComponents.hpp"
+#include "ParameterStore.hpp"
+#include "NBodySimulation.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+
+
+
+
+/**
+ * SweepRange struct, the values a sweep gives one parameter.
+ */
+struct SweepRange
+{
+	std::string parameter; // The registered name of the parameter: "theta", "G", "e" or "dt"
+	double first = 0, last = 0; // The first and last value
+	int count = 1; // Number of values, evenly spaced from 'first' to 'last'
+	bool logarithmic = false; // Space the values evenly in log10 instead, both ends must be positive
+
+	double valueAt(int i) const; // The i-th value of the range
+};
+
+
+/**
+ * SweepConfiguration struct, the simulation every point of a sweep runs.
+ */
+struct SweepConfiguration
+{
+	std::size_t bodies = 512; // Bodies per simulation
+	int steps = 200; // Time steps per simulation
+	std::size_t errorSamples = 64; // Bodies whose force error is measured against direct summation
+	uint32_t seed = 1; // Seeds the initial conditions, every simulation of a sweep starts from the same bodies
+};
+
+
+/**
+ * SweepResult struct, the measurements of one simulation.
+ */
+struct SweepResult
+{
+	std::vector<double> values; // The value of each swept parameter, in the order of the ranges
+	double wallSeconds = 0; // Time taken by the whole run, energy measurements included
+	double millisecondsPerStep = 0; // Average time of one step
+	double energyDrift = 0; // |E_end - E_start| / |E_start|
+	double forceErrorRms = 0; // Root mean square relative Barnes-Hut acceleration error over the sampled bodies
+	double forceErrorMax = 0; // Largest relative acceleration error over the sampled bodies
+};
+
+
+/// The metrics a results table can be sorted by.
+enum class SweepMetric
+{
+	TimePerStep,
+	EnergyDrift,
+	ForceError
+};
+
+
+
+
+
+
+
+
+/**
+ * ParameterSweep class representing a parameter sweep and its results.
+ *
+ * Start, poll and display a sweep from the UI thread; only the simulations run on the workers.
+ */
+class ParameterSweep
+{
+public:
+	/// ------------- Constructor and Destructor -------------
+	/// \{
+	ParameterSweep(); // Creates an idle sweep, the worker threads start with the first sweep
+	~ParameterSweep(); // Cancels a running sweep and waits for the simulations in progress
+	ParameterSweep(const ParameterSweep &) = delete;
+	ParameterSweep &operator=(const ParameterSweep &) = delete;
+	/// \}
+
+
+	/// ------------- Running -------------
+	/// \{
+	bool start(const std::vector<SweepRange> &ranges, const SweepConfiguration &configuration, const ParameterStore &store); // Queues every combination of the ranges, false if a range is invalid or a sweep is running
+	void cancel(); // Skips the simulations that have not started yet
+	bool isRunning() const; // Whether simulations are queued or running
+	bool collect(); // true once, on the first call after a sweep finished
+	std::size_t completedRuns() const; // Number of simulations finished (or skipped) so far
+	std::size_t totalRuns() const; // Number of simulations of the current sweep
+	static SweepResult run(const SimulationSettings &settings, const SweepConfiguration &configuration); // Runs and measures one simulation on the calling thread
+																										 /// \}
+
+
+	/// ------------- Results (after the sweep finished) -------------
+	/// \{
+	const std::vector<SweepResult> &results() const { return sweepResults; } // One result per combination, the last range varying fastest
+	const std::vector<SweepRange> &ranges() const { return sweepRanges; } // The ranges of the last sweep
+	bool writeCsv(const std::string &path) const; // Writes one line per simulation, with a header line
+	void fillResultsTable(Table &table, ParameterStore &store); // Lists the results as buttons that apply their parameters, after buttons that sort them
+	void sortResults(SweepMetric metric); // Reorders the rows of the results table, best first
+	void releaseStaleResultsTable(); // Removes the rows of the previous sweep once another started, outside of the tables' event handling
+	void apply(const SweepResult &result, ParameterStore &store) const; // Sets the swept parameters to the values of a result
+																		/// \}
+
+
+private:
+	void releaseResultsTable(); // Removes the buttons this sweep added to its results table
+
+	std::vector<SweepRange> sweepRanges; // The ranges of the last sweep
+	std::vector<SweepResult> sweepResults; // Preallocated, each job writes only its own slot
+	std::size_t runCount = 0; // Number of simulations of the last sweep
+	std::atomic<std::size_t> completed{0}; // Simulations finished or skipped
+	std::atomic<bool> cancelled{false}; // Whether queued simulations should be skipped
+	bool reported = true; // Whether collect() already reported the last sweep
+
+	Table *resultsTable = nullptr; // The table listing the results
+	bool resultsStale = false; // Whether a sweep started since the table was filled, so its rows no longer match sweepResults
+	std::vector<std::unique_ptr<Button>> headerButtons; // The sort buttons, owned here
+	std::vector<std::unique_ptr<Button>> rowButtons; // One button per result, in result order, owned here
+	std::vector<std::size_t> rowOrder; // The results in table order
+	std::size_t firstRow = 0; // Index of the first row button in the table's button list
+
+	std::unique_ptr<WorkerPool> pool; // One worker per core, destroyed first so no job outlives the members above
+};
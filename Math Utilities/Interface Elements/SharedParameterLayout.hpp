@@ -0,0 +1,351 @@
+//  SharedParameterLayout.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Shared Parameter Layout header file documents the POSIX shared-memory segment through which the UI
+ * hands parameters to a simulation running in another process, and declares the consumer's view of it.
+ *
+ * The UI side (SharedParameterSegment) mirrors a ParameterStore into the segment; the simulation maps
+ * the same segment and reads the values in place, so updates cross the process boundary without
+ * copies or sockets. This header depends only on the C++ standard library, POSIX and
+ * ParameterStore.hpp, so the simulation can include it without openFrameworks.
+ *
+ * Segment layout (shm_open name, e.g. "/ofui_parameters"; native byte order, 64-byte aligned):
+ *
+ *   offset 0:   SharedSegmentHeader (64 bytes)
+ *                 magic "UIPARAM1", formatVersion, capacity (number of fields),
+ *                 parameterCount (fields 0..parameterCount-1 are registered),
+ *                 consumerWaiting (set by a consumer blocked on the doorbell),
+ *                 changeCounter (incremented after every field change),
+ *                 producerPid (process id of the UI that last opened the segment)
+ *   offset 64:  SharedParameterField x capacity (64 bytes each, one cache line per field)
+ *                 sequence (per-field counter: odd while the field is being written, +2 per change),
+ *                 word (value encoded as by encodeParameter), changeVersion (the ParameterStore's change
+ *                 version of the value), min, max, type (ParameterType), name (zero-terminated)
+ *
+ * Field index i is the parameter's index in the UI's ParameterStore. A field's metadata (name, type,
+ * range) is written before parameterCount is raised past it and only changes if a restarted UI
+ * registers different parameters; its value words are written under the field's sequence counter, so a
+ * reader retries while 'sequence' is odd or changed during the read. Comparing a field's sequence with
+ * the one seen last tells whether it changed.
+ *
+ * Doorbell: a named FIFO at sharedDoorbellPath(name). A consumer that wants to block sets
+ * consumerWaiting, re-checks changeCounter and polls the FIFO; the producer writes one byte to the FIFO
+ * after a change only while consumerWaiting is set, so no system call is made per change while the
+ * consumer is busy. (An eventfd would need to be passed between unrelated processes over a Unix
+ * socket; a FIFO gives the same wake-up semantics by name and also exists on macOS.)
+ */
+
+
+#pragma once
+#include "ParameterStore.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+
+
+
+/**
+ * SharedSegmentHeader struct, the first cache line of the segment.
+ */
+struct SharedSegmentHeader
+{
+	char magic[8]; // "UIPARAM1"
+	uint32_t formatVersion; // SHARED_SEGMENT_FORMAT_VERSION
+	uint32_t capacity; // Number of fields in the segment
+	std::atomic<uint32_t> parameterCount; // Number of registered fields
+	std::atomic<uint32_t> consumerWaiting; // Non-zero while a consumer waits on the doorbell
+	std::atomic<uint64_t> changeCounter; // Incremented after every field change
+	uint64_t producerPid; // Process id of the UI that last opened the segment
+	uint8_t reserved[24]; // Pads the header to 64 bytes
+};
+
+
+/**
+ * SharedParameterField struct, one parameter, one cache line.
+ */
+struct SharedParameterField
+{
+	std::atomic<uint64_t> sequence; // Odd while the value is being written, increases by 2 per change
+	std::atomic<uint64_t> word; // The value, encoded as by encodeParameter
+	std::atomic<uint64_t> changeVersion; // The ParameterStore change version of the value
+	double min, max; // The parameter's range
+	uint8_t type; // The ParameterType of 'word'
+	char name[23]; // Zero-terminated parameter name, truncated if longer
+};
+
+
+static const char SHARED_SEGMENT_MAGIC[8] = {'U', 'I', 'P', 'A', 'R', 'A', 'M', '1'};
+static const uint32_t SHARED_SEGMENT_FORMAT_VERSION = 1;
+static_assert(sizeof(SharedSegmentHeader) == 64, "SharedSegmentHeader is part of the segment layout");
+static_assert(sizeof(SharedParameterField) == 64, "SharedParameterField is part of the segment layout");
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, "The segment needs lock-free atomics in shared memory");
+
+
+/// The size in bytes of a segment with 'capacity' fields.
+inline std::size_t sharedSegmentSize(uint32_t capacity)
+{
+	return sizeof(SharedSegmentHeader) + capacity * sizeof(SharedParameterField);
+}
+
+
+/// The path of the doorbell FIFO of a segment, "/ofui_parameters" rings "/tmp/ofui_parameters.doorbell".
+inline std::string sharedDoorbellPath(const std::string &segmentName)
+{
+	return "/tmp/" + (segmentName.size() > 0 && segmentName[0] == '/' ? segmentName.substr(1) : segmentName) + ".doorbell";
+}
+
+
+
+
+
+
+
+
+/**
+ * SharedParameterView class representing a consumer's read-only view of a parameter segment.
+ *
+ * Values are read in place from the mapping. Header-only, so that an out-of-process simulation can
+ * use it by including this file (POSIX only).
+ */
+class SharedParameterView
+{
+public:
+	/// ------------- Constructors and Destructor -------------
+	/// \{
+	SharedParameterView() {}
+	~SharedParameterView() { detach(); }
+	SharedParameterView(const SharedParameterView &) = delete;
+	SharedParameterView &operator=(const SharedParameterView &) = delete;
+	/// \}
+
+
+	/// ------------- Attachment -------------
+	/// \{
+	bool attach(const std::string &segmentName); // Maps an existing segment and opens its doorbell, false if there is none yet
+	void detach(); // Unmaps the segment
+	bool attached() const { return header != nullptr; }
+	/// \}
+
+
+	/// ------------- Reading -------------
+	/// \{
+	uint32_t size() const { return header ? header->parameterCount.load(std::memory_order_acquire) : 0; } // Number of registered fields
+	const SharedParameterField &field(uint32_t index) const { return fields[index]; } // A field, for its name, type and range
+	uint64_t read(uint32_t index, uint64_t &changeVersion) const; // A consistent (value, change version) pair, returns the value word
+	double value(uint32_t index) const; // The value of a field as a double
+	int indexOf(const std::string &name) const; // The index of a named field, -1 if unknown
+	uint64_t changeCounter() const { return header ? header->changeCounter.load(std::memory_order_seq_cst) : 0; } // Total number of changes so far
+	template<typename Function>
+	std::size_t forEachChanged(std::vector<uint64_t> &seenSequences, Function function) const; // Calls function(index) for every field whose sequence differs from 'seenSequences', updating it
+																								/// \}
+
+
+	/// ------------- Waiting -------------
+	/// \{
+	bool wait(uint64_t seenChangeCounter, int timeoutMillis); // Blocks until changeCounter differs from 'seenChangeCounter' or the timeout passes
+															  /// \}
+
+
+private:
+	void *mapping = nullptr; // The mapped segment
+	std::size_t mappingSize = 0; // The size of the mapping
+	SharedSegmentHeader *header = nullptr; // The header inside the mapping
+	SharedParameterField *fields = nullptr; // The fields inside the mapping
+	int doorbell = -1; // The doorbell FIFO, opened read-write so it never reports a hang-up
+};
+
+
+
+
+#ifndef _WIN32
+/**
+ * attach
+ * Maps an existing segment read-write (the consumer only writes 'consumerWaiting') and opens its
+ * doorbell, creating the FIFO if the producer has not yet. The FIFO is opened read-write so the consumer
+ * holds a writer of its own: once the producer closes or crashes, poll() keeps blocking until the
+ * timeout instead of reporting POLLHUP at once on every call.
+ *
+ * @param segmentName: The shm_open name of the segment
+ * @return bool: true if a valid segment was mapped
+ */
+inline bool SharedParameterView::attach(const std::string &segmentName)
+{
+	detach();
+	int fd = shm_open(segmentName.c_str(), O_RDWR, 0);
+	struct stat segmentStatus;
+	if (fd < 0 || fstat(fd, &segmentStatus) != 0 || static_cast<std::size_t>(segmentStatus.st_size) < sizeof(SharedSegmentHeader))
+	{
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+		return false;
+	}
+	std::size_t size = static_cast<std::size_t>(segmentStatus.st_size);
+	void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (address == MAP_FAILED)
+	{
+		return false;
+	}
+
+	SharedSegmentHeader *segmentHeader = static_cast<SharedSegmentHeader*>(address);
+	if (std::memcmp(segmentHeader->magic, SHARED_SEGMENT_MAGIC, sizeof(SHARED_SEGMENT_MAGIC)) != 0 || segmentHeader->formatVersion != SHARED_SEGMENT_FORMAT_VERSION || size < sharedSegmentSize(segmentHeader->capacity))
+	{
+		munmap(address, size);
+		return false;
+	}
+	mapping = address;
+	mappingSize = size;
+	header = segmentHeader;
+	fields = reinterpret_cast<SharedParameterField*>(static_cast<char*>(address) + sizeof(SharedSegmentHeader));
+
+	std::string doorbellPath = sharedDoorbellPath(segmentName);
+	mkfifo(doorbellPath.c_str(), 0600); // Fails harmlessly if the producer already created it
+	doorbell = open(doorbellPath.c_str(), O_RDWR | O_NONBLOCK);
+	return true;
+}
+
+
+inline void SharedParameterView::detach()
+{
+	if (mapping)
+	{
+		munmap(mapping, mappingSize);
+	}
+	if (doorbell >= 0)
+	{
+		close(doorbell);
+	}
+	mapping = nullptr;
+	mappingSize = 0;
+	header = nullptr;
+	fields = nullptr;
+	doorbell = -1;
+}
+
+
+/**
+ * read
+ * Reads a field's value and change version as a consistent pair, retrying while the producer writes it.
+ *
+ * @param index: The field to read
+ * @param changeVersion: Receives the change version of the value
+ * @return uint64_t: The encoded value
+ */
+inline uint64_t SharedParameterView::read(uint32_t index, uint64_t &changeVersion) const
+{
+	const SharedParameterField &shared = fields[index];
+	while (true)
+	{
+		uint64_t begin = shared.sequence.load(std::memory_order_acquire);
+		if (begin & 1)
+		{
+			continue;
+		}
+		uint64_t word = shared.word.load(std::memory_order_relaxed);
+		changeVersion = shared.changeVersion.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (shared.sequence.load(std::memory_order_relaxed) == begin)
+		{
+			return word;
+		}
+	}
+}
+
+
+inline double SharedParameterView::value(uint32_t index) const
+{
+	uint64_t changeVersion;
+	uint64_t word = read(index, changeVersion);
+	switch (static_cast<ParameterType>(fields[index].type))
+	{
+		case ParameterType::Float:
+			return decodeParameter<float>(word);
+		case ParameterType::Double:
+			return decodeParameter<double>(word);
+		case ParameterType::Int64:
+			return static_cast<double>(decodeParameter<int64_t>(word));
+		case ParameterType::Bool:
+			return decodeParameter<bool>(word) ? 1.0 : 0.0;
+	}
+	return 0;
+}
+
+
+inline int SharedParameterView::indexOf(const std::string &name) const
+{
+	uint32_t count = size();
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (name.compare(0, sizeof(fields[i].name) - 1, fields[i].name) == 0)
+		{
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
+
+template<typename Function>
+std::size_t SharedParameterView::forEachChanged(std::vector<uint64_t> &seenSequences, Function function) const
+{
+	uint32_t count = size();
+	seenSequences.resize(count, 0);
+	std::size_t changed = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint64_t sequence = fields[i].sequence.load(std::memory_order_acquire) & ~1ull; // A write in progress counts once it completes
+		if (sequence != seenSequences[i])
+		{
+			seenSequences[i] = sequence;
+			function(i);
+			changed++;
+		}
+	}
+	return changed;
+}
+
+
+/**
+ * wait
+ * Blocks until a change newer than 'seenChangeCounter' is published or the timeout passes. The waiting
+ * flag is raised before the counter is re-checked, so a change made in between always rings the doorbell.
+ *
+ * @param seenChangeCounter: The changeCounter the caller has caught up to
+ * @param timeoutMillis: The longest time to block, -1 to block indefinitely
+ * @return bool: true if there are changes newer than 'seenChangeCounter'
+ */
+inline bool SharedParameterView::wait(uint64_t seenChangeCounter, int timeoutMillis)
+{
+	if (!header)
+	{
+		return false;
+	}
+	header->consumerWaiting.store(1, std::memory_order_seq_cst);
+	if (changeCounter() == seenChangeCounter && doorbell >= 0)
+	{
+		pollfd descriptor = {doorbell, POLLIN, 0};
+		poll(&descriptor, 1, timeoutMillis);
+		char drained[64];
+		while (::read(doorbell, drained, sizeof(drained)) > 0)
+		{
+		}
+	}
+	header->consumerWaiting.store(0, std::memory_order_seq_cst);
+	return changeCounter() != seenChangeCounter;
+}
+#endif
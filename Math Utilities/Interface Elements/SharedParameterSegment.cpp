@@ -0,0 +1,253 @@
+//  SharedParameterSegment.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "SharedParameterSegment.hpp"
+#include "ofMain.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+
+
+
+SharedParameterSegment::SharedParameterSegment()
+{
+}
+
+
+SharedParameterSegment::~SharedParameterSegment()
+{
+	close();
+}
+
+
+/**
+ * open
+ * Creates the segment, or reopens one left by a previous run with the same layout so that a consumer
+ * that kept it mapped carries on, and registers with the store, which replays every registered
+ * parameter into the fields.
+ *
+ * @param _segmentName: The shm_open name of the segment, e.g. "/ofui_parameters"
+ * @param _store: The store to mirror
+ * @return bool: true if the segment is mapped and mirrors the store
+ */
+bool SharedParameterSegment::open(const std::string &_segmentName, ParameterStore &_store)
+{
+	close();
+
+#ifdef _WIN32
+	ofLogError("SharedParameterSegment") << "POSIX shared memory is not supported on this platform, not sharing " << _segmentName;
+	return false;
+#else
+	/// Step 1: Create or open the shared memory object
+	int fd = shm_open(_segmentName.c_str(), O_RDWR | O_CREAT, 0600);
+	if (fd < 0)
+	{
+		ofLogError("SharedParameterSegment") << "Could not open " << _segmentName << ": " << std::strerror(errno);
+		return false;
+	}
+
+	std::size_t size = sharedSegmentSize(CAPACITY);
+	struct stat segmentStatus;
+	bool reopening = fstat(fd, &segmentStatus) == 0 && static_cast<std::size_t>(segmentStatus.st_size) == size;
+	if (!reopening && ftruncate(fd, static_cast<off_t>(size)) != 0)
+	{
+		ofLogError("SharedParameterSegment") << "Could not size " << _segmentName << ": " << std::strerror(errno);
+		::close(fd);
+		return false;
+	}
+
+
+	/// Step 2: Map it, the mapping stays valid after the descriptor is closed
+	void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (address == MAP_FAILED)
+	{
+		ofLogError("SharedParameterSegment") << "Could not map " << _segmentName << ": " << std::strerror(errno);
+		return false;
+	}
+	mapping = address;
+	mappingSize = size;
+	header = static_cast<SharedSegmentHeader*>(address);
+	fields = reinterpret_cast<SharedParameterField*>(static_cast<char*>(address) + sizeof(SharedSegmentHeader));
+
+
+	/// Step 3: Keep a segment of this layout, initialize anything else
+	if (!reopening || std::memcmp(header->magic, SHARED_SEGMENT_MAGIC, sizeof(SHARED_SEGMENT_MAGIC)) != 0 || header->formatVersion != SHARED_SEGMENT_FORMAT_VERSION || header->capacity != CAPACITY)
+	{
+		std::memset(address, 0, size);
+		header->formatVersion = SHARED_SEGMENT_FORMAT_VERSION;
+		header->capacity = CAPACITY;
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(header->magic, SHARED_SEGMENT_MAGIC, sizeof(SHARED_SEGMENT_MAGIC)); // Consumers accept the segment once the magic is in place
+	}
+	header->producerPid = static_cast<uint64_t>(getpid());
+
+
+	/// Step 4: Open the doorbell; read-write, so the FIFO always has a reader and never blocks opening or raises SIGPIPE
+	std::string doorbellPath = sharedDoorbellPath(_segmentName);
+	if (mkfifo(doorbellPath.c_str(), 0600) != 0 && errno != EEXIST)
+	{
+		ofLogWarning("SharedParameterSegment") << "Could not create the doorbell " << doorbellPath << ", consumers will have to poll: " << std::strerror(errno);
+	}
+	doorbell = ::open(doorbellPath.c_str(), O_RDWR | O_NONBLOCK);
+
+
+	/// Step 5: Mirror the store
+	segmentName = _segmentName;
+	store = &_store;
+	store->addListener(this);
+	return true;
+#endif
+}
+
+
+/**
+ * close
+ * Stops mirroring the store and unmaps the segment. The shared memory object is left in place, so a
+ * consumer keeps the last values and a restarted UI continues where this one stopped.
+ */
+void SharedParameterSegment::close()
+{
+	if (store)
+	{
+		store->removeListener(this);
+	}
+#ifndef _WIN32
+	if (mapping)
+	{
+		munmap(mapping, mappingSize);
+	}
+	if (doorbell >= 0)
+	{
+		::close(doorbell);
+	}
+#endif
+	store = nullptr;
+	mapping = nullptr;
+	mappingSize = 0;
+	header = nullptr;
+	fields = nullptr;
+	doorbell = -1;
+	segmentName.clear();
+}
+
+
+bool SharedParameterSegment::isOpen() const
+{
+	return mapping != nullptr;
+}
+
+
+/**
+ * remove
+ * Unlinks a segment and its doorbell by name. Processes that have them open keep using them.
+ *
+ * @param _segmentName: The shm_open name of the segment
+ * @return bool: true if the segment existed and was unlinked
+ */
+bool SharedParameterSegment::remove(const std::string &_segmentName)
+{
+#ifdef _WIN32
+	return false;
+#else
+	::unlink(sharedDoorbellPath(_segmentName).c_str());
+	return shm_unlink(_segmentName.c_str()) == 0;
+#endif
+}
+
+
+
+
+/**
+ * writeValue
+ * Writes a field's value and change version under its sequence counter, then counts the change and rings
+ * the doorbell if a consumer is waiting. The flag is read after the counter is raised (both sequentially
+ * consistent), mirroring SharedParameterView::wait, so a consumer is never left asleep after a change.
+ *
+ * @param index: The field to write
+ * @param word: The new value
+ */
+void SharedParameterSegment::writeValue(uint32_t index, uint64_t word)
+{
+	SharedParameterField &field = fields[index];
+	uint64_t sequence = field.sequence.load(std::memory_order_relaxed);
+	field.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	field.word.store(word, std::memory_order_relaxed);
+	field.changeVersion.store(store->changeVersion(index), std::memory_order_relaxed);
+	field.sequence.store(sequence + 2, std::memory_order_release);
+
+	header->changeCounter.fetch_add(1, std::memory_order_seq_cst);
+	if (header->consumerWaiting.load(std::memory_order_seq_cst))
+	{
+		ring();
+	}
+}
+
+
+void SharedParameterSegment::ring()
+{
+#ifndef _WIN32
+	if (doorbell >= 0)
+	{
+		const char signal = 1;
+		ssize_t written = ::write(doorbell, &signal, 1); // EAGAIN means the FIFO is already full of unread rings
+		(void)written;
+	}
+#endif
+}
+
+
+
+
+/**
+ * parameterAdded
+ * Describes a parameter in its field and writes its current value, then makes the field visible to
+ * consumers by raising parameterCount past it. The description is only rewritten when a restarted UI
+ * registers a different parameter at this index.
+ *
+ * @param index: The parameter's index in the store, which is also its field
+ * @param info: The parameter's description
+ */
+void SharedParameterSegment::parameterAdded(uint32_t index, const ParameterInfo &info)
+{
+	if (!fields || index >= CAPACITY)
+	{
+		return;
+	}
+	SharedParameterField &field = fields[index];
+	char name[sizeof(field.name)] = {};
+	std::memcpy(name, info.name.c_str(), std::min(info.name.size(), sizeof(name) - 1));
+	if (std::memcmp(field.name, name, sizeof(name)) != 0 || field.type != static_cast<uint8_t>(info.type) || field.min != info.min || field.max != info.max) // A reopened segment usually describes the same parameters already
+	{
+		std::memcpy(field.name, name, sizeof(name));
+		field.type = static_cast<uint8_t>(info.type);
+		field.min = info.min;
+		field.max = info.max;
+	}
+	writeValue(index, store->getWord(index));
+	if (index >= header->parameterCount.load(std::memory_order_relaxed))
+	{
+		header->parameterCount.store(index + 1, std::memory_order_release);
+	}
+}
+
+
+void SharedParameterSegment::parameterChanged(uint32_t index, uint64_t /*oldWord*/, uint64_t newWord)
+{
+	if (fields && index < CAPACITY)
+	{
+		writeValue(index, newWord);
+	}
+}
@@ -0,0 +1,78 @@
+//  SharedParameterSegment.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Shared Parameter Segment header file declares the UI side of the POSIX shared-memory parameter segment
+ * described in SharedParameterLayout.hpp.
+ *
+ * A SharedParameterSegment listens to a ParameterStore and writes every registration and change straight
+ * into the shared mapping, so sliders, text fields and toggles bound to the store drive a simulation in
+ * another process: the simulation maps the segment with SharedParameterView and reads the values in
+ * place. A change costs a handful of stores into the mapping plus, only while the consumer is blocked
+ * waiting, one byte written to the doorbell FIFO.
+ */
+
+
+#pragma once
+#include "ParameterStore.hpp"
+#include "SharedParameterLayout.hpp"
+#include <cstdint>
+#include <string>
+
+
+
+
+
+
+/**
+ * SharedParameterSegment class representing the producer of a shared parameter segment.
+ *
+ * Owned and driven by the UI thread, like the ParameterStore it mirrors.
+ */
+class SharedParameterSegment : public ParameterListener
+{
+public:
+	/// ------------- Constructors and Destructor -------------
+	/// \{
+	SharedParameterSegment(); // Creates a closed segment
+	~SharedParameterSegment(); // Detaches from the store and unmaps the segment
+	SharedParameterSegment(const SharedParameterSegment &) = delete;
+	SharedParameterSegment &operator=(const SharedParameterSegment &) = delete;
+	/// \}
+
+
+	/// ------------- Segment -------------
+	/// \{
+	bool open(const std::string &segmentName, ParameterStore &store = ParameterStore::global()); // Creates or reopens the segment and starts mirroring 'store' into it
+	void close(); // Stops mirroring and unmaps the segment, which stays available to consumers
+	bool isOpen() const; // Whether a segment is mapped
+	static bool remove(const std::string &segmentName); // Unlinks a segment and its doorbell, consumers keep their mappings
+	const std::string &name() const { return segmentName; } // The shm_open name of the open segment
+															/// \}
+
+
+	/// ------------- ParameterListener -------------
+	/// \{
+	void parameterAdded(uint32_t index, const ParameterInfo &info) override; // Describes the parameter in its field
+	void parameterChanged(uint32_t index, uint64_t oldWord, uint64_t newWord) override; // Writes the new value into its field
+																						 /// \}
+
+
+	/// ------------- Format -------------
+	/// \{
+	static constexpr uint32_t CAPACITY = ParameterSnapshot::CAPACITY; // Fields in a segment, one per possible store parameter
+	/// \}
+
+
+private:
+	void writeValue(uint32_t index, uint64_t word); // Writes a field's value under its sequence counter and rings the doorbell
+	void ring(); // Wakes a consumer blocked in SharedParameterView::wait
+
+	std::string segmentName; // The shm_open name of the open segment
+	ParameterStore *store = nullptr; // The store being mirrored
+	void *mapping = nullptr; // The mapped segment
+	std::size_t mappingSize = 0; // The size of the mapping
+	SharedSegmentHeader *header = nullptr; // The header inside the mapping
+	SharedParameterField *fields = nullptr; // The fields inside the mapping
+	int doorbell = -1; // The doorbell FIFO, opened read-write so that ringing it never raises SIGPIPE
+};
@@ -0,0 +1,264 @@
+//  ThetaAutotuner.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "ThetaAutotuner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+
+
+
+
+
+/**
+ * of
+ * Computes the center of mass, the RMS radius and the mass fraction in every cell of an 8x8 grid spanning
+ * two RMS radii either side of the center. Bodies outside the grid count towards its border cells, so a
+ * few escapers do not stretch the grid the way a bounding box would.
+ *
+ * @param bodies: The bodies
+ * @return DistributionSignature: Their signature
+ */
+DistributionSignature DistributionSignature::of(const std::vector<Body> &bodies)
+{
+	DistributionSignature signature;
+	signature.count = bodies.size();
+	double mass = 0, x = 0, y = 0;
+	for (const Body &body : bodies)
+	{
+		mass += body.mass;
+		x += body.position.x * body.mass;
+		y += body.position.y * body.mass;
+	}
+	if (mass <= 0)
+	{
+		return signature;
+	}
+	signature.center = Vec2D(x / mass, y / mass);
+
+	double squared = 0;
+	for (const Body &body : bodies)
+	{
+		double dx = body.position.x - signature.center.x, dy = body.position.y - signature.center.y;
+		squared += (dx * dx + dy * dy) * body.mass;
+	}
+	signature.radius = std::sqrt(squared / mass);
+
+	double cell = signature.radius > 0 ? 4 * signature.radius / GRID : 1;
+	for (const Body &body : bodies)
+	{
+		int column = std::min(std::max(static_cast<int>(std::floor((body.position.x - signature.center.x) / cell)) + GRID / 2, 0), GRID - 1);
+		int row = std::min(std::max(static_cast<int>(std::floor((body.position.y - signature.center.y) / cell)) + GRID / 2, 0), GRID - 1);
+		signature.occupancy[row * GRID + column] += static_cast<float>(body.mass / mass);
+	}
+	return signature;
+}
+
+
+/**
+ * distance
+ * Compares two signatures: the total variation distance of the occupancy grids (the fraction of mass that
+ * would have to move between cells), plus the relative change of the RMS radius and of the body count.
+ * Moving the whole distribution does not count; scaling it does, since that changes the softening length
+ * relative to the spacing of the bodies.
+ *
+ * @param other: The signature to compare with
+ * @return double: 0 for equal distributions, 1 or more for very different ones
+ */
+double DistributionSignature::distance(const DistributionSignature &other) const
+{
+	double variation = 0;
+	for (int i = 0; i < GRID * GRID; i++)
+	{
+		variation += std::fabs(occupancy[i] - other.occupancy[i]);
+	}
+	variation *= 0.5;
+	double radiusChange = std::max(radius, other.radius) > 0 ? std::fabs(radius - other.radius) / std::max(radius, other.radius) : 0;
+	double countChange = std::max(count, other.count) > 0 ? std::fabs(static_cast<double>(count) - static_cast<double>(other.count)) / std::max(count, other.count) : 0;
+	return variation + radiusChange + countChange;
+}
+
+
+
+
+
+
+
+
+/**
+ * tune
+ * Builds the tree once, computes the direct-sum acceleration of a sample of bodies once, and then for every
+ * candidate theta measures the error on the sample and the time of a force evaluation of all bodies. The
+ * chosen theta is the largest candidate whose RMS error is within the budget.
+ *
+ * @param bodies: The particle set
+ * @param settings: G and the softening length of the simulation (its theta is ignored)
+ * @param candidates: The thetas to try
+ * @param errorBudget: The largest acceptable RMS relative acceleration error
+ * @param sampleCount: The number of bodies compared against direct summation
+ * @param repetitions: Timed evaluations per candidate, the fastest counts
+ * @return ThetaTuning: The measurements and the chosen theta
+ */
+ThetaTuning ThetaAutotuner::tune(const std::vector<Body> &bodies, const SimulationSettings &settings, const std::vector<double> &candidates, double errorBudget, std::size_t sampleCount, int repetitions)
+{
+	ThetaTuning result;
+	result.bodyCount = bodies.size();
+	if (bodies.empty() || candidates.empty())
+	{
+		result.theta = settings.theta;
+		return result;
+	}
+
+	/// Step 1: Build the tree and the direct-sum references, shared by all candidates
+	NBodySimulation reference(bodies, settings);
+	reference.tree.build(reference.bodies);
+	std::size_t samples = std::min(std::max<std::size_t>(sampleCount, 1), bodies.size());
+	std::vector<std::size_t> sampled(samples);
+	std::vector<Vec2D> exact(samples);
+	for (std::size_t s = 0; s < samples; s++)
+	{
+		sampled[s] = s * bodies.size() / samples; // Evenly through the list, bodies are not ordered by position
+		exact[s] = reference.directAcceleration(sampled[s]);
+	}
+
+
+	/// Step 2: Measure every candidate
+	std::vector<double> sorted = candidates;
+	std::sort(sorted.begin(), sorted.end());
+	for (double theta : sorted)
+	{
+		ThetaCandidate candidate;
+		candidate.theta = theta;
+		double squaredErrors = 0;
+		for (std::size_t s = 0; s < samples; s++)
+		{
+			Vec2D difference = reference.tree.acceleration(bodies[sampled[s]].position, theta, settings.G, settings.softening) - exact[s];
+			double magnitude = exact[s].vectorSquareLength();
+			double relative = magnitude > 0 ? std::sqrt(difference.vectorSquareLength() / magnitude) : 0;
+			squaredErrors += relative * relative;
+			candidate.maxError = std::max(candidate.maxError, relative);
+		}
+		candidate.rmsError = std::sqrt(squaredErrors / samples);
+
+		double best = 0;
+		for (int repetition = 0; repetition < std::max(repetitions, 1); repetition++)
+		{
+			volatile double sink = 0; // Keeps the evaluations from being optimized away
+			auto begin = std::chrono::steady_clock::now();
+			for (const Body &body : bodies)
+			{
+				sink = sink + reference.tree.acceleration(body.position, theta, settings.G, settings.softening).x;
+			}
+			double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+			best = repetition == 0 ? elapsed : std::min(best, elapsed);
+		}
+		candidate.microsecondsPerBody = best / bodies.size();
+		result.candidates.push_back(candidate);
+	}
+
+
+	/// Step 3: Choose the largest candidate within the budget, or the most accurate one if none is
+	result.theta = result.candidates.front().theta;
+	for (const ThetaCandidate &candidate : result.candidates)
+	{
+		if (candidate.rmsError <= errorBudget)
+		{
+			result.theta = candidate.theta;
+			result.withinBudget = true;
+		}
+	}
+	return result;
+}
+
+
+std::vector<double> ThetaAutotuner::defaultCandidates()
+{
+	std::vector<double> thetas;
+	for (int i = 1; i <= 15; i++)
+	{
+		thetas.push_back(i * 0.1);
+	}
+	return thetas;
+}
+
+
+
+
+/**
+ * update
+ * Applies a finished tuning by writing its theta into the store, where the bound slider picks it up, and
+ * starts a tuning on a snapshot of the bodies if none is running and the distribution moved more than
+ * 'retuneDistance' from the one last tuned on, the budget changed, or a tuning was requested.
+ *
+ * @param bodies: The current particle set
+ * @param settings: The simulation's current settings
+ * @param store: The store 'parameter' is registered in
+ * @return bool: true if theta was written this call
+ */
+bool ThetaAutotuner::update(const std::vector<Body> &bodies, const SimulationSettings &settings, ParameterStore &store)
+{
+	/// Step 1: Apply a finished tuning
+	bool written = false;
+	if (pending.valid() && pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+	{
+		pending = std::shared_future<void>();
+		tuning = *pendingTuning;
+		pendingTuning.reset();
+		tunedSignature = pendingSignature;
+		tunedBudget = pendingBudget;
+
+		int index = store.indexOf(parameter);
+		if (index >= 0 && !tuning.candidates.empty())
+		{
+			const ParameterInfo &info = store.info(index);
+			uint64_t word = parameterFromDouble(info.type, std::min(std::max(tuning.theta, info.min), info.max));
+			if (word != store.getWord(index))
+			{
+				store.setWord(index, word);
+				written = true;
+			}
+			if (!tuning.withinBudget)
+			{
+				ofLogWarning("ThetaAutotuner") << "No theta meets the error budget " << pendingBudget << ", using " << tuning.theta;
+			}
+		}
+	}
+
+
+	/// Step 2: Start a tuning if the particle set or the budget changed
+	if (!pending.valid() && !bodies.empty())
+	{
+		DistributionSignature signature = DistributionSignature::of(bodies);
+		if (requested || errorBudget != tunedBudget || signature.distance(tunedSignature) > retuneDistance)
+		{
+			requested = false;
+			pendingSignature = signature;
+			pendingBudget = errorBudget;
+			pendingTuning = std::make_shared<ThetaTuning>();
+			std::shared_ptr<ThetaTuning> output = pendingTuning;
+			std::vector<double> thetas = candidates;
+			double budget = errorBudget;
+			std::size_t samples = sampleCount;
+			std::vector<Body> snapshot = bodies; // The simulation keeps stepping while the tuning runs
+			pending = WorkerPool::global().submit([output, snapshot = std::move(snapshot), settings, thetas, budget, samples]() {
+				*output = ThetaAutotuner::tune(snapshot, settings, thetas, budget, samples);
+			});
+		}
+	}
+	return written;
+}
+
+
+void ThetaAutotuner::request()
+{
+	requested = true;
+}
+
+
+bool ThetaAutotuner::isTuning() const
+{
+	return pending.valid();
+}
@@ -0,0 +1,129 @@
+//  ThetaAutotuner.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Theta Autotuner header file declares an autotuner for the Barnes-Hut opening angle (the "theta"
+ * parameter edited by the MAC slider).
+ *
+ * These components include:
+ *   - ThetaCandidate: The accuracy and cost of one candidate theta on a particle set.
+ *   - ThetaTuning: The candidates measured on a particle set and the theta chosen from them.
+ *   - DistributionSignature: A coarse summary of where the bodies are (center, RMS radius and an occupancy
+ *     grid), used to notice that the distribution changed enough to tune again.
+ *   - ThetaAutotuner: Tunes on a snapshot of the bodies in the background, writes the chosen theta into the
+ *     ParameterStore (so the bound slider shows it) and tunes again when the distribution or the error budget
+ *     changes.
+ *
+ * The tree does not depend on theta, so a tuning builds it once and evaluates every candidate on it. The
+ * error of a candidate is the relative acceleration error against direct summation on a sample of bodies;
+ * the chosen theta is the largest candidate whose RMS error stays within the budget.
+ */
+
+
+#pragma once
+#include "ofMain.h"
+#include "WorkerPool.hpp"
+#include "ParameterStore.hpp"
+#include "NBodySimulation.hpp"
+#include <array>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+
+
+
+
+/**
+ * ThetaCandidate struct, one measured theta.
+ */
+struct ThetaCandidate
+{
+	double theta = 0; // The opening angle
+	double rmsError = 0; // Root mean square relative acceleration error over the sampled bodies
+	double maxError = 0; // Largest relative acceleration error over the sampled bodies
+	double microsecondsPerBody = 0; // Cost of one body's force evaluation, best of the repetitions
+};
+
+
+/**
+ * ThetaTuning struct, the outcome of tuning on one particle set.
+ */
+struct ThetaTuning
+{
+	std::vector<ThetaCandidate> candidates; // Every candidate, in increasing theta
+	double theta = 0; // The chosen theta
+	bool withinBudget = false; // false if even the smallest candidate exceeded the budget (it is chosen then)
+	std::size_t bodyCount = 0; // Number of bodies tuned on
+};
+
+
+/**
+ * DistributionSignature struct summarizing the positions of a set of bodies.
+ */
+struct DistributionSignature
+{
+	static constexpr int GRID = 8; // Cells per side of the occupancy grid
+
+	std::size_t count = 0; // Number of bodies
+	Vec2D center; // Center of mass
+	double radius = 0; // Mass-weighted RMS distance from the center
+	std::array<float, GRID * GRID> occupancy{}; // Mass fraction per cell of the square of side 4 * radius around the center
+
+	static DistributionSignature of(const std::vector<Body> &bodies); // Computes the signature of a set of bodies
+	double distance(const DistributionSignature &other) const; // 0 for equal distributions, 1 or more for very different ones
+};
+
+
+
+
+
+
+
+
+/**
+ * ThetaAutotuner class representing the automatic choice of theta for a changing particle set.
+ *
+ * Call update() from the UI thread once per frame; the measurements run on WorkerPool::global().
+ */
+class ThetaAutotuner
+{
+public:
+	/// ------------- Tuning -------------
+	/// \{
+	static ThetaTuning tune(const std::vector<Body> &bodies, const SimulationSettings &settings, const std::vector<double> &candidates, double errorBudget, std::size_t sampleCount, int repetitions = 2); // Measures every candidate on the calling thread and chooses one
+	static std::vector<double> defaultCandidates(); // 0.1, 0.2, ..., 1.5
+												   /// \}
+
+
+	/// ------------- Automatic Tuning (UI Thread) -------------
+	/// \{
+	bool update(const std::vector<Body> &bodies, const SimulationSettings &settings, ParameterStore &store); // Starts a tuning when needed and applies a finished one, returns true when theta was written
+	void request(); // Tunes again at the next update, whatever the distribution
+	bool isTuning() const; // Whether a tuning is running
+	const ThetaTuning &lastTuning() const { return tuning; } // The most recently applied tuning
+															 /// \}
+
+
+	/// ------------- Autotuner Attributes -------------
+	/// \{
+	std::string parameter = "theta"; // The registered name of the parameter written
+	double errorBudget = 0.01; // Largest acceptable RMS relative acceleration error
+	double retuneDistance = 0.25; // How far the distribution signature must move to tune again
+	std::size_t sampleCount = 128; // Bodies compared against direct summation
+	std::vector<double> candidates = defaultCandidates(); // The thetas tried
+														  /// \}
+
+
+private:
+	std::shared_future<void> pending; // Completes when the running tuning finished, invalid if none is running
+	std::shared_ptr<ThetaTuning> pendingTuning; // Written by the running tuning, read once it completed
+	DistributionSignature pendingSignature; // The distribution the running tuning measures
+	double pendingBudget = 0; // The budget the running tuning measures against
+	ThetaTuning tuning; // The last applied tuning
+	DistributionSignature tunedSignature; // The distribution the applied tuning measured
+	double tunedBudget = -1; // The budget of the applied tuning, negative before the first
+	bool requested = true; // Whether to tune regardless of the distribution
+};
@@ -0,0 +1,385 @@
+//  NBodySimulation.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "NBodySimulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+
+
+
+
+
+/**
+ * set
+ * Sets a setting by the name its parameter is registered under in the interface.
+ *
+ * @param name: "theta", "G", "e", "dt" or "reorder"
+ * @param value: The new value
+ * @return bool: true if 'name' is a setting
+ */
+bool SimulationSettings::set(const std::string &name, double value)
+{
+	if (name == "theta") { theta = value; }
+	else if (name == "G") { G = value; }
+	else if (name == "e") { softening = value; }
+	else if (name == "dt") { dt = value; }
+	else if (name == "reorder") { reorderInterval = static_cast<int>(value); }
+	else { return false; }
+	return true;
+}
+
+
+
+
+
+
+
+
+/**
+ * build
+ * Rebuilds the tree: the root is the smallest square holding every body, bodies are inserted one at a
+ * time, and the masses and centers of mass are then summed bottom-up.
+ *
+ * @param bodies: The bodies, which must outlive the tree's use
+ */
+void BarnesHutTree::build(const std::vector<Body> &bodies)
+{
+	source = &bodies;
+	nodes.clear();
+	if (bodies.empty())
+	{
+		return;
+	}
+
+	/// Step 1: Bound the bodies
+	double minX = bodies[0].position.x, maxX = minX, minY = bodies[0].position.y, maxY = minY;
+	for (const Body &body : bodies)
+	{
+		minX = std::min(minX, body.position.x);
+		maxX = std::max(maxX, body.position.x);
+		minY = std::min(minY, body.position.y);
+		maxY = std::max(maxY, body.position.y);
+	}
+	double size = std::max(maxX - minX, maxY - minY) * 1.0001 + 1e-12;
+	nodes.reserve(bodies.size() * 2);
+	nodes.emplace_back();
+	nodes[0].bounds = Square(Vec2D((minX + maxX) * 0.5, (minY + maxY) * 0.5), size);
+
+
+	/// Step 2: Insert the bodies and summarize the cells
+	for (int i = 0; i < static_cast<int>(bodies.size()); i++)
+	{
+		insert(0, i, 0);
+	}
+	summarize(0);
+}
+
+
+/**
+ * insert
+ * Adds a body below a cell: an empty leaf takes it, a leaf holding a body splits and passes both down.
+ *
+ * @param node: The cell
+ * @param body: The index of the body
+ * @param depth: The depth of the cell
+ */
+void BarnesHutTree::insert(int node, int body, int depth)
+{
+	const Vec2D &position = (*source)[body].position;
+	bool internal = nodes[node].children[0] >= 0 || nodes[node].children[1] >= 0 || nodes[node].children[2] >= 0 || nodes[node].children[3] >= 0;
+	if (!internal && nodes[node].body < 0)
+	{
+		nodes[node].body = body; // Empty leaf
+		return;
+	}
+	if (depth >= MAX_DEPTH)
+	{
+		nodes[node].mass += (*source)[body].mass; // Coincident bodies: the leaf keeps its body and accumulates the others' mass
+		return;
+	}
+	if (!internal)
+	{
+		int resident = nodes[node].body;
+		nodes[node].body = -1;
+		nodes[node].mass = 0;
+		const Vec2D &residentPosition = (*source)[resident].position;
+		const Vec2D &center = nodes[node].bounds.center;
+		insert(child(node, (residentPosition.x >= center.x ? 1 : 0) + (residentPosition.y >= center.y ? 2 : 0)), resident, depth + 1);
+	}
+	const Vec2D &center = nodes[node].bounds.center;
+	insert(child(node, (position.x >= center.x ? 1 : 0) + (position.y >= center.y ? 2 : 0)), body, depth + 1);
+}
+
+
+int BarnesHutTree::child(int node, int quadrant)
+{
+	if (nodes[node].children[quadrant] < 0)
+	{
+		const Square &bounds = nodes[node].bounds;
+		double quarter = bounds.size * 0.25;
+		Node cell;
+		cell.bounds = Square(Vec2D(bounds.center.x + (quadrant & 1 ? quarter : -quarter), bounds.center.y + (quadrant & 2 ? quarter : -quarter)), bounds.size * 0.5);
+		nodes.push_back(cell); // May reallocate, so indices rather than references are kept across it
+		nodes[node].children[quadrant] = static_cast<int>(nodes.size()) - 1;
+	}
+	return nodes[node].children[quadrant];
+}
+
+
+void BarnesHutTree::summarize(int node)
+{
+	Node &cell = nodes[node];
+	if (cell.body >= 0)
+	{
+		const Body &body = (*source)[cell.body];
+		cell.mass += body.mass; // Adds the leaf's own body to any coincident mass merged into it at MAX_DEPTH
+		cell.centerOfMass = body.position;
+		return;
+	}
+	double mass = 0, x = 0, y = 0;
+	for (int quadrant = 0; quadrant < 4; quadrant++)
+	{
+		int index = nodes[node].children[quadrant];
+		if (index >= 0)
+		{
+			summarize(index);
+			mass += nodes[index].mass;
+			x += nodes[index].centerOfMass.x * nodes[index].mass;
+			y += nodes[index].centerOfMass.y * nodes[index].mass;
+		}
+	}
+	nodes[node].mass = mass;
+	nodes[node].centerOfMass = mass > 0 ? Vec2D(x / mass, y / mass) : nodes[node].bounds.center;
+}
+
+
+/**
+ * acceleration
+ * Walks the tree from the root, treating a cell as a single mass at its center of mass when its size over
+ * its distance is below theta, and opening it otherwise. A body contributes nothing to its own position.
+ *
+ * @param position: Where to evaluate the acceleration
+ * @param theta: The opening angle
+ * @param G: The gravitational constant
+ * @param softening: The softening length
+ * @return Vec2D: The acceleration
+ */
+Vec2D BarnesHutTree::acceleration(const Vec2D &position, double theta, double G, double softening) const
+{
+	double ax = 0, ay = 0;
+	if (nodes.empty())
+	{
+		return Vec2D(0, 0);
+	}
+	double softening2 = softening * softening, theta2 = theta * theta;
+	int stack[4 * MAX_DEPTH + 4];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		const Node &cell = nodes[stack[--top]];
+		double dx = cell.centerOfMass.x - position.x, dy = cell.centerOfMass.y - position.y;
+		double distance2 = dx * dx + dy * dy;
+		bool leaf = cell.body >= 0;
+		if (leaf || cell.bounds.size * cell.bounds.size < theta2 * distance2)
+		{
+			double r2 = distance2 + softening2;
+			if (r2 > 0 && distance2 > 0)
+			{
+				double inverse = G * cell.mass / (r2 * std::sqrt(r2));
+				ax += dx * inverse;
+				ay += dy * inverse;
+			}
+			continue;
+		}
+		for (int quadrant = 0; quadrant < 4; quadrant++)
+		{
+			if (cell.children[quadrant] >= 0)
+			{
+				stack[top++] = cell.children[quadrant];
+			}
+		}
+	}
+	return Vec2D(ax, ay);
+}
+
+
+
+
+
+
+
+
+NBodySimulation::NBodySimulation()
+{
+}
+
+
+NBodySimulation::NBodySimulation(std::vector<Body> _bodies, SimulationSettings _settings) : bodies(std::move(_bodies)), settings(_settings)
+{
+}
+
+
+/**
+ * uniformDisk
+ * Generates bodies spread uniformly over a disk and sets each on a circular orbit around the mass enclosed
+ * by its radius, so the disk is close to equilibrium and energy drift reflects integration error.
+ *
+ * @param count: The number of bodies
+ * @param radius: The radius of the disk
+ * @param totalMass: The mass shared equally by the bodies
+ * @param G: The gravitational constant the orbits are computed with
+ * @param seed: Seeds the generator, equal seeds give equal disks
+ * @return std::vector<Body>: The bodies
+ */
+std::vector<Body> NBodySimulation::uniformDisk(std::size_t count, double radius, double totalMass, double G, uint32_t seed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> unit(0.0, 1.0);
+	std::vector<Body> generated(count);
+	for (Body &body : generated)
+	{
+		double r = radius * std::sqrt(unit(generator)); // Uniform in area
+		double angle = 2 * M_PI * unit(generator);
+		double enclosed = totalMass * (r / radius) * (r / radius);
+		double speed = r > 0 ? std::sqrt(G * enclosed / r) : 0;
+		body.position = Vec2D(r * std::cos(angle), r * std::sin(angle));
+		body.velocity = Vec2D(-speed * std::sin(angle), speed * std::cos(angle));
+		body.mass = totalMass / count;
+	}
+	return generated;
+}
+
+
+
+
+/**
+ * step
+ * Advances the simulation by one kick-drift-kick leapfrog step, which conserves energy well over long runs.
+ */
+void NBodySimulation::step()
+{
+	if (settings.reorderInterval > 0 && ++stepsSinceReorder >= settings.reorderInterval)
+	{
+		reorderBodies();
+	}
+	if (!accelerationsCurrent)
+	{
+		computeAccelerations();
+	}
+	double halfDt = settings.dt * 0.5;
+	for (Body &body : bodies)
+	{
+		body.velocity += body.acceleration * halfDt;
+		body.position += body.velocity * settings.dt;
+	}
+	computeAccelerations();
+	for (Body &body : bodies)
+	{
+		body.velocity += body.acceleration * halfDt;
+	}
+}
+
+
+void NBodySimulation::computeAccelerations()
+{
+	tree.build(bodies);
+	for (Body &body : bodies)
+	{
+		body.acceleration = tree.acceleration(body.position, settings.theta, settings.G, settings.softening);
+	}
+	accelerationsCurrent = true;
+}
+
+
+/**
+ * reorderBodies
+ * Sorts the bodies by their key along a space-filling curve, so that neighbours in the vector are neighbours
+ * in space and the force pass walks the tree with warm caches. The accelerations move with their bodies and
+ * stay current; the tree is rebuilt by the next force evaluation.
+ *
+ * @param curve: Morton or Hilbert order
+ */
+void NBodySimulation::reorderBodies(SpaceFillingCurve curve)
+{
+	/// Step 1: Key the positions against their bounding square
+	Vec2DArray positions(bodies.size());
+	for (std::size_t i = 0; i < bodies.size(); i++)
+	{
+		positions.set(i, bodies[i].position);
+	}
+	std::vector<uint64_t> keys;
+	spatialKeys(positions, boundingSquare(positions), curve, keys);
+
+
+	/// Step 2: Permute the bodies into key order
+	std::vector<uint32_t> order;
+	sortOrder(keys, order);
+	applyOrder(order, bodies);
+	stepsSinceReorder = 0;
+}
+
+
+
+
+Vec2D NBodySimulation::directAcceleration(std::size_t index) const
+{
+	double ax = 0, ay = 0, softening2 = settings.softening * settings.softening;
+	const Vec2D &position = bodies[index].position;
+	for (std::size_t j = 0; j < bodies.size(); j++)
+	{
+		if (j == index)
+		{
+			continue;
+		}
+		double dx = bodies[j].position.x - position.x, dy = bodies[j].position.y - position.y;
+		double r2 = dx * dx + dy * dy + softening2;
+		if (r2 > 0)
+		{
+			double inverse = settings.G * bodies[j].mass / (r2 * std::sqrt(r2));
+			ax += dx * inverse;
+			ay += dy * inverse;
+		}
+	}
+	return Vec2D(ax, ay);
+}
+
+
+double NBodySimulation::kineticEnergy() const
+{
+	double kinetic = 0;
+	for (const Body &body : bodies)
+	{
+		kinetic += 0.5 * body.mass * body.velocity.vectorSquareLength();
+	}
+	return kinetic;
+}
+
+
+/**
+ * totalEnergy
+ * Returns the kinetic energy plus the softened potential energy -G m_i m_j / sqrt(r^2 + e^2) of every pair.
+ *
+ * @return double: The total energy
+ */
+double NBodySimulation::totalEnergy() const
+{
+	double potential = 0, softening2 = settings.softening * settings.softening;
+	for (std::size_t i = 0; i < bodies.size(); i++)
+	{
+		for (std::size_t j = i + 1; j < bodies.size(); j++)
+		{
+			double dx = bodies[j].position.x - bodies[i].position.x, dy = bodies[j].position.y - bodies[i].position.y;
+			double r2 = dx * dx + dy * dy + softening2;
+			if (r2 > 0)
+			{
+				potential -= settings.G * bodies[i].mass * bodies[j].mass / std::sqrt(r2);
+			}
+		}
+	}
+	return kineticEnergy() + potential;
+}
@@ -0,0 +1,157 @@
+//  NBodySimulation.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * NBody Simulation header file declares a headless two-dimensional gravitational N-body simulation, the
+ * workload the interface's parameters (theta, G, e, dt) configure.
+ *
+ * These components include:
+ *   - Body: A point mass with its position, velocity and acceleration.
+ *   - SimulationSettings: The Barnes-Hut opening angle, gravitational constant, softening length and time step.
+ *   - BarnesHutTree: A quadtree over the bodies whose cells approximate distant groups of bodies by their
+ *     center of mass, making a force evaluation O(N log N) instead of O(N^2).
+ *   - NBodySimulation: The bodies stepped with a kick-drift-kick leapfrog using Barnes-Hut forces, plus the
+ *     direct-sum forces and total energy used to measure its accuracy. Every 'reorder' steps the bodies are
+ *     sorted along a space-filling curve (SpaceFillingCurves.hpp), so that bodies walked one after another
+ *     read the same tree cells from cache.
+ *
+ * Nothing here depends on openFrameworks, so simulations can run on worker threads (parameter sweeps,
+ * autotuning) while the UI keeps drawing.
+ */
+
+
+#pragma once
+#include "Vects.hpp"
+#include "Geometry.hpp"
+#include "SpaceFillingCurves.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+
+
+
+/**
+ * Body struct, one point mass.
+ */
+struct Body
+{
+	Vec2D position; // Position in simulation units
+	Vec2D velocity; // Velocity in simulation units per unit time
+	Vec2D acceleration; // Acceleration from the last force evaluation
+	double mass = 0; // Mass in simulation units
+};
+
+
+/**
+ * SimulationSettings struct, the parameters of a simulation, named as the interface registers them.
+ */
+struct SimulationSettings
+{
+	double theta = 0.5; // "theta": Barnes-Hut opening angle, 0 opens every cell (exact), larger is faster and coarser
+	double G = 1; // "G": Gravitational constant
+	double softening = 0.01; // "e": Softening length, keeps close encounters finite
+	double dt = 1.0 / 60.0; // "dt": Time step
+	int reorderInterval = 0; // "reorder": Steps between sorting the bodies along a Hilbert curve, 0 never sorts
+
+	bool set(const std::string &name, double value); // Sets a setting by its parameter name, false if the name is not a setting
+};
+
+
+
+
+
+
+
+
+/**
+ * BarnesHutTree class representing a quadtree over a set of bodies, with the mass and center of mass of
+ * every cell.
+ */
+class BarnesHutTree
+{
+public:
+	/// ------------- Construction -------------
+	/// \{
+	void build(const std::vector<Body> &bodies); // Rebuilds the tree over the bodies' current positions
+												 /// \}
+
+
+	/// ------------- Force Evaluation -------------
+	/// \{
+	Vec2D acceleration(const Vec2D &position, double theta, double G, double softening) const; // The acceleration at a position, opening cells that look larger than 'theta'
+	std::size_t nodeCount() const { return nodes.size(); } // Number of cells in the tree
+														   /// \}
+
+
+private:
+	/**
+	 * Node struct, one cell of the tree.
+	 */
+	struct Node
+	{
+		Square bounds; // The cell
+		Vec2D centerOfMass; // Mass-weighted position of the bodies in the cell
+		double mass = 0; // Total mass of the bodies in the cell
+		int children[4] = {-1, -1, -1, -1}; // Quadrant cells, -1 where empty
+		int body = -1; // The body of a leaf holding one body, -1 otherwise
+	};
+
+	void insert(int node, int body, int depth); // Adds a body below a cell
+	int child(int node, int quadrant); // The quadrant cell of a cell, created on first use
+	void summarize(int node); // Computes masses and centers of mass bottom-up
+
+	static const int MAX_DEPTH = 48; // Bodies closer than 2^-48 of the root cell share a leaf
+
+	std::vector<Node> nodes; // The cells, the root first
+	const std::vector<Body> *source = nullptr; // The bodies the tree was built over
+};
+
+
+
+
+
+
+
+
+/**
+ * NBodySimulation class representing a set of bodies stepped through time.
+ */
+class NBodySimulation
+{
+public:
+	/// ------------- Constructors -------------
+	/// \{
+	NBodySimulation(); // Creates an empty simulation
+	NBodySimulation(std::vector<Body> _bodies, SimulationSettings _settings); // Creates a simulation of the given bodies
+	static std::vector<Body> uniformDisk(std::size_t count, double radius, double totalMass, double G, uint32_t seed); // Bodies spread uniformly over a disk, on roughly circular orbits
+																														 /// \}
+
+
+	/// ------------- Stepping -------------
+	/// \{
+	void step(); // Advances the bodies by one time step (kick-drift-kick leapfrog)
+	void computeAccelerations(); // Evaluates the Barnes-Hut acceleration of every body
+	void reorderBodies(SpaceFillingCurve curve = SpaceFillingCurve::Hilbert); // Sorts the bodies along a curve through their bounding square
+								 /// \}
+
+
+	/// ------------- Accuracy -------------
+	/// \{
+	Vec2D directAcceleration(std::size_t index) const; // The exact (direct-sum) acceleration of a body
+	double totalEnergy() const; // Kinetic plus softened potential energy, by direct sum
+	double kineticEnergy() const; // Kinetic energy of all bodies
+								  /// \}
+
+
+	/// ------------- Simulation Attributes -------------
+	/// \{
+	std::vector<Body> bodies; // The bodies
+	SimulationSettings settings; // The parameters the simulation steps with
+	BarnesHutTree tree; // The tree of the last force evaluation
+	bool accelerationsCurrent = false; // Whether the bodies' accelerations match their positions
+	int stepsSinceReorder = 0; // Steps taken since the bodies were last sorted
+									   /// \}
+};
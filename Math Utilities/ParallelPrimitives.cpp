@@ -0,0 +1,136 @@
+//  ParallelPrimitives.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "ParallelPrimitives.hpp"
+
+
+
+
+
+
+namespace
+{
+	constexpr int RADIX_BITS = 8; // Bits per digit, one pass each
+	constexpr std::size_t RADIX_BUCKETS = std::size_t(1) << RADIX_BITS; // Values of a digit
+
+
+	/**
+	 * sortByDigits
+	 * Sorts the keys by one stable counting pass per digit, least significant first, moving the payload
+	 * (if any) with them.
+	 *
+	 * @param keys: The keys, sorted in place
+	 * @param payload: The values moved with the keys, or nullptr
+	 * @param pool: The pool lending its workers
+	 */
+	template<typename Key>
+	void sortByDigits(std::vector<Key> &keys, std::vector<uint32_t> *payload, WorkerPool &pool)
+	{
+		constexpr int DIGITS = sizeof(Key) * 8 / RADIX_BITS;
+		std::size_t count = keys.size();
+		if (count < 2)
+		{
+			return;
+		}
+
+		/// Step 1: Cut the keys into one tile per thread, and find the bits that differ between any keys
+		std::size_t tiles = std::max<std::size_t>(1, std::min(pool.threadCount() + 1, count / RADIX_TILE));
+		auto tileBegin = [count, tiles](std::size_t tile) { return count * tile / tiles; };
+		std::vector<Key> ors(tiles, Key(0)), ands(tiles, ~Key(0));
+		parallelFor(tiles, 1, [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t tile = first; tile < last; tile++)
+			{
+				Key anyBits = 0, allBits = ~Key(0);
+				for (std::size_t i = tileBegin(tile), end = tileBegin(tile + 1); i < end; i++)
+				{
+					anyBits |= keys[i];
+					allBits &= keys[i];
+				}
+				ors[tile] = anyBits;
+				ands[tile] = allBits;
+			}
+		}, pool);
+		Key anyBits = 0, allBits = ~Key(0);
+		for (std::size_t tile = 0; tile < tiles; tile++)
+		{
+			anyBits |= ors[tile];
+			allBits &= ands[tile];
+		}
+		Key varying = anyBits ^ allBits; // Bits set in some keys but not in all
+
+
+		/// Step 2: One counting pass for each digit that differs between keys
+		std::vector<Key> sortedKeys(count);
+		std::vector<uint32_t> sortedPayload(payload ? count : 0);
+		std::vector<std::size_t> offsets(RADIX_BUCKETS * tiles); // offsets[digit * tiles + tile], digit-major so that its exclusive scan gives the write positions in order
+		for (int digit = 0; digit < DIGITS; digit++)
+		{
+			int shift = digit * RADIX_BITS;
+			if (((varying >> shift) & (RADIX_BUCKETS - 1)) == 0)
+			{
+				continue; // Every key has this digit, a pass would not move anything
+			}
+
+			parallelFor(tiles, 1, [&](std::size_t first, std::size_t last) // Count the digits of each tile
+			{
+				for (std::size_t tile = first; tile < last; tile++)
+				{
+					std::size_t histogram[RADIX_BUCKETS] = {};
+					for (std::size_t i = tileBegin(tile), end = tileBegin(tile + 1); i < end; i++)
+					{
+						histogram[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+					}
+					for (std::size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+					{
+						offsets[bucket * tiles + tile] = histogram[bucket];
+					}
+				}
+			}, pool);
+			exclusiveScan(offsets, pool);
+
+			parallelFor(tiles, 1, [&](std::size_t first, std::size_t last) // Scatter each tile in order, which keeps the sort stable
+			{
+				for (std::size_t tile = first; tile < last; tile++)
+				{
+					std::size_t next[RADIX_BUCKETS];
+					for (std::size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+					{
+						next[bucket] = offsets[bucket * tiles + tile];
+					}
+					for (std::size_t i = tileBegin(tile), end = tileBegin(tile + 1); i < end; i++)
+					{
+						std::size_t position = next[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+						sortedKeys[position] = keys[i];
+						if (payload)
+						{
+							sortedPayload[position] = (*payload)[i];
+						}
+					}
+				}
+			}, pool);
+			keys.swap(sortedKeys);
+			if (payload)
+			{
+				payload->swap(sortedPayload);
+			}
+		}
+	}
+}
+
+
+
+
+
+
+
+
+/// ------------- Sorting -------------
+/// \{
+void radixSort(std::vector<uint32_t> &keys, std::vector<uint32_t> &payload, WorkerPool &pool) { sortByDigits(keys, &payload, pool); }
+void radixSort(std::vector<uint64_t> &keys, std::vector<uint32_t> &payload, WorkerPool &pool) { sortByDigits(keys, &payload, pool); }
+void radixSort(std::vector<uint32_t> &keys, WorkerPool &pool) { sortByDigits(keys, nullptr, pool); }
+void radixSort(std::vector<uint64_t> &keys, WorkerPool &pool) { sortByDigits(keys, nullptr, pool); }
+/// \}
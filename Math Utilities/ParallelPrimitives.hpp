@@ -0,0 +1,183 @@
+//  ParallelPrimitives.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Parallel Primitives header file declares the sort and scan that building trees, binning particles into
+ * grid cells and reordering them by key are made of, run across the WorkerPool.
+ *
+ * These components include:
+ *   - inclusiveScan, exclusiveScan: Running sums of an array. The array is cut into SCAN_BLOCK blocks whose
+ *     sums are taken in parallel, the block sums are scanned, and each block is then scanned from its
+ *     offset in parallel: two reads and one write of the array however many threads there are.
+ *   - radixSort: A stable least-significant-digit radix sort of 32- or 64-bit keys, optionally carrying a
+ *     uint32_t payload (such as the original indices) along. Each 8-bit digit is one pass: the threads
+ *     count the digits of their tile, an exclusive scan over (digit, tile) turns the counts into write
+ *     positions, and the threads scatter their tiles. Digits that every key shares are skipped, so keys
+ *     that only span a few bytes take only as many passes.
+ *
+ * The block boundaries of the scan depend on the element count alone, so floating-point scans give
+ * bitwise the same result on any number of threads (though not the result of a serial running sum, which
+ * rounds in another order). A stable sort has only one result, so the radix sort is reproducible as well.
+ * tools/ParallelPrimitivesBenchmark.cpp checks both and times them against the standard library from one
+ * to a hundred million elements.
+ */
+
+
+#pragma once
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+
+
+
+
+constexpr std::size_t SCAN_BLOCK = 1 << 16; // Elements per block of a scan
+constexpr std::size_t RADIX_TILE = 1 << 16; // Least keys per tile of a radix sort pass, smaller sorts use fewer threads
+
+
+
+
+
+
+
+
+/// ------------- Scans -------------
+/// \{
+/// out[i] = in[0] + ... + in[i]; 'in' and 'out' may be the same array.
+template<typename T>
+void inclusiveScan(const T *in, T *out, std::size_t count, WorkerPool &pool = WorkerPool::global());
+template<typename T>
+void inclusiveScan(std::vector<T> &values, WorkerPool &pool = WorkerPool::global());
+
+/// out[i] = in[0] + ... + in[i - 1], out[0] = 0; returns the sum of all elements. 'in' and 'out' may be the same array.
+template<typename T>
+T exclusiveScan(const T *in, T *out, std::size_t count, WorkerPool &pool = WorkerPool::global());
+template<typename T>
+T exclusiveScan(std::vector<T> &values, WorkerPool &pool = WorkerPool::global());
+/// \}
+
+
+/// ------------- Sorting -------------
+/// \{
+/// Sorts the keys ascending, equal keys keeping their order, and applies the same permutation to the payload (which needs keys.size() elements).
+void radixSort(std::vector<uint32_t> &keys, std::vector<uint32_t> &payload, WorkerPool &pool = WorkerPool::global());
+void radixSort(std::vector<uint64_t> &keys, std::vector<uint32_t> &payload, WorkerPool &pool = WorkerPool::global());
+void radixSort(std::vector<uint32_t> &keys, WorkerPool &pool = WorkerPool::global()); // The keys alone
+void radixSort(std::vector<uint64_t> &keys, WorkerPool &pool = WorkerPool::global());
+/// \}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/// ------------- Scan Definitions -------------
+/// \{
+namespace parallelPrimitives
+{
+	/**
+	 * scan
+	 * The three phases of a blocked scan: block sums in parallel, a serial exclusive scan of the block sums,
+	 * then each block scanned from its offset in parallel.
+	 *
+	 * @param in: The values
+	 * @param out: Receives the running sums, may be 'in'
+	 * @param count: The number of values
+	 * @param pool: The pool lending its workers
+	 * @return T: The sum of all values
+	 */
+	template<bool Inclusive, typename T>
+	T scan(const T *in, T *out, std::size_t count, WorkerPool &pool)
+	{
+		/// Step 1: The sum of every block
+		std::size_t blocks = (count + SCAN_BLOCK - 1) / SCAN_BLOCK;
+		std::vector<T> offsets(blocks + 1, T());
+		parallelFor(blocks, 1, [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t block = first; block < last; block++)
+			{
+				T sum = T();
+				for (std::size_t i = block * SCAN_BLOCK, end = std::min(count, i + SCAN_BLOCK); i < end; i++)
+				{
+					sum += in[i];
+				}
+				offsets[block + 1] = sum;
+			}
+		}, pool);
+
+
+		/// Step 2: The offset of every block
+		for (std::size_t block = 0; block < blocks; block++)
+		{
+			offsets[block + 1] += offsets[block];
+		}
+
+
+		/// Step 3: Scan each block from its offset
+		parallelFor(blocks, 1, [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t block = first; block < last; block++)
+			{
+				T sum = offsets[block];
+				for (std::size_t i = block * SCAN_BLOCK, end = std::min(count, i + SCAN_BLOCK); i < end; i++)
+				{
+					T value = in[i]; // Read before writing, 'out' may be 'in'
+					if constexpr (Inclusive)
+					{
+						sum += value;
+						out[i] = sum;
+					}
+					else
+					{
+						out[i] = sum;
+						sum += value;
+					}
+				}
+			}
+		}, pool);
+		return offsets[blocks];
+	}
+}
+
+
+template<typename T>
+void inclusiveScan(const T *in, T *out, std::size_t count, WorkerPool &pool)
+{
+	parallelPrimitives::scan<true>(in, out, count, pool);
+}
+
+
+template<typename T>
+void inclusiveScan(std::vector<T> &values, WorkerPool &pool)
+{
+	parallelPrimitives::scan<true>(values.data(), values.data(), values.size(), pool);
+}
+
+
+template<typename T>
+T exclusiveScan(const T *in, T *out, std::size_t count, WorkerPool &pool)
+{
+	return parallelPrimitives::scan<false>(in, out, count, pool);
+}
+
+
+template<typename T>
+T exclusiveScan(std::vector<T> &values, WorkerPool &pool)
+{
+	return parallelPrimitives::scan<false>(values.data(), values.data(), values.size(), pool);
+}
+/// \}
@@ -0,0 +1,262 @@
+//  RandomVectors.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "RandomVectors.hpp"
+#include "WorkerPool.hpp"
+#include <cmath>
+#include <initializer_list>
+
+
+
+
+
+
+namespace
+{
+	constexpr std::size_t GRAIN = 1 << 15; // Vectors per parallel chunk
+	constexpr double TWO_PI = 6.283185307179586476925286766559;
+
+
+	/**
+	 * generate
+	 * Resizes the arrays to 'count' and calls element(i, index) for every i, where index = firstElement + i
+	 * is the element of the random stream, in parallel chunks.
+	 */
+	template<int Dimensions, typename Element>
+	void generate(std::size_t count, std::initializer_list<VectorArray<Dimensions>*> arrays, Element element)
+	{
+		for (VectorArray<Dimensions> *array : arrays)
+		{
+			array->resize(count);
+		}
+		parallelFor(count, GRAIN, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; i++)
+			{
+				element(i);
+			}
+		});
+	}
+
+
+	/**
+	 * sinCosTurns
+	 * The sine and cosine of 2 pi * turns for turns in [0, 1], within 2 ulps. The turn is reduced to an eighth
+	 * of a circle around the nearest quarter and both functions are evaluated by their Taylor series to the
+	 * x^16 term (truncation below 5e-17 at pi / 4), then rotated by the quarter without branches. Unlike
+	 * libm calls this inlines and vectorizes, and it gives the same bits on every platform.
+	 *
+	 * @param turns: The angle in turns
+	 * @param sine: Receives sin(2 pi turns)
+	 * @param cosine: Receives cos(2 pi turns)
+	 */
+	inline void sinCosTurns(double turns, double &sine, double &cosine)
+	{
+		int64_t quarter = static_cast<int64_t>(turns * 4 + 0.5); // The nearest quarter, turns is not negative
+		double x = (turns - static_cast<double>(quarter) * 0.25) * TWO_PI; // In [-pi / 4, pi / 4]
+		double x2 = x * x;
+		double s = x * (1 + x2 * (-1.0 / 6 + x2 * (1.0 / 120 + x2 * (-1.0 / 5040 + x2 * (1.0 / 362880 + x2 * (-1.0 / 39916800 + x2 * (1.0 / 6227020800 + x2 * (-1.0 / 1307674368000))))))));
+		double c = 1 + x2 * (-0.5 + x2 * (1.0 / 24 + x2 * (-1.0 / 720 + x2 * (1.0 / 40320 + x2 * (-1.0 / 3628800 + x2 * (1.0 / 479001600 + x2 * (-1.0 / 87178291200 + x2 * (1.0 / 20922789888000))))))));
+		bool swap = quarter & 1; // Odd quarters exchange sine and cosine
+		sine = (swap ? c : s) * ((quarter & 2) ? -1.0 : 1.0);
+		cosine = (swap ? s : c) * (((quarter + 1) & 2) ? -1.0 : 1.0);
+	}
+
+
+	/// A uniform unit vector from draws 'draw' and 'draw' + 1 of an element.
+	template<int Dimensions>
+	void unitDirection(const CounterRng &rng, uint64_t index, uint32_t draw, double *direction)
+	{
+		double sine, cosine;
+		sinCosTurns(rng.uniform(index, draw), sine, cosine);
+		if constexpr (Dimensions == 2)
+		{
+			direction[0] = cosine;
+			direction[1] = sine;
+		}
+		else
+		{
+			double z = 2 * rng.uniform(index, draw + 1) - 1; // Uniform in z is uniform on the sphere (Archimedes)
+			double ring = std::sqrt(1 - z * z);
+			direction[0] = ring * cosine;
+			direction[1] = ring * sine;
+			direction[2] = z;
+		}
+	}
+
+
+	template<int Dimensions>
+	void store(VectorArray<Dimensions> &array, std::size_t i, const double *values)
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			array.component(d)[i] = values[d];
+		}
+	}
+}
+
+
+
+
+
+
+
+
+/**
+ * randomDirections
+ * Fills an array with vectors of one length pointing in uniformly random directions.
+ *
+ * @param out: Resized to 'count'
+ * @param count: The number of vectors
+ * @param rng: The random stream
+ * @param radius: The length of every vector
+ * @param firstElement: The element of the stream the first vector is
+ */
+template<int Dimensions>
+void randomDirections(VectorArray<Dimensions> &out, std::size_t count, const CounterRng &rng, double radius, std::size_t firstElement)
+{
+	generate<Dimensions>(count, {&out}, [&](std::size_t i)
+	{
+		double direction[3];
+		unitDirection<Dimensions>(rng, firstElement + i, 0, direction);
+		for (int d = 0; d < Dimensions; d++)
+		{
+			out.component(d)[i] = radius * direction[d];
+		}
+	});
+}
+
+
+/**
+ * randomGaussian
+ * Fills an array with normally distributed components by the Box-Muller transform, one pair of uniform
+ * draws per pair of components.
+ *
+ * @param out: Resized to 'count'
+ * @param count: The number of vectors
+ * @param rng: The random stream
+ * @param sigma: The standard deviation of every component
+ * @param firstElement: The element of the stream the first vector is
+ */
+template<int Dimensions>
+void randomGaussian(VectorArray<Dimensions> &out, std::size_t count, const CounterRng &rng, double sigma, std::size_t firstElement)
+{
+	generate<Dimensions>(count, {&out}, [&](std::size_t i)
+	{
+		uint64_t index = firstElement + i;
+		double values[4];
+		for (int pair = 0; pair < (Dimensions + 1) / 2; pair++)
+		{
+			double radius = sigma * std::sqrt(-2 * std::log(rng.uniform(index, 2 * pair)));
+			double sine, cosine;
+			sinCosTurns(rng.uniform(index, 2 * pair + 1), sine, cosine);
+			values[2 * pair] = radius * cosine;
+			values[2 * pair + 1] = radius * sine;
+		}
+		store(out, i, values);
+	});
+}
+
+
+/**
+ * randomDisk
+ * Spreads bodies uniformly over a disk in the xy-plane and sets each on a circular orbit around the mass
+ * enclosed by its radius, the distribution of NBodySimulation::uniformDisk.
+ *
+ * @param positions: Resized to 'count'
+ * @param velocities: Resized to 'count'
+ * @param count: The number of bodies
+ * @param rng: The random stream
+ * @param radius: The radius of the disk
+ * @param totalMass: The mass of all bodies together
+ * @param G: The gravitational constant of the orbits
+ * @param firstElement: The element of the stream the first body is
+ */
+template<int Dimensions>
+void randomDisk(VectorArray<Dimensions> &positions, VectorArray<Dimensions> &velocities, std::size_t count, const CounterRng &rng, double radius, double totalMass, double G, std::size_t firstElement)
+{
+	generate<Dimensions>(count, {&positions, &velocities}, [&](std::size_t i)
+	{
+		uint64_t index = firstElement + i;
+		double r = radius * std::sqrt(rng.uniform(index, 0)); // Uniform in area
+		double speed = std::sqrt(G * totalMass * r) / radius; // sqrt(G * enclosed / r), enclosed = totalMass * r^2 / radius^2
+		double sine, cosine;
+		sinCosTurns(rng.uniform(index, 1), sine, cosine);
+		double position[3] = {r * cosine, r * sine, 0}, velocity[3] = {-speed * sine, speed * cosine, 0};
+		store(positions, i, position);
+		store(velocities, i, velocity);
+	});
+}
+
+
+/**
+ * randomPlummer
+ * Samples a Plummer sphere (Aarseth, Henon & Wielen 1974): the radius inverts the cumulative mass
+ * M(r) = M r^3 / (r^2 + a^2)^(3/2), and the speed is q times the local escape speed, with q drawn by
+ * rejection from g(q) = q^2 (1 - q^2)^(7/2). Each rejection attempt uses the next two draws of the
+ * element, so the result still only depends on the element.
+ *
+ * @param positions: Resized to 'count'; 2D arrays get the x and y of the sphere
+ * @param velocities: Resized to 'count'; 2D arrays get the x and y of the sphere
+ * @param count: The number of bodies
+ * @param rng: The random stream
+ * @param scaleRadius: The Plummer radius a, the half-mass radius is about 1.305 a
+ * @param totalMass: The mass of all bodies together
+ * @param G: The gravitational constant the velocities are in equilibrium with
+ * @param firstElement: The element of the stream the first body is
+ */
+template<int Dimensions>
+void randomPlummer(VectorArray<Dimensions> &positions, VectorArray<Dimensions> &velocities, std::size_t count, const CounterRng &rng, double scaleRadius, double totalMass, double G, std::size_t firstElement)
+{
+	double escapeScale = std::sqrt(2 * G * totalMass);
+	generate<Dimensions>(count, {&positions, &velocities}, [&](std::size_t i)
+	{
+		uint64_t index = firstElement + i;
+
+		/// Step 1: The radius from draw 0, the direction from draws 1 and 2
+		double r = scaleRadius / std::sqrt(std::pow(rng.uniform(index, 0), -2.0 / 3.0) - 1);
+		double direction[3];
+		unitDirection<3>(rng, index, 1, direction);
+
+
+		/// Step 2: The speed from rejection pairs starting at draw 5, the velocity direction from draws 3 and 4
+		double q = 0;
+		for (uint32_t draw = 5; draw + 1 < CounterRng::DRAWS_PER_ELEMENT; draw += 2)
+		{
+			q = rng.uniform(index, draw);
+			double oneMinusQ2 = 1 - q * q;
+			if (0.1 * rng.uniform(index, draw + 1) < q * q * oneMinusQ2 * oneMinusQ2 * oneMinusQ2 * std::sqrt(oneMinusQ2)) // g(q) < 0.1
+			{
+				break;
+			}
+		}
+		double speed = q * escapeScale / std::sqrt(std::sqrt(r * r + scaleRadius * scaleRadius));
+		double velocityDirection[3];
+		unitDirection<3>(rng, index, 3, velocityDirection);
+
+
+		/// Step 3: Store, dropping z in 2D
+		double position[3], velocity[3];
+		for (int d = 0; d < 3; d++)
+		{
+			position[d] = r * direction[d];
+			velocity[d] = speed * velocityDirection[d];
+		}
+		store(positions, i, position);
+		store(velocities, i, velocity);
+	});
+}
+
+
+
+
+template void randomDirections<2>(Vec2DArray &, std::size_t, const CounterRng &, double, std::size_t);
+template void randomDirections<3>(Vec3DArray &, std::size_t, const CounterRng &, double, std::size_t);
+template void randomGaussian<2>(Vec2DArray &, std::size_t, const CounterRng &, double, std::size_t);
+template void randomGaussian<3>(Vec3DArray &, std::size_t, const CounterRng &, double, std::size_t);
+template void randomDisk<2>(Vec2DArray &, Vec2DArray &, std::size_t, const CounterRng &, double, double, double, std::size_t);
+template void randomDisk<3>(Vec3DArray &, Vec3DArray &, std::size_t, const CounterRng &, double, double, double, std::size_t);
+template void randomPlummer<2>(Vec2DArray &, Vec2DArray &, std::size_t, const CounterRng &, double, double, double, std::size_t);
+template void randomPlummer<3>(Vec3DArray &, Vec3DArray &, std::size_t, const CounterRng &, double, double, double, std::size_t);
@@ -0,0 +1,93 @@
+//  RandomVectors.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Random Vectors header file declares a counter-based random number generator and batched generators of
+ * random vectors for the initial conditions of simulations.
+ *
+ * These components include:
+ *   - CounterRng: Random numbers as a hash of (seed, stream, element, draw), with no state to advance.
+ *   - randomDirections: Uniform on the circle (2D) or sphere (3D) of a radius.
+ *   - randomGaussian: Independent normally distributed components.
+ *   - randomDisk: A uniform disk in the xy-plane on circular orbits, as NBodySimulation::uniformDisk.
+ *   - randomPlummer: Positions and velocities of a Plummer sphere in equilibrium (2D arrays get its
+ *     projection onto the xy-plane).
+ *
+ * Element i of every generator only depends on the generator and i, so the generators split the arrays
+ * across the WorkerPool and still give the same vectors on any number of threads, and a large scene can
+ * be generated in pieces (see 'firstElement') with the same result as in one call. Unlike
+ * Vec2D(double magnitude), which derives its direction from the magnitude, these are random.
+ * tools/RandomVectorsBenchmark.cpp times them on ten million vectors and checks their statistics.
+ */
+
+
+#pragma once
+#include "VectorArrays.hpp"
+#include <cstddef>
+#include <cstdint>
+
+
+
+
+
+
+/**
+ * CounterRng class representing a family of random streams keyed by a seed.
+ *
+ * bits(element, draw) is the SplitMix64 output for counter element * DRAWS_PER_ELEMENT + draw of a
+ * sequence starting at a key derived from the seed and stream, so any element can be generated on its
+ * own, in any order and on any thread.
+ */
+class CounterRng
+{
+public:
+	static constexpr uint32_t DRAWS_PER_ELEMENT = 256; // Random numbers available to each element (rejection sampling uses several)
+
+
+	/// ------------- Constructors -------------
+	/// \{
+	explicit CounterRng(uint64_t seed, uint64_t stream = 0) noexcept : key(mix(seed ^ mix(stream + GOLDEN_GAMMA))) {}
+	CounterRng split(uint64_t stream) const noexcept { return CounterRng(key, stream); } // An independent stream derived from this one, e.g. one per particle species
+	/// \}
+
+
+	/// ------------- Random Numbers -------------
+	/// \{
+	uint64_t bits(uint64_t element, uint32_t draw) const noexcept { return mix(key + (element * DRAWS_PER_ELEMENT + draw) * GOLDEN_GAMMA); } // 64 random bits
+	double uniform(uint64_t element, uint32_t draw) const noexcept { return (static_cast<double>(bits(element, draw) >> 11) + 0.5) * 0x1.0p-53; } // Uniform in the open interval (0, 1), safe for log and negative powers
+	/// \}
+
+
+	static constexpr uint64_t mix(uint64_t z) noexcept // The SplitMix64 finalizer
+	{
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+
+private:
+	static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull; // The SplitMix64 increment, 2^64 / golden ratio
+
+	uint64_t key; // The start of this stream's sequence
+};
+
+
+
+
+
+
+
+
+/// ------------- Generators -------------
+/// \{
+/// Each fills the first 'count' vectors of its arrays (resizing them) with elements firstElement .. firstElement + count - 1 of the stream.
+template<int Dimensions>
+void randomDirections(VectorArray<Dimensions> &out, std::size_t count, const CounterRng &rng, double radius = 1, std::size_t firstElement = 0); // Uniform on the circle or sphere of 'radius'
+template<int Dimensions>
+void randomGaussian(VectorArray<Dimensions> &out, std::size_t count, const CounterRng &rng, double sigma = 1, std::size_t firstElement = 0); // Every component normal with mean 0 and standard deviation 'sigma'
+template<int Dimensions>
+void randomDisk(VectorArray<Dimensions> &positions, VectorArray<Dimensions> &velocities, std::size_t count, const CounterRng &rng, double radius, double totalMass, double G, std::size_t firstElement = 0); // Uniform disk in the xy-plane on circular orbits
+template<int Dimensions>
+void randomPlummer(VectorArray<Dimensions> &positions, VectorArray<Dimensions> &velocities, std::size_t count, const CounterRng &rng, double scaleRadius, double totalMass, double G, std::size_t firstElement = 0); // Plummer sphere in equilibrium
+/// \}
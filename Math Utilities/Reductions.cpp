@@ -0,0 +1,153 @@
+//  Reductions.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "Reductions.hpp"
+#include <algorithm>
+
+
+
+
+
+
+namespace
+{
+	/// The component arrays of a VectorArray, for terms that read them without going through the array.
+	template<int Dimensions>
+	struct Components
+	{
+		explicit Components(const VectorArray<Dimensions> &a)
+		{
+			for (int d = 0; d < Dimensions; d++)
+			{
+				pointers[d] = a.component(d);
+			}
+		}
+
+		const double *pointers[Dimensions];
+	};
+}
+
+
+
+/**
+ * reduceSum
+ * Adds an array of doubles over the fixed reduction tree.
+ *
+ * @param values: The values
+ * @param count: The number of values
+ * @param summation: Plain or compensated additions
+ * @param pool: The pool lending its workers
+ * @return double: The sum, bitwise the same on any number of threads
+ */
+double reduceSum(const double *values, std::size_t count, Summation summation, WorkerPool &pool)
+{
+	double total;
+	reduceTerms<1>(count, [values](std::size_t i, double *term) { term[0] = values[i]; }, &total, summation, pool);
+	return total;
+}
+
+
+double reduceSum(const std::vector<double> &values, Summation summation, WorkerPool &pool)
+{
+	return reduceSum(values.data(), values.size(), summation, pool);
+}
+
+
+template<int Dimensions>
+typename VectorArray<Dimensions>::Vector reduceSum(const VectorArray<Dimensions> &a, Summation summation, WorkerPool &pool)
+{
+	double total[Dimensions];
+	Components<Dimensions> components(a);
+	reduceTerms<Dimensions>(a.size(), [components](std::size_t i, double *term)
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			term[d] = components.pointers[d][i];
+		}
+	}, total, summation, pool);
+	return reductions::toVector<Dimensions>(total);
+}
+
+
+/**
+ * centerOfMass
+ * Sums the mass-weighted positions and the masses in one pass over the bodies.
+ *
+ * @param positions: The positions of the bodies
+ * @param masses: The masses of the bodies
+ * @param summation: Plain or compensated additions
+ * @param pool: The pool lending its workers
+ * @return Vec2D or Vec3D: sum(m r) / sum(m), or the zero vector if the bodies have no mass
+ */
+template<int Dimensions>
+typename VectorArray<Dimensions>::Vector centerOfMass(const VectorArray<Dimensions> &positions, const std::vector<double> &masses, Summation summation, WorkerPool &pool)
+{
+	double totals[Dimensions + 1]; // The weighted positions, then the mass
+	const double *mass = masses.data();
+	Components<Dimensions> components(positions);
+	reduceTerms<Dimensions + 1>(std::min(positions.size(), masses.size()), [components, mass](std::size_t i, double *term)
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			term[d] = mass[i] * components.pointers[d][i];
+		}
+		term[Dimensions] = mass[i];
+	}, totals, summation, pool);
+
+	if (totals[Dimensions] == 0)
+	{
+		return typename VectorArray<Dimensions>::Vector();
+	}
+	return reductions::toVector<Dimensions>(totals) / totals[Dimensions];
+}
+
+
+template<int Dimensions>
+typename VectorArray<Dimensions>::Vector totalMomentum(const VectorArray<Dimensions> &velocities, const std::vector<double> &masses, Summation summation, WorkerPool &pool)
+{
+	double totals[Dimensions];
+	const double *mass = masses.data();
+	Components<Dimensions> components(velocities);
+	reduceTerms<Dimensions>(std::min(velocities.size(), masses.size()), [components, mass](std::size_t i, double *term)
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			term[d] = mass[i] * components.pointers[d][i];
+		}
+	}, totals, summation, pool);
+	return reductions::toVector<Dimensions>(totals);
+}
+
+
+template<int Dimensions>
+double kineticEnergy(const VectorArray<Dimensions> &velocities, const std::vector<double> &masses, Summation summation, WorkerPool &pool)
+{
+	double total;
+	const double *mass = masses.data();
+	Components<Dimensions> components(velocities);
+	reduceTerms<1>(std::min(velocities.size(), masses.size()), [components, mass](std::size_t i, double *term)
+	{
+		double squareSpeed = 0;
+		for (int d = 0; d < Dimensions; d++)
+		{
+			squareSpeed = squareSpeed + components.pointers[d][i] * components.pointers[d][i];
+		}
+		term[0] = mass[i] * squareSpeed;
+	}, &total, summation, pool);
+	return 0.5 * total; // Halving is exact, so this equals the sum of the halved terms
+}
+
+
+
+
+
+template Vec2D reduceSum<2>(const Vec2DArray &, Summation, WorkerPool &);
+template Vec3D reduceSum<3>(const Vec3DArray &, Summation, WorkerPool &);
+template Vec2D centerOfMass<2>(const Vec2DArray &, const std::vector<double> &, Summation, WorkerPool &);
+template Vec3D centerOfMass<3>(const Vec3DArray &, const std::vector<double> &, Summation, WorkerPool &);
+template Vec2D totalMomentum<2>(const Vec2DArray &, const std::vector<double> &, Summation, WorkerPool &);
+template Vec3D totalMomentum<3>(const Vec3DArray &, const std::vector<double> &, Summation, WorkerPool &);
+template double kineticEnergy<2>(const Vec2DArray &, const std::vector<double> &, Summation, WorkerPool &);
+template double kineticEnergy<3>(const Vec3DArray &, const std::vector<double> &, Summation, WorkerPool &);
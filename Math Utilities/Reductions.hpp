@@ -0,0 +1,298 @@
+//  Reductions.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Reductions header file declares sums over arrays of doubles, VectorArrays and array expressions that
+ * run across the WorkerPool and still give bitwise the same result on any number of threads.
+ *
+ * A parallel sum usually gives each thread a share of the elements and adds the shares as they finish,
+ * so the order of the additions, and with it the rounding, changes with the thread count and the timing.
+ * Here the order is a fixed function of the element count alone: the elements are cut into blocks of
+ * REDUCTION_BLOCK, element i of a block adds into lane i % REDUCTION_LANES, the lanes of a block and then
+ * the blocks are added pairwise in a fixed tree. Threads only decide who computes which block. Pairwise
+ * summation also bounds the rounding error by O(log n) instead of the O(n) of a running total, and
+ * Summation::Compensated additionally carries the rounding error of every addition along (Neumaier's
+ * variant of Kahan summation), for sums that cancel, such as the momentum of a system at rest.
+ *
+ * These components include:
+ *   - Summation: Plain or compensated additions.
+ *   - reduceTerms: The reduction of any per-element term with a fixed number of components.
+ *   - reduceSum: The sum of an array of doubles, of the vectors of a VectorArray, or of the elements of a
+ *     scalar or vector expression, e.g. reduceSum(velocities * scalars(masses)).
+ *   - centerOfMass, totalMomentum, kineticEnergy: The conserved quantities of a set of bodies.
+ *
+ * The results do not depend on the SimdLevel either, the additions are plain C++ in a fixed order. They
+ * do differ from a serial running total (and from sum() of ArrayExpressions.hpp), which adds in another
+ * order. tools/ReductionsBenchmark.cpp checks the reproducibility and compares accuracy and speed.
+ */
+
+
+#pragma once
+#include "ArrayExpressions.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+
+
+
+
+/// How the additions of a reduction are carried out.
+enum class Summation
+{
+	Plain, // Rounded additions, the error grows with the log of the element count
+	Compensated // Neumaier summation, the error stays near one rounding of the result, about twice the time
+};
+
+
+constexpr std::size_t REDUCTION_BLOCK = 4096; // Elements per leaf of the reduction tree, a multiple of REDUCTION_LANES
+constexpr std::size_t REDUCTION_LANES = 8; // Independent accumulators per block, as wide as an AVX-512 register of doubles
+
+
+
+
+
+
+
+
+/// ------------- Reductions -------------
+/// \{
+/// Adds term(i, values), which writes 'Components' values for element i, over every i < count into result[0 .. Components - 1]. 'term' is called concurrently.
+template<int Components, typename Term>
+void reduceTerms(std::size_t count, const Term &term, double *result, Summation summation = Summation::Plain, WorkerPool &pool = WorkerPool::global());
+
+double reduceSum(const double *values, std::size_t count, Summation summation = Summation::Plain, WorkerPool &pool = WorkerPool::global()); // values[0] + ... + values[count - 1]
+double reduceSum(const std::vector<double> &values, Summation summation = Summation::Plain, WorkerPool &pool = WorkerPool::global());
+template<int Dimensions>
+typename VectorArray<Dimensions>::Vector reduceSum(const VectorArray<Dimensions> &a, Summation summation = Summation::Plain, WorkerPool &pool = WorkerPool::global()); // The sum of the vectors
+template<typename Expression>
+double reduceSum(const ScalarExpression<Expression> &expression, Summation summation = Summation::Plain, WorkerPool &pool = WorkerPool::global()); // The sum of the values of the expression
+template<typename Expression>
+typename VectorArray<Expression::DIMENSIONS>::Vector reduceSum(const VectorExpression<Expression> &expression, Summation summation = Summation::Plain, WorkerPool &pool = WorkerPool::global()); // The sum of the vectors of the expression
+/// \}
+
+
+/// ------------- Bodies -------------
+/// \{
+/// Over the first min(sizes) bodies, like the VectorArrays operations.
+template<int Dimensions>
+typename VectorArray<Dimensions>::Vector centerOfMass(const VectorArray<Dimensions> &positions, const std::vector<double> &masses, Summation summation = Summation::Plain, WorkerPool &pool = WorkerPool::global()); // sum(m r) / sum(m), the zero vector without mass
+template<int Dimensions>
+typename VectorArray<Dimensions>::Vector totalMomentum(const VectorArray<Dimensions> &velocities, const std::vector<double> &masses, Summation summation = Summation::Plain, WorkerPool &pool = WorkerPool::global()); // sum(m v)
+template<int Dimensions>
+double kineticEnergy(const VectorArray<Dimensions> &velocities, const std::vector<double> &masses, Summation summation = Summation::Plain, WorkerPool &pool = WorkerPool::global()); // sum(m |v|^2) / 2
+/// \}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/// ------------- Reduction Definitions -------------
+/// \{
+namespace reductions
+{
+	/// Adds 'value' to 'sum' and the rounding error of that addition to 'compensation' (Neumaier 1974).
+	inline void compensatedAdd(double &sum, double &compensation, double value)
+	{
+		double total = sum + value;
+		compensation += std::abs(sum) >= std::abs(value) ? (sum - total) + value : (value - total) + sum;
+		sum = total;
+	}
+
+
+	/// The running sums of one node of the reduction tree.
+	template<int Components>
+	struct Partial
+	{
+		double sum[Components] = {};
+		double compensation[Components] = {};
+
+		template<bool Compensated>
+		void add(const double *values) // Adds one term, or merges the sums of another node
+		{
+			for (int c = 0; c < Components; c++)
+			{
+				if constexpr (Compensated)
+				{
+					compensatedAdd(sum[c], compensation[c], values[c]);
+				}
+				else
+				{
+					sum[c] = sum[c] + values[c];
+				}
+			}
+		}
+
+		template<bool Compensated>
+		void merge(const Partial &other)
+		{
+			add<Compensated>(other.sum);
+			for (int c = 0; c < Components; c++)
+			{
+				compensation[c] = compensation[c] + other.compensation[c];
+			}
+		}
+	};
+
+
+	/// Merges nodes[0 .. count - 1] pairwise, neighbours first, into nodes[0]; the shape only depends on 'count'.
+	template<bool Compensated, int Components>
+	void mergeTree(Partial<Components> *nodes, std::size_t count)
+	{
+		for (std::size_t width = 1; width < count; width *= 2)
+		{
+			for (std::size_t i = 0; i + width < count; i += 2 * width)
+			{
+				nodes[i].template merge<Compensated>(nodes[i + width]);
+			}
+		}
+	}
+
+
+	/**
+	 * reduceBlock
+	 * The leaf of the tree: adds the terms of [begin, end), which starts at a multiple of REDUCTION_LANES,
+	 * into REDUCTION_LANES lanes and merges the lanes.
+	 */
+	template<bool Compensated, int Components, typename Term>
+	Partial<Components> reduceBlock(std::size_t begin, std::size_t end, const Term &term)
+	{
+		double sums[Components][REDUCTION_LANES] = {}, compensations[Components][REDUCTION_LANES] = {}; // Lane-major, so the lanes of a component add as one vector
+		double values[REDUCTION_LANES][Components];
+		for (std::size_t base = begin; base < end; base += REDUCTION_LANES)
+		{
+			std::size_t lanes = std::min(REDUCTION_LANES, end - base);
+			for (std::size_t lane = 0; lane < REDUCTION_LANES; lane++)
+			{
+				if (lane < lanes)
+				{
+					term(base + lane, values[lane]);
+				}
+				else
+				{
+					std::fill(values[lane], values[lane] + Components, 0.0); // Adding zero leaves a lane as it is
+				}
+			}
+			for (int c = 0; c < Components; c++)
+			{
+				for (std::size_t lane = 0; lane < REDUCTION_LANES; lane++)
+				{
+					if constexpr (Compensated)
+					{
+						compensatedAdd(sums[c][lane], compensations[c][lane], values[lane][c]);
+					}
+					else
+					{
+						sums[c][lane] = sums[c][lane] + values[lane][c];
+					}
+				}
+			}
+		}
+
+		Partial<Components> lanes[REDUCTION_LANES];
+		for (std::size_t lane = 0; lane < REDUCTION_LANES; lane++)
+		{
+			for (int c = 0; c < Components; c++)
+			{
+				lanes[lane].sum[c] = sums[c][lane];
+				lanes[lane].compensation[c] = compensations[c][lane];
+			}
+		}
+		mergeTree<Compensated>(lanes, REDUCTION_LANES);
+		return lanes[0];
+	}
+
+
+	template<bool Compensated, int Components, typename Term>
+	void reduce(std::size_t count, const Term &term, double *result, WorkerPool &pool)
+	{
+		constexpr std::size_t BLOCKS_PER_CHUNK = 8; // Blocks a thread claims at a time
+		std::size_t blocks = (count + REDUCTION_BLOCK - 1) / REDUCTION_BLOCK;
+		std::vector<Partial<Components>> partials(blocks > 0 ? blocks : 1);
+		parallelFor(blocks, BLOCKS_PER_CHUNK, [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t block = first; block < last; block++)
+			{
+				partials[block] = reduceBlock<Compensated, Components>(block * REDUCTION_BLOCK, std::min(count, (block + 1) * REDUCTION_BLOCK), term);
+			}
+		}, pool);
+		mergeTree<Compensated>(partials.data(), blocks);
+		for (int c = 0; c < Components; c++)
+		{
+			result[c] = partials[0].sum[c] + partials[0].compensation[c];
+		}
+	}
+
+
+	template<int Dimensions>
+	typename VectorArray<Dimensions>::Vector toVector(const double *components)
+	{
+		if constexpr (Dimensions == 2)
+		{
+			return Vec2D(components[0], components[1]);
+		}
+		else
+		{
+			return Vec3D(components[0], components[1], components[2]);
+		}
+	}
+}
+
+
+/**
+ * reduceTerms
+ * Sums a per-element term over a fixed tree, in parallel on the pool; the result is bitwise the same for
+ * every pool and thread count.
+ *
+ * @param count: The number of elements
+ * @param term: term(i, values) writes the 'Components' values of element i; called from several threads at once
+ * @param result: Receives the 'Components' sums
+ * @param summation: Plain or compensated additions
+ * @param pool: The pool lending its workers
+ */
+template<int Components, typename Term>
+void reduceTerms(std::size_t count, const Term &term, double *result, Summation summation, WorkerPool &pool)
+{
+	if (summation == Summation::Compensated)
+	{
+		reductions::reduce<true, Components>(count, term, result, pool);
+	}
+	else
+	{
+		reductions::reduce<false, Components>(count, term, result, pool);
+	}
+}
+
+
+template<typename Expression>
+double reduceSum(const ScalarExpression<Expression> &expression, Summation summation, WorkerPool &pool)
+{
+	const Expression &scalar = expression.derived();
+	double total;
+	reduceTerms<1>(scalar.size(), [&scalar](std::size_t i, double *values) { values[0] = scalar.at(i); }, &total, summation, pool);
+	return total;
+}
+
+
+template<typename Expression>
+typename VectorArray<Expression::DIMENSIONS>::Vector reduceSum(const VectorExpression<Expression> &expression, Summation summation, WorkerPool &pool)
+{
+	const Expression &vector = expression.derived();
+	double total[Expression::DIMENSIONS];
+	reduceTerms<Expression::DIMENSIONS>(vector.size(), [&vector](std::size_t i, double *values) { vector.at(i, values); }, total, summation, pool);
+	return reductions::toVector<Expression::DIMENSIONS>(total);
+}
+/// \}
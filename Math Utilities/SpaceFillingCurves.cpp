@@ -0,0 +1,318 @@
+//  SpaceFillingCurves.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "SpaceFillingCurves.hpp"
+#include "ParallelPrimitives.hpp"
+#include <algorithm>
+
+
+
+
+
+
+namespace
+{
+	constexpr std::size_t KEY_GRAIN = 1 << 14; // Positions per parallel chunk
+	constexpr std::size_t KEY_BLOCK = 256; // Positions the kernels transform together, sized for the stack
+
+
+	/// The mapping of a domain from positions to cells.
+	struct Quantization
+	{
+		double lower[3]; // The low corner of the domain
+		double scale; // Cells per unit length
+		double lastCell; // The largest cell index, as a double
+	};
+
+
+	template<int Dimensions>
+	constexpr int keyBits() { return Dimensions == 2 ? SPATIAL_KEY_BITS_2D : SPATIAL_KEY_BITS_3D; }
+
+
+	/// The mapping of a Square or Cube, whose center components are consecutive doubles like those of any Vec2D/Vec3D.
+	template<int Dimensions, typename Domain>
+	Quantization quantization(const Domain &domain)
+	{
+		Quantization q;
+		const double *center = &domain.center.x;
+		for (int d = 0; d < Dimensions; d++)
+		{
+			q.lower[d] = center[d] - domain.size * 0.5;
+		}
+		double cells = static_cast<double>(1u << (keyBits<Dimensions>() - 1)) * 2; // 2^bits, without shifting a 32-bit one by 32
+		q.scale = domain.size > 0 ? cells / domain.size : 0; // A domain of no size maps everything to cell 0
+		q.lastCell = cells - 1;
+		return q;
+	}
+
+
+	/// Moves bit b of the low 32 bits of x to bit 2b.
+	inline uint64_t spreadBy1(uint64_t x)
+	{
+		x &= 0x00000000FFFFFFFFull;
+		x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+		x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+		x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		x = (x | (x << 2)) & 0x3333333333333333ull;
+		return (x | (x << 1)) & 0x5555555555555555ull;
+	}
+
+
+	/// Moves bit b of the low 21 bits of x to bit 3b.
+	inline uint64_t spreadBy2(uint64_t x)
+	{
+		x &= 0x00000000001FFFFFull;
+		x = (x | (x << 32)) & 0x001F00000000FFFFull;
+		x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+		x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+		x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+		return (x | (x << 2)) & 0x1249249249249249ull;
+	}
+
+
+	/**
+	 * keyBlock
+	 * The keys of up to KEY_BLOCK positions. Every step is a loop over the block without branches, so the
+	 * compiler vectorizes each of them.
+	 *
+	 * @param components: The component arrays of the positions
+	 * @param count: The number of positions, at most KEY_BLOCK
+	 * @param q: The mapping to cells
+	 * @param keys: Receives the 'count' keys
+	 */
+	template<int Dimensions, SpaceFillingCurve Curve>
+	void keyBlock(const double *const *components, std::size_t count, const Quantization &q, uint64_t *keys)
+	{
+		constexpr int BITS = keyBits<Dimensions>();
+		uint32_t cells[Dimensions][KEY_BLOCK];
+
+		/// Step 1: Quantize, sending NaN and positions below the domain to cell 0 and those above it to the last cell
+		for (int d = 0; d < Dimensions; d++)
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				double cell = (components[d][i] - q.lower[d]) * q.scale;
+				cell = cell > 0 ? cell : 0;
+				cell = cell < q.lastCell ? cell : q.lastCell;
+				cells[d][i] = static_cast<uint32_t>(static_cast<int32_t>(cell)); // Fits in int32, which converts in SIMD registers
+			}
+		}
+
+
+		/// Step 2: Hilbert curves transform the cells so that interleaving them gives the Hilbert index (Skilling 2004, "Programming the Hilbert curve")
+		if constexpr (Curve == SpaceFillingCurve::Hilbert)
+		{
+			for (uint32_t level = 1u << (BITS - 1); level > 1; level >>= 1) // Undo the excess work of the curve's rotations, top level first
+			{
+				uint32_t below = level - 1;
+				for (std::size_t i = 0; i < count; i++) // Axis 0 exchanges with itself, leaving only the inversion
+				{
+					cells[0][i] ^= below & (0u - static_cast<uint32_t>((cells[0][i] & level) != 0));
+				}
+				for (int d = 1; d < Dimensions; d++)
+				{
+					for (std::size_t i = 0; i < count; i++)
+					{
+						uint32_t set = 0u - static_cast<uint32_t>((cells[d][i] & level) != 0);
+						uint32_t exchange = (cells[0][i] ^ cells[d][i]) & below & ~set; // Swap the low bits of axes 0 and d where the bit is clear...
+						cells[0][i] ^= (below & set) ^ exchange; // ...and invert those of axis 0 where it is set
+						cells[d][i] ^= exchange;
+					}
+				}
+			}
+			for (int d = 1; d < Dimensions; d++) // Gray encode
+			{
+				for (std::size_t i = 0; i < count; i++)
+				{
+					cells[d][i] ^= cells[d - 1][i];
+				}
+			}
+			for (std::size_t i = 0; i < count; i++)
+			{
+				uint32_t flip = 0;
+				for (uint32_t level = 1u << (BITS - 1); level > 1; level >>= 1)
+				{
+					flip ^= (level - 1) & (0u - static_cast<uint32_t>((cells[Dimensions - 1][i] & level) != 0));
+				}
+				for (int d = 0; d < Dimensions; d++)
+				{
+					cells[d][i] ^= flip;
+				}
+			}
+		}
+
+
+		/// Step 3: Interleave the bits; Morton keys take x as the lowest bit of each group (the quadrant order of BarnesHutTree), Hilbert keys take axis 0 as the highest
+		for (std::size_t i = 0; i < count; i++)
+		{
+			uint64_t key = 0;
+			for (int d = 0; d < Dimensions; d++)
+			{
+				int shift = Curve == SpaceFillingCurve::Morton ? d : Dimensions - 1 - d;
+				key |= (Dimensions == 2 ? spreadBy1(cells[d][i]) : spreadBy2(cells[d][i])) << shift;
+			}
+			keys[i] = key;
+		}
+	}
+
+
+	template<int Dimensions, SpaceFillingCurve Curve>
+	uint64_t singleKey(const double *position, const Quantization &q)
+	{
+		const double *components[Dimensions];
+		for (int d = 0; d < Dimensions; d++)
+		{
+			components[d] = position + d;
+		}
+		uint64_t key;
+		keyBlock<Dimensions, Curve>(components, 1, q, &key);
+		return key;
+	}
+
+
+	template<int Dimensions, SpaceFillingCurve Curve>
+	void arrayKeys(const VectorArray<Dimensions> &positions, const Quantization &q, std::vector<uint64_t> &keys, WorkerPool &pool)
+	{
+		keys.resize(positions.size());
+		parallelFor(positions.size(), KEY_GRAIN, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t first = begin; first < end; first += KEY_BLOCK)
+			{
+				const double *components[Dimensions];
+				for (int d = 0; d < Dimensions; d++)
+				{
+					components[d] = positions.component(d) + first;
+				}
+				keyBlock<Dimensions, Curve>(components, std::min(KEY_BLOCK, end - first), q, keys.data() + first);
+			}
+		}, pool);
+	}
+
+
+	template<int Dimensions, typename Domain>
+	void arrayKeys(const VectorArray<Dimensions> &positions, const Domain &domain, SpaceFillingCurve curve, std::vector<uint64_t> &keys, WorkerPool &pool)
+	{
+		Quantization q = quantization<Dimensions>(domain);
+		if (curve == SpaceFillingCurve::Hilbert)
+		{
+			arrayKeys<Dimensions, SpaceFillingCurve::Hilbert>(positions, q, keys, pool);
+		}
+		else
+		{
+			arrayKeys<Dimensions, SpaceFillingCurve::Morton>(positions, q, keys, pool);
+		}
+	}
+
+
+	/// The low and high corners of the bounding box of the positions.
+	template<int Dimensions>
+	void bounds(const VectorArray<Dimensions> &positions, double *low, double *high)
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			const double *component = positions.component(d);
+			low[d] = high[d] = component[0];
+			for (std::size_t i = 1; i < positions.size(); i++)
+			{
+				low[d] = std::min(low[d], component[i]);
+				high[d] = std::max(high[d], component[i]);
+			}
+		}
+	}
+}
+
+
+
+
+
+
+
+
+/// ------------- Keys -------------
+/// \{
+uint64_t mortonKey(const Vec2D &position, const Square &domain) { return singleKey<2, SpaceFillingCurve::Morton>(&position.x, quantization<2>(domain)); }
+uint64_t mortonKey(const Vec3D &position, const Cube &domain) { return singleKey<3, SpaceFillingCurve::Morton>(&position.x, quantization<3>(domain)); }
+uint64_t hilbertKey(const Vec2D &position, const Square &domain) { return singleKey<2, SpaceFillingCurve::Hilbert>(&position.x, quantization<2>(domain)); }
+uint64_t hilbertKey(const Vec3D &position, const Cube &domain) { return singleKey<3, SpaceFillingCurve::Hilbert>(&position.x, quantization<3>(domain)); }
+
+
+/**
+ * spatialKeys
+ * Computes the key of every position along a curve, in parallel blocks on the pool.
+ *
+ * @param positions: The positions
+ * @param domain: The square mapped onto the key space, e.g. boundingSquare(positions)
+ * @param curve: Morton or Hilbert
+ * @param keys: Resized to positions.size() and filled with the keys
+ * @param pool: The pool lending its workers
+ */
+void spatialKeys(const Vec2DArray &positions, const Square &domain, SpaceFillingCurve curve, std::vector<uint64_t> &keys, WorkerPool &pool)
+{
+	arrayKeys(positions, domain, curve, keys, pool);
+}
+
+
+void spatialKeys(const Vec3DArray &positions, const Cube &domain, SpaceFillingCurve curve, std::vector<uint64_t> &keys, WorkerPool &pool)
+{
+	arrayKeys(positions, domain, curve, keys, pool);
+}
+
+
+Square boundingSquare(const Vec2DArray &positions)
+{
+	if (positions.empty())
+	{
+		return Square();
+	}
+	double low[2], high[2];
+	bounds(positions, low, high);
+	return Square(Vec2D((low[0] + high[0]) * 0.5, (low[1] + high[1]) * 0.5), std::max(high[0] - low[0], high[1] - low[1]));
+}
+
+
+Cube boundingCube(const Vec3DArray &positions)
+{
+	if (positions.empty())
+	{
+		return Cube();
+	}
+	double low[3], high[3];
+	bounds(positions, low, high);
+	return Cube(Vec3D((low[0] + high[0]) * 0.5, (low[1] + high[1]) * 0.5, (low[2] + high[2]) * 0.5), std::max({high[0] - low[0], high[1] - low[1], high[2] - low[2]}));
+}
+/// \}
+
+
+
+
+
+
+
+
+/// ------------- Reordering -------------
+/// \{
+/**
+ * sortOrder
+ * Radix sorts a copy of the keys with their indices as the payload. The sort is stable, so equal keys stay
+ * in index order.
+ *
+ * @param keys: The keys, at most 2^32 of them
+ * @param order: Resized to keys.size() and filled with the indices of the keys in ascending order
+ * @param pool: The pool lending its workers
+ */
+void sortOrder(const std::vector<uint64_t> &keys, std::vector<uint32_t> &order, WorkerPool &pool)
+{
+	std::vector<uint64_t> sorted(keys);
+	order.resize(keys.size());
+	parallelFor(order.size(), KEY_GRAIN, [&](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; i++)
+		{
+			order[i] = static_cast<uint32_t>(i);
+		}
+	}, pool);
+	radixSort(sorted, order, pool);
+}
+/// \}
@@ -0,0 +1,151 @@
+//  SpaceFillingCurves.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Space Filling Curves header file declares Morton (Z-order) and Hilbert keys of positions and the
+ * reordering of per-particle arrays by those keys.
+ *
+ * Particles that are near each other in space get nearby keys, so after sorting every per-particle array
+ * by key, consecutive particles are spatial neighbours: a tree walk for particle i + 1 then touches
+ * mostly the cells particle i just loaded, and a tree built from the sorted particles allocates its cells
+ * in the same order. The Hilbert curve never jumps, unlike the Morton curve at its quadrant boundaries, so
+ * it keeps neighbours slightly closer; Morton keys are cheaper to compute.
+ *
+ * These components include:
+ *   - SpaceFillingCurve: Morton or Hilbert.
+ *   - mortonKey, hilbertKey: The key of one Vec2D/Vec3D relative to a Square/Cube domain.
+ *   - spatialKeys: The keys of a whole VectorArray, in parallel, with branch-free block kernels that the
+ *     compiler vectorizes (quantization, Skilling's Hilbert transform and the bit interleaving are plain
+ *     integer shifts and masks).
+ *   - boundingSquare, boundingCube: The smallest domain holding every position.
+ *   - sortOrder, applyOrder: The permutation that sorts keys (a radixSort of ParallelPrimitives.hpp), and
+ *     its application to any number of std::vectors and VectorArrays at once.
+ *
+ * 2D keys hold SPATIAL_KEY_BITS_2D bits per axis, 3D keys SPATIAL_KEY_BITS_3D; positions outside the domain
+ * are clamped to its boundary. tools/SpaceFillingCurvesBenchmark.cpp times the keys and the force pass of
+ * NBodySimulation before and after reordering.
+ */
+
+
+#pragma once
+#include "VectorArrays.hpp"
+#include "Geometry.hpp"
+#include "WorkerPool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+
+
+
+
+/// The order of the cells along a space-filling curve.
+enum class SpaceFillingCurve
+{
+	Morton, // Z-order: the bits of the coordinates interleaved
+	Hilbert // Every cell is followed by one of its neighbours
+};
+
+
+constexpr int SPATIAL_KEY_BITS_2D = 31; // Bits per axis of 2D keys, 62-bit keys
+constexpr int SPATIAL_KEY_BITS_3D = 21; // Bits per axis of 3D keys, 63-bit keys
+
+
+
+
+
+
+
+
+/// ------------- Keys -------------
+/// \{
+uint64_t mortonKey(const Vec2D &position, const Square &domain);
+uint64_t mortonKey(const Vec3D &position, const Cube &domain);
+uint64_t hilbertKey(const Vec2D &position, const Square &domain);
+uint64_t hilbertKey(const Vec3D &position, const Cube &domain);
+void spatialKeys(const Vec2DArray &positions, const Square &domain, SpaceFillingCurve curve, std::vector<uint64_t> &keys, WorkerPool &pool = WorkerPool::global()); // keys[i] = the key of positions[i]
+void spatialKeys(const Vec3DArray &positions, const Cube &domain, SpaceFillingCurve curve, std::vector<uint64_t> &keys, WorkerPool &pool = WorkerPool::global());
+Square boundingSquare(const Vec2DArray &positions); // The smallest square holding every position, centered on their bounding box
+Cube boundingCube(const Vec3DArray &positions);
+/// \}
+
+
+/// ------------- Reordering -------------
+/// \{
+void sortOrder(const std::vector<uint64_t> &keys, std::vector<uint32_t> &order, WorkerPool &pool = WorkerPool::global()); // order[k] = the index of the k-th smallest key, equal keys in index order
+template<typename... Arrays>
+void applyOrder(const std::vector<uint32_t> &order, Arrays &... arrays); // arrays[k] = old arrays[order[k]] for every std::vector and VectorArray given
+/// \}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/// ------------- Reordering Definitions -------------
+/// \{
+namespace spaceFillingCurves
+{
+	constexpr std::size_t GATHER_GRAIN = 1 << 15; // Elements per parallel chunk of a gather
+
+
+	template<typename T>
+	void gather(const std::vector<uint32_t> &order, std::vector<T> &values)
+	{
+		std::vector<T> sorted(order.size());
+		parallelFor(order.size(), GATHER_GRAIN, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t k = begin; k < end; k++)
+			{
+				sorted[k] = values[order[k]];
+			}
+		});
+		values.swap(sorted);
+	}
+
+
+	template<int Dimensions>
+	void gather(const std::vector<uint32_t> &order, VectorArray<Dimensions> &values)
+	{
+		VectorArray<Dimensions> sorted(order.size());
+		parallelFor(order.size(), GATHER_GRAIN, [&](std::size_t begin, std::size_t end)
+		{
+			for (int d = 0; d < Dimensions; d++)
+			{
+				const double *source = values.component(d);
+				double *destination = sorted.component(d);
+				for (std::size_t k = begin; k < end; k++)
+				{
+					destination[k] = source[order[k]];
+				}
+			}
+		});
+		values = std::move(sorted);
+	}
+}
+
+
+/**
+ * applyOrder
+ * Permutes per-particle arrays by a sort order, each with a parallel gather into a new array. Every array
+ * must hold at least order.size() elements and ends up with exactly that many.
+ *
+ * @param order: The permutation, e.g. from sortOrder
+ * @param arrays: The std::vectors and VectorArrays to permute
+ */
+template<typename... Arrays>
+void applyOrder(const std::vector<uint32_t> &order, Arrays &... arrays)
+{
+	(spaceFillingCurves::gather(order, arrays), ...);
+}
+/// \}
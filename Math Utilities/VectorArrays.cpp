@@ -0,0 +1,426 @@
+//  VectorArrays.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "VectorArrays.hpp"
+#include "VectorKernels.hpp"
+#include <atomic>
+#include <cmath>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VECTOR_ARRAYS_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define VECTOR_ARRAYS_NEON 1
+#endif
+
+
+
+
+
+
+namespace
+{
+	/// One double at a time, the reference every other instruction set matches.
+	struct ScalarLanes
+	{
+		using Register = double;
+		static constexpr std::size_t WIDTH = 1;
+		static Register load(const double *p) { return *p; }
+		static void store(double *p, Register r) { *p = r; }
+		static Register broadcast(double s) { return s; }
+		static Register add(Register a, Register b) { return a + b; }
+		static Register subtract(Register a, Register b) { return a - b; }
+		static Register multiply(Register a, Register b) { return a * b; }
+		static Register divide(Register a, Register b) { return a / b; }
+		static Register squareRoot(Register a) { return std::sqrt(a); }
+		static Register selectNonZero(Register test, Register ifNonZero, Register ifZero) { return test != 0 ? ifNonZero : ifZero; }
+		static Register reciprocalSquareRootEstimate(Register a) { return 1.0f / std::sqrt(static_cast<float>(a)); } // Single precision, more accurate than the hardware estimates
+	};
+
+
+#ifdef VECTOR_ARRAYS_SSE2
+	struct Sse2Lanes
+	{
+		using Register = __m128d;
+		static constexpr std::size_t WIDTH = 2;
+		static Register load(const double *p) { return _mm_loadu_pd(p); }
+		static void store(double *p, Register r) { _mm_storeu_pd(p, r); }
+		static Register broadcast(double s) { return _mm_set1_pd(s); }
+		static Register add(Register a, Register b) { return _mm_add_pd(a, b); }
+		static Register subtract(Register a, Register b) { return _mm_sub_pd(a, b); }
+		static Register multiply(Register a, Register b) { return _mm_mul_pd(a, b); }
+		static Register divide(Register a, Register b) { return _mm_div_pd(a, b); }
+		static Register squareRoot(Register a) { return _mm_sqrt_pd(a); }
+		static Register selectNonZero(Register test, Register ifNonZero, Register ifZero)
+		{
+			Register zero = _mm_cmpeq_pd(test, _mm_setzero_pd());
+			return _mm_or_pd(_mm_and_pd(zero, ifZero), _mm_andnot_pd(zero, ifNonZero));
+		}
+		static Register reciprocalSquareRootEstimate(Register a) { return _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(a))); } // rsqrtps, relative error below 1.5 * 2^-12
+	};
+#endif
+
+
+#ifdef VECTOR_ARRAYS_NEON
+	struct NeonLanes
+	{
+		using Register = float64x2_t;
+		static constexpr std::size_t WIDTH = 2;
+		static Register load(const double *p) { return vld1q_f64(p); }
+		static void store(double *p, Register r) { vst1q_f64(p, r); }
+		static Register broadcast(double s) { return vdupq_n_f64(s); }
+		static Register add(Register a, Register b) { return vaddq_f64(a, b); }
+		static Register subtract(Register a, Register b) { return vsubq_f64(a, b); }
+		static Register multiply(Register a, Register b) { return vmulq_f64(a, b); }
+		static Register divide(Register a, Register b) { return vdivq_f64(a, b); }
+		static Register squareRoot(Register a) { return vsqrtq_f64(a); }
+		static Register selectNonZero(Register test, Register ifNonZero, Register ifZero) { return vbslq_f64(vceqq_f64(test, vdupq_n_f64(0.0)), ifZero, ifNonZero); }
+		static Register reciprocalSquareRootEstimate(Register a)
+		{
+			Register estimate = vrsqrteq_f64(a); // 8 bits, one built-in step brings it past 12
+			return vmulq_f64(estimate, vrsqrtsq_f64(vmulq_f64(a, estimate), estimate));
+		}
+	};
+#endif
+
+
+	const VectorKernelTable SCALAR_KERNELS = makeVectorKernelTable<ScalarLanes>();
+#ifdef VECTOR_ARRAYS_SSE2
+	const VectorKernelTable SSE2_KERNELS = makeVectorKernelTable<Sse2Lanes>();
+#endif
+#ifdef VECTOR_ARRAYS_NEON
+	const VectorKernelTable NEON_KERNELS = makeVectorKernelTable<NeonLanes>();
+#endif
+
+
+	/// The kernels of an instruction set, nullptr if it is not available on this processor.
+	const VectorKernelTable *kernelsFor(SimdLevel level)
+	{
+		switch (level)
+		{
+			case SimdLevel::Scalar: return &SCALAR_KERNELS;
+#ifdef VECTOR_ARRAYS_SSE2
+			case SimdLevel::SSE2: return &SSE2_KERNELS;
+#endif
+#ifdef VECTOR_ARRAYS_NEON
+			case SimdLevel::NEON: return &NEON_KERNELS;
+#endif
+			case SimdLevel::AVX2: return avx2VectorKernels();
+			default: return nullptr;
+		}
+	}
+
+
+	struct ActiveKernels
+	{
+		std::atomic<const VectorKernelTable*> table;
+		std::atomic<SimdLevel> level;
+	};
+
+	ActiveKernels &active()
+	{
+		static ActiveKernels kernels{{kernelsFor(bestSimdLevel())}, {bestSimdLevel()}}; // Detected once, on first use
+		return kernels;
+	}
+
+	const VectorKernelTable &kernels()
+	{
+		return *active().table.load(std::memory_order_acquire);
+	}
+
+
+	double zOf(const Vec2D &) { return 0; }
+	double zOf(const Vec3D &vector) { return vector.z; }
+
+
+	template<int Dimensions>
+	void componentPointers(const VectorArray<Dimensions> &a, const double *(&pointers)[Dimensions])
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			pointers[d] = a.component(d);
+		}
+	}
+}
+
+
+
+
+
+
+
+
+const VectorKernelTable &activeVectorKernels()
+{
+	return kernels();
+}
+
+
+/**
+ * bestSimdLevel
+ * Returns the fastest instruction set the operations can use here: AVX2 if it was compiled in and the
+ * processor and operating system support it, otherwise the baseline of the architecture.
+ *
+ * @return SimdLevel: The instruction set
+ */
+SimdLevel bestSimdLevel()
+{
+	if (avx2VectorKernels())
+	{
+		return SimdLevel::AVX2; // Only returned where the processor supports it
+	}
+#if defined(VECTOR_ARRAYS_SSE2)
+	return SimdLevel::SSE2;
+#elif defined(VECTOR_ARRAYS_NEON)
+	return SimdLevel::NEON;
+#else
+	return SimdLevel::Scalar;
+#endif
+}
+
+
+SimdLevel activeSimdLevel()
+{
+	return active().level.load(std::memory_order_acquire);
+}
+
+
+/**
+ * setSimdLevel
+ * Switches the instruction set of all following operations, for benchmarks and for checking the SIMD
+ * paths against the scalar one. Operations already running finish on the previous one.
+ *
+ * @param level: The instruction set
+ * @return bool: false if this processor (or build) does not support 'level'
+ */
+bool setSimdLevel(SimdLevel level)
+{
+	const VectorKernelTable *table = kernelsFor(level);
+	if (!table)
+	{
+		return false;
+	}
+	active().table.store(table, std::memory_order_release);
+	active().level.store(level, std::memory_order_release);
+	return true;
+}
+
+
+const char *simdLevelName(SimdLevel level)
+{
+	switch (level)
+	{
+		case SimdLevel::Scalar: return "Scalar";
+		case SimdLevel::SSE2: return "SSE2";
+		case SimdLevel::AVX2: return "AVX2";
+		case SimdLevel::NEON: return "NEON";
+	}
+	return "Unknown";
+}
+
+
+
+
+
+
+
+
+template<int Dimensions>
+void vectorAdd(const VectorArray<Dimensions> &a, const VectorArray<Dimensions> &b, VectorArray<Dimensions> &out)
+{
+	std::size_t count = std::min(a.size(), b.size());
+	out.resize(count);
+	for (int d = 0; d < Dimensions; d++)
+	{
+		kernels().add(a.component(d), b.component(d), out.component(d), count);
+	}
+}
+
+
+/**
+ * vectorAddScaled
+ * Adds a scaled array to another, the drift and kick of an integrator (positions += velocities * dt).
+ *
+ * @param a: The array added to
+ * @param b: The array added
+ * @param scalar: The factor 'b' is multiplied by
+ */
+template<int Dimensions>
+void vectorAddScaled(VectorArray<Dimensions> &a, const VectorArray<Dimensions> &b, double scalar)
+{
+	std::size_t count = std::min(a.size(), b.size());
+	for (int d = 0; d < Dimensions; d++)
+	{
+		kernels().addScaled(a.component(d), b.component(d), scalar, count);
+	}
+}
+
+
+template<int Dimensions>
+void vectorScale(VectorArray<Dimensions> &a, double scalar)
+{
+	for (int d = 0; d < Dimensions; d++)
+	{
+		kernels().scale(a.component(d), scalar, a.size());
+	}
+}
+
+
+template<int Dimensions>
+void vectorSquareLengths(const VectorArray<Dimensions> &a, std::vector<double> &out)
+{
+	const double *components[Dimensions];
+	componentPointers(a, components);
+	out.resize(a.size());
+	(Dimensions == 2 ? kernels().squareLengths2 : kernels().squareLengths3)(components, out.data(), a.size());
+}
+
+
+template<int Dimensions>
+void vectorLengths(const VectorArray<Dimensions> &a, std::vector<double> &out)
+{
+	const double *components[Dimensions];
+	componentPointers(a, components);
+	out.resize(a.size());
+	(Dimensions == 2 ? kernels().lengths2 : kernels().lengths3)(components, out.data(), a.size());
+}
+
+
+template<int Dimensions>
+void vectorNormalize(VectorArray<Dimensions> &a)
+{
+	double *components[Dimensions];
+	for (int d = 0; d < Dimensions; d++)
+	{
+		components[d] = a.component(d);
+	}
+	(Dimensions == 2 ? kernels().normalize2 : kernels().normalize3)(components, a.size());
+}
+
+
+template<int Dimensions>
+void vectorDistances(const VectorArray<Dimensions> &a, const VectorArray<Dimensions> &b, std::vector<double> &out)
+{
+	const double *first[Dimensions], *second[Dimensions];
+	componentPointers(a, first);
+	componentPointers(b, second);
+	std::size_t count = std::min(a.size(), b.size());
+	out.resize(count);
+	(Dimensions == 2 ? kernels().distances2 : kernels().distances3)(first, second, out.data(), count);
+}
+
+
+
+
+
+
+
+
+/**
+ * rsqrtErrorBound
+ * The largest relative error of 1/sqrt(x) in an accuracy mode. The estimates (SSE2/AVX2 rsqrtps, NEON
+ * vrsqrte with one step, single-precision 1/sqrt in the scalar fallback) are within e0 = 1.5 * 2^-12; each
+ * Newton-Raphson step turns an error e into about 1.5 * e^2 plus a few ulps of rounding. Derived values
+ * compound it: 1/r^3 is within about 3 times the bound, normalized vectors and distances within it.
+ * tools/RsqrtBenchmark.cpp checks the kernels against these bounds.
+ *
+ * @param accuracy: The mode
+ * @return double: The bound
+ */
+double rsqrtErrorBound(RsqrtAccuracy accuracy)
+{
+	switch (accuracy)
+	{
+		case RsqrtAccuracy::Fast: return 2.5e-7; // 1.5 * e0^2 = 2.0e-7
+		case RsqrtAccuracy::Refined: return 1e-13; // 1.5 * (2.0e-7)^2 = 6e-14
+		case RsqrtAccuracy::Exact: return 4.5e-16; // Two correctly rounded operations, 2 ulps
+	}
+	return 0;
+}
+
+
+void inverseSquareRoots(const double *values, double *out, std::size_t count, RsqrtAccuracy accuracy)
+{
+	kernels().inverseSquareRoots[static_cast<int>(accuracy)](values, out, count);
+}
+
+
+template<int Dimensions>
+void vectorInverseCubeDistances(const VectorArray<Dimensions> &a, const typename VectorArray<Dimensions>::Vector &point, double softening2, std::vector<double> &out, RsqrtAccuracy accuracy)
+{
+	const double *components[Dimensions];
+	componentPointers(a, components);
+	const double coordinates[3] = {point.x, point.y, zOf(point)};
+	out.resize(a.size());
+	(Dimensions == 2 ? kernels().inverseCubeDistances2 : kernels().inverseCubeDistances3)[static_cast<int>(accuracy)](components, coordinates, softening2, out.data(), a.size());
+}
+
+
+
+/**
+ * vectorNormalize
+ * Normalizes every vector through a reciprocal square root of the given accuracy; Exact is the same as
+ * vectorNormalize without an accuracy.
+ *
+ * @param a: The vectors, zero vectors stay zero
+ * @param accuracy: The accuracy of 1/|a[i]|
+ */
+template<int Dimensions>
+void vectorNormalize(VectorArray<Dimensions> &a, RsqrtAccuracy accuracy)
+{
+	if (accuracy == RsqrtAccuracy::Exact)
+	{
+		vectorNormalize(a);
+		return;
+	}
+	double *components[Dimensions];
+	for (int d = 0; d < Dimensions; d++)
+	{
+		components[d] = a.component(d);
+	}
+	(Dimensions == 2 ? kernels().approximateNormalize2 : kernels().approximateNormalize3)[static_cast<int>(accuracy)](components, a.size());
+}
+
+
+template<int Dimensions>
+void vectorDistances(const VectorArray<Dimensions> &a, const VectorArray<Dimensions> &b, std::vector<double> &out, RsqrtAccuracy accuracy)
+{
+	if (accuracy == RsqrtAccuracy::Exact)
+	{
+		vectorDistances(a, b, out);
+		return;
+	}
+	const double *first[Dimensions], *second[Dimensions];
+	componentPointers(a, first);
+	componentPointers(b, second);
+	std::size_t count = std::min(a.size(), b.size());
+	out.resize(count);
+	(Dimensions == 2 ? kernels().approximateDistances2 : kernels().approximateDistances3)[static_cast<int>(accuracy)](first, second, out.data(), count);
+}
+
+
+
+
+
+template void vectorAdd<2>(const Vec2DArray &, const Vec2DArray &, Vec2DArray &);
+template void vectorAdd<3>(const Vec3DArray &, const Vec3DArray &, Vec3DArray &);
+template void vectorAddScaled<2>(Vec2DArray &, const Vec2DArray &, double);
+template void vectorAddScaled<3>(Vec3DArray &, const Vec3DArray &, double);
+template void vectorScale<2>(Vec2DArray &, double);
+template void vectorScale<3>(Vec3DArray &, double);
+template void vectorSquareLengths<2>(const Vec2DArray &, std::vector<double> &);
+template void vectorSquareLengths<3>(const Vec3DArray &, std::vector<double> &);
+template void vectorLengths<2>(const Vec2DArray &, std::vector<double> &);
+template void vectorLengths<3>(const Vec3DArray &, std::vector<double> &);
+template void vectorNormalize<2>(Vec2DArray &);
+template void vectorNormalize<3>(Vec3DArray &);
+template void vectorDistances<2>(const Vec2DArray &, const Vec2DArray &, std::vector<double> &);
+template void vectorDistances<3>(const Vec3DArray &, const Vec3DArray &, std::vector<double> &);
+template void vectorInverseCubeDistances<2>(const Vec2DArray &, const Vec2D &, double, std::vector<double> &, RsqrtAccuracy);
+template void vectorInverseCubeDistances<3>(const Vec3DArray &, const Vec3D &, double, std::vector<double> &, RsqrtAccuracy);
+template void vectorNormalize<2>(Vec2DArray &, RsqrtAccuracy);
+template void vectorNormalize<3>(Vec3DArray &, RsqrtAccuracy);
+template void vectorDistances<2>(const Vec2DArray &, const Vec2DArray &, std::vector<double> &, RsqrtAccuracy);
+template void vectorDistances<3>(const Vec3DArray &, const Vec3DArray &, std::vector<double> &, RsqrtAccuracy);
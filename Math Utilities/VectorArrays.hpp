@@ -0,0 +1,392 @@
+//  VectorArrays.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Vector Arrays header file declares struct-of-arrays containers of two- and three-dimensional vectors,
+ * and SIMD operations over whole arrays of them.
+ *
+ * These components include:
+ *   - VectorArray<Dimensions> (Vec2DArray, Vec3DArray): The x, y (and z) components of many vectors in
+ *     separate arrays. All components share one allocation aligned to 64 bytes, and every component array
+ *     is padded with zeros to a multiple of 8 doubles, so each component starts on its own cache line.
+ *   - vectorAdd, vectorAddScaled, vectorScale: Component-wise arithmetic (integration passes).
+ *   - vectorSquareLengths, vectorLengths, vectorNormalize, vectorDistances: Per-vector reductions
+ *     (diagnostic passes).
+ *   - inverseSquareRoots, vectorInverseCubeDistances and the RsqrtAccuracy overloads of vectorNormalize and
+ *     vectorDistances: The 1/sqrt of softened gravity and normalization, from the hardware estimate refined
+ *     by Newton-Raphson steps (Fast, Refined) or exact.
+ *   - Expression assignment (=, +=, -=): Arithmetic written as on single vectors, fused into one loop;
+ *     the operators are in ArrayExpressions.hpp.
+ *   - SimdLevel: The instruction set the operations run on. The best one the processor supports (AVX2 or
+ *     SSE2 on x86-64, NEON on ARM64) is picked at the first call, with a portable scalar fallback;
+ *     setSimdLevel() can force a lower one, e.g. to compare them.
+ *
+ * Every instruction set computes the same results as the scalar loop (see VectorKernels.hpp), so the
+ * choice only affects speed; only the Fast and Refined modes differ between instruction sets, within
+ * rsqrtErrorBound(). tools/VectorArraysBenchmark.cpp compares them with loops over Vec2D.
+ */
+
+
+#pragma once
+#include "Vects.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+
+
+
+
+
+template<typename Expression> struct VectorExpression; // Defined in ArrayExpressions.hpp
+
+
+/// The instruction sets the array operations can run on.
+enum class SimdLevel
+{
+	Scalar, // Portable loops, one element at a time
+	SSE2, // 2 doubles per instruction, x86-64 baseline
+	AVX2, // 4 doubles per instruction, detected at runtime
+	NEON // 2 doubles per instruction, ARM64 baseline
+};
+
+
+SimdLevel bestSimdLevel(); // The fastest instruction set this processor supports
+SimdLevel activeSimdLevel(); // The instruction set the operations currently run on
+bool setSimdLevel(SimdLevel level); // Runs the operations on 'level', false (and nothing changes) if the processor does not support it
+const char *simdLevelName(SimdLevel level); // "Scalar", "SSE2", "AVX2" or "NEON"
+
+
+/// The accuracy of the reciprocal square roots behind inverseSquareRoots and the operations taking an RsqrtAccuracy.
+enum class RsqrtAccuracy
+{
+	Fast, // Hardware estimate and one Newton-Raphson step, about single precision
+	Refined, // Hardware estimate and two Newton-Raphson steps, within a few hundred ulps of double precision
+	Exact // Square root and division, as the operations without an accuracy
+};
+
+
+double rsqrtErrorBound(RsqrtAccuracy accuracy); // The largest relative error of 1/sqrt(x) in 'accuracy', on every instruction set
+
+
+
+
+
+
+
+
+/**
+ * VectorArray class representing an array of vectors stored as one array per component.
+ *
+ * Elements are read and written as Vec2D/Vec3D with get/set, or directly through the component arrays;
+ * the elements past size() up to the padded stride are always zero.
+ */
+template<int Dimensions>
+class VectorArray
+{
+	static_assert(Dimensions == 2 || Dimensions == 3, "VectorArray holds 2D or 3D vectors");
+
+public:
+	using Vector = typename std::conditional<Dimensions == 2, Vec2D, Vec3D>::type; // The element type
+	static constexpr int DIMENSIONS = Dimensions;
+	static constexpr std::size_t ALIGNMENT = 64; // Bytes, one cache line and one AVX-512 register
+	static constexpr std::size_t PADDING = ALIGNMENT / sizeof(double); // Component arrays are padded to a multiple of this many doubles
+
+
+	/// ------------- Constructors and Destructor -------------
+	/// \{
+	VectorArray() noexcept; // Creates an empty array
+	explicit VectorArray(std::size_t count); // Creates 'count' zero vectors
+	VectorArray(const VectorArray &other);
+	VectorArray(VectorArray &&other) noexcept;
+	VectorArray &operator=(const VectorArray &other);
+	VectorArray &operator=(VectorArray &&other) noexcept;
+	~VectorArray();
+	/// \}
+
+
+	/// ------------- Expressions (ArrayExpressions.hpp) -------------
+	/// \{
+	template<typename Expression>
+	VectorArray(const VectorExpression<Expression> &expression); // Creates the array an expression evaluates to
+	template<typename Expression>
+	VectorArray &operator=(const VectorExpression<Expression> &expression); // Evaluates an expression into this array in one pass, resizing it to the expression
+	template<typename Expression>
+	VectorArray &operator+=(const VectorExpression<Expression> &expression); // Adds an expression to the first min(size(), expression size) vectors in one pass
+	template<typename Expression>
+	VectorArray &operator-=(const VectorExpression<Expression> &expression);
+	/// \}
+
+
+	/// ------------- Size -------------
+	/// \{
+	std::size_t size() const noexcept { return count; } // Number of vectors
+	std::size_t capacity() const noexcept { return stride; } // Number of vectors that fit without reallocating, the padded length of each component array
+	bool empty() const noexcept { return count == 0; }
+	void resize(std::size_t newCount); // Adds zero vectors or drops vectors at the end
+	void reserve(std::size_t newCapacity); // Makes room for 'newCapacity' vectors
+	void clear() noexcept; // Removes every vector, keeping the allocation
+	void push_back(const Vector &vector); // Appends a vector
+										  /// \}
+
+
+	/// ------------- Access -------------
+	/// \{
+	Vector get(std::size_t index) const noexcept; // The vector at 'index'
+	void set(std::size_t index, const Vector &vector) noexcept; // Replaces the vector at 'index'
+	double *component(int dimension) noexcept { return data + dimension * stride; } // The array of one component, 0 for x
+	const double *component(int dimension) const noexcept { return data + dimension * stride; }
+	double *x() noexcept { return component(0); }
+	double *y() noexcept { return component(1); }
+	double *z() noexcept { static_assert(Dimensions == 3, "Only 3D arrays have z"); return component(2); }
+	const double *x() const noexcept { return component(0); }
+	const double *y() const noexcept { return component(1); }
+	const double *z() const noexcept { static_assert(Dimensions == 3, "Only 3D arrays have z"); return component(2); }
+	/// \}
+
+
+private:
+	template<typename Expression, typename Operation>
+	void evaluate(const Expression &expression, std::size_t count); // Applies 'Operation' to the first 'count' vectors and the expression's values
+	void reallocate(std::size_t newStride); // Moves the components into an allocation of 'newStride' vectors per component
+	static std::size_t padded(std::size_t vectors) { return (vectors + PADDING - 1) / PADDING * PADDING; }
+
+	double *data = nullptr; // Dimensions * stride doubles, component d at data + d * stride
+	std::size_t count = 0; // Number of vectors
+	std::size_t stride = 0; // Padded length of each component array
+};
+
+
+using Vec2DArray = VectorArray<2>;
+using Vec3DArray = VectorArray<3>;
+
+
+
+
+
+
+
+
+/// ------------- Array Operations -------------
+/// \{
+/// Operations on two arrays use the first min(a.size(), b.size()) vectors; outputs are resized to match.
+template<int Dimensions>
+void vectorAdd(const VectorArray<Dimensions> &a, const VectorArray<Dimensions> &b, VectorArray<Dimensions> &out); // out = a + b
+template<int Dimensions>
+void vectorAddScaled(VectorArray<Dimensions> &a, const VectorArray<Dimensions> &b, double scalar); // a += b * scalar, e.g. positions += velocities * dt
+template<int Dimensions>
+void vectorScale(VectorArray<Dimensions> &a, double scalar); // a *= scalar
+template<int Dimensions>
+void vectorSquareLengths(const VectorArray<Dimensions> &a, std::vector<double> &out); // out[i] = |a[i]|^2
+template<int Dimensions>
+void vectorLengths(const VectorArray<Dimensions> &a, std::vector<double> &out); // out[i] = |a[i]|
+template<int Dimensions>
+void vectorNormalize(VectorArray<Dimensions> &a); // a[i] /= |a[i]|, zero vectors stay zero
+template<int Dimensions>
+void vectorDistances(const VectorArray<Dimensions> &a, const VectorArray<Dimensions> &b, std::vector<double> &out); // out[i] = |a[i] - b[i]|
+/// \}
+
+
+/// ------------- Reciprocal Square Root Operations -------------
+/// \{
+/// The approximate modes need their arguments of 1/sqrt (squared lengths plus softening) within the range of single precision, about 1e-38 to 3e38.
+void inverseSquareRoots(const double *values, double *out, std::size_t count, RsqrtAccuracy accuracy); // out[i] = 1 / sqrt(values[i])
+template<int Dimensions>
+void vectorInverseCubeDistances(const VectorArray<Dimensions> &a, const typename VectorArray<Dimensions>::Vector &point, double softening2, std::vector<double> &out, RsqrtAccuracy accuracy); // out[i] = 1 / (|a[i] - point|^2 + softening2)^(3/2), the 1/r^3 of softened gravity
+template<int Dimensions>
+void vectorNormalize(VectorArray<Dimensions> &a, RsqrtAccuracy accuracy); // a[i] *= 1 / |a[i]|, zero vectors stay zero
+template<int Dimensions>
+void vectorDistances(const VectorArray<Dimensions> &a, const VectorArray<Dimensions> &b, std::vector<double> &out, RsqrtAccuracy accuracy); // out[i] = |a[i] - b[i]|^2 / |a[i] - b[i]|
+/// \}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/// ------------- VectorArray Definitions -------------
+/// \{
+template<int Dimensions>
+VectorArray<Dimensions>::VectorArray() noexcept
+{
+}
+
+
+template<int Dimensions>
+VectorArray<Dimensions>::VectorArray(std::size_t count)
+{
+	resize(count);
+}
+
+
+template<int Dimensions>
+VectorArray<Dimensions>::VectorArray(const VectorArray &other)
+{
+	*this = other;
+}
+
+
+template<int Dimensions>
+VectorArray<Dimensions>::VectorArray(VectorArray &&other) noexcept : data(other.data), count(other.count), stride(other.stride)
+{
+	other.data = nullptr;
+	other.count = 0;
+	other.stride = 0;
+}
+
+
+template<int Dimensions>
+VectorArray<Dimensions> &VectorArray<Dimensions>::operator=(const VectorArray &other)
+{
+	if (this != &other)
+	{
+		if (stride < other.count)
+		{
+			reallocate(padded(other.count));
+		}
+		clear();
+		count = other.count;
+		for (int d = 0; d < Dimensions; d++)
+		{
+			if (count > 0)
+			{
+				std::memcpy(component(d), other.component(d), count * sizeof(double));
+			}
+		}
+	}
+	return *this;
+}
+
+
+template<int Dimensions>
+VectorArray<Dimensions> &VectorArray<Dimensions>::operator=(VectorArray &&other) noexcept
+{
+	if (this != &other)
+	{
+		::operator delete(data, std::align_val_t(ALIGNMENT));
+		data = other.data;
+		count = other.count;
+		stride = other.stride;
+		other.data = nullptr;
+		other.count = 0;
+		other.stride = 0;
+	}
+	return *this;
+}
+
+
+template<int Dimensions>
+VectorArray<Dimensions>::~VectorArray()
+{
+	::operator delete(data, std::align_val_t(ALIGNMENT));
+}
+
+
+
+
+/**
+ * resize
+ * Changes the number of vectors. New vectors are zero; dropped vectors are zeroed, keeping the padding
+ * past size() zero.
+ *
+ * @param newCount: The new number of vectors
+ */
+template<int Dimensions>
+void VectorArray<Dimensions>::resize(std::size_t newCount)
+{
+	if (newCount > stride)
+	{
+		reallocate(padded(std::max(newCount, stride * 2)));
+	}
+	else if (newCount < count)
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			std::memset(component(d) + newCount, 0, (count - newCount) * sizeof(double));
+		}
+	}
+	count = newCount;
+}
+
+
+template<int Dimensions>
+void VectorArray<Dimensions>::reserve(std::size_t newCapacity)
+{
+	if (newCapacity > stride)
+	{
+		reallocate(padded(newCapacity));
+	}
+}
+
+
+template<int Dimensions>
+void VectorArray<Dimensions>::clear() noexcept
+{
+	if (data)
+	{
+		std::memset(data, 0, Dimensions * stride * sizeof(double));
+	}
+	count = 0;
+}
+
+
+template<int Dimensions>
+void VectorArray<Dimensions>::push_back(const Vector &vector)
+{
+	resize(count + 1);
+	set(count - 1, vector);
+}
+
+
+template<int Dimensions>
+typename VectorArray<Dimensions>::Vector VectorArray<Dimensions>::get(std::size_t index) const noexcept
+{
+	if constexpr (Dimensions == 2)
+	{
+		return Vec2D(data[index], data[stride + index]);
+	}
+	else
+	{
+		return Vec3D(data[index], data[stride + index], data[2 * stride + index]);
+	}
+}
+
+
+template<int Dimensions>
+void VectorArray<Dimensions>::set(std::size_t index, const Vector &vector) noexcept
+{
+	data[index] = vector.x;
+	data[stride + index] = vector.y;
+	if constexpr (Dimensions == 3)
+	{
+		data[2 * stride + index] = vector.z;
+	}
+}
+
+
+template<int Dimensions>
+void VectorArray<Dimensions>::reallocate(std::size_t newStride)
+{
+	double *newData = static_cast<double*>(::operator new(Dimensions * newStride * sizeof(double), std::align_val_t(ALIGNMENT)));
+	std::memset(newData, 0, Dimensions * newStride * sizeof(double));
+	for (int d = 0; d < Dimensions && data; d++)
+	{
+		std::memcpy(newData + d * newStride, component(d), count * sizeof(double));
+	}
+	::operator delete(data, std::align_val_t(ALIGNMENT));
+	data = newData;
+	stride = newStride;
+}
+/// \}
@@ -0,0 +1,87 @@
+//  VectorArraysAVX2.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * The AVX2 instantiation of the VectorArrays kernels. Only the kernels in this file are compiled for
+ * AVX2 (through a target pragma, so the build needs no per-file flags); VectorArrays.cpp only calls them
+ * after checking that the processor supports AVX2. Everything this file includes that is not AVX2 code
+ * is included before the pragma.
+ */
+
+
+#include "VectorArrays.hpp"
+#include <cmath>
+#include <cstddef>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "VectorKernels.hpp"
+
+
+
+
+namespace
+{
+	struct Avx2Lanes
+	{
+		using Register = __m256d;
+		static constexpr std::size_t WIDTH = 4;
+		static Register load(const double *p) { return _mm256_loadu_pd(p); }
+		static void store(double *p, Register r) { _mm256_storeu_pd(p, r); }
+		static Register broadcast(double s) { return _mm256_set1_pd(s); }
+		static Register add(Register a, Register b) { return _mm256_add_pd(a, b); }
+		static Register subtract(Register a, Register b) { return _mm256_sub_pd(a, b); }
+		static Register multiply(Register a, Register b) { return _mm256_mul_pd(a, b); }
+		static Register divide(Register a, Register b) { return _mm256_div_pd(a, b); }
+		static Register squareRoot(Register a) { return _mm256_sqrt_pd(a); }
+		static Register selectNonZero(Register test, Register ifNonZero, Register ifZero) { return _mm256_blendv_pd(ifNonZero, ifZero, _mm256_cmp_pd(test, _mm256_setzero_pd(), _CMP_EQ_OQ)); }
+		static Register reciprocalSquareRootEstimate(Register a) { return _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(a))); } // rsqrtps, relative error below 1.5 * 2^-12
+	};
+
+
+	const VectorKernelTable *makeAvx2Kernels()
+	{
+		static const VectorKernelTable table = makeVectorKernelTable<Avx2Lanes>();
+		return &table;
+	}
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+
+
+
+/**
+ * avx2VectorKernels
+ * Returns the AVX2 kernels if the processor and operating system support AVX2.
+ *
+ * @return const VectorKernelTable*: The kernels, nullptr without AVX2
+ */
+const VectorKernelTable *avx2VectorKernels()
+{
+	static const VectorKernelTable *kernels = __builtin_cpu_supports("avx2") ? makeAvx2Kernels() : nullptr;
+	return kernels;
+}
+
+
+#else
+#include "VectorKernels.hpp"
+
+
+const VectorKernelTable *avx2VectorKernels()
+{
+	return nullptr; // Not an x86 build, or a compiler without target attributes
+}
+#endif
@@ -0,0 +1,193 @@
+//  VectorBlocks.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "VectorBlocks.hpp"
+#include "VectorKernels.hpp"
+#include <algorithm>
+
+
+
+
+
+
+namespace
+{
+	template<std::size_t Width>
+	constexpr int widthIndex() { return Width == 8 ? 0 : 1; } // The index of a block width in the block kernels of VectorKernelTable
+
+
+	/// The doubles of an array's blocks, one block after another.
+	template<int Dimensions, std::size_t Width>
+	const double *blockData(const VectorBlockArray<Dimensions, Width> &a) { return a.blockCount() > 0 ? a.block(0).lanes[0] : nullptr; }
+	template<int Dimensions, std::size_t Width>
+	double *blockData(VectorBlockArray<Dimensions, Width> &a) { return a.blockCount() > 0 ? a.block(0).lanes[0] : nullptr; }
+
+
+	/**
+	 * forEachRun
+	 * Runs a component-wise kernel over the first 'count' vectors of same-shaped arrays: the whole blocks
+	 * as one flat run of doubles, then each component of the last, partly filled block alone, so the lanes
+	 * past 'count' are left as they are.
+	 *
+	 * @param count: The number of vectors
+	 * @param run: Called with the offset in doubles from the start of the blocks and the number of doubles
+	 */
+	template<int Dimensions, std::size_t Width, typename Run>
+	void forEachRun(std::size_t count, const Run &run)
+	{
+		std::size_t whole = count / Width;
+		run(0, whole * Dimensions * Width);
+		for (int d = 0; d < Dimensions && count % Width != 0; d++)
+		{
+			run((whole * Dimensions + d) * Width, count % Width);
+		}
+	}
+
+
+	/**
+	 * forEachBlockRun
+	 * Runs a block kernel over the blocks holding the first 'count' vectors: the whole blocks straight
+	 * into 'out', the last, partly filled block into a buffer whose valid lanes are then copied.
+	 *
+	 * @param count: The number of vectors, and of values written to 'out'
+	 * @param out: The per-vector results
+	 * @param blocks: Called with the first block, the number of blocks and where their Width values per block go
+	 */
+	template<std::size_t Width, typename Blocks>
+	void forEachBlockRun(std::size_t count, double *out, const Blocks &blocks)
+	{
+		std::size_t whole = count / Width;
+		blocks(0, whole, out);
+		if (count % Width != 0)
+		{
+			double last[Width];
+			blocks(whole, 1, last);
+			std::copy(last, last + count % Width, out + whole * Width);
+		}
+	}
+
+
+	double zOf(const Vec2D &) { return 0; }
+	double zOf(const Vec3D &vector) { return vector.z; }
+}
+
+
+
+
+
+
+
+
+/// ------------- Block Operations -------------
+/// \{
+/// The operations run the kernels of the active SimdLevel, the same kernels (component-wise) or the same register operations (per vector) as the VectorArray operations, so the results match bit for bit.
+template<int Dimensions, std::size_t Width>
+void vectorAdd(const VectorBlockArray<Dimensions, Width> &a, const VectorBlockArray<Dimensions, Width> &b, VectorBlockArray<Dimensions, Width> &out)
+{
+	std::size_t count = std::min(a.size(), b.size());
+	out.resize(count);
+	const double *first = blockData(a), *second = blockData(b);
+	double *sum = blockData(out);
+	forEachRun<Dimensions, Width>(count, [&](std::size_t offset, std::size_t length)
+	{
+		activeVectorKernels().add(first + offset, second + offset, sum + offset, length);
+	});
+}
+
+
+/**
+ * vectorAddScaled
+ * Adds a scaled array to another, the drift and kick of an integrator (positions += velocities * dt). The
+ * whole blocks of both arrays line up, so they are one flat run of doubles.
+ *
+ * @param a: The array added to
+ * @param b: The array added
+ * @param scalar: The factor 'b' is multiplied by
+ */
+template<int Dimensions, std::size_t Width>
+void vectorAddScaled(VectorBlockArray<Dimensions, Width> &a, const VectorBlockArray<Dimensions, Width> &b, double scalar)
+{
+	double *target = blockData(a);
+	const double *added = blockData(b);
+	forEachRun<Dimensions, Width>(std::min(a.size(), b.size()), [&](std::size_t offset, std::size_t length)
+	{
+		activeVectorKernels().addScaled(target + offset, added + offset, scalar, length);
+	});
+}
+
+
+template<int Dimensions, std::size_t Width>
+void vectorScale(VectorBlockArray<Dimensions, Width> &a, double scalar)
+{
+	double *target = blockData(a);
+	forEachRun<Dimensions, Width>(a.size(), [&](std::size_t offset, std::size_t length)
+	{
+		activeVectorKernels().scale(target + offset, scalar, length);
+	});
+}
+
+
+template<int Dimensions, std::size_t Width>
+void vectorSquareLengths(const VectorBlockArray<Dimensions, Width> &a, std::vector<double> &out)
+{
+	out.resize(a.size());
+	const double *source = blockData(a);
+	auto kernel = (Dimensions == 2 ? activeVectorKernels().blockSquareLengths2 : activeVectorKernels().blockSquareLengths3)[widthIndex<Width>()];
+	forEachBlockRun<Width>(a.size(), out.data(), [&](std::size_t first, std::size_t blocks, double *values)
+	{
+		kernel(source + first * Dimensions * Width, values, blocks);
+	});
+}
+
+
+/**
+ * vectorInverseCubeDistances
+ * The 1/|r|^3 factor of softened gravity between each vector and one point, block by block, from the
+ * register operations of the VectorArray version.
+ *
+ * @param a: The vectors
+ * @param point: The point the distances are measured from
+ * @param softening2: The squared softening length added to every squared distance
+ * @param out: Resized to a.size() and filled with the factors
+ * @param accuracy: The accuracy of the reciprocal square roots
+ */
+template<int Dimensions, std::size_t Width>
+void vectorInverseCubeDistances(const VectorBlockArray<Dimensions, Width> &a, const typename VectorArray<Dimensions>::Vector &point, double softening2, std::vector<double> &out, RsqrtAccuracy accuracy)
+{
+	const double coordinates[3] = {point.x, point.y, zOf(point)};
+	out.resize(a.size());
+	const double *source = blockData(a);
+	auto kernel = (Dimensions == 2 ? activeVectorKernels().blockInverseCubeDistances2 : activeVectorKernels().blockInverseCubeDistances3)[widthIndex<Width>()][static_cast<int>(accuracy)];
+	forEachBlockRun<Width>(a.size(), out.data(), [&](std::size_t first, std::size_t blocks, double *values)
+	{
+		kernel(source + first * Dimensions * Width, coordinates, softening2, values, blocks);
+	});
+}
+/// \}
+
+
+
+
+
+template void vectorAdd<2, 8>(const VectorBlockArray<2, 8> &, const VectorBlockArray<2, 8> &, VectorBlockArray<2, 8> &);
+template void vectorAdd<3, 8>(const VectorBlockArray<3, 8> &, const VectorBlockArray<3, 8> &, VectorBlockArray<3, 8> &);
+template void vectorAdd<2, 16>(const VectorBlockArray<2, 16> &, const VectorBlockArray<2, 16> &, VectorBlockArray<2, 16> &);
+template void vectorAdd<3, 16>(const VectorBlockArray<3, 16> &, const VectorBlockArray<3, 16> &, VectorBlockArray<3, 16> &);
+template void vectorAddScaled<2, 8>(VectorBlockArray<2, 8> &, const VectorBlockArray<2, 8> &, double);
+template void vectorAddScaled<3, 8>(VectorBlockArray<3, 8> &, const VectorBlockArray<3, 8> &, double);
+template void vectorAddScaled<2, 16>(VectorBlockArray<2, 16> &, const VectorBlockArray<2, 16> &, double);
+template void vectorAddScaled<3, 16>(VectorBlockArray<3, 16> &, const VectorBlockArray<3, 16> &, double);
+template void vectorScale<2, 8>(VectorBlockArray<2, 8> &, double);
+template void vectorScale<3, 8>(VectorBlockArray<3, 8> &, double);
+template void vectorScale<2, 16>(VectorBlockArray<2, 16> &, double);
+template void vectorScale<3, 16>(VectorBlockArray<3, 16> &, double);
+template void vectorSquareLengths<2, 8>(const VectorBlockArray<2, 8> &, std::vector<double> &);
+template void vectorSquareLengths<3, 8>(const VectorBlockArray<3, 8> &, std::vector<double> &);
+template void vectorSquareLengths<2, 16>(const VectorBlockArray<2, 16> &, std::vector<double> &);
+template void vectorSquareLengths<3, 16>(const VectorBlockArray<3, 16> &, std::vector<double> &);
+template void vectorInverseCubeDistances<2, 8>(const VectorBlockArray<2, 8> &, const Vec2D &, double, std::vector<double> &, RsqrtAccuracy);
+template void vectorInverseCubeDistances<3, 8>(const VectorBlockArray<3, 8> &, const Vec3D &, double, std::vector<double> &, RsqrtAccuracy);
+template void vectorInverseCubeDistances<2, 16>(const VectorBlockArray<2, 16> &, const Vec2D &, double, std::vector<double> &, RsqrtAccuracy);
+template void vectorInverseCubeDistances<3, 16>(const VectorBlockArray<3, 16> &, const Vec3D &, double, std::vector<double> &, RsqrtAccuracy);
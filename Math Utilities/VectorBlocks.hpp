@@ -0,0 +1,248 @@
+//  VectorBlocks.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Vector Blocks header file declares an array-of-structs-of-arrays (AoSoA) container of two- and
+ * three-dimensional vectors, and the array operations over it.
+ *
+ * A VectorArray keeps each component in its own array, so the x, y and z of one particle lie far apart
+ * and a tree walk that visits particles in an irregular order touches a cache line per component. An
+ * array of Vec3D keeps them together but interleaves the components, which defeats SIMD. A
+ * VectorBlockArray cuts the vectors into blocks of 'Width' (8 or 16); within a block each component is a
+ * contiguous run of 'Width' doubles, one or two AVX-512 registers, and the components of a block follow
+ * each other. One particle is then a few doubles within one block, and a pass over the array still loads
+ * whole registers of one component.
+ *
+ * These components include:
+ *   - VectorBlockArray<Dimensions, Width> (Vec2DBlocks, Vec3DBlocks with 8-wide blocks): The container,
+ *     with get/set per vector, iteration over its blocks, and conversion from and to a VectorArray.
+ *   - vectorAdd, vectorAddScaled, vectorScale, vectorSquareLengths, vectorInverseCubeDistances: The
+ *     operations of VectorArrays.hpp with the same names and arguments, so force and integrator code
+ *     written as a template over the container runs on either layout. They run on the active SimdLevel:
+ *     the component-wise ones treat the whole blocks as one flat array, the per-vector ones use block
+ *     kernels from VectorKernels.hpp whose registers never straddle a block. Both give bitwise the
+ *     results of the VectorArray operations.
+ *
+ * The lanes past size() in the last block are always zero, like the padding of a VectorArray.
+ * tools/VectorBlocksBenchmark.cpp compares the layouts on passes over the array and on the random
+ * gathers of a tree walk.
+ */
+
+
+#pragma once
+#include "VectorArrays.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+
+
+
+
+
+/**
+ * VectorBlockArray class representing an array of vectors stored in blocks of 'Width' vectors, one run of
+ * 'Width' doubles per component in each block.
+ */
+template<int Dimensions, std::size_t Width = 8>
+class VectorBlockArray
+{
+	static_assert(Dimensions == 2 || Dimensions == 3, "VectorBlockArray holds 2D or 3D vectors");
+	static_assert(Width == 8 || Width == 16, "Blocks hold 8 or 16 vectors, whole AVX-512 registers");
+
+public:
+	using Vector = typename VectorArray<Dimensions>::Vector; // The element type
+	static constexpr int DIMENSIONS = Dimensions;
+	static constexpr std::size_t WIDTH = Width;
+
+
+	/**
+	 * Block struct, 'Width' vectors with each component contiguous, aligned to a cache line.
+	 */
+	struct alignas(64) Block
+	{
+		double lanes[Dimensions][Width] = {}; // lanes[d][k], component d of vector k of the block
+	};
+	static_assert(sizeof(Block) == Dimensions * Width * sizeof(double), "Blocks follow each other without gaps, the kernels see one array of doubles");
+
+
+	/// ------------- Constructors -------------
+	/// \{
+	VectorBlockArray() = default; // Creates an empty array
+	explicit VectorBlockArray(std::size_t count) { resize(count); } // Creates 'count' zero vectors
+	explicit VectorBlockArray(const VectorArray<Dimensions> &array); // Copies the vectors of a VectorArray
+	VectorArray<Dimensions> toVectorArray() const; // The vectors as a VectorArray
+	/// \}
+
+
+	/// ------------- Size -------------
+	/// \{
+	std::size_t size() const noexcept { return count; } // Number of vectors
+	std::size_t capacity() const noexcept { return blocks.capacity() * Width; } // Number of vectors that fit without reallocating
+	bool empty() const noexcept { return count == 0; }
+	void resize(std::size_t newCount); // Adds zero vectors or drops vectors at the end
+	void reserve(std::size_t newCapacity) { blocks.reserve(blockCountFor(newCapacity)); } // Makes room for 'newCapacity' vectors
+	void clear() noexcept { blocks.clear(); count = 0; } // Removes every vector, keeping the allocation
+	void push_back(const Vector &vector); // Appends a vector
+	/// \}
+
+
+	/// ------------- Access -------------
+	/// \{
+	Vector get(std::size_t index) const noexcept; // The vector at 'index'
+	void set(std::size_t index, const Vector &vector) noexcept; // Replaces the vector at 'index'
+	std::size_t blockCount() const noexcept { return blocks.size(); } // Number of blocks, the last one possibly partly filled
+	Block &block(std::size_t b) noexcept { return blocks[b]; } // The block holding vectors b * Width to b * Width + Width - 1
+	const Block &block(std::size_t b) const noexcept { return blocks[b]; }
+	/// \}
+
+
+	/// ------------- Block Iteration -------------
+	/// \{
+	typename std::vector<Block>::iterator begin() noexcept { return blocks.begin(); } // The first block, for range-for over the blocks
+	typename std::vector<Block>::iterator end() noexcept { return blocks.end(); }
+	typename std::vector<Block>::const_iterator begin() const noexcept { return blocks.begin(); }
+	typename std::vector<Block>::const_iterator end() const noexcept { return blocks.end(); }
+	/// \}
+
+
+private:
+	static std::size_t blockCountFor(std::size_t vectors) { return (vectors + Width - 1) / Width; }
+
+	std::vector<Block> blocks; // The blocks, over-aligned through the aligned operator new of C++17
+	std::size_t count = 0; // Number of vectors
+};
+
+
+using Vec2DBlocks = VectorBlockArray<2>;
+using Vec3DBlocks = VectorBlockArray<3>;
+
+
+
+
+
+
+
+
+/// ------------- Block Operations -------------
+/// \{
+/// As the VectorArray operations: two arrays use the first min(a.size(), b.size()) vectors, outputs are resized to match.
+template<int Dimensions, std::size_t Width>
+void vectorAdd(const VectorBlockArray<Dimensions, Width> &a, const VectorBlockArray<Dimensions, Width> &b, VectorBlockArray<Dimensions, Width> &out); // out = a + b
+template<int Dimensions, std::size_t Width>
+void vectorAddScaled(VectorBlockArray<Dimensions, Width> &a, const VectorBlockArray<Dimensions, Width> &b, double scalar); // a += b * scalar, e.g. positions += velocities * dt
+template<int Dimensions, std::size_t Width>
+void vectorScale(VectorBlockArray<Dimensions, Width> &a, double scalar); // a *= scalar
+template<int Dimensions, std::size_t Width>
+void vectorSquareLengths(const VectorBlockArray<Dimensions, Width> &a, std::vector<double> &out); // out[i] = |a[i]|^2
+template<int Dimensions, std::size_t Width>
+void vectorInverseCubeDistances(const VectorBlockArray<Dimensions, Width> &a, const typename VectorArray<Dimensions>::Vector &point, double softening2, std::vector<double> &out, RsqrtAccuracy accuracy); // out[i] = 1 / (|a[i] - point|^2 + softening2)^(3/2)
+/// \}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+/// ------------- VectorBlockArray Definitions -------------
+/// \{
+template<int Dimensions, std::size_t Width>
+VectorBlockArray<Dimensions, Width>::VectorBlockArray(const VectorArray<Dimensions> &array)
+{
+	resize(array.size());
+	for (std::size_t b = 0; b < blocks.size(); b++)
+	{
+		std::size_t first = b * Width, lanes = std::min(Width, count - first);
+		for (int d = 0; d < Dimensions; d++)
+		{
+			std::copy(array.component(d) + first, array.component(d) + first + lanes, blocks[b].lanes[d]);
+		}
+	}
+}
+
+
+template<int Dimensions, std::size_t Width>
+VectorArray<Dimensions> VectorBlockArray<Dimensions, Width>::toVectorArray() const
+{
+	VectorArray<Dimensions> array(count);
+	for (std::size_t b = 0; b < blocks.size(); b++)
+	{
+		std::size_t first = b * Width, lanes = std::min(Width, count - first);
+		for (int d = 0; d < Dimensions; d++)
+		{
+			std::copy(blocks[b].lanes[d], blocks[b].lanes[d] + lanes, array.component(d) + first);
+		}
+	}
+	return array;
+}
+
+
+/**
+ * resize
+ * Changes the number of vectors. New vectors are zero; the lanes of dropped vectors in the last block are
+ * zeroed, keeping the lanes past size() zero.
+ *
+ * @param newCount: The new number of vectors
+ */
+template<int Dimensions, std::size_t Width>
+void VectorBlockArray<Dimensions, Width>::resize(std::size_t newCount)
+{
+	blocks.resize(blockCountFor(newCount));
+	if (newCount < count && newCount % Width != 0)
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			std::fill(blocks.back().lanes[d] + newCount % Width, blocks.back().lanes[d] + Width, 0.0);
+		}
+	}
+	count = newCount;
+}
+
+
+template<int Dimensions, std::size_t Width>
+void VectorBlockArray<Dimensions, Width>::push_back(const Vector &vector)
+{
+	resize(count + 1);
+	set(count - 1, vector);
+}
+
+
+template<int Dimensions, std::size_t Width>
+typename VectorBlockArray<Dimensions, Width>::Vector VectorBlockArray<Dimensions, Width>::get(std::size_t index) const noexcept
+{
+	const Block &holder = blocks[index / Width];
+	std::size_t lane = index % Width;
+	if constexpr (Dimensions == 2)
+	{
+		return Vec2D(holder.lanes[0][lane], holder.lanes[1][lane]);
+	}
+	else
+	{
+		return Vec3D(holder.lanes[0][lane], holder.lanes[1][lane], holder.lanes[2][lane]);
+	}
+}
+
+
+template<int Dimensions, std::size_t Width>
+void VectorBlockArray<Dimensions, Width>::set(std::size_t index, const Vector &vector) noexcept
+{
+	Block &holder = blocks[index / Width];
+	std::size_t lane = index % Width;
+	holder.lanes[0][lane] = vector.x;
+	holder.lanes[1][lane] = vector.y;
+	if constexpr (Dimensions == 3)
+	{
+		holder.lanes[2][lane] = vector.z;
+	}
+}
+/// \}
@@ -0,0 +1,518 @@
+//  VectorKernels.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Vector Kernels header file defines the loops behind the VectorArrays operations once, generically over
+ * a "Lanes" type that wraps one SIMD instruction set. It is internal to VectorArrays.cpp,
+ * VectorArraysAVX2.cpp and VectorBlocks.cpp; use VectorArrays.hpp and VectorBlocks.hpp instead.
+ *
+ * A Lanes type provides:
+ *   - Register, WIDTH: the register type and how many doubles it holds.
+ *   - load, store (unaligned), broadcast, add, subtract, multiply, divide, squareRoot.
+ *   - selectNonZero(test, ifNonZero, ifZero): per lane, 'ifNonZero' where 'test' is not zero.
+ *   - reciprocalSquareRootEstimate: 1/sqrt per lane with a relative error below 1.5 * 2^-12, from the
+ *     hardware estimate instruction (through single precision) where there is one.
+ *
+ * Every kernel runs whole registers and finishes the remainder one element at a time with the same
+ * operations in the same order, so all instruction sets compute the same results as the scalar loop
+ * (the kernels are compiled without fused multiply-add). The approximate reciprocal-square-root kernels are
+ * the exception: their estimates differ between instruction sets, within the bounds of rsqrtErrorBound().
+ *
+ * Each instruction set instantiates these templates with Lanes types that have internal linkage, so
+ * code compiled for AVX2 is never shared with, or picked by the linker for, the other instruction sets.
+ * This header must not define any non-template function for the same reason.
+ */
+
+
+#pragma once
+#include <cmath>
+#include <cstddef>
+
+
+
+
+
+
+/**
+ * VectorKernelTable struct, the kernels of one instruction set. Components are separate arrays of 'count' doubles.
+ */
+struct VectorKernelTable
+{
+	void (*add)(const double *a, const double *b, double *out, std::size_t count); // out = a + b
+	void (*addScaled)(double *a, const double *b, double scalar, std::size_t count); // a += b * scalar
+	void (*scale)(double *a, double scalar, std::size_t count); // a *= scalar
+	void (*squareLengths2)(const double *const *components, double *out, std::size_t count); // out = x*x + y*y
+	void (*squareLengths3)(const double *const *components, double *out, std::size_t count); // out = x*x + y*y + z*z
+	void (*lengths2)(const double *const *components, double *out, std::size_t count); // out = sqrt(x*x + y*y)
+	void (*lengths3)(const double *const *components, double *out, std::size_t count); // out = sqrt(x*x + y*y + z*z)
+	void (*normalize2)(double *const *components, std::size_t count); // Scales every non-zero vector to length 1
+	void (*normalize3)(double *const *components, std::size_t count);
+	void (*distances2)(const double *const *a, const double *const *b, double *out, std::size_t count); // out = |a - b|
+	void (*distances3)(const double *const *a, const double *const *b, double *out, std::size_t count);
+
+	/// Reciprocal-square-root kernels, indexed by accuracy: 0 Fast, 1 Refined, 2 Exact (the order of RsqrtAccuracy)
+	void (*inverseSquareRoots[3])(const double *values, double *out, std::size_t count); // out = 1/sqrt(values)
+	void (*inverseCubeDistances2[3])(const double *const *a, const double *point, double softening2, double *out, std::size_t count); // out = 1/(|a - point|^2 + softening2)^(3/2)
+	void (*inverseCubeDistances3[3])(const double *const *a, const double *point, double softening2, double *out, std::size_t count);
+	void (*approximateNormalize2[2])(double *const *components, std::size_t count); // normalize2 through an estimate, Fast and Refined only
+	void (*approximateNormalize3[2])(double *const *components, std::size_t count);
+	void (*approximateDistances2[2])(const double *const *a, const double *const *b, double *out, std::size_t count); // distances2 as r2 / sqrt(r2) through an estimate
+	void (*approximateDistances3[2])(const double *const *a, const double *const *b, double *out, std::size_t count);
+
+	/// Kernels over whole blocks of a VectorBlockArray, 'blockCount' blocks of Dimensions runs of 8 (index 0) or 16 (index 1) doubles each
+	void (*blockSquareLengths2[2])(const double *blocks, double *out, std::size_t blockCount); // out = x*x + y*y, one value per lane
+	void (*blockSquareLengths3[2])(const double *blocks, double *out, std::size_t blockCount);
+	void (*blockInverseCubeDistances2[2][3])(const double *blocks, const double *point, double softening2, double *out, std::size_t blockCount); // As inverseCubeDistances2, by accuracy
+	void (*blockInverseCubeDistances3[2][3])(const double *blocks, const double *point, double softening2, double *out, std::size_t blockCount);
+};
+
+
+const VectorKernelTable *avx2VectorKernels(); // The AVX2 kernels, nullptr where they are not compiled in (defined in VectorArraysAVX2.cpp)
+const VectorKernelTable &activeVectorKernels(); // The kernels of the active SimdLevel (defined in VectorArrays.cpp)
+
+
+
+
+
+
+
+
+/// ------------- Generic Kernels -------------
+/// \{
+template<typename Lanes>
+void kernelAdd(const double *a, const double *b, double *out, std::size_t count)
+{
+	std::size_t i = 0;
+	for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+	{
+		Lanes::store(out + i, Lanes::add(Lanes::load(a + i), Lanes::load(b + i)));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = a[i] + b[i];
+	}
+}
+
+
+template<typename Lanes>
+void kernelAddScaled(double *a, const double *b, double scalar, std::size_t count)
+{
+	typename Lanes::Register factor = Lanes::broadcast(scalar);
+	std::size_t i = 0;
+	for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+	{
+		Lanes::store(a + i, Lanes::add(Lanes::load(a + i), Lanes::multiply(Lanes::load(b + i), factor)));
+	}
+	for (; i < count; i++)
+	{
+		double product = b[i] * scalar;
+		a[i] = a[i] + product;
+	}
+}
+
+
+template<typename Lanes>
+void kernelScale(double *a, double scalar, std::size_t count)
+{
+	typename Lanes::Register factor = Lanes::broadcast(scalar);
+	std::size_t i = 0;
+	for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+	{
+		Lanes::store(a + i, Lanes::multiply(Lanes::load(a + i), factor));
+	}
+	for (; i < count; i++)
+	{
+		a[i] = a[i] * scalar;
+	}
+}
+
+
+/// The sum of squares of the components of the vectors starting at element i, one register at a time.
+template<typename Lanes, int Dimensions>
+typename Lanes::Register registerSquareLength(const double *const *components, std::size_t i)
+{
+	typename Lanes::Register component = Lanes::load(components[0] + i);
+	typename Lanes::Register sum = Lanes::multiply(component, component);
+	for (int d = 1; d < Dimensions; d++)
+	{
+		component = Lanes::load(components[d] + i);
+		sum = Lanes::add(sum, Lanes::multiply(component, component));
+	}
+	return sum;
+}
+
+
+template<typename Lanes, int Dimensions>
+double elementSquareLength(const double *const *components, std::size_t i)
+{
+	double sum = components[0][i] * components[0][i];
+	for (int d = 1; d < Dimensions; d++)
+	{
+		double square = components[d][i] * components[d][i];
+		sum = sum + square;
+	}
+	return sum;
+}
+
+
+template<typename Lanes, int Dimensions>
+void kernelSquareLengths(const double *const *components, double *out, std::size_t count)
+{
+	std::size_t i = 0;
+	for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+	{
+		Lanes::store(out + i, registerSquareLength<Lanes, Dimensions>(components, i));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = elementSquareLength<Lanes, Dimensions>(components, i);
+	}
+}
+
+
+template<typename Lanes, int Dimensions>
+void kernelLengths(const double *const *components, double *out, std::size_t count)
+{
+	std::size_t i = 0;
+	for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+	{
+		Lanes::store(out + i, Lanes::squareRoot(registerSquareLength<Lanes, Dimensions>(components, i)));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = std::sqrt(elementSquareLength<Lanes, Dimensions>(components, i));
+	}
+}
+
+
+template<typename Lanes, int Dimensions>
+void kernelNormalize(double *const *components, std::size_t count)
+{
+	typename Lanes::Register one = Lanes::broadcast(1.0);
+	std::size_t i = 0;
+	for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+	{
+		typename Lanes::Register length = Lanes::squareRoot(registerSquareLength<Lanes, Dimensions>(components, i));
+		typename Lanes::Register inverse = Lanes::divide(one, length);
+		for (int d = 0; d < Dimensions; d++)
+		{
+			typename Lanes::Register component = Lanes::load(components[d] + i);
+			Lanes::store(components[d] + i, Lanes::selectNonZero(length, Lanes::multiply(component, inverse), component));
+		}
+	}
+	for (; i < count; i++)
+	{
+		double length = std::sqrt(elementSquareLength<Lanes, Dimensions>(components, i));
+		if (length != 0)
+		{
+			double inverse = 1.0 / length;
+			for (int d = 0; d < Dimensions; d++)
+			{
+				components[d][i] = components[d][i] * inverse;
+			}
+		}
+	}
+}
+
+
+template<typename Lanes, int Dimensions>
+void kernelDistances(const double *const *a, const double *const *b, double *out, std::size_t count)
+{
+	std::size_t i = 0;
+	for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+	{
+		typename Lanes::Register difference = Lanes::subtract(Lanes::load(a[0] + i), Lanes::load(b[0] + i));
+		typename Lanes::Register sum = Lanes::multiply(difference, difference);
+		for (int d = 1; d < Dimensions; d++)
+		{
+			difference = Lanes::subtract(Lanes::load(a[d] + i), Lanes::load(b[d] + i));
+			sum = Lanes::add(sum, Lanes::multiply(difference, difference));
+		}
+		Lanes::store(out + i, Lanes::squareRoot(sum));
+	}
+	for (; i < count; i++)
+	{
+		double difference = a[0][i] - b[0][i];
+		double sum = difference * difference;
+		for (int d = 1; d < Dimensions; d++)
+		{
+			difference = a[d][i] - b[d][i];
+			double square = difference * difference;
+			sum = sum + square;
+		}
+		out[i] = std::sqrt(sum);
+	}
+}
+
+
+/// \}
+
+
+
+
+
+
+
+
+/// ------------- Reciprocal Square Root Kernels -------------
+/// \{
+/// Accuracy modes of the kernels below, the values of RsqrtAccuracy.
+constexpr int RSQRT_FAST = 0; // The estimate and one Newton-Raphson step
+constexpr int RSQRT_REFINED = 1; // The estimate and two Newton-Raphson steps
+constexpr int RSQRT_EXACT = 2; // 1 / sqrt(x), correctly rounded square root and division
+
+
+/**
+ * reciprocalSquareRoot
+ * 1/sqrt(x) per lane in one of the accuracy modes. Each Newton-Raphson step y' = y * (1.5 - 0.5 * x * y * y)
+ * squares the relative error (times 1.5), so the 2^-12 estimate reaches about 2^-22 after one step and the
+ * rounding error of double precision after two.
+ *
+ * @param x: Positive values within the range of single precision (about 1e-38 to 3e38) for the approximate modes
+ * @return Register: The reciprocal square roots
+ */
+template<typename Lanes, int Mode>
+typename Lanes::Register reciprocalSquareRoot(typename Lanes::Register x)
+{
+	if constexpr (Mode == RSQRT_EXACT)
+	{
+		return Lanes::divide(Lanes::broadcast(1.0), Lanes::squareRoot(x));
+	}
+	else
+	{
+		typename Lanes::Register estimate = Lanes::reciprocalSquareRootEstimate(x);
+		typename Lanes::Register halfX = Lanes::multiply(Lanes::broadcast(0.5), x), threeHalves = Lanes::broadcast(1.5);
+		for (int step = 0; step <= Mode; step++)
+		{
+			estimate = Lanes::multiply(estimate, Lanes::subtract(threeHalves, Lanes::multiply(halfX, Lanes::multiply(estimate, estimate))));
+		}
+		return estimate;
+	}
+}
+
+
+/// Loads and stores whole registers, in the main loop of the reciprocal-square-root kernels.
+template<typename Lanes>
+struct FullRegisterAccess
+{
+	typename Lanes::Register load(const double *p, double) const { return Lanes::load(p); }
+	void store(double *p, typename Lanes::Register r) const { Lanes::store(p, r); }
+};
+
+
+/// Loads and stores the first 'available' lanes of a register, the others filled, for the remainder of an array.
+template<typename Lanes>
+struct PartialRegisterAccess
+{
+	std::size_t available;
+
+	typename Lanes::Register load(const double *p, double fill) const
+	{
+		double buffer[Lanes::WIDTH];
+		for (std::size_t k = 0; k < Lanes::WIDTH; k++)
+		{
+			buffer[k] = k < available ? p[k] : fill;
+		}
+		return Lanes::load(buffer);
+	}
+
+	void store(double *p, typename Lanes::Register r) const
+	{
+		double buffer[Lanes::WIDTH];
+		Lanes::store(buffer, r);
+		for (std::size_t k = 0; k < available; k++)
+		{
+			p[k] = buffer[k];
+		}
+	}
+};
+
+
+/// Runs 'block(i, access)' on every whole register of 'count' elements, then once on the remainder, so the estimates need no scalar version.
+template<typename Lanes, typename Block>
+void forEachRegister(std::size_t count, Block block)
+{
+	std::size_t i = 0;
+	for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+	{
+		block(i, FullRegisterAccess<Lanes>());
+	}
+	if (i < count)
+	{
+		block(i, PartialRegisterAccess<Lanes>{count - i});
+	}
+}
+
+
+/// The squared lengths of the vectors starting at element i, minus 'point' if it is not nullptr.
+template<typename Lanes, int Dimensions, typename Access>
+typename Lanes::Register accessSquareLength(const double *const *components, const double *point, std::size_t i, const Access &access)
+{
+	typename Lanes::Register sum = Lanes::broadcast(0.0);
+	for (int d = 0; d < Dimensions; d++)
+	{
+		typename Lanes::Register component = access.load(components[d] + i, 0.0);
+		if (point)
+		{
+			component = Lanes::subtract(component, Lanes::broadcast(point[d]));
+		}
+		sum = Lanes::add(sum, Lanes::multiply(component, component));
+	}
+	return sum;
+}
+
+
+template<typename Lanes, int Mode>
+void kernelInverseSquareRoots(const double *values, double *out, std::size_t count)
+{
+	forEachRegister<Lanes>(count, [&](std::size_t i, const auto &access)
+	{
+		access.store(out + i, reciprocalSquareRoot<Lanes, Mode>(access.load(values + i, 1.0)));
+	});
+}
+
+
+/**
+ * kernelInverseCubeDistances
+ * The 1/|r|^3 factor of softened gravity between each vector of 'a' and one point, from one reciprocal
+ * square root per element. The exact mode computes 1 / (r2 * sqrt(r2)) like the scalar force loops.
+ */
+template<typename Lanes, int Dimensions, int Mode, typename Access>
+typename Lanes::Register registerInverseCubeDistance(const double *const *a, const double *point, typename Lanes::Register softening, std::size_t i, const Access &access)
+{
+	typename Lanes::Register r2 = Lanes::add(accessSquareLength<Lanes, Dimensions>(a, point, i, access), softening);
+	if constexpr (Mode == RSQRT_EXACT)
+	{
+		return Lanes::divide(Lanes::broadcast(1.0), Lanes::multiply(r2, Lanes::squareRoot(r2)));
+	}
+	else
+	{
+		typename Lanes::Register inverse = reciprocalSquareRoot<Lanes, Mode>(r2);
+		return Lanes::multiply(Lanes::multiply(inverse, inverse), inverse);
+	}
+}
+
+
+template<typename Lanes, int Dimensions, int Mode>
+void kernelInverseCubeDistances(const double *const *a, const double *point, double softening2, double *out, std::size_t count)
+{
+	typename Lanes::Register softening = Lanes::broadcast(softening2);
+	forEachRegister<Lanes>(count, [&](std::size_t i, const auto &access)
+	{
+		access.store(out + i, registerInverseCubeDistance<Lanes, Dimensions, Mode>(a, point, softening, i, access));
+	});
+}
+
+
+template<typename Lanes, int Dimensions, int Mode>
+void kernelApproximateNormalize(double *const *components, std::size_t count)
+{
+	forEachRegister<Lanes>(count, [&](std::size_t i, const auto &access)
+	{
+		typename Lanes::Register squareLength = accessSquareLength<Lanes, Dimensions>(components, nullptr, i, access);
+		typename Lanes::Register inverse = reciprocalSquareRoot<Lanes, Mode>(squareLength); // Infinite for zero vectors, which are kept below
+		for (int d = 0; d < Dimensions; d++)
+		{
+			typename Lanes::Register component = access.load(components[d] + i, 0.0);
+			access.store(components[d] + i, Lanes::selectNonZero(squareLength, Lanes::multiply(component, inverse), component));
+		}
+	});
+}
+
+
+template<typename Lanes, int Dimensions, int Mode>
+void kernelApproximateDistances(const double *const *a, const double *const *b, double *out, std::size_t count)
+{
+	typename Lanes::Register zero = Lanes::broadcast(0.0);
+	forEachRegister<Lanes>(count, [&](std::size_t i, const auto &access)
+	{
+		typename Lanes::Register r2 = zero;
+		for (int d = 0; d < Dimensions; d++)
+		{
+			typename Lanes::Register difference = Lanes::subtract(access.load(a[d] + i, 0.0), access.load(b[d] + i, 0.0));
+			r2 = Lanes::add(r2, Lanes::multiply(difference, difference));
+		}
+		access.store(out + i, Lanes::selectNonZero(r2, Lanes::multiply(r2, reciprocalSquareRoot<Lanes, Mode>(r2)), zero));
+	});
+}
+/// \}
+
+
+
+
+/// ------------- Block Kernels -------------
+/// \{
+/// The component runs of one block of a VectorBlockArray.
+template<int Dimensions, std::size_t Width>
+void blockComponents(const double *blocks, std::size_t block, const double *(&components)[Dimensions])
+{
+	for (int d = 0; d < Dimensions; d++)
+	{
+		components[d] = blocks + (block * Dimensions + d) * Width;
+	}
+}
+
+
+/// The runs of a block are whole registers on every instruction set, so the block kernels need no remainder loop.
+template<typename Lanes, int Dimensions, std::size_t Width>
+void kernelBlockSquareLengths(const double *blocks, double *out, std::size_t blockCount)
+{
+	static_assert(Width % Lanes::WIDTH == 0, "Blocks hold whole registers");
+	for (std::size_t block = 0; block < blockCount; block++)
+	{
+		const double *components[Dimensions];
+		blockComponents<Dimensions, Width>(blocks, block, components);
+		for (std::size_t i = 0; i < Width; i += Lanes::WIDTH)
+		{
+			Lanes::store(out + block * Width + i, registerSquareLength<Lanes, Dimensions>(components, i));
+		}
+	}
+}
+
+
+template<typename Lanes, int Dimensions, std::size_t Width, int Mode>
+void kernelBlockInverseCubeDistances(const double *blocks, const double *point, double softening2, double *out, std::size_t blockCount)
+{
+	static_assert(Width % Lanes::WIDTH == 0, "Blocks hold whole registers");
+	typename Lanes::Register softening = Lanes::broadcast(softening2);
+	for (std::size_t block = 0; block < blockCount; block++)
+	{
+		const double *components[Dimensions];
+		blockComponents<Dimensions, Width>(blocks, block, components);
+		for (std::size_t i = 0; i < Width; i += Lanes::WIDTH)
+		{
+			Lanes::store(out + block * Width + i, registerInverseCubeDistance<Lanes, Dimensions, Mode>(components, point, softening, i, FullRegisterAccess<Lanes>()));
+		}
+	}
+}
+/// \}
+
+
+
+
+/// ------------- Kernel Table -------------
+/// \{
+/// The kernel table of an instruction set.
+template<typename Lanes>
+VectorKernelTable makeVectorKernelTable()
+{
+	return {kernelAdd<Lanes>, kernelAddScaled<Lanes>, kernelScale<Lanes>,
+		kernelSquareLengths<Lanes, 2>, kernelSquareLengths<Lanes, 3>,
+		kernelLengths<Lanes, 2>, kernelLengths<Lanes, 3>,
+		kernelNormalize<Lanes, 2>, kernelNormalize<Lanes, 3>,
+		kernelDistances<Lanes, 2>, kernelDistances<Lanes, 3>,
+		{kernelInverseSquareRoots<Lanes, RSQRT_FAST>, kernelInverseSquareRoots<Lanes, RSQRT_REFINED>, kernelInverseSquareRoots<Lanes, RSQRT_EXACT>},
+		{kernelInverseCubeDistances<Lanes, 2, RSQRT_FAST>, kernelInverseCubeDistances<Lanes, 2, RSQRT_REFINED>, kernelInverseCubeDistances<Lanes, 2, RSQRT_EXACT>},
+		{kernelInverseCubeDistances<Lanes, 3, RSQRT_FAST>, kernelInverseCubeDistances<Lanes, 3, RSQRT_REFINED>, kernelInverseCubeDistances<Lanes, 3, RSQRT_EXACT>},
+		{kernelApproximateNormalize<Lanes, 2, RSQRT_FAST>, kernelApproximateNormalize<Lanes, 2, RSQRT_REFINED>},
+		{kernelApproximateNormalize<Lanes, 3, RSQRT_FAST>, kernelApproximateNormalize<Lanes, 3, RSQRT_REFINED>},
+		{kernelApproximateDistances<Lanes, 2, RSQRT_FAST>, kernelApproximateDistances<Lanes, 2, RSQRT_REFINED>},
+		{kernelApproximateDistances<Lanes, 3, RSQRT_FAST>, kernelApproximateDistances<Lanes, 3, RSQRT_REFINED>},
+		{kernelBlockSquareLengths<Lanes, 2, 8>, kernelBlockSquareLengths<Lanes, 2, 16>},
+		{kernelBlockSquareLengths<Lanes, 3, 8>, kernelBlockSquareLengths<Lanes, 3, 16>},
+		{{kernelBlockInverseCubeDistances<Lanes, 2, 8, RSQRT_FAST>, kernelBlockInverseCubeDistances<Lanes, 2, 8, RSQRT_REFINED>, kernelBlockInverseCubeDistances<Lanes, 2, 8, RSQRT_EXACT>},
+		 {kernelBlockInverseCubeDistances<Lanes, 2, 16, RSQRT_FAST>, kernelBlockInverseCubeDistances<Lanes, 2, 16, RSQRT_REFINED>, kernelBlockInverseCubeDistances<Lanes, 2, 16, RSQRT_EXACT>}},
+		{{kernelBlockInverseCubeDistances<Lanes, 3, 8, RSQRT_FAST>, kernelBlockInverseCubeDistances<Lanes, 3, 8, RSQRT_REFINED>, kernelBlockInverseCubeDistances<Lanes, 3, 8, RSQRT_EXACT>},
+		 {kernelBlockInverseCubeDistances<Lanes, 3, 16, RSQRT_FAST>, kernelBlockInverseCubeDistances<Lanes, 3, 16, RSQRT_REFINED>, kernelBlockInverseCubeDistances<Lanes, 3, 16, RSQRT_EXACT>}}};
+}
+/// \}
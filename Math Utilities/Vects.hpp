@@ -10,129 +10,190 @@
  *
  * These classes encapsulates a vector's components and provide methods
  * to perform basic vector operations and manipulate vector data.
+ *
+ * Both classes are header-only: every member is defined inline at the end of this file, constexpr
+ * where the standard library allows it (everything but the square roots and trigonometry) and
+ * noexcept. The copy/move constructors, assignments and destructor are the implicit ones, so the
+ * vectors are trivially copyable: arrays of them are copied with memcpy, passed in registers, and
+ * loops over them can be inlined and auto-vectorized in every translation unit.
+ * tools/VectsBenchmark.cpp measures them against the previous out-of-line versions.
+ *
+ * Both are templates on their scalar type (Vec2<Scalar>, Vec3<Scalar>). Vec2D and Vec3D are the double
+ * vectors the rest of the library uses; Vec2F and Vec3F hold floats, for work that only needs
+ * visualization quality and benefits from twice the SIMD width and half the memory traffic
+ * (tools/PrecisionBenchmark.cpp). Vectors of different precisions do not mix: converting one to the
+ * other is an explicit construction, e.g. Vec3F(position).
  */
 
 
 #pragma once
 #include <math.h>
+#include <cmath>
+#include <type_traits>
 
 
 
 
 
 
-/// Vec2D class representing a 2D Vector
-class Vec2D
+/// Vec2 class template representing a 2D Vector with components of type Scalar
+template<typename Scalar>
+class Vec2
 {
 public:
-	/// @section Constructors and Destructor
-	Vec2D(); // Default constructor
-	Vec2D(double _x, double _y); // Construct with provided x and y values
-	Vec2D(const Vec2D &other); // Construct by copying another Vec2D object
-	Vec2D(double magnitude); // Construct with provided magnitude
-	~Vec2D(); // Destructor
-	
-	
-	
+	static_assert(std::is_floating_point<Scalar>::value, "Vec2 components must be a floating-point type");
+	using ScalarType = Scalar; // The type of the components
+
+
+	/// @section Constructors
+	constexpr Vec2() noexcept; // Default constructor, the zero vector
+	constexpr Vec2(Scalar _x, Scalar _y) noexcept; // Construct with provided x and y values
+	explicit Vec2(Scalar magnitude) noexcept; // Construct with provided magnitude
+	template<typename Other>
+	constexpr explicit Vec2(const Vec2<Other>& other) noexcept; // Converts a vector of another precision, component by component
+
+
+
 	/// @section Comparison operators
-	bool operator!=(const Vec2D& other); // Checks inequality with another Vec2D object
-	
-	
-	
-	/// @section Accessor operators (Return new Vec2D based on current one)
-	Vec2D operator+(const Vec2D& other) const; // Adds this vector with another
-	Vec2D operator-(const Vec2D& other) const; // Subtracts another vector from this vector
-	Vec2D operator*(const double scalar) const; // Multiplies this vector by a scalar
-	Vec2D operator/(const double scalar) const; // Divides this vector by a scalar
-	
-	
-	
-	/// @section Modifier operators (Modify the current Vec2D and return reference)
-	Vec2D& operator=(const Vec2D& other); // Assigns this vector the values of another
-	void operator+=(const Vec2D& other); // Adds another vector to this vector and assigns the result to this vector
-	void operator-=(const Vec2D& other); // Subtracts another vector from this vector and assigns the result to this vector
-	void operator*=(const double scalar); // Multiplies this vector by a scalar and assigns the result to this vector
-	void operator/=(const double scalar); // Divides this vector by a scalar and assigns the result to this vector
-	
-	
-	
-	
+	[[nodiscard]] constexpr bool operator==(const Vec2& other) const noexcept; // Checks equality of the components with another Vec2 object
+	[[nodiscard]] constexpr bool operator!=(const Vec2& other) const noexcept; // Checks inequality of the components with another Vec2 object
+
+
+
+	/// @section Accessor operators (Return new Vec2 based on current one)
+	[[nodiscard]] constexpr Vec2 operator+(const Vec2& other) const noexcept; // Adds this vector with another
+	[[nodiscard]] constexpr Vec2 operator-(const Vec2& other) const noexcept; // Subtracts another vector from this vector
+	[[nodiscard]] constexpr Vec2 operator-() const noexcept; // Negates this vector
+	[[nodiscard]] constexpr Vec2 operator*(const Scalar scalar) const noexcept; // Multiplies this vector by a scalar
+	[[nodiscard]] constexpr Vec2 operator/(const Scalar scalar) const noexcept; // Divides this vector by a scalar
+
+
+
+	/// @section Modifier operators (Modify the current Vec2 and return reference)
+	constexpr Vec2& operator+=(const Vec2& other) noexcept; // Adds another vector to this vector and assigns the result to this vector
+	constexpr Vec2& operator-=(const Vec2& other) noexcept; // Subtracts another vector from this vector and assigns the result to this vector
+	constexpr Vec2& operator*=(const Scalar scalar) noexcept; // Multiplies this vector by a scalar and assigns the result to this vector
+	constexpr Vec2& operator/=(const Scalar scalar) noexcept; // Divides this vector by a non-zero scalar and assigns the result to this vector
+
+
+
+
 	/// @section Vector operations
-	Vec2D scaleVector(double scalar) const; // Returns a new vector that is this vector scaled by a scalar
-	double vectorLength() const; // Returns the length of this vector
-	double vectorSquareLength() const; // Returns the square of the length of this vector
-	void vectorNormalize(); // Normalizes this vector
-	Vec2D vectorGetNormalized() const; // Returns a new vector that is a normalized version of this vector
-	double vectorDistance(const Vec2D& other); // Returns the distance between this vector and another vector
-	void set(double _x, double _y); // Sets the x and y values of this vector
-	void reset(); // Resets this vector to the zero vector
-	
-	
+	[[nodiscard]] Vec2 scaleVector(Scalar scalar) const noexcept; // Returns a new vector in the direction of this vector with length 'scalar'
+	[[nodiscard]] Scalar vectorLength() const noexcept; // Returns the length of this vector
+	[[nodiscard]] constexpr Scalar vectorSquareLength() const noexcept; // Returns the square of the length of this vector
+	[[nodiscard]] constexpr Scalar dot(const Vec2& other) const noexcept; // Returns the dot product of this vector and another
+	Vec2& vectorNormalize() noexcept; // Normalizes this vector
+	[[nodiscard]] Vec2 vectorGetNormalized() const noexcept; // Returns a new vector that is a normalized version of this vector
+	[[nodiscard]] Scalar vectorDistance(const Vec2& other) const noexcept; // Returns the distance between this vector and another vector
+	[[nodiscard]] constexpr Scalar vectorSquareDistance(const Vec2& other) const noexcept; // Returns the square of the distance between this vector and another vector
+	constexpr void set(Scalar _x, Scalar _y) noexcept; // Sets the x and y values of this vector
+	constexpr void reset() noexcept; // Resets this vector to the zero vector
+
+
 	/// @section Member variables
-	double x; // The x component of this vector
-	double y; // The y component of this vector
+	Scalar x; // The x component of this vector
+	Scalar y; // The y component of this vector
 };
 
 
+template<typename Scalar>
+[[nodiscard]] constexpr Vec2<Scalar> operator*(const typename Vec2<Scalar>::ScalarType scalar, const Vec2<Scalar>& vector) noexcept; // Multiplies a vector by a scalar, scalar first
+
 
 
 
 
 
 
-/// Vec3D class representing a 3D Vector
-class Vec3D
+
+/// Vec3 class template representing a 3D Vector with components of type Scalar
+template<typename Scalar>
+class Vec3
 {
 public:
-	/// @section Constructors and Destructor
-	Vec3D(); // Default constructor
-	Vec3D(double _x, double _y, double _z); // Construct with provided x, y, and z values
-	Vec3D(const Vec3D &other); // Construct by copying another Vec3D object
-	Vec3D(double magnitude); // Construct with provided magnitude
-	~Vec3D(); // Destructor
-	
-	
-	
+	static_assert(std::is_floating_point<Scalar>::value, "Vec3 components must be a floating-point type");
+	using ScalarType = Scalar; // The type of the components
+
+
+	/// @section Constructors
+	constexpr Vec3() noexcept; // Default constructor, the zero vector
+	constexpr Vec3(Scalar _x, Scalar _y, Scalar _z) noexcept; // Construct with provided x, y, and z values
+	explicit Vec3(Scalar magnitude) noexcept; // Construct with provided magnitude
+	template<typename Other>
+	constexpr explicit Vec3(const Vec3<Other>& other) noexcept; // Converts a vector of another precision, component by component
+
+
+
 	/// @section Comparison operators
-	bool operator!=(const Vec3D& other); // Checks inequality with another Vec3D object
-	
-	
-	
-	/// @section Accessor operators (Return new Vec2D based on current one)
-	Vec3D operator+(const Vec3D& other) const; // Adds this vector with another
-	Vec3D operator-(const Vec3D& other) const; // Subtracts another vector from this vector
-	Vec3D operator*(const double scalar) const; // Multiplies this vector by a scalar
-	Vec3D operator/(const double scalar) const; // Divides this vector by a scalar
-	
-	
-	
-	/// @section Modifier operators  (Modify the current Vec3D and return reference)
-	Vec3D& operator=(const Vec3D& other); // Assigns this vector the values of another
-	void operator+=(const Vec3D& other); // Adds another vector to this vector and assigns the result to this vector
-	void operator-=(const Vec3D& other); // Subtracts another vector from this vector and assigns the result to this vector
-	void operator*=(const double scalar); // Multiplies this vector by a scalar and assigns the result to this vector
-	void operator/=(const double scalar); // Divides this vector by a scalar and assigns the result to this vector
-	
-	
-	
+	[[nodiscard]] constexpr bool operator==(const Vec3& other) const noexcept; // Checks equality of the components with another Vec3 object
+	[[nodiscard]] constexpr bool operator!=(const Vec3& other) const noexcept; // Checks inequality of the components with another Vec3 object
+
+
+
+	/// @section Accessor operators (Return new Vec3 based on current one)
+	[[nodiscard]] constexpr Vec3 operator+(const Vec3& other) const noexcept; // Adds this vector with another
+	[[nodiscard]] constexpr Vec3 operator-(const Vec3& other) const noexcept; // Subtracts another vector from this vector
+	[[nodiscard]] constexpr Vec3 operator-() const noexcept; // Negates this vector
+	[[nodiscard]] constexpr Vec3 operator*(const Scalar scalar) const noexcept; // Multiplies this vector by a scalar
+	[[nodiscard]] constexpr Vec3 operator/(const Scalar scalar) const noexcept; // Divides this vector by a scalar
+
+
+
+	/// @section Modifier operators  (Modify the current Vec3 and return reference)
+	constexpr Vec3& operator+=(const Vec3& other) noexcept; // Adds another vector to this vector and assigns the result to this vector
+	constexpr Vec3& operator-=(const Vec3& other) noexcept; // Subtracts another vector from this vector and assigns the result to this vector
+	constexpr Vec3& operator*=(const Scalar scalar) noexcept; // Multiplies this vector by a scalar and assigns the result to this vector
+	constexpr Vec3& operator/=(const Scalar scalar) noexcept; // Divides this vector by a non-zero scalar and assigns the result to this vector
+
+
+
 	/// @section Vector operations
-	Vec3D scaleVector(double scalar) const; // Returns a new vector that is this vector scaled by a scalar
-	double vectorLength() const; // Returns the length of this vector
-	double vectorSquareLength() const; // Returns the square of the length of this vector
-	void vectorNormalize(); // Normalizes this vector
-	Vec3D vectorGetNormalized() const; // Returns a new vector that is a normalized version of this vector
-	double vectorDistance(const Vec3D& other); // Returns the distance between this vector and another vector
-	void set(double _x, double _y, double _z); // Sets the x, y, and z values of this vector
-	
-	
-	
+	[[nodiscard]] constexpr Vec3 scaleVector(Scalar scalar) const noexcept; // Returns a new vector that is this vector scaled by a scalar
+	[[nodiscard]] Scalar vectorLength() const noexcept; // Returns the length of this vector
+	[[nodiscard]] constexpr Scalar vectorSquareLength() const noexcept; // Returns the square of the length of this vector
+	[[nodiscard]] constexpr Scalar dot(const Vec3& other) const noexcept; // Returns the dot product of this vector and another
+	[[nodiscard]] constexpr Vec3 cross(const Vec3& other) const noexcept; // Returns the cross product of this vector and another
+	Vec3& vectorNormalize() noexcept; // Normalizes this vector
+	[[nodiscard]] Vec3 vectorGetNormalized() const noexcept; // Returns a new vector that is a normalized version of this vector
+	[[nodiscard]] Scalar vectorDistance(const Vec3& other) const noexcept; // Returns the distance between this vector and another vector
+	[[nodiscard]] constexpr Scalar vectorSquareDistance(const Vec3& other) const noexcept; // Returns the square of the distance between this vector and another vector
+	constexpr void set(Scalar _x, Scalar _y, Scalar _z) noexcept; // Sets the x, y, and z values of this vector
+	constexpr void reset() noexcept; // Resets this vector to the zero vector
+
+
+
 	/// @section Member variables
-	double x; // The x component of this vector
-	double y; // The y component of this vector
-	double z; // The z component of this vector
+	Scalar x; // The x component of this vector
+	Scalar y; // The y component of this vector
+	Scalar z; // The z component of this vector
 };
 
 
+template<typename Scalar>
+[[nodiscard]] constexpr Vec3<Scalar> operator*(const typename Vec3<Scalar>::ScalarType scalar, const Vec3<Scalar>& vector) noexcept; // Multiplies a vector by a scalar, scalar first
+
+
+
+
+/// ------------- Precisions -------------
+/// \{
+using Vec2D = Vec2<double>; // The double-precision vectors the simulations use
+using Vec3D = Vec3<double>;
+using Vec2F = Vec2<float>; // Single-precision vectors for visualization-quality work
+using Vec3F = Vec3<float>;
+/// \}
+
+
+static_assert(std::is_trivially_copyable<Vec2D>::value && sizeof(Vec2D) == 2 * sizeof(double), "Vec2D must stay a plain pair of doubles");
+static_assert(std::is_trivially_copyable<Vec3D>::value && sizeof(Vec3D) == 3 * sizeof(double), "Vec3D must stay a plain triple of doubles");
+static_assert(std::is_trivially_copyable<Vec2F>::value && sizeof(Vec2F) == 2 * sizeof(float), "Vec2F must stay a plain pair of floats");
+static_assert(std::is_trivially_copyable<Vec3F>::value && sizeof(Vec3F) == 3 * sizeof(float), "Vec3F must stay a plain triple of floats");
+static_assert(!std::is_convertible<Vec3F, Vec3D>::value && !std::is_convertible<Vec3D, Vec3F>::value, "Precisions must only convert explicitly");
+
+
+
+
 
 
 
@@ -144,5 +205,238 @@ public:
 
 
 
+/// ------------- Vec2 Definitions -------------
+/// \{
+template<typename Scalar> constexpr Vec2<Scalar>::Vec2() noexcept : x(0), y(0) {}
+template<typename Scalar> constexpr Vec2<Scalar>::Vec2(Scalar _x, Scalar _y) noexcept : x(_x), y(_y) {}
+template<typename Scalar> template<typename Other> constexpr Vec2<Scalar>::Vec2(const Vec2<Other>& other) noexcept : x(static_cast<Scalar>(other.x)), y(static_cast<Scalar>(other.y)) {}
+
+
+/**
+ * Vec2::Vec2
+ *
+ * Constructor with magnitude for the Vec2 class. The direction is a fixed function of the magnitude,
+ * not random: acos(2 / sqrt(magnitude)), which is NaN for magnitudes below 4. For random directions see
+ * randomDirections in RandomVectors.hpp.
+ *
+ * @param magnitude: The magnitude of the vector.
+ */
+template<typename Scalar>
+inline Vec2<Scalar>::Vec2(Scalar magnitude) noexcept
+{
+	Scalar theta = std::acos(2/std::sqrt(magnitude)*1);
+	x = magnitude * std::cos(theta);
+	y = magnitude * std::sin(theta);
+}
+
+
+template<typename Scalar> constexpr bool Vec2<Scalar>::operator==(const Vec2& other) const noexcept { return x == other.x && y == other.y; }
+template<typename Scalar> constexpr bool Vec2<Scalar>::operator!=(const Vec2& other) const noexcept { return !(*this == other); }
+
+template<typename Scalar> constexpr Vec2<Scalar> Vec2<Scalar>::operator+(const Vec2& other) const noexcept { return Vec2(x + other.x, y + other.y); }
+template<typename Scalar> constexpr Vec2<Scalar> Vec2<Scalar>::operator-(const Vec2& other) const noexcept { return Vec2(x - other.x, y - other.y); }
+template<typename Scalar> constexpr Vec2<Scalar> Vec2<Scalar>::operator-() const noexcept { return Vec2(-x, -y); }
+template<typename Scalar> constexpr Vec2<Scalar> Vec2<Scalar>::operator*(const Scalar scalar) const noexcept { return Vec2(x * scalar, y * scalar); }
+template<typename Scalar> constexpr Vec2<Scalar> Vec2<Scalar>::operator/(const Scalar scalar) const noexcept { return Vec2(x / scalar, y / scalar); }
+template<typename Scalar> constexpr Vec2<Scalar> operator*(const typename Vec2<Scalar>::ScalarType scalar, const Vec2<Scalar>& vector) noexcept { return vector * scalar; }
+
+template<typename Scalar> constexpr Vec2<Scalar>& Vec2<Scalar>::operator+=(const Vec2& other) noexcept { x += other.x; y += other.y; return *this; }
+template<typename Scalar> constexpr Vec2<Scalar>& Vec2<Scalar>::operator-=(const Vec2& other) noexcept { x -= other.x; y -= other.y; return *this; }
+template<typename Scalar> constexpr Vec2<Scalar>& Vec2<Scalar>::operator*=(const Scalar scalar) noexcept { x *= scalar; y *= scalar; return *this; }
+
+
+/**
+ * operator/=
+ *
+ * Divides the components by a scalar. If the scalar is zero, no operation is performed to avoid division by zero.
+ *
+ * @param scalar: The scalar to divide the components by.
+ * @return: A reference to this vector.
+ */
+template<typename Scalar>
+constexpr Vec2<Scalar>& Vec2<Scalar>::operator/=(const Scalar scalar) noexcept
+{
+	if (scalar != 0)
+	{
+		Scalar inverseScalar = 1 / scalar;
+		x *= inverseScalar;
+		y *= inverseScalar;
+	}
+	return *this;
+}
+
+
+/**
+ * scaleVector
+ *
+ * Scales a vector by a given scalar.
+ * First, the vector is normalized, and then it is multiplied by the scalar.
+ * The function does not modify the original vector, but returns a new one.
+ *
+ * @param scalar: The scalar to scale the vector by.
+ * @return: A new instance of the vector scaled by the scalar.
+ */
+template<typename Scalar> inline Vec2<Scalar> Vec2<Scalar>::scaleVector(Scalar scalar) const noexcept { return vectorGetNormalized() * scalar; }
+
+template<typename Scalar> inline Scalar Vec2<Scalar>::vectorLength() const noexcept { return std::sqrt(x * x + y * y); }
+template<typename Scalar> constexpr Scalar Vec2<Scalar>::vectorSquareLength() const noexcept { return x * x + y * y; }
+template<typename Scalar> constexpr Scalar Vec2<Scalar>::dot(const Vec2& other) const noexcept { return x * other.x + y * other.y; }
+
+
+/**
+ * vectorNormalize
+ *
+ * Normalizes the vector, i.e., scales it to have length 1.
+ * If the length of the vector is zero, the function does nothing.
+ *
+ * @return: A reference to this vector.
+ */
+template<typename Scalar>
+inline Vec2<Scalar>& Vec2<Scalar>::vectorNormalize() noexcept
+{
+	Scalar length = vectorLength();
+	if (length != 0)
+	{
+		Scalar inverseLength = 1 / length;
+		x *= inverseLength;
+		y *= inverseLength;
+	}
+	return *this;
+}
+
+
+/**
+ * vectorGetNormalized
+ *
+ * Returns a normalized version of the vector, i.e., a vector in the same direction but with length 1.
+ * If the length of the vector is zero, returns the original vector (which is the zero vector).
+ *
+ * @return: A new instance of the vector normalized.
+ */
+template<typename Scalar>
+inline Vec2<Scalar> Vec2<Scalar>::vectorGetNormalized() const noexcept
+{
+	Vec2 normalVec = *this;
+	return normalVec.vectorNormalize();
+}
+
+
+template<typename Scalar> inline Scalar Vec2<Scalar>::vectorDistance(const Vec2& other) const noexcept { return std::sqrt(vectorSquareDistance(other)); }
+template<typename Scalar> constexpr Scalar Vec2<Scalar>::vectorSquareDistance(const Vec2& other) const noexcept { return (x - other.x) * (x - other.x) + (y - other.y) * (y - other.y); }
+template<typename Scalar> constexpr void Vec2<Scalar>::set(Scalar _x, Scalar _y) noexcept { x = _x; y = _y; }
+template<typename Scalar> constexpr void Vec2<Scalar>::reset() noexcept { x = 0; y = 0; }
+/// \}
+
+
+
+
+
+
+
+
+/// ------------- Vec3 Definitions -------------
+/// \{
+template<typename Scalar> constexpr Vec3<Scalar>::Vec3() noexcept : x(0), y(0), z(0) {}
+template<typename Scalar> constexpr Vec3<Scalar>::Vec3(Scalar _x, Scalar _y, Scalar _z) noexcept : x(_x), y(_y), z(_z) {}
+template<typename Scalar> template<typename Other> constexpr Vec3<Scalar>::Vec3(const Vec3<Other>& other) noexcept : x(static_cast<Scalar>(other.x)), y(static_cast<Scalar>(other.y)), z(static_cast<Scalar>(other.z)) {}
+
+
+/**
+ * Vec3::Vec3
+ *
+ * Constructor with magnitude for the Vec3 class. Like Vec2's, the direction is a fixed function of
+ * the magnitude, acos(3 / sqrt(magnitude)), and z is cos(theta) * sin(theta) (not scaled by the magnitude).
+ * For random directions see randomDirections in RandomVectors.hpp.
+ *
+ * @param magnitude: The magnitude of the vector.
+ */
+template<typename Scalar>
+inline Vec3<Scalar>::Vec3(Scalar magnitude) noexcept
+{
+	Scalar theta = std::acos(3/std::sqrt(magnitude)*1);
+	x = magnitude * std::cos(theta);
+	y = magnitude * std::sin(theta);
+	z = std::cos(theta) * std::sin(theta);
+}
+
+
+template<typename Scalar> constexpr bool Vec3<Scalar>::operator==(const Vec3& other) const noexcept { return x == other.x && y == other.y && z == other.z; }
+template<typename Scalar> constexpr bool Vec3<Scalar>::operator!=(const Vec3& other) const noexcept { return !(*this == other); }
+
+template<typename Scalar> constexpr Vec3<Scalar> Vec3<Scalar>::operator+(const Vec3& other) const noexcept { return Vec3(x + other.x, y + other.y, z + other.z); }
+template<typename Scalar> constexpr Vec3<Scalar> Vec3<Scalar>::operator-(const Vec3& other) const noexcept { return Vec3(x - other.x, y - other.y, z - other.z); }
+template<typename Scalar> constexpr Vec3<Scalar> Vec3<Scalar>::operator-() const noexcept { return Vec3(-x, -y, -z); }
+template<typename Scalar> constexpr Vec3<Scalar> Vec3<Scalar>::operator*(const Scalar scalar) const noexcept { return Vec3(x * scalar, y * scalar, z * scalar); }
+template<typename Scalar> constexpr Vec3<Scalar> Vec3<Scalar>::operator/(const Scalar scalar) const noexcept { return Vec3(x / scalar, y / scalar, z / scalar); }
+template<typename Scalar> constexpr Vec3<Scalar> operator*(const typename Vec3<Scalar>::ScalarType scalar, const Vec3<Scalar>& vector) noexcept { return vector * scalar; }
+
+template<typename Scalar> constexpr Vec3<Scalar>& Vec3<Scalar>::operator+=(const Vec3& other) noexcept { x += other.x; y += other.y; z += other.z; return *this; }
+template<typename Scalar> constexpr Vec3<Scalar>& Vec3<Scalar>::operator-=(const Vec3& other) noexcept { x -= other.x; y -= other.y; z -= other.z; return *this; }
+template<typename Scalar> constexpr Vec3<Scalar>& Vec3<Scalar>::operator*=(const Scalar scalar) noexcept { x *= scalar; y *= scalar; z *= scalar; return *this; }
+
+
+/**
+ * operator/=
+ *
+ * Divides the components by a scalar. If the scalar is zero, no operation is performed to avoid division by zero.
+ *
+ * @param scalar: The scalar to divide the components by.
+ * @return: A reference to this vector.
+ */
+template<typename Scalar>
+constexpr Vec3<Scalar>& Vec3<Scalar>::operator/=(const Scalar scalar) noexcept
+{
+	if (scalar != 0)
+	{
+		Scalar inverseScalar = 1 / scalar;
+		x *= inverseScalar;
+		y *= inverseScalar;
+		z *= inverseScalar;
+	}
+	return *this;
+}
+
+
+template<typename Scalar> constexpr Vec3<Scalar> Vec3<Scalar>::scaleVector(Scalar scalar) const noexcept { return *this * scalar; } // Unlike Vec2's, does not normalize first
+template<typename Scalar> inline Scalar Vec3<Scalar>::vectorLength() const noexcept { return std::sqrt(x * x + y * y + z * z); }
+template<typename Scalar> constexpr Scalar Vec3<Scalar>::vectorSquareLength() const noexcept { return x * x + y * y + z * z; }
+template<typename Scalar> constexpr Scalar Vec3<Scalar>::dot(const Vec3& other) const noexcept { return x * other.x + y * other.y + z * other.z; }
+template<typename Scalar> constexpr Vec3<Scalar> Vec3<Scalar>::cross(const Vec3& other) const noexcept { return Vec3(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x); }
+
+
+/**
+ * Vec3::vectorNormalize
+ *
+ * Normalizes the vector by dividing each component by the vector's length.
+ * If the length of the vector is zero, no operation is performed.
+ *
+ * @return: A reference to this vector.
+ */
+template<typename Scalar>
+inline Vec3<Scalar>& Vec3<Scalar>::vectorNormalize() noexcept
+{
+	Scalar length = vectorLength();
+	if (length != 0)
+	{
+		Scalar inverseLength = 1 / length;
+		x *= inverseLength;
+		y *= inverseLength;
+		z *= inverseLength;
+	}
+	return *this;
+}
+
+
+template<typename Scalar>
+inline Vec3<Scalar> Vec3<Scalar>::vectorGetNormalized() const noexcept
+{
+	Vec3 normalVec = *this;
+	return normalVec.vectorNormalize();
+}
 
 
+template<typename Scalar> inline Scalar Vec3<Scalar>::vectorDistance(const Vec3& other) const noexcept { return std::sqrt(vectorSquareDistance(other)); }
+template<typename Scalar> constexpr Scalar Vec3<Scalar>::vectorSquareDistance(const Vec3& other) const noexcept { return (x - other.x) * (x - other.x) + (y - other.y) * (y - other.y) + (z - other.z) * (z - other.z); }
+template<typename Scalar> constexpr void Vec3<Scalar>::set(Scalar _x, Scalar _y, Scalar _z) noexcept { x = _x; y = _y; z = _z; }
+template<typename Scalar> constexpr void Vec3<Scalar>::reset() noexcept { x = 0; y = 0; z = 0; }
+/// \}
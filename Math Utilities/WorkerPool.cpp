@@ -0,0 +1,202 @@
+//  WorkerPool.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+
+
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+
+
+
+
+
+/**
+ * WorkerPool
+ * Constructor that starts the worker threads.
+ *
+ * @param threadCount: The number of worker threads, at least one is started
+ */
+WorkerPool::WorkerPool(std::size_t threadCount)
+{
+	threadCount = std::max<std::size_t>(1, threadCount);
+	for (std::size_t i = 0; i < threadCount; i++)
+	{
+		workers.emplace_back(&WorkerPool::workerLoop, this);
+	}
+}
+
+
+/**
+ * ~WorkerPool
+ * Destructor that lets every running job finish, abandons the jobs that never started (their futures
+ * report a broken promise) and joins the worker threads.
+ */
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		stopping = true;
+		jobs.clear();
+	}
+	jobAvailable.notify_all();
+
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+}
+
+
+/**
+ * global
+ * Returns the pool shared by the application. It leaves one hardware thread free for the render loop.
+ */
+WorkerPool &WorkerPool::global()
+{
+	static WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+	return pool;
+}
+
+
+/**
+ * submit
+ * Queues a job for the next free worker.
+ *
+ * @param job: The work to run
+ * @return std::shared_future<void>: Completes when the job has run, rethrowing any exception it threw
+ */
+std::shared_future<void> WorkerPool::submit(std::function<void()> job)
+{
+	std::packaged_task<void()> task(std::move(job));
+	std::shared_future<void> result = task.get_future().share();
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		jobs.push_back(std::move(task));
+	}
+	jobAvailable.notify_one();
+	return result;
+}
+
+
+std::size_t WorkerPool::pendingJobs() const
+{
+	std::lock_guard<std::mutex> lock(jobMutex);
+	return jobs.size();
+}
+
+
+std::size_t WorkerPool::threadCount() const
+{
+	return workers.size();
+}
+
+
+/**
+ * workerLoop
+ * Waits for jobs and runs them until the pool stops.
+ */
+void WorkerPool::workerLoop()
+{
+	while (true)
+	{
+		std::packaged_task<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(jobMutex);
+			jobAvailable.wait(lock, [this]() { return stopping || !jobs.empty(); });
+			if (stopping)
+			{
+				return;
+			}
+			task = std::move(jobs.front());
+			jobs.pop_front();
+		}
+		task(); // Exceptions are captured in the task's future
+	}
+}
+
+
+
+
+
+/**
+ * parallelFor
+ * Splits a loop into chunks that the calling thread and up to threadCount() helper jobs claim one at a
+ * time. The caller works through the chunks itself and only waits for chunks other threads have already
+ * claimed, so a call never waits for helper jobs that are still queued behind other work (and cannot
+ * deadlock when made from inside a pool job); helpers that start after the last chunk return at once.
+ *
+ * @param count: The number of elements
+ * @param grain: The number of elements per chunk, at least one
+ * @param body: Called with [begin, end) of each chunk, concurrently from several threads
+ * @param pool: The pool lending its workers
+ */
+void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t begin, std::size_t end)> &body, WorkerPool &pool)
+{
+	grain = std::max<std::size_t>(1, grain);
+	std::size_t chunks = (count + grain - 1) / grain;
+	if (chunks <= 1)
+	{
+		if (count > 0)
+		{
+			body(0, count);
+		}
+		return;
+	}
+
+	struct Progress
+	{
+		std::atomic<std::size_t> next{0}; // The next chunk to claim
+		std::size_t finished = 0; // Chunks done, guarded by 'mutex'
+		std::exception_ptr error; // The first exception of a chunk
+		std::mutex mutex;
+		std::condition_variable allFinished;
+	};
+	auto progress = std::make_shared<Progress>();
+	const std::function<void(std::size_t, std::size_t)> *loopBody = &body; // Only used while chunks remain, so while the caller waits
+
+	/// Step 1: Claim and run chunks until none are left
+	auto work = [progress, loopBody, chunks, grain, count]()
+	{
+		for (std::size_t chunk; (chunk = progress->next.fetch_add(1)) < chunks;)
+		{
+			std::exception_ptr error;
+			try
+			{
+				(*loopBody)(chunk * grain, std::min(count, (chunk + 1) * grain));
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+			std::lock_guard<std::mutex> lock(progress->mutex);
+			if (error && !progress->error)
+			{
+				progress->error = error;
+			}
+			if (++progress->finished == chunks)
+			{
+				progress->allFinished.notify_all();
+			}
+		}
+	};
+
+	/// Step 2: Lend the pool's workers, then work on the calling thread as well
+	std::size_t helpers = std::min(pool.threadCount(), chunks - 1);
+	for (std::size_t i = 0; i < helpers; i++)
+	{
+		pool.submit(work);
+	}
+	work();
+
+	/// Step 3: Wait for the chunks claimed by helpers
+	std::unique_lock<std::mutex> lock(progress->mutex);
+	progress->allFinished.wait(lock, [&]() { return progress->finished == chunks; });
+	if (progress->error)
+	{
+		std::rethrow_exception(progress->error);
+	}
+}
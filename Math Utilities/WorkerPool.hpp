@@ -0,0 +1,74 @@
+//  WorkerPool.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Worker Pool header file declares the thread pool shared by the widgets and the math modules, and a
+ * parallel loop over it.
+ *
+ * These components include:
+ *   - WorkerPool: A small fixed-size thread pool executing submitted jobs in FIFO order.
+ *   - parallelFor: Splits a loop over a range into chunks run by the calling thread and the pool.
+ *
+ * The pool does not depend on openFrameworks or on the widgets, so the math modules (Reductions,
+ * RandomVectors, ParallelPrimitives, SpaceFillingCurves) and the command-line tools build against it
+ * alone. AsyncCallbacks.hpp builds the widget callbacks on top of it.
+ */
+
+
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+
+
+
+/**
+ * WorkerPool class representing a fixed set of worker threads draining a shared job queue.
+ */
+class WorkerPool
+{
+public:
+	/// ------------- Constructors and Destructor -------------
+	/// \{
+	explicit WorkerPool(std::size_t threadCount); // Starts 'threadCount' worker threads
+	~WorkerPool(); // Stops the workers once their current jobs finish; jobs that never started are abandoned
+	WorkerPool(const WorkerPool &) = delete;
+	WorkerPool &operator=(const WorkerPool &) = delete;
+	/// \}
+
+
+	/// ------------- Access -------------
+	/// \{
+	static WorkerPool &global(); // The pool shared by the application, sized to leave one core for the render thread
+								 /// \}
+
+
+	/// ------------- Jobs -------------
+	/// \{
+	std::shared_future<void> submit(std::function<void()> job); // Queues a job, the future completes (or rethrows) when it has run
+	std::size_t pendingJobs() const; // Number of jobs waiting for a worker
+	std::size_t threadCount() const; // Number of worker threads
+									 /// \}
+
+
+private:
+	void workerLoop(); // Body of every worker thread
+
+	std::vector<std::thread> workers; // The worker threads
+	std::deque<std::packaged_task<void()>> jobs; // Jobs waiting for a worker
+	mutable std::mutex jobMutex; // Guards 'jobs' and 'stopping'
+	std::condition_variable jobAvailable; // Signalled when a job is queued or the pool stops
+	bool stopping = false; // Whether the pool is shutting down
+};
+
+
+/// Runs body(begin, end) over [0, count) in chunks of 'grain' elements, on the calling thread and the workers of 'pool', and returns when all chunks are done (rethrowing the first exception of a chunk).
+void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t begin, std::size_t end)> &body, WorkerPool &pool = WorkerPool::global());
@@ -19,44 +19,170 @@ void ofApp::setup()
 	inputControls->addButtonElement(myButton);
 	inputControls->addToggleElement(myToggle);
 	inputControls->addTextFieldElement(myTextField);
+	latencyReadoutToggle = new Toggle("Show Latency", 50, 190, 40, 40, false);
+	inputControls->addToggleElement(latencyReadoutToggle);
+	Button *savePresetButton = new Button("Save Preset", 50, 260, 40, 40, [this]() {
+		presets.save("default", *tableManager);});
+	Button *loadPresetButton = new Button("Load Preset", 50, 330, 40, 40, [this]() {
+		ofLogNotice("Presets") << presets.apply("default", *tableManager) << " widgets restored.";});
+	inputControls->addButtonElement(savePresetButton);
+	inputControls->addButtonElement(loadPresetButton);
+	Toggle *shareParametersToggle = new Toggle("Share Parameters", 50, 400, 40, 40, false);
+	shareParametersToggle->onToggle = [this](bool on) {
+		if (on) { sharedParameters.open("/ofui_parameters"); } else { sharedParameters.close(); }};
+	inputControls->addToggleElement(shareParametersToggle);
+	Button *undoButton = new Button("Undo", 50, 470, 40, 40, [this]() { history.undo(); });
+	Button *redoButton = new Button("Redo", 50, 540, 40, 40, [this]() { history.redo(); });
+	inputControls->addButtonElement(undoButton);
+	inputControls->addButtonElement(redoButton);
 	
 	
-	Slider* thetaSlider = new Slider("MAC", 125, 50, 150, 10, 0, 2, theta);
-	Slider *dtS = new Slider("t", 0,0,200,15, (1/120), 1, dt);
-	TextField *gTF = new TextField("G", 0,0,200,17,6.67430e-11, 6.67430e4, G, 15);
+	ParameterStore &parameters = ParameterStore::global();
+	theta = parameters.add<float>("theta", 0.5f, 0, 2);
+	dt = parameters.add<float>("dt", 1.0f / 60.0f, 1.0 / 120.0, 1);
+	G = parameters.add<double>("G", 6.67430e-11, 6.67430e-11, 6.67430e4);
+	softening = parameters.add<float>("e", 0.01f, 0, 1);
+	thetaBudget = parameters.add<float>("theta_budget", 0.01f, 0.001, 0.2);
+	switchParameter = parameters.add<bool>("switch", false, 0, 1);
+	parameters.publish();
+	if (parameterJournal.open(ofToDataPath("parameter_journal.bin")))
+	{
+		parameters.addListener(&parameterJournal);
+	}
+	myToggle->bindParameter(switchParameter);
+	history.attach(parameters);
+	
+	Slider* thetaSlider = new Slider("MAC", 125, 50, 150, 10, theta);
+	Slider *dtS = new Slider("t", 0,0,200,15, dt);
+	TextField *gTF = new TextField("G", 0,0,200,17, G, 15);
+	BasicSlider<double, Log10SliderMapping> *gSlider = new BasicSlider<double, Log10SliderMapping>("G (log)", 0,0,200,15, G); // G spans 15 orders of magnitude
+	gSlider->precision = 15;
+	Slider *eSlider = new Slider("e", 0,0,200,15, softening);
+	BasicSlider<float, Log10SliderMapping> *budgetSlider = new BasicSlider<float, Log10SliderMapping>("MAC error budget", 0,0,200,15, thetaBudget);
+	simulateToggle = new Toggle("Run Simulation", 0,0,40,40, false);
+	autotuneToggle = new Toggle("Autotune MAC", 0,0,40,40, false);
+	autotuneToggle->onToggle = [this](bool on) {
+		if (on) { thetaAutotuner.request(); }};
 	navigationalComponents = new Table("Navigation Components Manager", 45, 450, 20, 20, false);
 	navigationalComponents->addSliderElement(thetaSlider);
 	navigationalComponents->addSliderElement(dtS);
+	navigationalComponents->addSliderElement(gSlider);
+	navigationalComponents->addSliderElement(eSlider);
+	navigationalComponents->addSliderElement(budgetSlider);
 	navigationalComponents->addTextFieldElement(gTF);
+	navigationalComponents->addToggleElement(simulateToggle);
+	navigationalComponents->addToggleElement(autotuneToggle);
+	double g = parameters.get(G);
+	simulation = NBodySimulation(NBodySimulation::uniformDisk(1024, 1.0, 1.0 / g, g, 1), SimulationSettings()); // A total mass of 1/G keeps orbital times of order one for any G
+	
 	
+	sweepTable = new Table("Parameter Sweep", 45, 650, 20, 20, false);
+	Button *runSweepButton = new Button("Run Sweep", 50, 50, 40, 40, [this]() {
+		std::vector<SweepRange> ranges = {{"theta", 0.2, 1.1, 4}, {"dt", 1.0 / 120.0, 1.0 / 30.0, 3, true}, {"e", 0.005, 0.08, 3, true}};
+		sweep.start(ranges, SweepConfiguration(), ParameterStore::global());});
+	sweepTable->addButtonElement(runSweepButton);
 	
 	
 	tableManager = new TableManager(0, "UI Elements Table Manager", 0 + ofGetWidth() * 0.025, ofGetHeight() * 0.030, 15, 15);
 	tableManager->addTable(inputControls);
 	tableManager->addTable(navigationalComponents);
+	tableManager->addTable(sweepTable);
 }
 
 
 
 
 
+void ofApp::update()
+{
+	// Process all input received since the last frame, in order; a release ends the gesture being recorded for undo
+	inputQueue.dispatch([this](const InputEvent &event) {
+		bool command = ofGetKeyPressed(OF_KEY_CONTROL) || ofGetKeyPressed(OF_KEY_COMMAND);
+		if (event.type == InputEventType::KeyReleased && command && (event.key == 'z' || event.key == 'Z' || event.key == 26))
+		{
+			ofGetKeyPressed(OF_KEY_SHIFT) ? history.redo() : history.undo(); // Ctrl/Cmd+Z undoes, with Shift it redoes
+			return;
+		}
+		InputEventQueue::deliver(*tableManager, event);
+		if (event.type == InputEventType::MouseReleased || event.type == InputEventType::KeyReleased)
+		{
+			history.seal();
+		}}, InputEventQueue::QUEUE_CAPACITY);
+	sweep.releaseStaleResultsTable(); // A sweep started since the last frame: drop the rows of the previous one, outside of the tables' event handling
+	if (sweep.collect()) // A sweep finished since the last frame: save it and list it, outside of the tables' event handling
+	{
+		sweep.writeCsv(ofToDataPath("sweep_results.csv"));
+		sweep.fillResultsTable(*sweepTable, ParameterStore::global());
+	}
+	ParameterExpressions::global().update(); // Re-derive the parameters typed as expressions whose inputs just changed
+	ParameterStore::global().publish(); // Hand this frame's parameter edits to the simulation as one consistent set
+	
+	// Step boundary of the simulation: pick up the parameters that changed, without locking
+	tableManager->update(simulationTheta, simulationG, simulationE, simulationDt);
+	simulation.settings = {simulationTheta, simulationG, simulationE, simulationDt};
+	if (simulateToggle->isOn)
+	{
+		simulation.step();
+	}
+	if (autotuneToggle->isOn)
+	{
+		thetaAutotuner.errorBudget = ParameterStore::global().get(thetaBudget);
+		if (thetaAutotuner.update(simulation.bodies, simulation.settings, ParameterStore::global()))
+		{
+			history.seal(); // An autotuned theta is its own undo step
+		}
+	}
+}
+
+
 void ofApp::draw()
 {
-	ofBackground(40); ofSetColor(255);
+	ofBackground(40);
+	ofFill(); ofSetColor(255, 255, 255, 160);
+	float scale = std::min(ofGetWidth(), ofGetHeight()) * 0.3f;
+	for (const Body &body : simulation.bodies)
+	{
+		ofDrawRectangle(ofGetWidth() * 0.5f + body.position.x * scale, ofGetHeight() * 0.5f + body.position.y * scale, 2, 2);
+	}
+	ofSetColor(255);
 	tableManager->draw();
+	
+	if (autotuneToggle->isOn && !thetaAutotuner.lastTuning().candidates.empty())
+	{
+		const ThetaTuning &tuning = thetaAutotuner.lastTuning();
+		const ThetaCandidate *chosen = &tuning.candidates.front();
+		for (const ThetaCandidate &candidate : tuning.candidates) { if (candidate.theta == tuning.theta) { chosen = &candidate; } }
+		ofDrawBitmapStringHighlight("Autotuned theta = " + ofToString(tuning.theta, 2) + "  (RMS force error " + ofToString(chosen->rmsError * 100, 2) + "%, " + ofToString(chosen->microsecondsPerBody, 2) + " us/body" + (thetaAutotuner.isTuning() ? ", retuning" : "") + ")", 25, ofGetHeight() - 80);
+	}
+	
+	LatencyMonitor::global().showReadout = latencyReadoutToggle->isOn;
+	if (LatencyMonitor::global().showReadout)
+	{
+		LatencyMonitor::global().draw(ofGetWidth() - 480, ofGetHeight() - 150);
+	}
 	ofDrawBitmapStringHighlight("Click or toggle the controls above;\nType in the TextField and press ENTER to apply.", 25, ofGetHeight() - 50);
 }
 
 
+void ofApp::exit()
+{
+	ParameterStore::global().removeListener(&parameterJournal);
+	parameterJournal.close();
+	sharedParameters.close();
+	history.detach();
+	sweep.cancel();
+}
+
+
 void ofApp::keyReleased(int key)
-{ tableManager->keyReleased(key); }
+{ inputQueue.enqueueKeyReleased(key); }
 
 void ofApp::mouseDragged(int x, int y, int button)
-{ tableManager->mouseDragged(x, y, button); }
+{ inputQueue.enqueueMouseDragged(x, y, button); }
 void ofApp::mousePressed(int x, int y, int button)
-{ tableManager->mousePressed(x, y, button); }
+{ inputQueue.enqueueMousePressed(x, y, button); }
 void ofApp::mouseReleased(int x, int y, int button)
-{ tableManager->mouseReleased(x, y, button); }
+{ inputQueue.enqueueMouseReleased(x, y, button); }
 
 
 
@@ -11,6 +11,16 @@
 #include "InputControls.hpp"
 #include "NavigationalComponents.hpp"
 #include "InformationalComponents.hpp"
+#include "InterfaceDiagnostics.hpp"
+#include "InputEventQueue.hpp"
+#include "ParameterStore.hpp"
+#include "ParameterJournal.hpp"
+#include "InterfacePresets.hpp"
+#include "SharedParameterSegment.hpp"
+#include "InterfaceHistory.hpp"
+#include "ParameterExpressions.hpp"
+#include "ParameterSweep.hpp"
+#include "ThetaAutotuner.hpp"
 
 
 
@@ -23,18 +33,39 @@ public:
 	double testValue = 25.0; // Example value for the TextField
 	Table *inputControls;
 	Table *navigationalComponents;
+	Table *sweepTable; // Starts parameter sweeps and lists their results
 	TableManager *tableManager;
+	Toggle *latencyReadoutToggle; // Shows the input-to-callback latency readout while on
+	Toggle *simulateToggle; // Steps the simulation once per frame while on
+	Toggle *autotuneToggle; // Lets the autotuner choose theta while on
+	InputEventQueue inputQueue; // Window callbacks only enqueue, the UI drains it once per frame in update()
 	
 	
 	
 	
-	float theta = 0.5; // Example value for Barnes-Hut θ
-	float dt = 1.0 / 60.0; // Example value for Δt (time step)
-	double G = 6.67430e-11; // Gravitational constant in m^3 kg^-1 s^-2
+	// Simulation parameters live in the ParameterStore; widgets edit them through these handles and
+	// simulation threads read them from published snapshots, never from the widgets' values directly
+	ParameterHandle<float> theta; // Example value for Barnes-Hut θ
+	ParameterHandle<float> dt; // Example value for Δt (time step)
+	ParameterHandle<double> G; // Gravitational constant in m^3 kg^-1 s^-2
+	ParameterHandle<float> softening; // Softening length e
+	ParameterHandle<float> thetaBudget; // Error budget of the theta autotuner (RMS relative force error)
+	ParameterHandle<bool> switchParameter; // State of the "Switch Toggle"
+	float simulationTheta = 0.5, simulationDt = 1.0 / 60.0, simulationE = 0; // The parameter values the simulation steps with, refreshed by TableManager::update
+	double simulationG = 6.67430e-11;
+	ParameterJournal parameterJournal; // Audit trail of every parameter change, decoded with tools/ParameterJournalReader
+	PresetLibrary presets{ofToDataPath("presets")}; // Named snapshots of every bound widget value
+	SharedParameterSegment sharedParameters; // Mirrors the parameters into shared memory for an out-of-process simulation, e.g. tools/SharedParameterConsumer
+	UndoHistory history; // Undo/redo of parameter edits, one entry per drag, click or submitted text
+	ParameterSweep sweep; // Headless simulations over ranges of theta, dt and e, on every core
+	NBodySimulation simulation; // The particle set the parameters drive
+	ThetaAutotuner thetaAutotuner; // Picks the fastest theta within the error budget for the current particle set
 	
 	
 	void setup() override;
+	void update() override;
 	void draw() override;
+	void exit() override;
 	
 
 	void keyReleased(int key) override;
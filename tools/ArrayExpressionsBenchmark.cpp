@@ -0,0 +1,230 @@
+//  ArrayExpressionsBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Array Expressions Benchmark, a command-line tool that times the same integrator and force-accumulation
+ * arithmetic written three ways: as a hand-written loop, as VectorArrays operations that build a temporary
+ * array per operator, and as one ArrayExpressions statement.
+ *
+ * Usage:
+ *   ArrayExpressionsBenchmark [count] [repetitions]
+ *
+ * The integrator drifts 'count' positions (default 16384) by velocities * dt + accelerations * dt^2 / 2;
+ * the force pass sums the softened attraction of count / 8 bodies on each of them. The fastest of
+ * 'repetitions' runs (default 7) is reported in nanoseconds per element; all three forms must give bitwise
+ * equal checksums. Build it from the repository root with optimizations, e.g.:
+ *
+ *   c++ -std=c++17 -O3 -I"Math Utilities" tools/ArrayExpressionsBenchmark.cpp "Math Utilities/VectorArrays.cpp" "Math Utilities/VectorArraysAVX2.cpp" -o ArrayExpressionsBenchmark
+ */
+
+
+#include "ArrayExpressions.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	/// The fastest of several runs of a pass in nanoseconds per element, and the checksum of the last run.
+	struct Timing
+	{
+		double nanosecondsPerElement;
+		double checksum;
+	};
+
+	Timing measure(int repetitions, double elements, const std::function<double()> &pass)
+	{
+		Timing timing = {0, 0};
+		for (int repetition = 0; repetition < repetitions; repetition++)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			double checksum = pass();
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / elements;
+			if (repetition == 0 || nanoseconds < timing.nanosecondsPerElement)
+			{
+				timing.nanosecondsPerElement = nanoseconds;
+			}
+			timing.checksum = checksum;
+		}
+		return timing;
+	}
+
+
+	Vec2DArray randomArray(std::size_t count, uint32_t seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<double> unit(-1.0, 1.0);
+		Vec2DArray array(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			double x = unit(generator), y = unit(generator);
+			array.set(i, Vec2D(x, y));
+		}
+		return array;
+	}
+
+
+	double checksum(const Vec2DArray &array)
+	{
+		double total = 0;
+		for (std::size_t i = 0; i < array.size(); i += 16)
+		{
+			total += array.x()[i] + array.y()[i];
+		}
+		return total;
+	}
+
+
+	constexpr double DT = 1e-3;
+	constexpr double SOFTENING2 = 1e-4;
+
+
+
+
+	/// ------------- Integrator: positions += velocities * dt + accelerations * (dt * dt / 2) -------------
+	/// \{
+	double driftLoop(Vec2DArray &positions, const Vec2DArray &velocities, const Vec2DArray &accelerations)
+	{
+		const double halfDt2 = 0.5 * DT * DT;
+		for (std::size_t i = 0; i < positions.size(); i++)
+		{
+			positions.x()[i] = positions.x()[i] + (velocities.x()[i] * DT + accelerations.x()[i] * halfDt2);
+			positions.y()[i] = positions.y()[i] + (velocities.y()[i] * DT + accelerations.y()[i] * halfDt2);
+		}
+		return checksum(positions);
+	}
+
+
+	double driftTemporaries(Vec2DArray &positions, const Vec2DArray &velocities, const Vec2DArray &accelerations)
+	{
+		Vec2DArray scaledVelocities = velocities, scaledAccelerations = accelerations, step; // One temporary per operator
+		vectorScale(scaledVelocities, DT);
+		vectorScale(scaledAccelerations, 0.5 * DT * DT);
+		vectorAdd(scaledVelocities, scaledAccelerations, step);
+		vectorAdd(positions, step, positions);
+		return checksum(positions);
+	}
+
+
+	double driftExpression(Vec2DArray &positions, const Vec2DArray &velocities, const Vec2DArray &accelerations)
+	{
+		positions += velocities * DT + accelerations * (0.5 * DT * DT);
+		return checksum(positions);
+	}
+	/// \}
+
+
+
+
+	/// ------------- Forces: the softened attraction of all bodies on each -------------
+	/// \{
+	double forcesLoop(const Vec2DArray &positions, const std::vector<double> &masses, Vec2DArray &accelerations)
+	{
+		for (std::size_t i = 0; i < positions.size(); i++)
+		{
+			Vec2D position = positions.get(i), acceleration;
+			for (std::size_t j = 0; j < positions.size(); j++)
+			{
+				Vec2D difference = positions.get(j) - position;
+				double r2 = difference.dot(difference) + SOFTENING2;
+				acceleration += difference * (masses[j] / (r2 * std::sqrt(r2)));
+			}
+			accelerations.set(i, acceleration);
+		}
+		return checksum(accelerations);
+	}
+
+
+	double forcesTemporaries(const Vec2DArray &positions, const std::vector<double> &masses, Vec2DArray &accelerations)
+	{
+		Vec2DArray differences;
+		std::vector<double> factors;
+		for (std::size_t i = 0; i < positions.size(); i++)
+		{
+			Vec2D position = positions.get(i), acceleration;
+			Vec2DArray broadcast(positions.size()); // positions - position, one operation at a time
+			for (std::size_t j = 0; j < positions.size(); j++)
+			{
+				broadcast.set(j, -position);
+			}
+			vectorAdd(positions, broadcast, differences);
+			vectorSquareLengths(differences, factors);
+			for (std::size_t j = 0; j < positions.size(); j++)
+			{
+				double r2 = factors[j] + SOFTENING2;
+				factors[j] = masses[j] / (r2 * std::sqrt(r2));
+			}
+			for (std::size_t j = 0; j < positions.size(); j++)
+			{
+				acceleration += differences.get(j) * factors[j];
+			}
+			accelerations.set(i, acceleration);
+		}
+		return checksum(accelerations);
+	}
+
+
+	double forcesExpression(const Vec2DArray &positions, const std::vector<double> &masses, Vec2DArray &accelerations)
+	{
+		for (std::size_t i = 0; i < positions.size(); i++)
+		{
+			auto difference = positions - positions.get(i);
+			auto r2 = squareLength(difference) + SOFTENING2;
+			accelerations.set(i, sum(difference * (scalars(masses) / (r2 * sqrt(r2)))));
+		}
+		return checksum(accelerations);
+	}
+	/// \}
+
+
+
+
+	bool report(const char *name, const Timing &loop, const Timing &temporaries, const Timing &expression)
+	{
+		bool match = loop.checksum == temporaries.checksum && loop.checksum == expression.checksum;
+		std::printf("%-12s %12.3f %12.3f %12.3f %9.2fx   %s\n", name, loop.nanosecondsPerElement, temporaries.nanosecondsPerElement, expression.nanosecondsPerElement, temporaries.nanosecondsPerElement / expression.nanosecondsPerElement, match ? "checksums match" : "CHECKSUM MISMATCH");
+		return match;
+	}
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	std::size_t count = argc > 1 ? std::max(64, std::atoi(argv[1])) : 1 << 14;
+	int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 7;
+	std::printf("%-12s %12s %12s %12s %10s\n", "ns/element", "loop", "temporaries", "expression", "speedup");
+
+
+	/// Step 1: The integrator, each form from the same inputs
+	const Vec2DArray velocities = randomArray(count, 2), accelerations = randomArray(count, 3);
+	Vec2DArray loopPositions = randomArray(count, 1), temporaryPositions = loopPositions, expressionPositions = loopPositions;
+	Timing loop = measure(repetitions, count, [&]() { return driftLoop(loopPositions, velocities, accelerations); });
+	Timing temporaries = measure(repetitions, count, [&]() { return driftTemporaries(temporaryPositions, velocities, accelerations); });
+	Timing expression = measure(repetitions, count, [&]() { return driftExpression(expressionPositions, velocities, accelerations); });
+	bool allMatch = report("drift", loop, temporaries, expression);
+
+
+	/// Step 2: Direct-sum forces over pairs of bodies
+	std::size_t bodies = count / 8;
+	const Vec2DArray positions = randomArray(bodies, 4);
+	std::vector<double> masses(bodies, 1.0 / bodies);
+	Vec2DArray forces(bodies);
+	double pairs = static_cast<double>(bodies) * bodies;
+	loop = measure(repetitions, pairs, [&]() { return forcesLoop(positions, masses, forces); });
+	temporaries = measure(repetitions, pairs, [&]() { return forcesTemporaries(positions, masses, forces); });
+	expression = measure(repetitions, pairs, [&]() { return forcesExpression(positions, masses, forces); });
+	allMatch &= report("forces", loop, temporaries, expression);
+
+	return allMatch ? 0 : 1;
+}
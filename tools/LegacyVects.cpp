@@ -1,13 +1,9 @@
-//  Vects.cpp
+//  LegacyVects.cpp
 //  OpenFrameworks_User_Interface_Library
 //  DavidRichardson02
-/**
- dev NOTE:
- The 'Vects' header and source files contain code that is not yet incorporated into the larger project and is still in experimental stages of development(probably no point in trying to learn how to make my own graphics thing using OpenGL when graphics won't really be a performance bottleneck for this simulation, that's just a bunch of dots, the real heavy lifting comes from the interactions between these dots and accurately approximating them to balance the insane computational complexity of direct simulations(O(N^2)) with reasonable accuracy, so these will probably find some use in some future thing, who knows, not me. So it almost definitely makes more sense to just use the existing stuff provided by OpenFrameworks.
- */
 
 
-#include "Vects.hpp"
+#include "LegacyVects.hpp"
 
 
 
@@ -15,55 +11,55 @@
 
 
 /**
- * Vec2D::Vec2D
+ * LegacyVec2D::LegacyVec2D
  *
- * Default constructor for the Vec2D class.
- * Initializes a new instance of the Vec2D class with both components (x, y) set to zero.
+ * Default constructor for the LegacyVec2D class.
+ * Initializes a new instance of the LegacyVec2D class with both components (x, y) set to zero.
  */
-Vec2D::Vec2D() : x(0), y(0)
+LegacyVec2D::LegacyVec2D() : x(0), y(0)
 {
 	// Both components are initialized to zero
 }
 
 
 /**
- * Vec2D::Vec2D
+ * LegacyVec2D::LegacyVec2D
  *
- * Constructor with parameters for the Vec2D class.
- * Initializes a new instance of the Vec2D class with the specified components.
+ * Constructor with parameters for the LegacyVec2D class.
+ * Initializes a new instance of the LegacyVec2D class with the specified components.
  *
  * @param _x: The x component of the vector.
  * @param _y: The y component of the vector.
  */
-Vec2D::Vec2D(double _x, double _y) : x(_x), y(_y)
+LegacyVec2D::LegacyVec2D(double _x, double _y) : x(_x), y(_y)
 {
 	// The components are assigned the values provided as parameters
 }
 
 
 /**
- * Vec2D::Vec2D
+ * LegacyVec2D::LegacyVec2D
  *
- * Copy constructor for the Vec2D class.
- * Initializes a new instance of the Vec2D class, copying the components from another instance.
+ * Copy constructor for the LegacyVec2D class.
+ * Initializes a new instance of the LegacyVec2D class, copying the components from another instance.
  *
  * @param other: The instance to copy the components from.
  */
-Vec2D::Vec2D(const Vec2D &other) : x(other.x), y(other.y)
+LegacyVec2D::LegacyVec2D(const LegacyVec2D &other) : x(other.x), y(other.y)
 {
 	// The components are copied from the other instance
 }
 
 
 /**
- * Vec2D::Vec2D
+ * LegacyVec2D::LegacyVec2D
  *
- * Constructor with magnitude for the Vec2D class.
- * Initializes a new instance of the Vec2D class with a specified magnitude and a random direction.
+ * Constructor with magnitude for the LegacyVec2D class.
+ * Initializes a new instance of the LegacyVec2D class with a specified magnitude and a random direction.
  *
  * @param magnitude: The magnitude of the vector.
  */
-Vec2D::Vec2D(double magnitude)
+LegacyVec2D::LegacyVec2D(double magnitude)
 {
 	/// Generate a random direction
 	double theta = acos(2/sqrt(magnitude)*1);
@@ -75,12 +71,12 @@ Vec2D::Vec2D(double magnitude)
 
 
 /**
- * Vec2D::~Vec2D
+ * LegacyVec2D::~LegacyVec2D
  *
- * Destructor for the Vec2D class.
- * Resets the components (x, y) of the Vec2D instance to zero.
+ * Destructor for the LegacyVec2D class.
+ * Resets the components (x, y) of the LegacyVec2D instance to zero.
  */
-Vec2D::~Vec2D()
+LegacyVec2D::~LegacyVec2D()
 {
 	// Reset the components to zero
 	x = 0;
@@ -91,15 +87,15 @@ Vec2D::~Vec2D()
 
 
 /**
- * Vec2D::operator!=
+ * LegacyVec2D::operator!=
  *
- * Not-equal-to operator overload for the Vec2D class.
+ * Not-equal-to operator overload for the LegacyVec2D class.
  * Checks if this instance is not equal to another instance.
  *
  * @param other: The instance to compare with.
  * @return: true if the instances are not equal, false otherwise.
  */
-bool Vec2D::operator!=(const Vec2D& other)
+bool LegacyVec2D::operator!=(const LegacyVec2D& other)
 {
 	// Initialize the result as false (equal)
 	bool notEqual = false;
@@ -117,15 +113,15 @@ bool Vec2D::operator!=(const Vec2D& other)
 
 
 /**
- * Vec2D::operator=
+ * LegacyVec2D::operator=
  *
- * Assignment operator overload for the Vec2D class.
+ * Assignment operator overload for the LegacyVec2D class.
  * Assigns the components of another instance to this instance.
  *
  * @param other: The instance to copy the components from.
  * @return: A reference to this instance.
  */
-Vec2D& Vec2D::operator=(const Vec2D& other)
+LegacyVec2D& LegacyVec2D::operator=(const LegacyVec2D& other)
 {
 	/// Check if the instances are not the same
 	if (this != &other)
@@ -141,66 +137,66 @@ Vec2D& Vec2D::operator=(const Vec2D& other)
 
 
 /**
- * Vec2D::operator+
+ * LegacyVec2D::operator+
  *
- * Addition operator overload for the Vec2D class.
+ * Addition operator overload for the LegacyVec2D class.
  * Adds the components of this instance and another instance.
  *
  * @param other: The instance to add the components from.
  * @return: A new instance with the added components.
  */
-Vec2D Vec2D::operator+(const Vec2D& other) const
+LegacyVec2D LegacyVec2D::operator+(const LegacyVec2D& other) const
 {
 	// Create a new instance with the added components and return it
-	return(Vec2D(x + other.x, y + other.y));
+	return(LegacyVec2D(x + other.x, y + other.y));
 }
 
 
 /**
  * operator-
  *
- * Subtraction operator overload for the Vec2D class.
+ * Subtraction operator overload for the LegacyVec2D class.
  * Subtracts the components of another instance from this instance.
  *
  * @param other: The instance to subtract the components from.
  * @return: A new instance with the subtracted components.
  */
-Vec2D Vec2D::operator-(const Vec2D& other) const
+LegacyVec2D LegacyVec2D::operator-(const LegacyVec2D& other) const
 {
 	// Create a new instance with the subtracted components and return it
-	return(Vec2D(x - other.x, y - other.y));
+	return(LegacyVec2D(x - other.x, y - other.y));
 }
 
 
 /**
  * operator*
  *
- * Multiplication operator overload for the Vec2D class.
+ * Multiplication operator overload for the LegacyVec2D class.
  * Multiplies the components of this instance by a scalar.
  *
  * @param scalar: The scalar to multiply the components by.
  * @return: A new instance with the multiplied components.
  */
-Vec2D Vec2D::operator*(const double scalar) const
+LegacyVec2D LegacyVec2D::operator*(const double scalar) const
 {
 	// Create a new instance with the multiplied components and return it
-	return(Vec2D(x * scalar, y * scalar));
+	return(LegacyVec2D(x * scalar, y * scalar));
 }
 
 
 /**
  * operator/
  *
- * Division operator overload for the Vec2D class.
+ * Division operator overload for the LegacyVec2D class.
  * Divides the components of this instance by a scalar.
  *
  * @param scalar: The scalar to divide the components by.
  * @return: A new instance with the divided components.
  */
-Vec2D Vec2D::operator/(const double scalar) const
+LegacyVec2D LegacyVec2D::operator/(const double scalar) const
 {
 	// Create a new instance with the divided components and return it
-	return(Vec2D(x / scalar, y / scalar));
+	return(LegacyVec2D(x / scalar, y / scalar));
 }
 
 
@@ -209,12 +205,12 @@ Vec2D Vec2D::operator/(const double scalar) const
 /**
  * operator+=
  *
- * Addition-assignment operator overload for the Vec2D class.
+ * Addition-assignment operator overload for the LegacyVec2D class.
  * Adds the components of another instance to this instance.
  *
  * @param other: The instance to add the components from.
  */
-void Vec2D::operator+=(const Vec2D& other)
+void LegacyVec2D::operator+=(const LegacyVec2D& other)
 {
 	// Add the components
 	x = x + other.x;
@@ -225,12 +221,12 @@ void Vec2D::operator+=(const Vec2D& other)
 /**
  * operator-=
  *
- * Subtraction-assignment operator overload for the Vec2D class.
+ * Subtraction-assignment operator overload for the LegacyVec2D class.
  * Subtracts the components of another instance from this instance.
  *
  * @param other: The instance to subtract the components from.
  */
-void Vec2D::operator-=(const Vec2D& other)
+void LegacyVec2D::operator-=(const LegacyVec2D& other)
 {
 	// Subtract the components
 	x = x - other.x;
@@ -241,12 +237,12 @@ void Vec2D::operator-=(const Vec2D& other)
 /**
  * operator*=
  *
- * Multiplication-assignment operator overload for the Vec2D class.
+ * Multiplication-assignment operator overload for the LegacyVec2D class.
  * Multiplies the components of this instance by a scalar.
  *
  * @param scalar: The scalar to multiply the components by.
  */
-void Vec2D::operator*=(const double scalar)
+void LegacyVec2D::operator*=(const double scalar)
 {
 	// Multiply the components
 	x = x * scalar;
@@ -257,13 +253,13 @@ void Vec2D::operator*=(const double scalar)
 /**
  * operator/=
  *
- * Division-assignment operator overload for the Vec2D class.
+ * Division-assignment operator overload for the LegacyVec2D class.
  * Divides the components of this instance by a scalar.
  * If the scalar is zero, no operation is performed to avoid division by zero.
  *
  * @param scalar: The scalar to divide the components by.
  */
-void Vec2D::operator/=(const double scalar)
+void LegacyVec2D::operator/=(const double scalar)
 {
 	// Check if scalar is not zero to avoid division by zero
 	if (scalar != 0)
@@ -271,7 +267,7 @@ void Vec2D::operator/=(const double scalar)
 		/// Calculate the inverse of the scalar
 		double inverseScalar = 1 / scalar;
 		
-		// Multiply the x and y components of the Vec2D object by the inverse of the scalar
+		// Multiply the x and y components of the LegacyVec2D object by the inverse of the scalar
 		x = x * inverseScalar;
 		y = y * inverseScalar;
 	}
@@ -290,10 +286,10 @@ void Vec2D::operator/=(const double scalar)
  * @param scalar: The scalar to scale the vector by.
  * @return: A new instance of the vector scaled by the scalar.
  */
-Vec2D Vec2D::scaleVector(double scalar) const
+LegacyVec2D LegacyVec2D::scaleVector(double scalar) const
 {
 	/// Normalize the vector and scale it
-	Vec2D scaledVector = vectorGetNormalized();
+	LegacyVec2D scaledVector = vectorGetNormalized();
 	scaledVector = scaledVector * scalar;
 	return(scaledVector);
 }
@@ -307,7 +303,7 @@ Vec2D Vec2D::scaleVector(double scalar) const
  *
  * @return: The length of the vector.
  */
-double Vec2D::vectorLength() const
+double LegacyVec2D::vectorLength() const
 {
 	/// Calculate the length using the Pythagorean theorem
 	return(sqrt(x * x + y * y));
@@ -323,7 +319,7 @@ double Vec2D::vectorLength() const
  *
  * @return: The square of the length of the vector.
  */
-double Vec2D::vectorSquareLength() const
+double LegacyVec2D::vectorSquareLength() const
 {
 	/// Calculate the square of the length
 	return(x * x + y * y);
@@ -336,7 +332,7 @@ double Vec2D::vectorSquareLength() const
  * Normalizes the vector, i.e., scales it to have length 1.
  * If the length of the vector is zero, the function does nothing.
  */
-void Vec2D::vectorNormalize()
+void LegacyVec2D::vectorNormalize()
 {
 	double length = vectorLength();
 	if (length != 0)
@@ -357,14 +353,14 @@ void Vec2D::vectorNormalize()
  *
  * @return: A new instance of the vector normalized.
  */
-Vec2D Vec2D::vectorGetNormalized() const
+LegacyVec2D LegacyVec2D::vectorGetNormalized() const
 {
 	double length = vectorLength();
 	if (length != 0)
 	{
 		/// Normalize the vector if its length is non-zero
 		double inverseLength = 1 / length;
-		Vec2D normalVec = { x * inverseLength , y * inverseLength };
+		LegacyVec2D normalVec = { x * inverseLength , y * inverseLength };
 		return(normalVec);
 	}
 	else
@@ -381,7 +377,7 @@ Vec2D Vec2D::vectorGetNormalized() const
  * Calculates the distance between this vector and another vector.
  * The distance is calculated as the length of the difference between the two vectors.
  */
-double Vec2D::vectorDistance(const Vec2D& other)
+double LegacyVec2D::vectorDistance(const LegacyVec2D& other)
 {
 	/// Calculate the distance between the vectors
 	return(sqrt((x - other.x) * (x - other.x) + (y - other.y) * (y - other.y)));
@@ -395,7 +391,7 @@ double Vec2D::vectorDistance(const Vec2D& other)
  *
  * Sets the x and y components of the vector to the specified values.
  */
-void Vec2D::set(double _x, double _y)
+void LegacyVec2D::set(double _x, double _y)
 {
 	/// Assign the new values to the x and y components
 	x = _x;
@@ -404,7 +400,7 @@ void Vec2D::set(double _x, double _y)
 
 
 
-void Vec2D::reset()
+void LegacyVec2D::reset()
 {
 	/// Reset the x and y components to zero
 	x = 0;
@@ -419,56 +415,56 @@ void Vec2D::reset()
 
 
 /**
- * Vec3D
+ * LegacyVec3D
  *
- * Default constructor for the Vec3D class.
- * Initializes a new instance of the Vec3D class with all components (x, y, z) set to zero.
+ * Default constructor for the LegacyVec3D class.
+ * Initializes a new instance of the LegacyVec3D class with all components (x, y, z) set to zero.
  */
-Vec3D::Vec3D() : x(0), y(0), z(0)
+LegacyVec3D::LegacyVec3D() : x(0), y(0), z(0)
 {
 	// x, y, z are initialized to zero
 }
 
 
 /**
- * Vec3D
+ * LegacyVec3D
  *
- * Constructor with parameters for the Vec3D class.
- * Initializes a new instance of the Vec3D class with the specified components.
+ * Constructor with parameters for the LegacyVec3D class.
+ * Initializes a new instance of the LegacyVec3D class with the specified components.
  *
  * @param _x: The x component of the vector.
  * @param _y: The y component of the vector.
  * @param _z: The z component of the vector.
  */
-Vec3D::Vec3D(double _x, double _y, double _z) : x(_x), y(_y), z(_z)
+LegacyVec3D::LegacyVec3D(double _x, double _y, double _z) : x(_x), y(_y), z(_z)
 {
 	// x, y, z are assigned the values provided as parameters
 }
 
 
 /**
- * Vec3D
+ * LegacyVec3D
  *
- * Copy constructor for the Vec3D class.
- * Initializes a new instance of the Vec3D class, copying the components from another instance.
+ * Copy constructor for the LegacyVec3D class.
+ * Initializes a new instance of the LegacyVec3D class, copying the components from another instance.
  *
  * @param other: The instance to copy the components from.
  */
-Vec3D::Vec3D(const Vec3D &other) : x(other.x), y(other.y), z(other.z)
+LegacyVec3D::LegacyVec3D(const LegacyVec3D &other) : x(other.x), y(other.y), z(other.z)
 {
 	// x, y, z are copied from the other instance
 }
 
 
 /**
- * Vec3D
+ * LegacyVec3D
  *
- * Constructor with magnitude for the Vec3D class.
- * Initializes a new instance of the Vec3D class with a specified magnitude and a random direction.
+ * Constructor with magnitude for the LegacyVec3D class.
+ * Initializes a new instance of the LegacyVec3D class with a specified magnitude and a random direction.
  *
  * @param magnitude: The magnitude of the vector.
  */
-Vec3D::Vec3D(double magnitude)
+LegacyVec3D::LegacyVec3D(double magnitude)
 {
 	/// Generate a random direction
 	double theta = acos(3/sqrt(magnitude)*1);
@@ -481,12 +477,12 @@ Vec3D::Vec3D(double magnitude)
 
 
 /**
- * ~Vec3D
+ * ~LegacyVec3D
  *
- * Destructor for the Vec3D class.
- * Resets the components (x, y, z) of the Vec3D instance to zero.
+ * Destructor for the LegacyVec3D class.
+ * Resets the components (x, y, z) of the LegacyVec3D instance to zero.
  */
-Vec3D::~Vec3D()
+LegacyVec3D::~LegacyVec3D()
 {
 	// Reset the components to zero
 	x = 0;
@@ -498,13 +494,13 @@ Vec3D::~Vec3D()
 /**
  * operator!=
  *
- * Not-equal-to operator overload for the Vec3D class.
+ * Not-equal-to operator overload for the LegacyVec3D class.
  * Checks if this instance is not equal to another instance.
  *
  * @param other: The instance to compare with.
  * @return: true if the instances are not equal, false otherwise.
  */
-bool Vec3D::operator!=(const Vec3D& other)
+bool LegacyVec3D::operator!=(const LegacyVec3D& other)
 {
 	// Return true if any of the components are not equal, false otherwise
 	return(x != other.x || y != other.y || z != other.z);
@@ -514,13 +510,13 @@ bool Vec3D::operator!=(const Vec3D& other)
 /**
  * operator=
  *
- * Assignment operator overload for the Vec3D class.
+ * Assignment operator overload for the LegacyVec3D class.
  * Assigns the components of another instance to this instance.
  *
  * @param other: The instance to copy the components from.
  * @return: A reference to this instance.
  */
-Vec3D& Vec3D::operator=(const Vec3D& other)
+LegacyVec3D& LegacyVec3D::operator=(const LegacyVec3D& other)
 {
 	/// Check if the instances are not the same
 	if (this != &other)
@@ -539,76 +535,76 @@ Vec3D& Vec3D::operator=(const Vec3D& other)
 /**
  * operator+
  *
- * Addition operator overload for the Vec3D class.
+ * Addition operator overload for the LegacyVec3D class.
  * Adds the components of this instance and another instance.
  *
  * @param other: The instance to add the components from.
  * @return: A new instance with the added components.
  */
-Vec3D Vec3D::operator+(const Vec3D& other) const
+LegacyVec3D LegacyVec3D::operator+(const LegacyVec3D& other) const
 {
 	// Create a new instance with the added components and return it
-	return(Vec3D(x + other.x, y + other.y, z + other.z));
+	return(LegacyVec3D(x + other.x, y + other.y, z + other.z));
 }
 
 
 /**
  * operator-
  *
- * Subtraction operator overload for the Vec3D class.
+ * Subtraction operator overload for the LegacyVec3D class.
  * Subtracts the components of another instance from this instance.
  *
  * @param other: The instance to subtract the components from.
  * @return: A new instance with the subtracted components.
  */
-Vec3D Vec3D::operator-(const Vec3D& other) const
+LegacyVec3D LegacyVec3D::operator-(const LegacyVec3D& other) const
 {
 	// Create a new instance with the subtracted components and return it
-	return(Vec3D(x - other.x, y - other.y, z - other.z));
+	return(LegacyVec3D(x - other.x, y - other.y, z - other.z));
 }
 
 
 /**
  * operator*
  *
- * Multiplication operator overload for the Vec3D class.
+ * Multiplication operator overload for the LegacyVec3D class.
  * Multiplies the components of this instance by a scalar.
  *
  * @param scalar: The scalar to multiply the components by.
  * @return: A new instance with the multiplied components.
  */
-Vec3D Vec3D::operator*(const double scalar) const
+LegacyVec3D LegacyVec3D::operator*(const double scalar) const
 {
 	// Create a new instance with the multiplied components and return it
-	return(Vec3D(x * scalar, y * scalar, z * scalar));
+	return(LegacyVec3D(x * scalar, y * scalar, z * scalar));
 }
 
 
 /**
  * operator/
  *
- * Division operator overload for the Vec3D class.
+ * Division operator overload for the LegacyVec3D class.
  * Divides the components of this instance by a scalar.
  *
  * @param scalar: The scalar to divide the components by.
  * @return: A new instance with the divided components.
  */
-Vec3D Vec3D::operator/(const double scalar) const
+LegacyVec3D LegacyVec3D::operator/(const double scalar) const
 {
 	// Create a new instance with the divided components and return it
-	return(Vec3D(x / scalar, y / scalar, z / scalar));
+	return(LegacyVec3D(x / scalar, y / scalar, z / scalar));
 }
 
 
 /**
  * operator+=
  *
- * Addition-assignment operator overload for the Vec3D class.
+ * Addition-assignment operator overload for the LegacyVec3D class.
  * Adds the components of another instance to this instance.
  *
  * @param other: The instance to add the components from.
  */
-void Vec3D::operator+=(const Vec3D& other)
+void LegacyVec3D::operator+=(const LegacyVec3D& other)
 {
 	// Add the components
 	x = x + other.x;
@@ -620,12 +616,12 @@ void Vec3D::operator+=(const Vec3D& other)
 /**
  * operator-=
  *
- * Subtraction-assignment operator overload for the Vec3D class.
+ * Subtraction-assignment operator overload for the LegacyVec3D class.
  * Subtracts the components of another instance from this instance.
  *
  * @param other: The instance to subtract the components from.
  */
-void Vec3D::operator-=(const Vec3D& other)
+void LegacyVec3D::operator-=(const LegacyVec3D& other)
 {
 	// Subtract the components
 	x = x - other.x;
@@ -637,12 +633,12 @@ void Vec3D::operator-=(const Vec3D& other)
 /**
  * operator*=
  *
- * Multiplication-assignment operator overload for the Vec3D class.
+ * Multiplication-assignment operator overload for the LegacyVec3D class.
  * Multiplies the components of this instance by a scalar.
  *
  * @param scalar: The scalar to multiply the components by.
  */
-void Vec3D::operator*=(const double scalar)
+void LegacyVec3D::operator*=(const double scalar)
 {
 	// Multiply the components
 	x = x * scalar;
@@ -654,13 +650,13 @@ void Vec3D::operator*=(const double scalar)
 /**
  * operator/=
  *
- * Division-assignment operator overload for the Vec3D class.
+ * Division-assignment operator overload for the LegacyVec3D class.
  * Divides the components of this instance by a scalar.
  * If the scalar is zero, no operation is performed to avoid division by zero.
  *
  * @param scalar: The scalar to divide the components by.
  */
-void Vec3D::operator/=(const double scalar)
+void LegacyVec3D::operator/=(const double scalar)
 {
 	// Check if scalar is not zero to avoid division by zero
 	if (scalar != 0)
@@ -668,7 +664,7 @@ void Vec3D::operator/=(const double scalar)
 		/// Calculate the inverse of the scalar
 		double inverseScalar = 1 / scalar;
 		
-		/// Update the components of the Vec3D instance, each component is multiplied by the inverse of the scalar
+		/// Update the components of the LegacyVec3D instance, each component is multiplied by the inverse of the scalar
 		x = x * inverseScalar;
 		y = y * inverseScalar;
 		z = z * inverseScalar;
@@ -679,7 +675,7 @@ void Vec3D::operator/=(const double scalar)
 
 
 /**
- * Vec3D::scaleVector
+ * LegacyVec3D::scaleVector
  *
  * Returns a new vector that is a scaled version of this vector.
  * The scaling operates uniformly on all components.
@@ -687,23 +683,23 @@ void Vec3D::operator/=(const double scalar)
  * @param scalar: The factor by which to scale the vector.
  * @return: A new instance of the vector scaled.
  */
-Vec3D Vec3D::scaleVector(double scalar) const
+LegacyVec3D LegacyVec3D::scaleVector(double scalar) const
 {
 	// Create a new vector with components scaled by the scalar and return it
-	Vec3D scaledVector = { x * scalar, y * scalar ,z * scalar };
+	LegacyVec3D scaledVector = { x * scalar, y * scalar ,z * scalar };
 	return(scaledVector);
 }
 
 
 /**
- * Vec3D::vectorLength
+ * LegacyVec3D::vectorLength
  *
  * Computes the length (magnitude) of the vector.
  * The length is computed as the square root of the sum of the squares of the components.
  *
  * @return: The length of the vector.
  */
-double Vec3D::vectorLength() const
+double LegacyVec3D::vectorLength() const
 {
 	// Compute and return the length of the vector
 	return(sqrt(x * x + y * y + z * z));
@@ -711,14 +707,14 @@ double Vec3D::vectorLength() const
 
 
 /**
- * Vec3D::vectorSquareLength
+ * LegacyVec3D::vectorSquareLength
  *
  * Computes the square of the length (magnitude) of the vector.
  * The square of the length is computed as the sum of the squares of the components.
  *
  * @return: The square of the length of the vector.
  */
-double Vec3D::vectorSquareLength() const
+double LegacyVec3D::vectorSquareLength() const
 {
 	// Compute and return the square of the length of the vector
 	return(x * x + y * y + z * z);
@@ -726,12 +722,12 @@ double Vec3D::vectorSquareLength() const
 
 
 /**
- * Vec3D::vectorNormalize
+ * LegacyVec3D::vectorNormalize
  *
  * Normalizes the vector by dividing each component by the vector's length.
  * If the length of the vector is zero, no operation is performed.
  */
-void Vec3D::vectorNormalize()
+void LegacyVec3D::vectorNormalize()
 {
 	// Compute the length of the vector
 	double length = vectorLength();
@@ -756,7 +752,7 @@ void Vec3D::vectorNormalize()
 
 
 /**
- * Vec3D::vectorGetNormalized
+ * LegacyVec3D::vectorGetNormalized
  *
  * Returns a new vector that is a normalized version of this vector.
  * The returned vector has the same direction as this vector but a length of 1.
@@ -764,7 +760,7 @@ void Vec3D::vectorNormalize()
  *
  * @return: A new instance of the vector normalized.
  */
-Vec3D Vec3D::vectorGetNormalized() const
+LegacyVec3D LegacyVec3D::vectorGetNormalized() const
 {
 	// Compute the length of the vector
 	double length = vectorLength();
@@ -776,7 +772,7 @@ Vec3D Vec3D::vectorGetNormalized() const
 		double inverseLength = 1 / length;
 		
 		// Create a new vector with components scaled by the inverse of the length and return it
-		Vec3D normalVec = { x * inverseLength , y * inverseLength , z * inverseLength };
+		LegacyVec3D normalVec = { x * inverseLength , y * inverseLength , z * inverseLength };
 		return(normalVec);
 	}
 	else
@@ -788,7 +784,7 @@ Vec3D Vec3D::vectorGetNormalized() const
 
 
 /**
- * Vec3D::vectorDistance
+ * LegacyVec3D::vectorDistance
  *
  * Computes the Euclidean distance between this vector and another vector.
  * The distance is computed as the length of the difference between the two vectors.
@@ -796,7 +792,7 @@ Vec3D Vec3D::vectorGetNormalized() const
  * @param other: The other vector to compute the distance to.
  * @return: The distance between the vectors.
  */
-double Vec3D::vectorDistance(const Vec3D& other)
+double LegacyVec3D::vectorDistance(const LegacyVec3D& other)
 {
 	/// Compute and return the distance between the vectors
 	// The distance is the square root of the sum of the squared differences of the components
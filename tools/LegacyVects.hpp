@@ -0,0 +1,149 @@
+//  LegacyVects.hpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Legacy Vects header file keeps the out-of-line Vec2D and Vec3D (user-provided copy constructors,
+ * assignment operators and destructors, every operator defined in LegacyVects.cpp) under the names
+ * LegacyVec2D and LegacyVec3D, as the baseline of tools/VectsBenchmark.cpp. Nothing else uses them.
+ */
+/**
+ * LegacyVec2D and LegacyVec3D Classes: Provide an abstraction for two-dimensional and three-dimensional Euclidean vectors, encapsulating the vector's components (x, y) and (x, y, z) respectively
+ *
+ * These classes encapsulates a vector's components and provide methods
+ * to perform basic vector operations and manipulate vector data.
+ */
+
+
+#pragma once
+#include <math.h>
+
+
+
+
+
+
+/// LegacyVec2D class representing a 2D Vector
+class LegacyVec2D
+{
+public:
+	/// @section Constructors and Destructor
+	LegacyVec2D(); // Default constructor
+	LegacyVec2D(double _x, double _y); // Construct with provided x and y values
+	LegacyVec2D(const LegacyVec2D &other); // Construct by copying another LegacyVec2D object
+	LegacyVec2D(double magnitude); // Construct with provided magnitude
+	~LegacyVec2D(); // Destructor
+	
+	
+	
+	/// @section Comparison operators
+	bool operator!=(const LegacyVec2D& other); // Checks inequality with another LegacyVec2D object
+	
+	
+	
+	/// @section Accessor operators (Return new LegacyVec2D based on current one)
+	LegacyVec2D operator+(const LegacyVec2D& other) const; // Adds this vector with another
+	LegacyVec2D operator-(const LegacyVec2D& other) const; // Subtracts another vector from this vector
+	LegacyVec2D operator*(const double scalar) const; // Multiplies this vector by a scalar
+	LegacyVec2D operator/(const double scalar) const; // Divides this vector by a scalar
+	
+	
+	
+	/// @section Modifier operators (Modify the current LegacyVec2D and return reference)
+	LegacyVec2D& operator=(const LegacyVec2D& other); // Assigns this vector the values of another
+	void operator+=(const LegacyVec2D& other); // Adds another vector to this vector and assigns the result to this vector
+	void operator-=(const LegacyVec2D& other); // Subtracts another vector from this vector and assigns the result to this vector
+	void operator*=(const double scalar); // Multiplies this vector by a scalar and assigns the result to this vector
+	void operator/=(const double scalar); // Divides this vector by a scalar and assigns the result to this vector
+	
+	
+	
+	
+	/// @section Vector operations
+	LegacyVec2D scaleVector(double scalar) const; // Returns a new vector that is this vector scaled by a scalar
+	double vectorLength() const; // Returns the length of this vector
+	double vectorSquareLength() const; // Returns the square of the length of this vector
+	void vectorNormalize(); // Normalizes this vector
+	LegacyVec2D vectorGetNormalized() const; // Returns a new vector that is a normalized version of this vector
+	double vectorDistance(const LegacyVec2D& other); // Returns the distance between this vector and another vector
+	void set(double _x, double _y); // Sets the x and y values of this vector
+	void reset(); // Resets this vector to the zero vector
+	
+	
+	/// @section Member variables
+	double x; // The x component of this vector
+	double y; // The y component of this vector
+};
+
+
+
+
+
+
+
+
+/// LegacyVec3D class representing a 3D Vector
+class LegacyVec3D
+{
+public:
+	/// @section Constructors and Destructor
+	LegacyVec3D(); // Default constructor
+	LegacyVec3D(double _x, double _y, double _z); // Construct with provided x, y, and z values
+	LegacyVec3D(const LegacyVec3D &other); // Construct by copying another LegacyVec3D object
+	LegacyVec3D(double magnitude); // Construct with provided magnitude
+	~LegacyVec3D(); // Destructor
+	
+	
+	
+	/// @section Comparison operators
+	bool operator!=(const LegacyVec3D& other); // Checks inequality with another LegacyVec3D object
+	
+	
+	
+	/// @section Accessor operators (Return new LegacyVec2D based on current one)
+	LegacyVec3D operator+(const LegacyVec3D& other) const; // Adds this vector with another
+	LegacyVec3D operator-(const LegacyVec3D& other) const; // Subtracts another vector from this vector
+	LegacyVec3D operator*(const double scalar) const; // Multiplies this vector by a scalar
+	LegacyVec3D operator/(const double scalar) const; // Divides this vector by a scalar
+	
+	
+	
+	/// @section Modifier operators  (Modify the current LegacyVec3D and return reference)
+	LegacyVec3D& operator=(const LegacyVec3D& other); // Assigns this vector the values of another
+	void operator+=(const LegacyVec3D& other); // Adds another vector to this vector and assigns the result to this vector
+	void operator-=(const LegacyVec3D& other); // Subtracts another vector from this vector and assigns the result to this vector
+	void operator*=(const double scalar); // Multiplies this vector by a scalar and assigns the result to this vector
+	void operator/=(const double scalar); // Divides this vector by a scalar and assigns the result to this vector
+	
+	
+	
+	/// @section Vector operations
+	LegacyVec3D scaleVector(double scalar) const; // Returns a new vector that is this vector scaled by a scalar
+	double vectorLength() const; // Returns the length of this vector
+	double vectorSquareLength() const; // Returns the square of the length of this vector
+	void vectorNormalize(); // Normalizes this vector
+	LegacyVec3D vectorGetNormalized() const; // Returns a new vector that is a normalized version of this vector
+	double vectorDistance(const LegacyVec3D& other); // Returns the distance between this vector and another vector
+	void set(double _x, double _y, double _z); // Sets the x, y, and z values of this vector
+	
+	
+	
+	/// @section Member variables
+	double x; // The x component of this vector
+	double y; // The y component of this vector
+	double z; // The z component of this vector
+};
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
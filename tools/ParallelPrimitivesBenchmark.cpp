@@ -0,0 +1,218 @@
+//  ParallelPrimitivesBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Parallel Primitives Benchmark, a command-line tool that checks the radix sort and the scans and times
+ * them against the standard library.
+ *
+ * Usage:
+ *   ParallelPrimitivesBenchmark [largest]
+ *
+ * For 1, 10 and 100 million elements (up to 'largest', default 100 million):
+ *   1. radixSort of random 32-bit keys, random 64-bit keys and 62-bit Hilbert keys, each with their indices
+ *      as payload. The keys must come out ascending, every payload must point at its key, and equal keys
+ *      must keep their order. Up to ten million keys, std::sort and std::stable_sort of (key, index) pairs
+ *      are timed for comparison (they need twice the memory of the radix sort).
+ *   2. inclusiveScan of 64-bit integers against std::inclusive_scan, which must match exactly, and
+ *      exclusiveScan of doubles, which must give the same bits on pools of 1 to 4 workers.
+ * Build it from the repository root with optimizations, e.g.:
+ *
+ *   c++ -std=c++17 -O3 -pthread -I"Math Utilities" tools/ParallelPrimitivesBenchmark.cpp "Math Utilities/ParallelPrimitives.cpp" "Math Utilities/SpaceFillingCurves.cpp" "Math Utilities/Geometry.cpp" "Math Utilities/RandomVectors.cpp" "Math Utilities/VectorArrays.cpp" "Math Utilities/VectorArraysAVX2.cpp" "Math Utilities/WorkerPool.cpp" -o ParallelPrimitivesBenchmark
+ */
+
+
+#include "ParallelPrimitives.hpp"
+#include "SpaceFillingCurves.hpp"
+#include "RandomVectors.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	/// Times a pass that first restores its input with 'reset' (untimed), returning the fastest of 'repetitions' runs in nanoseconds per element.
+	double measure(int repetitions, double elements, const std::function<void()> &reset, const std::function<void()> &pass)
+	{
+		double fastest = 0;
+		for (int repetition = 0; repetition < repetitions; repetition++)
+		{
+			reset();
+			auto begin = std::chrono::steady_clock::now();
+			pass();
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / elements;
+			if (repetition == 0 || nanoseconds < fastest)
+			{
+				fastest = nanoseconds;
+			}
+		}
+		return fastest;
+	}
+
+
+	/// A well mixed 64-bit value of a counter (SplitMix64).
+	uint64_t mix(uint64_t x)
+	{
+		x += 0x9E3779B97F4A7C15ull;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return x ^ (x >> 31);
+	}
+
+
+	/// Whether 'keys' and 'payload' are the stable sort of 'original' with the identity as payload.
+	template<typename Key>
+	bool stablySorted(const std::vector<Key> &original, const std::vector<Key> &keys, const std::vector<uint32_t> &payload)
+	{
+		if (keys.size() != original.size() || payload.size() != original.size())
+		{
+			return false;
+		}
+		for (std::size_t k = 0; k < keys.size(); k++)
+		{
+			if (payload[k] >= original.size() || keys[k] != original[payload[k]])
+			{
+				return false;
+			}
+			if (k > 0 && (keys[k - 1] > keys[k] || (keys[k - 1] == keys[k] && payload[k - 1] >= payload[k])))
+			{
+				return false;
+			}
+		}
+		return true; // Ascending pairs of distinct indices that all point at their keys: a permutation
+	}
+
+
+	/// Sorts the keys with their indices as payload, checks the result and prints its time next to the standard library's.
+	template<typename Key>
+	bool benchmarkSort(const char *name, const std::vector<Key> &original)
+	{
+		const int repetitions = 3;
+		std::size_t count = original.size();
+		std::vector<Key> keys;
+		std::vector<uint32_t> payload;
+		auto reset = [&]()
+		{
+			keys = original;
+			payload.resize(count);
+			std::iota(payload.begin(), payload.end(), 0u);
+		};
+		double radix = measure(repetitions, count, reset, [&]() { radixSort(keys, payload); });
+		bool pass = stablySorted(original, keys, payload);
+
+		std::printf("%-18s %10.2f", name, radix);
+		if (count <= 10000000)
+		{
+			std::vector<std::pair<Key, uint32_t>> pairs;
+			auto resetPairs = [&]()
+			{
+				pairs.resize(count);
+				for (std::size_t i = 0; i < count; i++)
+				{
+					pairs[i] = {original[i], static_cast<uint32_t>(i)};
+				}
+			};
+			auto byKey = [](const std::pair<Key, uint32_t> &a, const std::pair<Key, uint32_t> &b) { return a.first < b.first; };
+			double sort = measure(repetitions, count, resetPairs, [&]() { std::sort(pairs.begin(), pairs.end(), byKey); });
+			double stable = measure(repetitions, count, resetPairs, [&]() { std::stable_sort(pairs.begin(), pairs.end(), byKey); });
+			std::printf(" %12.2f %14.2f %9.1fx", sort, stable, stable / radix);
+		}
+		else
+		{
+			std::printf(" %12s %14s %10s", "-", "-", "-");
+		}
+		std::printf("%s\n", pass ? "" : "   NOT SORTED");
+		return pass;
+	}
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	std::size_t largest = argc > 1 ? std::max<long long>(1, std::atoll(argv[1])) : 100000000;
+	bool pass = true;
+	std::printf("%zu threads, times in ns/element\n", WorkerPool::global().threadCount() + 1);
+
+	for (std::size_t count = 1000000; count <= largest; count *= 10)
+	{
+		/// Step 1: Sorts of random and spatial keys
+		std::printf("\n%zu elements\n%-18s %10s %12s %14s %10s\n", count, "sort", "radixSort", "std::sort", "stable_sort", "speedup");
+		{
+			std::vector<uint32_t> keys32(count);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				keys32[i] = static_cast<uint32_t>(mix(i));
+			}
+			pass = benchmarkSort("32-bit random", keys32) && pass;
+		}
+		{
+			std::vector<uint64_t> keys64(count);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				keys64[i] = mix(i);
+			}
+			pass = benchmarkSort("64-bit random", keys64) && pass;
+		}
+		{
+			Vec2DArray positions;
+			randomGaussian(positions, count, CounterRng(2024));
+			std::vector<uint64_t> hilbert;
+			spatialKeys(positions, boundingSquare(positions), SpaceFillingCurve::Hilbert, hilbert);
+			pass = benchmarkSort("64-bit Hilbert", hilbert) && pass;
+		}
+
+
+		/// Step 2: Scans
+		std::printf("%-18s %10s %12s\n", "scan", "parallel", "std");
+		{
+			std::vector<uint64_t> values(count), scanned, reference(count);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				values[i] = mix(i) >> 40;
+			}
+			double parallel = measure(3, count, [&]() { scanned = values; }, [&]() { inclusiveScan(scanned); });
+			double standard = measure(3, count, []() {}, [&]() { std::inclusive_scan(values.begin(), values.end(), reference.begin()); });
+			bool same = scanned == reference;
+			pass = pass && same;
+			std::printf("%-18s %10.2f %12.2f%s\n", "inclusive uint64", parallel, standard, same ? "" : "   SCAN DIFFERS");
+		}
+		{
+			std::vector<double> values(count), scanned(count), other(count);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				values[i] = static_cast<double>(mix(i) >> 11) * 0x1.0p-53 - 0.5;
+			}
+			double parallel = measure(3, count, []() {}, [&]() { exclusiveScan(values.data(), scanned.data(), count); });
+			double total = 0, standard = measure(3, count, []() {}, [&]() { total = *(std::exclusive_scan(values.begin(), values.end(), other.begin(), 0.0) - 1) + values.back(); });
+			bool same = true;
+			for (std::size_t workers = 1; workers <= 4; workers++)
+			{
+				WorkerPool pool(workers);
+				exclusiveScan(values.data(), other.data(), count, pool);
+				same = same && std::memcmp(other.data(), scanned.data(), count * sizeof(double)) == 0;
+			}
+			pass = pass && same;
+			std::printf("%-18s %10.2f %12.2f%s   (total %+.6f)\n", "exclusive double", parallel, standard, same ? "" : "   POOLS DIFFER", total);
+		}
+	}
+
+	if (!pass)
+	{
+		std::printf("\nParallel primitives FAILED.\n");
+		return 1;
+	}
+	std::printf("\nAll parallel primitives pass.\n");
+	return 0;
+}
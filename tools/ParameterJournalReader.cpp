@@ -0,0 +1,226 @@
+//  ParameterJournalReader.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Parameter Journal Reader, a command-line tool that decodes a journal written by ParameterJournal.
+ *
+ * Usage:
+ *   ParameterJournalReader <journal file> [--csv] [--parameter <name>] [--last <count>]
+ *
+ *   --csv               Prints comma-separated values (time, elapsed, parameter, type, old, new) instead of a table
+ *   --parameter <name>  Only prints the changes of one parameter
+ *   --last <count>      Only prints the most recent <count> records
+ *
+ * The file is mapped read-only, so a journal can be decoded while the application is still writing
+ * it; records that are being written at that moment are skipped. The tool does not depend on
+ * openFrameworks, build it from the repository root with:
+ *
+ *   c++ -std=c++17 -I"Math Utilities/Interface Elements" tools/ParameterJournalReader.cpp \
+ *       "Math Utilities/Interface Elements/ParameterStore.cpp" -o ParameterJournalReader
+ */
+
+
+#include "ParameterJournal.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+
+
+
+
+/**
+ * typeName
+ * Returns the printable name of a parameter type.
+ */
+static const char *typeName(uint8_t type)
+{
+	switch (static_cast<ParameterType>(type))
+	{
+		case ParameterType::Float:
+			return "float";
+		case ParameterType::Double:
+			return "double";
+		case ParameterType::Int64:
+			return "int64";
+		case ParameterType::Bool:
+			return "bool";
+	}
+	return "unknown";
+}
+
+
+/**
+ * formatTime
+ * Formats microseconds since the Unix epoch as local time with microsecond resolution.
+ *
+ * @param micros: The time to format
+ * @param buffer: The output buffer
+ * @param size: The size of the output buffer
+ */
+static void formatTime(uint64_t micros, char *buffer, std::size_t size)
+{
+	std::time_t seconds = static_cast<std::time_t>(micros / 1000000);
+	std::tm local;
+	localtime_r(&seconds, &local);
+	std::size_t length = std::strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &local);
+	std::snprintf(buffer + length, size - length, ".%06llu", static_cast<unsigned long long>(micros % 1000000));
+}
+
+
+/**
+ * printUsage
+ * Prints the command line syntax.
+ */
+static void printUsage(const char *program)
+{
+	std::fprintf(stderr, "Usage: %s <journal file> [--csv] [--parameter <name>] [--last <count>]\n", program);
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	/// Step 1: Parse the command line
+	if (argc < 2)
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+	const char *path = argv[1];
+	bool csv = false;
+	const char *onlyParameter = nullptr;
+	uint64_t last = 0;
+	for (int i = 2; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--csv") == 0)
+		{
+			csv = true;
+		}
+		else if (std::strcmp(argv[i], "--parameter") == 0 && i + 1 < argc)
+		{
+			onlyParameter = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--last") == 0 && i + 1 < argc)
+		{
+			last = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+
+	/// Step 2: Map the file and validate its header
+	int fd = open(path, O_RDONLY);
+	struct stat fileStatus;
+	if (fd < 0 || fstat(fd, &fileStatus) != 0 || static_cast<std::size_t>(fileStatus.st_size) < sizeof(JournalHeader))
+	{
+		std::fprintf(stderr, "%s: cannot read a journal header from %s\n", argv[0], path);
+		return 1;
+	}
+	std::size_t size = static_cast<std::size_t>(fileStatus.st_size);
+	void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+	{
+		std::fprintf(stderr, "%s: cannot map %s\n", argv[0], path);
+		return 1;
+	}
+
+	const JournalHeader *header = static_cast<const JournalHeader*>(mapping);
+	if (std::memcmp(header->magic, "PJOURNL1", 8) != 0 || header->formatVersion != ParameterJournal::FORMAT_VERSION || header->recordSize != sizeof(JournalRecord) || size != ParameterJournal::fileSize(header->capacity))
+	{
+		std::fprintf(stderr, "%s: %s is not a parameter journal of format version %u\n", argv[0], path, ParameterJournal::FORMAT_VERSION);
+		munmap(mapping, size);
+		return 1;
+	}
+	const JournalParameterName *names = reinterpret_cast<const JournalParameterName*>(static_cast<const char*>(mapping) + sizeof(JournalHeader));
+	const JournalRecord *records = reinterpret_cast<const JournalRecord*>(names + ParameterJournal::MAX_PARAMETERS);
+
+
+	/// Step 3: Determine which records are still in the ring
+	uint64_t written = header->writeIndex.load(std::memory_order_acquire);
+	uint64_t oldest = written > header->capacity ? written - header->capacity : 0; // Older records have been overwritten
+	uint64_t first = oldest;
+	if (last > 0 && written - first > last)
+	{
+		first = written - last;
+	}
+	if (!csv)
+	{
+		std::printf("%s: %llu records written, %llu kept (capacity %llu)\n", path, static_cast<unsigned long long>(written), static_cast<unsigned long long>(written - oldest), static_cast<unsigned long long>(header->capacity));
+	}
+	else
+	{
+		std::printf("time,elapsed_seconds,parameter,type,old,new\n");
+	}
+
+
+	/// Step 4: Decode the records, oldest first
+	uint64_t skipped = 0;
+	for (uint64_t index = first; index < written; index++)
+	{
+		const JournalRecord &slot = records[index % header->capacity];
+		if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+		{
+			skipped++; // Being written, or already overwritten by a newer record
+			continue;
+		}
+		JournalRecord record;
+		record.timestampMicros = slot.timestampMicros;
+		record.oldWord = slot.oldWord;
+		record.newWord = slot.newWord;
+		record.parameter = slot.parameter;
+		record.type = slot.type;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) != index + 1)
+		{
+			skipped++; // Overwritten while it was being copied
+			continue;
+		}
+
+		char name[64];
+		if (record.parameter < ParameterJournal::MAX_PARAMETERS && names[record.parameter].name[0] != 0)
+		{
+			std::snprintf(name, sizeof(name), "%.46s", names[record.parameter].name);
+		}
+		else
+		{
+			std::snprintf(name, sizeof(name), "#%u", record.parameter);
+		}
+		if (onlyParameter && std::strcmp(name, onlyParameter) != 0)
+		{
+			continue;
+		}
+
+		char time[48];
+		formatTime(header->epochMicros + record.timestampMicros, time, sizeof(time));
+		ParameterType type = static_cast<ParameterType>(record.type);
+		double oldValue = parameterAsDouble(type, record.oldWord), newValue = parameterAsDouble(type, record.newWord);
+		if (csv)
+		{
+			std::printf("%s,%.6f,%s,%s,%.17g,%.17g\n", time, record.timestampMicros * 1e-6, name, typeName(record.type), oldValue, newValue);
+		}
+		else
+		{
+			std::printf("%s  %-20s %-6s %.9g -> %.9g\n", time, name, typeName(record.type), oldValue, newValue);
+		}
+	}
+
+	if (skipped > 0)
+	{
+		std::fprintf(stderr, "%llu records were being written and were skipped\n", static_cast<unsigned long long>(skipped));
+	}
+	munmap(mapping, size);
+	return 0;
+}
@@ -0,0 +1,190 @@
+//  PrecisionBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Precision Benchmark, a command-line tool that runs the same vector kernels on Vec3F and Vec3D and
+ * reports what float buys and what it costs: the time per element of each precision, and the error of
+ * the float results against the double ones.
+ *
+ * Usage:
+ *   PrecisionBenchmark [repetitions]
+ *
+ * Every kernel is one template over the scalar type and runs 'repetitions' times (default 7); the
+ * fastest run is reported. The tool exits with a non-zero status if the float forces stray further
+ * from the double ones than visualization needs (1e-4 relative). Build it from the repository root
+ * with optimizations, e.g.:
+ *
+ *   c++ -std=c++17 -O2 -I"Math Utilities" tools/PrecisionBenchmark.cpp "Math Utilities/Geometry.cpp" -o PrecisionBenchmark
+ */
+
+
+#include "Geometry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	/// Times a kernel, returning the fastest of 'repetitions' runs in nanoseconds per element.
+	double measure(int repetitions, double elements, const std::function<void()> &kernel)
+	{
+		double fastest = 0;
+		for (int repetition = 0; repetition < repetitions; repetition++)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			kernel();
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / elements;
+			if (repetition == 0 || nanoseconds < fastest)
+			{
+				fastest = nanoseconds;
+			}
+		}
+		return fastest;
+	}
+
+
+	/// The same random vectors in both precisions, so that the float run only differs by rounding.
+	template<typename Scalar>
+	std::vector<Vec3<Scalar>> randomVectors(std::size_t count, uint32_t seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<double> unit(-1.0, 1.0);
+		std::vector<Vec3<Scalar>> vectors;
+		vectors.reserve(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			double x = unit(generator), y = unit(generator), z = unit(generator);
+			vectors.push_back(Vec3<Scalar>(Vec3D(x, y, z)));
+		}
+		return vectors;
+	}
+
+
+
+
+	/// ------------- Kernels, identical for both precisions -------------
+	/// \{
+	template<typename Scalar>
+	void directForces(const std::vector<Vec3<Scalar>> &positions, std::vector<Vec3<Scalar>> &accelerations, Scalar softening2)
+	{
+		for (std::size_t i = 0; i < positions.size(); i++)
+		{
+			Vec3<Scalar> acceleration;
+			for (std::size_t j = 0; j < positions.size(); j++)
+			{
+				Vec3<Scalar> difference = positions[j] - positions[i];
+				Scalar r2 = difference.vectorSquareLength() + softening2;
+				acceleration += difference * (1 / (r2 * std::sqrt(r2)));
+			}
+			accelerations[i] = acceleration;
+		}
+	}
+
+
+	template<typename Scalar>
+	void integrate(std::vector<Vec3<Scalar>> &positions, std::vector<Vec3<Scalar>> &velocities, const std::vector<Vec3<Scalar>> &accelerations, Scalar dt)
+	{
+		for (std::size_t i = 0; i < positions.size(); i++) // Leapfrog drift and kick
+		{
+			velocities[i] += accelerations[i] * dt;
+			positions[i] += velocities[i] * dt;
+		}
+	}
+
+
+	template<typename Scalar>
+	std::size_t countInside(const std::vector<Vec3<Scalar>> &points, const BasicSphere<Scalar> &sphere)
+	{
+		std::size_t inside = 0;
+		for (const Vec3<Scalar> &point : points)
+		{
+			inside += sphere.containsPoint(point);
+		}
+		return inside;
+	}
+	/// \}
+
+
+
+
+	void report(const char *name, double doubleTime, double floatTime, const char *accuracy)
+	{
+		std::printf("%-26s %10.3f %10.3f %8.2fx   %s\n", name, doubleTime, floatTime, doubleTime / floatTime, accuracy);
+	}
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	int repetitions = argc > 1 ? std::max(1, std::atoi(argv[1])) : 7;
+	const std::size_t streamCount = 1 << 20, bodyCount = 4096;
+	bool pass = true;
+	char accuracy[96];
+	std::printf("%-26s %10s %10s %9s   %s\n", "kernel (ns/element)", "double", "float", "speedup", "float vs double");
+
+
+	/// Step 1: Direct-sum forces, the error is relative to the largest double acceleration
+	{
+		auto positions = randomVectors<double>(bodyCount, 1);
+		auto positionsF = randomVectors<float>(bodyCount, 1);
+		std::vector<Vec3D> accelerations(bodyCount);
+		std::vector<Vec3F> accelerationsF(bodyCount);
+		double pairs = double(bodyCount) * bodyCount;
+		double doubleTime = measure(repetitions, pairs, [&]() { directForces(positions, accelerations, 1e-2); });
+		double floatTime = measure(repetitions, pairs, [&]() { directForces(positionsF, accelerationsF, 1e-2f); });
+
+		double largest = 0, worst = 0;
+		for (std::size_t i = 0; i < bodyCount; i++)
+		{
+			largest = std::max(largest, accelerations[i].vectorLength());
+			worst = std::max(worst, (Vec3D(accelerationsF[i]) - accelerations[i]).vectorLength());
+		}
+		std::snprintf(accuracy, sizeof(accuracy), "max error %.1e relative", worst / largest);
+		pass = pass && worst / largest < 1e-4;
+		report("3D direct-sum pair", doubleTime, floatTime, accuracy);
+	}
+
+
+	/// Step 2: Integration of a particle set, memory-bound, so float halves the traffic
+	{
+		auto positions = randomVectors<double>(streamCount, 2), velocities = randomVectors<double>(streamCount, 3), accelerations = randomVectors<double>(streamCount, 4);
+		auto positionsF = randomVectors<float>(streamCount, 2), velocitiesF = randomVectors<float>(streamCount, 3), accelerationsF = randomVectors<float>(streamCount, 4);
+		double doubleTime = measure(repetitions, streamCount, [&]() { integrate(positions, velocities, accelerations, 1e-3); });
+		double floatTime = measure(repetitions, streamCount, [&]() { integrate(positionsF, velocitiesF, accelerationsF, 1e-3f); });
+		std::snprintf(accuracy, sizeof(accuracy), "%zu vs %zu bytes per body", 3 * sizeof(Vec3D), 3 * sizeof(Vec3F));
+		report("3D leapfrog integrate", doubleTime, floatTime, accuracy);
+	}
+
+
+	/// Step 3: Containment, the counts may only differ for points within rounding of the surface
+	{
+		auto points = randomVectors<double>(streamCount, 5);
+		auto pointsF = randomVectors<float>(streamCount, 5);
+		Sphere sphere(Vec3D(0.1, 0.2, 0.3), 0.7);
+		SphereF sphereF(sphere);
+		std::size_t inside = 0, insideF = 0;
+		double doubleTime = measure(repetitions, streamCount, [&]() { inside = countInside(points, sphere); });
+		double floatTime = measure(repetitions, streamCount, [&]() { insideF = countInside(pointsF, sphereF); });
+		std::snprintf(accuracy, sizeof(accuracy), "%zu vs %zu inside", inside, insideF);
+		pass = pass && (inside > insideF ? inside - insideF : insideF - inside) <= 16;
+		report("3D sphere containment", doubleTime, floatTime, accuracy);
+	}
+
+	if (!pass)
+	{
+		std::printf("Float results are outside tolerance.\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,198 @@
+//  RandomVectorsBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Random Vectors Benchmark, a command-line tool that times the RandomVectors generators on a large scene
+ * and checks them.
+ *
+ * Usage:
+ *   RandomVectorsBenchmark [count]
+ *
+ * Every generator fills 'count' vectors (default ten million) once; the time is reported with the
+ * statistics the distribution must have (mean radius on the circle/sphere, variance of the Gaussian,
+ * mean square radius of the disk, half-mass radius and virial ratio of the Plummer sphere, the latter
+ * estimated from a subsample). Each scene is then generated again in two pieces split at an odd element,
+ * which must give the same vectors bitwise. Build it from the repository root with optimizations, e.g.:
+ *
+ *   c++ -std=c++17 -O2 -pthread -I"Math Utilities" tools/RandomVectorsBenchmark.cpp "Math Utilities/RandomVectors.cpp" "Math Utilities/VectorArrays.cpp" "Math Utilities/VectorArraysAVX2.cpp" "Math Utilities/WorkerPool.cpp" -o RandomVectorsBenchmark
+ */
+
+
+#include "RandomVectors.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	double seconds(const std::function<void()> &pass)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		pass();
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	}
+
+
+	template<int Dimensions>
+	double squareLength(const VectorArray<Dimensions> &array, std::size_t i)
+	{
+		double sum = 0;
+		for (int d = 0; d < Dimensions; d++)
+		{
+			sum += array.component(d)[i] * array.component(d)[i];
+		}
+		return sum;
+	}
+
+
+	/// Whether 'whole' equals 'first' followed by 'second', bitwise.
+	template<int Dimensions>
+	bool samePieces(const VectorArray<Dimensions> &whole, const VectorArray<Dimensions> &first, const VectorArray<Dimensions> &second)
+	{
+		for (int d = 0; d < Dimensions; d++)
+		{
+			if (std::memcmp(whole.component(d), first.component(d), first.size() * sizeof(double)) != 0 || std::memcmp(whole.component(d) + first.size(), second.component(d), second.size() * sizeof(double)) != 0)
+			{
+				return false;
+			}
+		}
+		return whole.size() == first.size() + second.size();
+	}
+
+
+	/**
+	 * virialRatio
+	 * 2K / |W| of a Plummer sample (1 in equilibrium), with the potential energy from a direct sum over a
+	 * subsample of bodies, scaled up to all of them.
+	 */
+	double virialRatio(const Vec3DArray &positions, const Vec3DArray &velocities, double totalMass, double G, std::size_t subsample)
+	{
+		std::size_t stride = std::max<std::size_t>(1, positions.size() / subsample);
+		double mass = totalMass / positions.size(), kinetic = 0, potential = 0, sampleMass = 0;
+		for (std::size_t i = 0; i < positions.size(); i += stride)
+		{
+			kinetic += 0.5 * squareLength(velocities, i);
+			for (std::size_t j = i + stride; j < positions.size(); j += stride)
+			{
+				potential -= 1 / (positions.get(i) - positions.get(j)).vectorLength();
+			}
+			sampleMass += 1;
+		}
+		double sampleBodyMass = totalMass / sampleMass; // The subsample stands in for the whole sphere
+		kinetic *= mass * positions.size() / sampleMass;
+		potential *= G * sampleBodyMass * sampleBodyMass;
+		return 2 * kinetic / std::fabs(potential);
+	}
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	std::size_t count = argc > 1 ? std::max(1000, std::atoi(argv[1])) : 10000000;
+	std::size_t split = count / 3 + 1;
+	CounterRng rng(2024);
+	bool allPassed = true;
+	std::printf("%zu vectors on %zu threads\n", count, WorkerPool::global().threadCount() + 1);
+	std::printf("%-22s %10s   %-40s %s\n", "distribution", "seconds", "statistic (expected)", "pieces");
+
+
+	/// Step 1: Directions on the circle and sphere of radius 2
+	{
+		Vec2DArray circle, first, second;
+		Vec3DArray sphere, first3, second3;
+		double time2 = seconds([&]() { randomDirections(circle, count, rng, 2.0); });
+		double time3 = seconds([&]() { randomDirections(sphere, count, rng, 2.0); });
+		double worst = 0, meanZ = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			worst = std::max({worst, std::fabs(std::sqrt(squareLength(circle, i)) - 2), std::fabs(std::sqrt(squareLength(sphere, i)) - 2)});
+			meanZ += sphere.z()[i] / count;
+		}
+		randomDirections(first, split, rng, 2.0);
+		randomDirections(second, count - split, rng, 2.0, split);
+		randomDirections(first3, split, rng, 2.0);
+		randomDirections(second3, count - split, rng, 2.0, split);
+		bool pieces = samePieces(circle, first, second) && samePieces(sphere, first3, second3);
+		bool passed = pieces && worst < 1e-12 && std::fabs(meanZ) < 5.0 / std::sqrt(count);
+		allPassed &= passed;
+		std::printf("%-22s %10.3f   |r| - 2 <= %.1e, mean z %+.1e (0)       %s\n", "circle + sphere", time2 + time3, worst, meanZ, pieces ? "equal" : "DIFFERENT");
+	}
+
+
+	/// Step 2: Gaussian components with sigma 3
+	{
+		Vec3DArray gaussian, first, second;
+		double time = seconds([&]() { randomGaussian(gaussian, count, rng.split(1), 3.0); });
+		double mean = 0, variance = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			for (int d = 0; d < 3; d++)
+			{
+				mean += gaussian.component(d)[i];
+				variance += gaussian.component(d)[i] * gaussian.component(d)[i];
+			}
+		}
+		mean /= 3.0 * count;
+		variance = variance / (3.0 * count) - mean * mean;
+		randomGaussian(first, split, rng.split(1), 3.0);
+		randomGaussian(second, count - split, rng.split(1), 3.0, split);
+		bool pieces = samePieces(gaussian, first, second);
+		bool passed = pieces && std::fabs(variance - 9) < 50.0 / std::sqrt(count) && std::fabs(mean) < 20.0 / std::sqrt(count);
+		allPassed &= passed;
+		std::printf("%-22s %10.3f   variance %.4f (9), mean %+.1e (0)    %s\n", "gaussian 3D", time, variance, mean, pieces ? "equal" : "DIFFERENT");
+	}
+
+
+	/// Step 3: Uniform disk of radius 10, mean square radius R^2 / 2
+	{
+		Vec2DArray positions, velocities, first, second, firstVelocities, secondVelocities;
+		double time = seconds([&]() { randomDisk(positions, velocities, count, rng.split(2), 10.0, 1.0, 1.0); });
+		double meanSquare = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			meanSquare += squareLength(positions, i) / count;
+		}
+		randomDisk(first, firstVelocities, split, rng.split(2), 10.0, 1.0, 1.0);
+		randomDisk(second, secondVelocities, count - split, rng.split(2), 10.0, 1.0, 1.0, split);
+		bool pieces = samePieces(positions, first, second) && samePieces(velocities, firstVelocities, secondVelocities);
+		bool passed = pieces && std::fabs(meanSquare - 50) < 0.5;
+		allPassed &= passed;
+		std::printf("%-22s %10.3f   mean r^2 %.3f (50)                     %s\n", "disk 2D", time, meanSquare, pieces ? "equal" : "DIFFERENT");
+	}
+
+
+	/// Step 4: Plummer sphere with G = M = a = 1
+	{
+		Vec3DArray positions, velocities, first, second, firstVelocities, secondVelocities;
+		double time = seconds([&]() { randomPlummer(positions, velocities, count, rng.split(3), 1.0, 1.0, 1.0); });
+		std::vector<double> radii(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			radii[i] = std::sqrt(squareLength(positions, i));
+		}
+		std::nth_element(radii.begin(), radii.begin() + count / 2, radii.end());
+		double halfMass = radii[count / 2], virial = virialRatio(positions, velocities, 1.0, 1.0, 4000);
+		randomPlummer(first, firstVelocities, split, rng.split(3), 1.0, 1.0, 1.0);
+		randomPlummer(second, secondVelocities, count - split, rng.split(3), 1.0, 1.0, 1.0, split);
+		bool pieces = samePieces(positions, first, second) && samePieces(velocities, firstVelocities, secondVelocities);
+		bool passed = pieces && std::fabs(halfMass - 1.3048) < 0.02 && std::fabs(virial - 1) < 0.1;
+		allPassed &= passed;
+		std::printf("%-22s %10.3f   half-mass r %.4f (1.3048), 2K/|W| %.3f (1) %s\n", "plummer 3D", time, halfMass, virial, pieces ? "equal" : "DIFFERENT");
+	}
+
+	std::printf(allPassed ? "All distributions pass.\n" : "A distribution FAILED.\n");
+	return allPassed ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+//  ReductionsBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Reductions Benchmark, a command-line tool that checks that the Reductions sums are reproducible on any
+ * number of threads, and compares their accuracy and speed with a serial running total.
+ *
+ * Usage:
+ *   ReductionsBenchmark [count]
+ *
+ * The scene is a Plummer sphere of 'count' bodies (default ten million) with random masses, moved into
+ * its center-of-momentum frame so that the total momentum nearly cancels, the hard case for rounding.
+ *   1. The momentum, center of mass and kinetic energy are reduced on pools of 1 to 8 workers, plainly
+ *      and compensated; every pool must give the same bits. For contrast, a sum that splits the bodies
+ *      into one share per thread (1 to 8 shares) is shown to change with the thread count.
+ *   2. The error of each summation against a compensated long double reference.
+ *   3. The time per body of each summation.
+ * Build it from the repository root with optimizations (GCC only vectorizes the lanes of a block from
+ * -O3, clang from -O2), e.g.:
+ *
+ *   c++ -std=c++17 -O3 -pthread -I"Math Utilities" tools/ReductionsBenchmark.cpp "Math Utilities/Reductions.cpp" "Math Utilities/RandomVectors.cpp" "Math Utilities/VectorArrays.cpp" "Math Utilities/VectorArraysAVX2.cpp" "Math Utilities/WorkerPool.cpp" -o ReductionsBenchmark
+ */
+
+
+#include "Reductions.hpp"
+#include "RandomVectors.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <set>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	/// Times a pass, returning the fastest of 'repetitions' runs in nanoseconds per element.
+	double measure(int repetitions, double elements, const std::function<void()> &pass)
+	{
+		double fastest = 0;
+		for (int repetition = 0; repetition < repetitions; repetition++)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			pass();
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / elements;
+			if (repetition == 0 || nanoseconds < fastest)
+			{
+				fastest = nanoseconds;
+			}
+		}
+		return fastest;
+	}
+
+
+	bool sameBits(const Vec3D &a, const Vec3D &b) { return std::memcmp(&a, &b, sizeof(Vec3D)) == 0; }
+	bool sameBits(double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; }
+
+
+	/// The momentum by a running total in element order, as a serial loop computes it.
+	Vec3D runningMomentum(const Vec3DArray &velocities, const std::vector<double> &masses, std::size_t begin, std::size_t end)
+	{
+		Vec3D total;
+		for (std::size_t i = begin; i < end; i++)
+		{
+			total += Vec3D(masses[i] * velocities.x()[i], masses[i] * velocities.y()[i], masses[i] * velocities.z()[i]);
+		}
+		return total;
+	}
+
+
+	/// The momentum as a parallel loop with one share per thread would compute it, shares added in order.
+	Vec3D sharedMomentum(const Vec3DArray &velocities, const std::vector<double> &masses, std::size_t threads)
+	{
+		Vec3D total;
+		std::size_t count = velocities.size();
+		for (std::size_t thread = 0; thread < threads; thread++)
+		{
+			total += runningMomentum(velocities, masses, count * thread / threads, count * (thread + 1) / threads);
+		}
+		return total;
+	}
+
+
+	/// The momentum of the same terms, compensated in long double, as the reference.
+	void referenceMomentum(const Vec3DArray &velocities, const std::vector<double> &masses, long double *reference)
+	{
+		for (int d = 0; d < 3; d++)
+		{
+			long double sum = 0, compensation = 0;
+			for (std::size_t i = 0; i < velocities.size(); i++)
+			{
+				long double value = masses[i] * velocities.component(d)[i], total = sum + value;
+				compensation += std::fabs(sum) >= std::fabs(value) ? (sum - total) + value : (value - total) + sum;
+				sum = total;
+			}
+			reference[d] = sum + compensation;
+		}
+	}
+
+
+	double error(const Vec3D &momentum, const long double *reference)
+	{
+		return static_cast<double>(std::fabs(momentum.x - reference[0]) + std::fabs(momentum.y - reference[1]) + std::fabs(momentum.z - reference[2]));
+	}
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	std::size_t count = argc > 1 ? std::max<long long>(1, std::atoll(argv[1])) : 10000000;
+	bool pass = true;
+
+
+	/// Step 1: A Plummer sphere with random masses, at rest as a whole
+	Vec3DArray positions, velocities;
+	CounterRng rng(2024);
+	randomPlummer(positions, velocities, count, rng, 1.0, 1.0, 1.0);
+	std::vector<double> masses(count);
+	for (std::size_t i = 0; i < count; i++)
+	{
+		masses[i] = (0.5 + rng.split(1).uniform(i, 0)) / static_cast<double>(count);
+	}
+	Vec3D drift = totalMomentum(velocities, masses, Summation::Compensated) / reduceSum(masses, Summation::Compensated);
+	for (std::size_t i = 0; i < count; i++)
+	{
+		velocities.set(i, velocities.get(i) - drift);
+	}
+	std::printf("%zu bodies, momentum terms up to %.1e\n\n", count, 2.0 / static_cast<double>(count));
+
+
+	/// Step 2: The same bits on every pool
+	std::printf("%-8s %-26s %-26s %s\n", "workers", "momentum x (plain)", "momentum x (compensated)", "per-thread shares");
+	Vec3D plain, compensated, center;
+	double kinetic = 0;
+	std::set<double> shares;
+	for (std::size_t workers = 1; workers <= 8; workers++)
+	{
+		WorkerPool pool(workers);
+		Vec3D plainHere = totalMomentum(velocities, masses, Summation::Plain, pool);
+		Vec3D compensatedHere = totalMomentum(velocities, masses, Summation::Compensated, pool);
+		Vec3D centerHere = centerOfMass(positions, masses, Summation::Compensated, pool);
+		double kineticHere = kineticEnergy(velocities, masses, Summation::Plain, pool);
+		Vec3D share = sharedMomentum(velocities, masses, workers);
+		shares.insert(share.x);
+		if (workers == 1)
+		{
+			plain = plainHere, compensated = compensatedHere, center = centerHere, kinetic = kineticHere;
+		}
+		bool same = sameBits(plain, plainHere) && sameBits(compensated, compensatedHere) && sameBits(center, centerHere) && sameBits(kinetic, kineticHere);
+		pass = pass && same;
+		std::printf("%-8zu %+.17e %+.17e %+.17e%s\n", workers, plainHere.x, compensatedHere.x, share.x, same ? "" : "   REDUCTION CHANGED");
+	}
+	std::printf("Reductions: the same bits on every pool%s. Per-thread shares: %zu different results.\n\n", pass ? "" : " FAILED", shares.size());
+
+
+	/// Step 3: Accuracy against the long double reference
+	long double reference[3];
+	referenceMomentum(velocities, masses, reference);
+	double running = error(runningMomentum(velocities, masses, 0, count), reference), plainError = error(plain, reference), compensatedError = error(compensated, reference);
+	std::printf("%-24s %12s\n", "momentum error", "sum |error|");
+	std::printf("%-24s %12.3e\n", "serial running total", running);
+	std::printf("%-24s %12.3e\n", "reduceSum plain", plainError);
+	std::printf("%-24s %12.3e\n\n", "reduceSum compensated", compensatedError);
+	pass = pass && compensatedError <= plainError && compensatedError < 1e-18;
+
+
+	/// Step 4: Speed on the global pool
+	const int repetitions = 5;
+	Vec3D sink;
+	std::printf("%-24s %12s   (%zu threads)\n", "momentum", "ns/body", WorkerPool::global().threadCount() + 1);
+	std::printf("%-24s %12.3f\n", "serial running total", measure(repetitions, count, [&]() { sink += runningMomentum(velocities, masses, 0, count); }));
+	std::printf("%-24s %12.3f\n", "reduceSum plain", measure(repetitions, count, [&]() { sink += totalMomentum(velocities, masses, Summation::Plain); }));
+	std::printf("%-24s %12.3f\n", "reduceSum compensated", measure(repetitions, count, [&]() { sink += totalMomentum(velocities, masses, Summation::Compensated); }));
+	std::printf("%-24s %12.3f\n", "expression, plain", measure(repetitions, count, [&]() { sink += reduceSum(velocities * scalars(masses)); }));
+	pass = pass && sameBits(reduceSum(velocities * scalars(masses)), plain);
+
+	if (!pass)
+	{
+		std::printf("Reductions FAILED.\n");
+		return 1;
+	}
+	std::printf("All reductions pass (checksum %g).\n", sink.x);
+	return 0;
+}
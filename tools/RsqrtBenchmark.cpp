@@ -0,0 +1,196 @@
+//  RsqrtBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Rsqrt Benchmark, a command-line tool that checks the reciprocal-square-root operations of VectorArrays
+ * against long double references and times them, in every accuracy mode on every instruction set this
+ * processor supports.
+ *
+ * Usage:
+ *   RsqrtBenchmark [count] [repetitions]
+ *
+ * The error check runs inverseSquareRoots on values spread over the whole range the approximate modes
+ * accept, and vectorInverseCubeDistances, vectorNormalize and vectorDistances on random vectors, failing
+ * (exit code 1) if any result is further from the reference than rsqrtErrorBound() allows. The timings
+ * are the fastest of 'repetitions' runs (default 7) over 'count' elements (default 16384), with the
+ * speedup over the exact mode. Build it from the repository root with optimizations, e.g.:
+ *
+ *   c++ -std=c++17 -O2 -I"Math Utilities" tools/RsqrtBenchmark.cpp "Math Utilities/VectorArrays.cpp" "Math Utilities/VectorArraysAVX2.cpp" -o RsqrtBenchmark
+ */
+
+
+#include "VectorArrays.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	const RsqrtAccuracy ACCURACIES[] = {RsqrtAccuracy::Fast, RsqrtAccuracy::Refined, RsqrtAccuracy::Exact};
+	const char *ACCURACY_NAMES[] = {"Fast", "Refined", "Exact"};
+	constexpr double SOFTENING2 = 1e-4;
+
+
+	double measure(int repetitions, double elements, const std::function<void()> &pass)
+	{
+		double fastest = 0;
+		for (int repetition = 0; repetition < repetitions; repetition++)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			pass();
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / elements;
+			fastest = repetition == 0 ? nanoseconds : std::min(fastest, nanoseconds);
+		}
+		return fastest;
+	}
+
+
+	double relativeError(double value, long double reference)
+	{
+		return static_cast<double>(std::fabs((value - reference) / reference));
+	}
+
+
+	/// The inputs of the checks and timings.
+	struct Inputs
+	{
+		std::vector<double> values; // Log-uniform over the range of single precision, for inverseSquareRoots
+		Vec3DArray a, b; // Random vectors, a few of them zero
+		Vec3D point;
+
+		Inputs(std::size_t count)
+		{
+			std::mt19937 generator(7);
+			std::uniform_real_distribution<double> exponent(-37.0, 38.0), unit(-1.0, 1.0);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				values.push_back(std::pow(10.0, exponent(generator)));
+				a.push_back(i % 97 == 0 ? Vec3D() : Vec3D(unit(generator), unit(generator), unit(generator)) * std::pow(10.0, exponent(generator) / 4));
+				b.push_back(Vec3D(unit(generator), unit(generator), unit(generator)));
+			}
+			point = Vec3D(0.25, -0.5, 0.125);
+		}
+	};
+
+
+	/**
+	 * worstErrors
+	 * The largest relative errors of the four operations in one mode: 1/sqrt, 1/r^3, the components of
+	 * normalized vectors (relative to their length, 1) and distances.
+	 */
+	void worstErrors(const Inputs &inputs, RsqrtAccuracy accuracy, double errors[4])
+	{
+		std::size_t count = inputs.values.size();
+		std::vector<double> out(count);
+		for (int k = 0; k < 4; k++)
+		{
+			errors[k] = 0;
+		}
+
+		inverseSquareRoots(inputs.values.data(), out.data(), count, accuracy);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			errors[0] = std::max(errors[0], relativeError(out[i], 1.0L / std::sqrt(static_cast<long double>(inputs.values[i]))));
+		}
+
+		vectorInverseCubeDistances(inputs.b, inputs.point, SOFTENING2, out, accuracy);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			Vec3D difference = inputs.b.get(i) - inputs.point;
+			long double r2 = static_cast<long double>(difference.x) * difference.x + static_cast<long double>(difference.y) * difference.y + static_cast<long double>(difference.z) * difference.z + SOFTENING2;
+			errors[1] = std::max(errors[1], relativeError(out[i], 1.0L / (r2 * std::sqrt(r2))));
+		}
+
+		Vec3DArray normalized = inputs.a;
+		vectorNormalize(normalized, accuracy);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			Vec3D vector = inputs.a.get(i), result = normalized.get(i);
+			long double length = std::sqrt(static_cast<long double>(vector.x) * vector.x + static_cast<long double>(vector.y) * vector.y + static_cast<long double>(vector.z) * vector.z);
+			if (length == 0)
+			{
+				errors[2] = std::max(errors[2], result == Vec3D() ? 0.0 : 1.0); // Zero vectors must stay zero
+				continue;
+			}
+			errors[2] = std::max({errors[2], static_cast<double>(std::fabs(result.x - vector.x / length)), static_cast<double>(std::fabs(result.y - vector.y / length)), static_cast<double>(std::fabs(result.z - vector.z / length))});
+		}
+
+		vectorDistances(inputs.a, inputs.b, out, accuracy);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			Vec3D difference = inputs.a.get(i) - inputs.b.get(i);
+			long double distance = std::sqrt(static_cast<long double>(difference.x) * difference.x + static_cast<long double>(difference.y) * difference.y + static_cast<long double>(difference.z) * difference.z);
+			errors[3] = std::max(errors[3], relativeError(out[i], distance));
+		}
+	}
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	std::size_t count = argc > 1 ? std::max(16, std::atoi(argv[1])) : 1 << 14;
+	int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 7;
+	Inputs inputs(count);
+	std::vector<double> out(count);
+	bool withinBounds = true;
+
+
+	/// Step 1: Worst relative errors against long double, per instruction set and mode
+	std::printf("%-8s %-8s %10s %12s %12s %12s %12s\n", "level", "mode", "bound", "1/sqrt", "1/r^3", "normalize", "distance");
+	for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::NEON, SimdLevel::AVX2})
+	{
+		if (!setSimdLevel(level))
+		{
+			continue;
+		}
+		for (int mode = 0; mode < 3; mode++)
+		{
+			double errors[4], bound = rsqrtErrorBound(ACCURACIES[mode]);
+			worstErrors(inputs, ACCURACIES[mode], errors);
+			bool ok = errors[0] <= bound && errors[1] <= 3 * bound + 4.5e-16 && errors[2] <= bound + 4.5e-16 && errors[3] <= bound + 4.5e-16; // Plus the rounding of the squared lengths
+			withinBounds &= ok;
+			std::printf("%-8s %-8s %10.2e %12.3e %12.3e %12.3e %12.3e   %s\n", simdLevelName(level), ACCURACY_NAMES[mode], bound, errors[0], errors[1], errors[2], errors[3], ok ? "within bounds" : "OUT OF BOUNDS");
+		}
+	}
+
+
+	/// Step 2: Timings, with the speedup over the exact mode of the same instruction set
+	std::printf("\n%-8s %-8s %14s %14s %14s\n", "level", "mode", "1/r^3 ns", "normalize ns", "distance ns");
+	for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::NEON, SimdLevel::AVX2})
+	{
+		if (!setSimdLevel(level))
+		{
+			continue;
+		}
+		double exact[3] = {0, 0, 0};
+		for (int mode = 2; mode >= 0; mode--)
+		{
+			Vec3DArray normalized;
+			double times[3] = {
+				measure(repetitions, count, [&]() { vectorInverseCubeDistances(inputs.b, inputs.point, SOFTENING2, out, ACCURACIES[mode]); }),
+				measure(repetitions, count, [&]() { normalized = inputs.a; vectorNormalize(normalized, ACCURACIES[mode]); }),
+				measure(repetitions, count, [&]() { vectorDistances(inputs.a, inputs.b, out, ACCURACIES[mode]); })};
+			if (mode == 2)
+			{
+				std::copy(times, times + 3, exact);
+			}
+			std::printf("%-8s %-8s %8.3f %4.2fx %8.3f %4.2fx %8.3f %4.2fx\n", simdLevelName(level), ACCURACY_NAMES[mode], times[0], exact[0] / times[0], times[1], exact[1] / times[1], times[2], exact[2] / times[2]);
+		}
+	}
+	setSimdLevel(bestSimdLevel());
+
+	std::printf(withinBounds ? "All errors within bounds.\n" : "Errors OUT OF BOUNDS.\n");
+	return withinBounds ? 0 : 1;
+}
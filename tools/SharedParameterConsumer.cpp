@@ -0,0 +1,105 @@
+//  SharedParameterConsumer.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Shared Parameter Consumer, a command-line stand-in for an out-of-process simulation that follows the
+ * parameters the UI shares through a SharedParameterSegment.
+ *
+ * Usage:
+ *   SharedParameterConsumer [segment name] [--once]
+ *
+ *   segment name  The shm_open name of the segment, "/ofui_parameters" by default
+ *   --once        Prints every parameter once and exits instead of following changes
+ *
+ * The tool maps the segment, prints every parameter, then sleeps on the doorbell and prints each
+ * parameter whose field sequence moved, reading the values in place. It waits for the UI if the
+ * segment does not exist yet. The tool does not depend on openFrameworks, build it from the
+ * repository root with:
+ *
+ *   c++ -std=c++17 -I"Math Utilities/Interface Elements" tools/SharedParameterConsumer.cpp -o SharedParameterConsumer
+ *
+ * (add -lrt on older glibc).
+ */
+
+
+#include "SharedParameterLayout.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+
+
+
+/**
+ * printParameter
+ * Prints a field's name, value and change version.
+ */
+static void printParameter(const SharedParameterView &view, uint32_t index)
+{
+	uint64_t changeVersion;
+	view.read(index, changeVersion);
+	const SharedParameterField &field = view.field(index);
+	std::printf("%-24s %.17g  [%g, %g]  (change %llu)\n", field.name, view.value(index), field.min, field.max, static_cast<unsigned long long>(changeVersion));
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	/// Step 1: Parse the arguments
+	std::string segmentName = "/ofui_parameters";
+	bool once = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--once") == 0)
+		{
+			once = true;
+		}
+		else if (argv[i][0] != '-')
+		{
+			segmentName = argv[i];
+		}
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [segment name] [--once]\n", argv[0]);
+			return 1;
+		}
+	}
+
+
+	/// Step 2: Wait for the UI to create the segment
+	SharedParameterView view;
+	while (!view.attach(segmentName))
+	{
+		if (once)
+		{
+			std::fprintf(stderr, "No parameter segment named %s\n", segmentName.c_str());
+			return 1;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+	}
+
+
+	/// Step 3: Print everything once, then follow the changes
+	std::vector<uint64_t> seenSequences;
+	uint64_t seenChanges = view.changeCounter();
+	view.forEachChanged(seenSequences, [&](uint32_t index) { printParameter(view, index); });
+	std::fflush(stdout);
+	while (!once)
+	{
+		if (!view.wait(seenChanges, 1000))
+		{
+			continue;
+		}
+		seenChanges = view.changeCounter();
+		view.forEachChanged(seenSequences, [&](uint32_t index) { printParameter(view, index); });
+		std::fflush(stdout);
+	}
+	return 0;
+}
@@ -0,0 +1,225 @@
+//  SpaceFillingCurvesBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Space Filling Curves Benchmark, a command-line tool that checks the Morton and Hilbert keys and measures
+ * what sorting the bodies along them does for the Barnes-Hut force pass.
+ *
+ * Usage:
+ *   SpaceFillingCurvesBenchmark [positions] [bodies]
+ *
+ *   1. The block kernels must match a bit-by-bit reference for 'positions' (default ten million) Gaussian
+ *      positions in 2D and 3D, the Hilbert keys of a coarse grid must step between neighbouring cells, and
+ *      sortOrder must agree with std::stable_sort.
+ *   2. The time per position of each kernel.
+ *   3. The time of NBodySimulation::computeAccelerations over a disk of 'bodies' bodies (default 200000),
+ *      in random, Morton and Hilbert order. Every body must get bitwise the same acceleration in every order.
+ * Build it from the repository root with optimizations (GCC vectorizes the kernels from -O3, clang from
+ * -O2), e.g.:
+ *
+ *   c++ -std=c++17 -O3 -pthread -I"Math Utilities" tools/SpaceFillingCurvesBenchmark.cpp "Math Utilities/SpaceFillingCurves.cpp" "Math Utilities/ParallelPrimitives.cpp" "Math Utilities/NBodySimulation.cpp" "Math Utilities/Geometry.cpp" "Math Utilities/RandomVectors.cpp" "Math Utilities/VectorArrays.cpp" "Math Utilities/VectorArraysAVX2.cpp" "Math Utilities/WorkerPool.cpp" -o SpaceFillingCurvesBenchmark
+ */
+
+
+#include "SpaceFillingCurves.hpp"
+#include "NBodySimulation.hpp"
+#include "RandomVectors.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	/// Times a pass, returning the fastest of 'repetitions' runs in nanoseconds per element.
+	double measure(int repetitions, double elements, const std::function<void()> &pass)
+	{
+		double fastest = 0;
+		for (int repetition = 0; repetition < repetitions; repetition++)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			pass();
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / elements;
+			if (repetition == 0 || nanoseconds < fastest)
+			{
+				fastest = nanoseconds;
+			}
+		}
+		return fastest;
+	}
+
+
+	/// The Morton key of one position, one bit at a time.
+	uint64_t referenceMorton(const double *position, const double *center, double size, int dimensions)
+	{
+		int bits = dimensions == 2 ? SPATIAL_KEY_BITS_2D : SPATIAL_KEY_BITS_3D;
+		double cells = std::ldexp(1.0, bits);
+		uint64_t key = 0;
+		for (int d = 0; d < dimensions; d++)
+		{
+			double cell = std::floor((position[d] - (center[d] - size * 0.5)) * (cells / size));
+			uint64_t clamped = static_cast<uint64_t>(std::min(std::max(cell, 0.0), cells - 1));
+			for (int bit = 0; bit < bits; bit++)
+			{
+				key |= ((clamped >> bit) & 1) << (bit * dimensions + d);
+			}
+		}
+		return key;
+	}
+
+
+	/// Whether the cells of consecutive Hilbert keys of a grid of 'side' cells per axis are neighbours.
+	template<int Dimensions>
+	bool hilbertSteps(int side)
+	{
+		using Vector = typename VectorArray<Dimensions>::Vector;
+		std::size_t cells = 1;
+		for (int d = 0; d < Dimensions; d++)
+		{
+			cells *= side;
+		}
+		std::vector<std::pair<uint64_t, std::size_t>> keyed(cells);
+		for (std::size_t cell = 0; cell < cells; cell++)
+		{
+			double coordinates[3] = {};
+			for (std::size_t rest = cell, d = 0; d < Dimensions; d++, rest /= side)
+			{
+				coordinates[d] = (rest % side) + 0.5; // The cell centers of [0, side)^Dimensions
+			}
+			if constexpr (Dimensions == 2)
+			{
+				keyed[cell] = {hilbertKey(Vector(coordinates[0], coordinates[1]), Square(Vec2D(side * 0.5, side * 0.5), side)), cell};
+			}
+			else
+			{
+				keyed[cell] = {hilbertKey(Vector(coordinates[0], coordinates[1], coordinates[2]), Cube(Vec3D(side * 0.5, side * 0.5, side * 0.5), side)), cell};
+			}
+		}
+		std::sort(keyed.begin(), keyed.end());
+		for (std::size_t k = 1; k < cells; k++)
+		{
+			int distance = 0;
+			for (std::size_t a = keyed[k - 1].second, b = keyed[k].second, d = 0; d < Dimensions; d++, a /= side, b /= side)
+			{
+				distance += std::abs(static_cast<int>(a % side) - static_cast<int>(b % side));
+			}
+			if (distance != 1 || keyed[k - 1].first == keyed[k].first)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+	/// Checks the kernels of one dimension against the single-position functions and the reference, and times them.
+	template<int Dimensions, typename Domain>
+	bool checkKeys(const VectorArray<Dimensions> &positions, const Domain &domain)
+	{
+		bool pass = true;
+		std::vector<uint64_t> morton, hilbert;
+		spatialKeys(positions, domain, SpaceFillingCurve::Morton, morton);
+		spatialKeys(positions, domain, SpaceFillingCurve::Hilbert, hilbert);
+		for (std::size_t i = 0; i < positions.size(); i += 97)
+		{
+			auto position = positions.get(i);
+			uint64_t reference = referenceMorton(&position.x, &domain.center.x, domain.size, Dimensions);
+			pass = pass && morton[i] == reference && morton[i] == mortonKey(position, domain) && hilbert[i] == hilbertKey(position, domain);
+		}
+
+		const int repetitions = 5;
+		std::printf("%-12s %8dD %10.3f %10.3f%s\n", "keys", Dimensions,
+					measure(repetitions, positions.size(), [&]() { spatialKeys(positions, domain, SpaceFillingCurve::Morton, morton); }),
+					measure(repetitions, positions.size(), [&]() { spatialKeys(positions, domain, SpaceFillingCurve::Hilbert, hilbert); }),
+					pass ? "" : "   KEYS DIFFER");
+		return pass;
+	}
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	std::size_t count = argc > 1 ? std::max<long long>(1, std::atoll(argv[1])) : 10000000;
+	std::size_t bodyCount = argc > 2 ? std::max<long long>(1, std::atoll(argv[2])) : 200000;
+	bool pass = true;
+
+
+	/// Step 1: The keys against the reference, and their speed
+	CounterRng rng(2024);
+	Vec2DArray positions2D;
+	Vec3DArray positions3D;
+	randomGaussian(positions2D, count, rng);
+	randomGaussian(positions3D, count, rng.split(1));
+	std::printf("%zu positions (%zu threads)\n%-12s %9s %10s %10s\n", count, WorkerPool::global().threadCount() + 1, "", "", "Morton", "Hilbert");
+	pass = checkKeys(positions2D, boundingSquare(positions2D)) && pass;
+	pass = checkKeys(positions3D, boundingCube(positions3D)) && pass;
+	bool steps = hilbertSteps<2>(64) && hilbertSteps<3>(16);
+	pass = pass && steps;
+	std::printf("Hilbert keys of a grid step between neighbours: %s\n", steps ? "yes" : "NO");
+
+	std::vector<uint64_t> keys;
+	std::vector<uint32_t> order, stable(count);
+	spatialKeys(positions2D, boundingSquare(positions2D), SpaceFillingCurve::Hilbert, keys);
+	for (uint64_t &key : keys)
+	{
+		key >>= 40; // Coarse keys, so that many are equal
+	}
+	double sortTime = measure(3, count, [&]() { sortOrder(keys, order); });
+	std::iota(stable.begin(), stable.end(), 0u);
+	std::stable_sort(stable.begin(), stable.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+	pass = pass && order == stable;
+	std::printf("sortOrder: %.3f ns/key, %s std::stable_sort\n\n", sortTime, order == stable ? "matches" : "DIFFERS FROM");
+
+
+	/// Step 2: The force pass in random, Morton and Hilbert order
+	SimulationSettings settings;
+	NBodySimulation random(NBodySimulation::uniformDisk(bodyCount, 1.0, 1.0, settings.G, 7), settings);
+	std::printf("%zu bodies, theta %.2f\n%-12s %14s %12s\n", bodyCount, settings.theta, "order", "forces (ms)", "speedup");
+	double randomTime = measure(3, 1e6, [&]() { random.computeAccelerations(); });
+	std::printf("%-12s %14.2f %12s\n", "random", randomTime, "1.00");
+	const char *names[] = {"Morton", "Hilbert"};
+	for (SpaceFillingCurve curve : {SpaceFillingCurve::Morton, SpaceFillingCurve::Hilbert})
+	{
+		NBodySimulation sorted = random;
+		std::vector<uint64_t> bodyKeys;
+		Vec2DArray bodyPositions(bodyCount);
+		for (std::size_t i = 0; i < bodyCount; i++)
+		{
+			bodyPositions.set(i, sorted.bodies[i].position);
+		}
+		spatialKeys(bodyPositions, boundingSquare(bodyPositions), curve, bodyKeys);
+		sortOrder(bodyKeys, order);
+		applyOrder(order, sorted.bodies);
+		double time = measure(3, 1e6, [&]() { sorted.computeAccelerations(); });
+
+		bool same = true;
+		for (std::size_t k = 0; k < bodyCount; k++)
+		{
+			same = same && std::memcmp(&sorted.bodies[k].acceleration, &random.bodies[order[k]].acceleration, sizeof(Vec2D)) == 0;
+		}
+		pass = pass && same;
+		std::printf("%-12s %14.2f %12.2f%s\n", names[curve == SpaceFillingCurve::Hilbert], time, randomTime / time, same ? "" : "   ACCELERATIONS CHANGED");
+	}
+	double reorderTime = measure(3, 1e6, [&]() { NBodySimulation copy = random; copy.reorderBodies(); });
+	std::printf("%-12s %14.2f   (reorderBodies, with a copy of the bodies)\n", "reorder", reorderTime);
+
+	if (!pass)
+	{
+		std::printf("Space-filling curves FAILED.\n");
+		return 1;
+	}
+	std::printf("All space-filling curve checks pass.\n");
+	return 0;
+}
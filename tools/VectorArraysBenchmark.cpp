@@ -0,0 +1,272 @@
+//  VectorArraysBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Vector Arrays Benchmark, a command-line tool that times the integration and diagnostic passes of a
+ * particle set stored as std::vector<Vec2D> (array of structs) and as a Vec2DArray (struct of arrays)
+ * on every instruction set this processor supports.
+ *
+ * Usage:
+ *   VectorArraysBenchmark [count] [repetitions]
+ *
+ * Every pass runs 'repetitions' times (default 7) over 'count' vectors (default 65536); the fastest run
+ * is reported in nanoseconds per vector, with the speedup over the Vec2D loop. The checksums of all
+ * instruction sets must match bitwise. Build it from the repository root with optimizations, e.g.:
+ *
+ *   c++ -std=c++17 -O2 -I"Math Utilities" tools/VectorArraysBenchmark.cpp "Math Utilities/VectorArrays.cpp" "Math Utilities/VectorArraysAVX2.cpp" -o VectorArraysBenchmark
+ */
+
+
+#include "VectorArrays.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	/// The fastest of several runs of a pass in nanoseconds per vector, and the checksum of the last run.
+	struct Timing
+	{
+		double nanosecondsPerElement;
+		double checksum;
+	};
+
+	Timing measure(int repetitions, double elements, const std::function<double()> &pass)
+	{
+		Timing timing = {0, 0};
+		for (int repetition = 0; repetition < repetitions; repetition++)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			double checksum = pass();
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / elements;
+			if (repetition == 0 || nanoseconds < timing.nanosecondsPerElement)
+			{
+				timing.nanosecondsPerElement = nanoseconds;
+			}
+			timing.checksum = checksum; // Of the last run, so passes that update their inputs compare equal
+		}
+		return timing;
+	}
+
+
+	/// Checksums add every CHECKSUM_STRIDE-th result, so that the serial sum does not dominate the timing.
+	constexpr std::size_t CHECKSUM_STRIDE = 16;
+
+	double sum(const std::vector<double> &values)
+	{
+		double total = 0;
+		for (std::size_t i = 0; i < values.size(); i += CHECKSUM_STRIDE)
+		{
+			total += values[i];
+		}
+		return total;
+	}
+
+
+	double sum(const Vec2DArray &vectors)
+	{
+		double total = 0;
+		for (std::size_t i = 0; i < vectors.size(); i += CHECKSUM_STRIDE)
+		{
+			total += vectors.x()[i] + vectors.y()[i];
+		}
+		return total;
+	}
+
+
+	/// The inputs of every pass, identical in both layouts.
+	struct ParticleSet
+	{
+		std::vector<Vec2D> positions, velocities, accelerations, targets;
+		Vec2DArray positionArray, velocityArray, accelerationArray, targetArray;
+
+		ParticleSet(std::size_t count)
+		{
+			std::mt19937 generator(1);
+			std::uniform_real_distribution<double> unit(-1.0, 1.0);
+			for (std::vector<Vec2D> *vectors : {&positions, &velocities, &accelerations, &targets})
+			{
+				for (std::size_t i = 0; i < count; i++)
+				{
+					double x = unit(generator), y = unit(generator);
+					vectors->push_back(Vec2D(x, y));
+				}
+			}
+			positionArray = toArray(positions);
+			velocityArray = toArray(velocities);
+			accelerationArray = toArray(accelerations);
+			targetArray = toArray(targets);
+		}
+
+		static Vec2DArray toArray(const std::vector<Vec2D> &vectors)
+		{
+			Vec2DArray array(vectors.size());
+			for (std::size_t i = 0; i < vectors.size(); i++)
+			{
+				array.set(i, vectors[i]);
+			}
+			return array;
+		}
+	};
+
+
+
+
+	/// ------------- Passes over std::vector<Vec2D> -------------
+	/// \{
+	double integrateVectors(ParticleSet &set, double dt)
+	{
+		for (std::size_t i = 0; i < set.positions.size(); i++) // Kick, then drift
+		{
+			set.velocities[i] += set.accelerations[i] * dt;
+		}
+		for (std::size_t i = 0; i < set.positions.size(); i++)
+		{
+			set.positions[i] += set.velocities[i] * dt;
+		}
+		return set.positions[set.positions.size() / 2].x;
+	}
+
+
+	double lengthsOfVectors(const ParticleSet &set, std::vector<double> &lengths)
+	{
+		lengths.resize(set.velocities.size());
+		for (std::size_t i = 0; i < set.velocities.size(); i++)
+		{
+			lengths[i] = set.velocities[i].vectorLength();
+		}
+		return sum(lengths);
+	}
+
+
+	double distancesOfVectors(const ParticleSet &set, std::vector<double> &distances)
+	{
+		distances.resize(set.positions.size());
+		for (std::size_t i = 0; i < set.positions.size(); i++)
+		{
+			distances[i] = set.positions[i].vectorDistance(set.targets[i]);
+		}
+		return sum(distances);
+	}
+
+
+	double normalizeVectors(const ParticleSet &set, std::vector<Vec2D> &normalized)
+	{
+		normalized = set.accelerations;
+		for (Vec2D &vector : normalized)
+		{
+			vector = vector.vectorGetNormalized();
+		}
+		double total = 0;
+		for (std::size_t i = 0; i < normalized.size(); i += CHECKSUM_STRIDE)
+		{
+			total += normalized[i].x + normalized[i].y;
+		}
+		return total;
+	}
+	/// \}
+
+
+
+
+	/// ------------- Passes over Vec2DArray -------------
+	/// \{
+	double integrateArrays(ParticleSet &set, double dt)
+	{
+		vectorAddScaled(set.velocityArray, set.accelerationArray, dt);
+		vectorAddScaled(set.positionArray, set.velocityArray, dt);
+		return set.positionArray.get(set.positionArray.size() / 2).x;
+	}
+
+
+	double lengthsOfArrays(const ParticleSet &set, std::vector<double> &lengths)
+	{
+		vectorLengths(set.velocityArray, lengths);
+		return sum(lengths);
+	}
+
+
+	double distancesOfArrays(const ParticleSet &set, std::vector<double> &distances)
+	{
+		vectorDistances(set.positionArray, set.targetArray, distances);
+		return sum(distances);
+	}
+
+
+	double normalizeArrays(const ParticleSet &set, Vec2DArray &normalized)
+	{
+		normalized = set.accelerationArray;
+		vectorNormalize(normalized);
+		return sum(normalized);
+	}
+	/// \}
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	std::size_t count = argc > 1 ? std::max(16, std::atoi(argv[1])) : 1 << 16;
+	int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 7;
+	std::vector<double> scratch;
+	std::vector<Vec2D> scratchVectors;
+	Vec2DArray scratchArray;
+
+	const char *names[] = {"integrate (kick + drift)", "lengths", "distances", "normalize"};
+	std::vector<std::function<double(ParticleSet&)>> vectorPasses = {
+		[&](ParticleSet &set) { return integrateVectors(set, 1e-3); },
+		[&](ParticleSet &set) { return lengthsOfVectors(set, scratch); },
+		[&](ParticleSet &set) { return distancesOfVectors(set, scratch); },
+		[&](ParticleSet &set) { return normalizeVectors(set, scratchVectors); }};
+	std::vector<std::function<double(ParticleSet&)>> arrayPasses = {
+		[&](ParticleSet &set) { return integrateArrays(set, 1e-3); },
+		[&](ParticleSet &set) { return lengthsOfArrays(set, scratch); },
+		[&](ParticleSet &set) { return distancesOfArrays(set, scratch); },
+		[&](ParticleSet &set) { return normalizeArrays(set, scratchArray); }};
+
+	std::printf("%zu vectors, best instruction set %s\n", count, simdLevelName(bestSimdLevel()));
+	std::printf("%-26s %-8s %12s %9s   %s\n", "pass", "layout", "ns/vector", "speedup", "checksum");
+
+
+	bool allMatch = true;
+	for (std::size_t pass = 0; pass < vectorPasses.size(); pass++)
+	{
+		/// Step 1: The Vec2D loop, the baseline of the speedups
+		ParticleSet vectorSet(count);
+		Timing baseline = measure(repetitions, count, [&]() { return vectorPasses[pass](vectorSet); });
+		std::printf("%-26s %-8s %12.3f %8.2fx   %.17g\n", names[pass], "Vec2D", baseline.nanosecondsPerElement, 1.0, baseline.checksum);
+
+
+		/// Step 2: The array pass on every supported instruction set, each from the same inputs
+		double reference = 0;
+		bool first = true;
+		for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::NEON, SimdLevel::AVX2})
+		{
+			if (!setSimdLevel(level))
+			{
+				continue;
+			}
+			ParticleSet arraySet(count);
+			Timing timing = measure(repetitions, count, [&]() { return arrayPasses[pass](arraySet); });
+			bool match = first || timing.checksum == reference;
+			allMatch &= match;
+			reference = first ? timing.checksum : reference;
+			first = false;
+			std::printf("%-26s %-8s %12.3f %8.2fx   %.17g%s\n", "", simdLevelName(level), timing.nanosecondsPerElement, baseline.nanosecondsPerElement / timing.nanosecondsPerElement, timing.checksum, match ? "" : "  MISMATCH");
+		}
+	}
+	setSimdLevel(bestSimdLevel());
+
+	std::printf(allMatch ? "All instruction sets agree.\n" : "Instruction sets DISAGREE.\n");
+	return allMatch ? 0 : 1;
+}
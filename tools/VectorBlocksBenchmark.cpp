@@ -0,0 +1,257 @@
+//  VectorBlocksBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Vector Blocks Benchmark, a command-line tool that checks the VectorBlockArray operations against the
+ * VectorArray ones and compares the AoSoA, SoA and AoS layouts.
+ *
+ * Usage:
+ *   VectorBlocksBenchmark [count]
+ *
+ *   1. Every block operation, in 2D and 3D with blocks of 8 and 16, every RsqrtAccuracy and on every
+ *      SimdLevel, must give bitwise the results of the VectorArray operation on the same vectors. The
+ *      count is odd on purpose, so the last block is partly filled.
+ *   2. The same integrator and force code, written once as templates over the container, timed on
+ *      'count' (default four million) 3D vectors per layout: a kick-drift step and the 1/r^3 factors of
+ *      softened gravity towards a point, both passes over the whole array.
+ *   3. Random gathers of whole vectors, the access pattern of a tree walk, through get() of each layout
+ *      and an array of Vec3D.
+ * Build it from the repository root with optimizations, e.g.:
+ *
+ *   c++ -std=c++17 -O3 -pthread -I"Math Utilities" tools/VectorBlocksBenchmark.cpp "Math Utilities/VectorBlocks.cpp" "Math Utilities/VectorArrays.cpp" "Math Utilities/VectorArraysAVX2.cpp" "Math Utilities/RandomVectors.cpp" "Math Utilities/WorkerPool.cpp" -o VectorBlocksBenchmark
+ */
+
+
+#include "VectorBlocks.hpp"
+#include "RandomVectors.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	/// Times a pass, returning the fastest of 'repetitions' runs in nanoseconds per element.
+	double measure(int repetitions, double elements, const std::function<void()> &pass)
+	{
+		double fastest = 0;
+		for (int repetition = 0; repetition < repetitions; repetition++)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			pass();
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / elements;
+			if (repetition == 0 || nanoseconds < fastest)
+			{
+				fastest = nanoseconds;
+			}
+		}
+		return fastest;
+	}
+
+
+	bool sameBits(const std::vector<double> &a, const std::vector<double> &b)
+	{
+		return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+	}
+
+
+	/// The vectors of any container as a VectorArray, to compare them bitwise.
+	template<int Dimensions>
+	std::vector<double> flatten(const VectorArray<Dimensions> &a)
+	{
+		std::vector<double> values;
+		for (std::size_t i = 0; i < a.size(); i++)
+		{
+			auto vector = a.get(i);
+			const double *components = &vector.x;
+			values.insert(values.end(), components, components + Dimensions);
+		}
+		return values;
+	}
+
+
+	template<int Dimensions, std::size_t Width>
+	std::vector<double> flatten(const VectorBlockArray<Dimensions, Width> &a) { return flatten(a.toVectorArray()); }
+
+
+
+
+	/// ------------- Layout-Independent Code -------------
+	/// \{
+	/// A kick-drift step, the same source for both containers.
+	template<typename Array>
+	void kickDrift(Array &positions, Array &velocities, const Array &accelerations, double dt)
+	{
+		vectorAddScaled(velocities, accelerations, dt);
+		vectorAddScaled(positions, velocities, dt);
+	}
+
+
+	/// The 1/r^3 factors of softened gravity towards a point, the same source for both containers.
+	template<typename Array>
+	void forceFactors(const Array &positions, const typename Array::Vector &point, std::vector<double> &factors, RsqrtAccuracy accuracy)
+	{
+		vectorInverseCubeDistances(positions, point, 1e-4, factors, accuracy);
+	}
+	/// \}
+
+
+
+
+	/// Checks every block operation against the VectorArray operation on the same vectors.
+	template<int Dimensions, std::size_t Width>
+	bool checkOperations(std::size_t count)
+	{
+		using Array = VectorArray<Dimensions>;
+		using Blocks = VectorBlockArray<Dimensions, Width>;
+		Array a, b, sum;
+		randomGaussian(a, count, CounterRng(Dimensions * 100 + Width));
+		randomGaussian(b, count - 3, CounterRng(Dimensions * 100 + Width).split(1)); // Shorter, so the operations use the common length
+		Blocks blocksA(a), blocksB(b), blocksSum;
+		bool pass = flatten(blocksA) == flatten(a) && blocksA.get(count / 2).x == a.get(count / 2).x;
+
+		vectorAdd(a, b, sum);
+		vectorAdd(blocksA, blocksB, blocksSum);
+		pass = pass && flatten(blocksSum) == flatten(sum);
+
+		kickDrift(a, sum, b, 0.01);
+		kickDrift(blocksA, blocksSum, blocksB, 0.01);
+		vectorScale(a, 1.5);
+		vectorScale(blocksA, 1.5);
+		pass = pass && flatten(blocksA) == flatten(a) && flatten(blocksSum) == flatten(sum);
+
+		std::vector<double> expected, actual;
+		vectorSquareLengths(a, expected);
+		vectorSquareLengths(blocksA, actual);
+		pass = pass && sameBits(expected, actual);
+		for (RsqrtAccuracy accuracy : {RsqrtAccuracy::Fast, RsqrtAccuracy::Refined, RsqrtAccuracy::Exact})
+		{
+			typename Array::Vector point = b.get(7);
+			forceFactors(a, point, expected, accuracy);
+			forceFactors(blocksA, point, actual, accuracy);
+			pass = pass && sameBits(expected, actual);
+		}
+
+		Blocks grown;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			grown.push_back(a.get(i));
+		}
+		grown.resize(count - 5); // The dropped lanes must read as zero again after growing
+		grown.resize(count);
+		pass = pass && grown.get(count - 1).x == 0 && grown.get(count - 6).x == a.get(count - 6).x;
+
+		std::printf("%dD, blocks of %-3zu %s\n", Dimensions, Width, pass ? "match VectorArray" : "DIFFER FROM VectorArray");
+		return pass;
+	}
+
+
+	/// Sums the vectors at the given indices through get(), as a tree walk reads the bodies of its leaves.
+	template<typename Array>
+	double gather(const Array &positions, const std::vector<uint32_t> &indices)
+	{
+		double total = 0;
+		for (uint32_t index : indices)
+		{
+			Vec3D position = positions.get(index);
+			total += position.x + position.y + position.z;
+		}
+		return total;
+	}
+
+
+	/// An array of Vec3D with the get() of the containers.
+	struct Vec3DStructs
+	{
+		std::vector<Vec3D> vectors;
+		Vec3D get(std::size_t index) const { return vectors[index]; }
+	};
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	std::size_t count = argc > 1 ? std::max<long long>(64, std::atoll(argv[1])) : 4000000;
+	bool pass = true;
+
+
+	/// Step 1: The block operations against the VectorArray operations
+	SimdLevel best = bestSimdLevel();
+	for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON})
+	{
+		if (setSimdLevel(level))
+		{
+			std::printf("SimdLevel %s\n", simdLevelName(level));
+			pass = checkOperations<2, 8>(1001) && pass;
+			pass = checkOperations<3, 8>(1001) && pass;
+			pass = checkOperations<2, 16>(1001) && pass;
+			pass = checkOperations<3, 16>(1001) && pass;
+		}
+	}
+	setSimdLevel(best);
+
+
+	/// Step 2: Passes over the whole array
+	Vec3DArray positions, velocities, accelerations;
+	CounterRng rng(2024);
+	randomGaussian(positions, count, rng);
+	randomGaussian(velocities, count, rng.split(1));
+	randomGaussian(accelerations, count, rng.split(2));
+	VectorBlockArray<3, 8> positions8(positions), velocities8(velocities), accelerations8(accelerations);
+	VectorBlockArray<3, 16> positions16(positions), velocities16(velocities), accelerations16(accelerations);
+	std::vector<double> factors;
+	const int repetitions = 5;
+	const Vec3D point(0.1, 0.2, 0.3);
+
+	std::printf("\n%zu vectors, ns/vector, SimdLevel %s\n%-28s %10s %10s %10s %10s\n", count, simdLevelName(best), "pass", "SoA", "AoSoA 8", "AoSoA 16", "AoS");
+	std::printf("%-28s %10.3f %10.3f %10.3f %10s\n", "kick + drift",
+				measure(repetitions, count, [&]() { kickDrift(positions, velocities, accelerations, 1e-3); }),
+				measure(repetitions, count, [&]() { kickDrift(positions8, velocities8, accelerations8, 1e-3); }),
+				measure(repetitions, count, [&]() { kickDrift(positions16, velocities16, accelerations16, 1e-3); }), "-");
+	for (RsqrtAccuracy accuracy : {RsqrtAccuracy::Fast, RsqrtAccuracy::Exact})
+	{
+		std::printf("%-28s %10.3f %10.3f %10.3f %10s\n", accuracy == RsqrtAccuracy::Fast ? "1/r^3 factors (Fast)" : "1/r^3 factors (Exact)",
+					measure(repetitions, count, [&]() { forceFactors(positions, point, factors, accuracy); }),
+					measure(repetitions, count, [&]() { forceFactors(positions8, point, factors, accuracy); }),
+					measure(repetitions, count, [&]() { forceFactors(positions16, point, factors, accuracy); }), "-");
+	}
+
+
+	/// Step 3: Random gathers
+	Vec3DStructs structs;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		structs.vectors.push_back(positions.get(i));
+	}
+	std::vector<uint32_t> indices(count);
+	for (std::size_t i = 0; i < count; i++)
+	{
+		indices[i] = static_cast<uint32_t>(rng.split(3).uniform(i, 0) * static_cast<double>(count));
+	}
+	double totals[4];
+	std::printf("%-28s %10.3f %10.3f %10.3f %10.3f\n", "random gather",
+				measure(repetitions, count, [&]() { totals[0] = gather(positions, indices); }),
+				measure(repetitions, count, [&]() { totals[1] = gather(positions8, indices); }),
+				measure(repetitions, count, [&]() { totals[2] = gather(positions16, indices); }),
+				measure(repetitions, count, [&]() { totals[3] = gather(structs, indices); }));
+	bool sameGathers = totals[0] == totals[1] && totals[0] == totals[2] && totals[0] == totals[3];
+	pass = pass && sameGathers;
+
+	if (!pass)
+	{
+		std::printf("\nVector blocks FAILED.\n");
+		return 1;
+	}
+	std::printf("\nAll vector block checks pass.\n");
+	return 0;
+}
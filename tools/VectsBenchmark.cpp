@@ -0,0 +1,244 @@
+//  VectsBenchmark.cpp
+//  OpenFrameworks_User_Interface_Library
+//  DavidRichardson02
+/**
+ * Vects Benchmark, a command-line tool that times the loops the simulation and geometry code run on
+ * vectors, once with the header-only Vec2D/Vec3D and once with the previous out-of-line versions
+ * (LegacyVec2D/LegacyVec3D, compiled in their own translation unit exactly as they used to be).
+ *
+ * Usage:
+ *   VectsBenchmark [repetitions]
+ *
+ * Every kernel is the same template for both types and runs 'repetitions' times (default 7); the
+ * fastest run is reported in nanoseconds per element, with the speedup and the checksum of the last run,
+ * which must match between the two (the tool exits with 1 otherwise). Build it from the repository root
+ * with optimizations, e.g.:
+ *
+ *   c++ -std=c++17 -O2 -I"Math Utilities" -Itools tools/VectsBenchmark.cpp tools/LegacyVects.cpp -o VectsBenchmark
+ */
+
+
+#include "Vects.hpp"
+#include "LegacyVects.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+
+
+
+
+namespace
+{
+	/// Times a kernel, returning the fastest of 'repetitions' runs in nanoseconds per element and the checksum of the last run.
+	struct Timing
+	{
+		double nanosecondsPerElement;
+		double checksum;
+	};
+
+	Timing measure(int repetitions, double elements, const std::function<double()> &kernel)
+	{
+		Timing timing = {0, 0};
+		for (int repetition = 0; repetition < repetitions; repetition++)
+		{
+			auto begin = std::chrono::steady_clock::now();
+			double checksum = kernel();
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / elements;
+			if (repetition == 0 || nanoseconds < timing.nanosecondsPerElement)
+			{
+				timing.nanosecondsPerElement = nanoseconds;
+			}
+			timing.checksum = checksum; // Of the last run, so kernels that update their inputs compare equal
+		}
+		return timing;
+	}
+
+
+	template<typename V>
+	std::vector<V> randomVectors2D(std::size_t count, uint32_t seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<double> unit(-1.0, 1.0);
+		std::vector<V> vectors;
+		vectors.reserve(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			double x = unit(generator), y = unit(generator);
+			vectors.push_back(V(x, y));
+		}
+		return vectors;
+	}
+
+
+	template<typename V>
+	std::vector<V> randomVectors3D(std::size_t count, uint32_t seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<double> unit(-1.0, 1.0);
+		std::vector<V> vectors;
+		vectors.reserve(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			double x = unit(generator), y = unit(generator), z = unit(generator);
+			vectors.push_back(V(x, y, z));
+		}
+		return vectors;
+	}
+
+
+
+
+	/// ------------- Kernels, identical for both vector types -------------
+	/// \{
+	template<typename V>
+	double integrate(std::vector<V> &positions, std::vector<V> &velocities, const std::vector<V> &accelerations, double dt)
+	{
+		for (std::size_t i = 0; i < positions.size(); i++) // Leapfrog drift and kick
+		{
+			velocities[i] += accelerations[i] * dt;
+			positions[i] += velocities[i] * dt;
+		}
+		return positions[positions.size() / 2].x;
+	}
+
+
+	template<typename V>
+	double directForces(const std::vector<V> &positions, std::vector<V> &accelerations, double softening2)
+	{
+		for (std::size_t i = 0; i < positions.size(); i++)
+		{
+			V acceleration(0, 0);
+			for (std::size_t j = 0; j < positions.size(); j++)
+			{
+				V difference = positions[j] - positions[i];
+				double r2 = difference.vectorSquareLength() + softening2;
+				acceleration += difference * (1.0 / (r2 * sqrt(r2)));
+			}
+			accelerations[i] = acceleration;
+		}
+		return accelerations[7].x + accelerations[positions.size() - 1].y;
+	}
+
+
+	template<typename V>
+	double countInside(const std::vector<V> &points, V center, double radius)
+	{
+		std::size_t inside = 0;
+		for (const V &point : points) // Circle::containsPoint
+		{
+			inside += (center - point).vectorSquareLength() <= radius * radius;
+		}
+		return static_cast<double>(inside);
+	}
+
+
+	template<typename V>
+	double normalizeAll(std::vector<V> &vectors)
+	{
+		for (V &vector : vectors)
+		{
+			vector = vector.vectorGetNormalized();
+		}
+		return vectors[vectors.size() / 3].x;
+	}
+
+
+	template<typename V>
+	double copyAll(const std::vector<V> &vectors)
+	{
+		std::vector<V> copy(vectors);
+		return copy.back().x;
+	}
+
+
+	template<typename V>
+	double directForces3D(const std::vector<V> &positions, std::vector<V> &accelerations, double softening2)
+	{
+		for (std::size_t i = 0; i < positions.size(); i++)
+		{
+			V acceleration(0, 0, 0);
+			for (std::size_t j = 0; j < positions.size(); j++)
+			{
+				V difference = positions[j] - positions[i];
+				double r2 = difference.vectorSquareLength() + softening2;
+				acceleration += difference * (1.0 / (r2 * sqrt(r2)));
+			}
+			accelerations[i] = acceleration;
+		}
+		return accelerations[7].z + accelerations[positions.size() - 1].y;
+	}
+	/// \}
+
+
+
+
+	/// Prints a kernel's row, returning whether the checksums match.
+	bool report(const char *name, const Timing &legacy, const Timing &inlined)
+	{
+		std::printf("%-28s %12.3f %12.3f %9.2fx   %s\n", name, legacy.nanosecondsPerElement, inlined.nanosecondsPerElement, legacy.nanosecondsPerElement / inlined.nanosecondsPerElement, legacy.checksum == inlined.checksum ? "checksums match" : "CHECKSUM MISMATCH");
+		return legacy.checksum == inlined.checksum;
+	}
+}
+
+
+
+
+int main(int argc, char **argv)
+{
+	int repetitions = argc > 1 ? std::max(1, std::atoi(argv[1])) : 7;
+	const std::size_t streamCount = 1 << 16, bodyCount = 2048;
+	bool pass = true;
+	std::printf("%-28s %12s %12s %10s\n", "kernel (ns/element)", "out-of-line", "header-only", "speedup");
+
+
+	/// Step 1: Integration of a particle set
+	{
+		auto legacyPositions = randomVectors2D<LegacyVec2D>(streamCount, 1), legacyVelocities = randomVectors2D<LegacyVec2D>(streamCount, 2), legacyAccelerations = randomVectors2D<LegacyVec2D>(streamCount, 3);
+		auto positions = randomVectors2D<Vec2D>(streamCount, 1), velocities = randomVectors2D<Vec2D>(streamCount, 2), accelerations = randomVectors2D<Vec2D>(streamCount, 3);
+		Timing legacy = measure(repetitions, streamCount, [&]() { return integrate(legacyPositions, legacyVelocities, legacyAccelerations, 1e-3); });
+		Timing inlined = measure(repetitions, streamCount, [&]() { return integrate(positions, velocities, accelerations, 1e-3); });
+		pass = report("2D leapfrog integrate", legacy, inlined) && pass;
+	}
+
+
+	/// Step 2: Direct-sum forces, the inner loop of every force evaluation
+	{
+		auto legacyPositions = randomVectors2D<LegacyVec2D>(bodyCount, 4);
+		auto positions = randomVectors2D<Vec2D>(bodyCount, 4);
+		std::vector<LegacyVec2D> legacyAccelerations(bodyCount);
+		std::vector<Vec2D> accelerations(bodyCount);
+		Timing legacy = measure(repetitions, double(bodyCount) * bodyCount, [&]() { return directForces(legacyPositions, legacyAccelerations, 1e-4); });
+		Timing inlined = measure(repetitions, double(bodyCount) * bodyCount, [&]() { return directForces(positions, accelerations, 1e-4); });
+		pass = report("2D direct-sum pair", legacy, inlined) && pass;
+
+		auto legacyPositions3 = randomVectors3D<LegacyVec3D>(bodyCount, 5);
+		auto positions3 = randomVectors3D<Vec3D>(bodyCount, 5);
+		std::vector<LegacyVec3D> legacyAccelerations3(bodyCount);
+		std::vector<Vec3D> accelerations3(bodyCount);
+		Timing legacy3 = measure(repetitions, double(bodyCount) * bodyCount, [&]() { return directForces3D(legacyPositions3, legacyAccelerations3, 1e-4); });
+		Timing inlined3 = measure(repetitions, double(bodyCount) * bodyCount, [&]() { return directForces3D(positions3, accelerations3, 1e-4); });
+		pass = report("3D direct-sum pair", legacy3, inlined3) && pass;
+	}
+
+
+	/// Step 3: Geometry, normalization and bulk copies
+	{
+		auto legacyPoints = randomVectors2D<LegacyVec2D>(streamCount, 6);
+		auto points = randomVectors2D<Vec2D>(streamCount, 6);
+		pass = report("2D circle containment", measure(repetitions, streamCount, [&]() { return countInside(legacyPoints, LegacyVec2D(0.1, 0.2), 0.5); }), measure(repetitions, streamCount, [&]() { return countInside(points, Vec2D(0.1, 0.2), 0.5); })) && pass;
+		pass = report("2D normalize", measure(repetitions, streamCount, [&]() { return normalizeAll(legacyPoints); }), measure(repetitions, streamCount, [&]() { return normalizeAll(points); })) && pass;
+		pass = report("2D vector copy", measure(repetitions, streamCount, [&]() { return copyAll(legacyPoints); }), measure(repetitions, streamCount, [&]() { return copyAll(points); })) && pass;
+	}
+
+	if (!pass)
+	{
+		std::printf("\nVects benchmark FAILED.\n");
+		return 1;
+	}
+	return 0;
+}